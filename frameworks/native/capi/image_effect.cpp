@@ -19,11 +19,13 @@
 #include "efilter_factory.h"
 #include "external_loader.h"
 #include "image_effect_inner.h"
+#include "effect_binary_helper.h"
 #include "effect_json_helper.h"
 #include "native_effect_base.h"
 #include "native_common_utils.h"
 #include "native_window.h"
 #include "event_report.h"
+#include "graphic/render_program_binary_cache.h"
 
 #define MAX_EFILTER_NUMS 100
 
@@ -703,6 +705,119 @@ OH_ImageEffect *OH_ImageEffect_Restore(const char *info)
     return ohImageEffect;
 }
 
+EFFECT_EXPORT
+ImageEffect_ErrorCode OH_ImageEffect_SaveBinary(OH_ImageEffect *imageEffect, const uint8_t **data, uint32_t *size)
+{
+    EFFECT_LOGD("Save effect to binary.");
+    CHECK_AND_RETURN_RET_LOG(imageEffect != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "SaveBinary: input parameter imageEffect is null!");
+    CHECK_AND_RETURN_RET_LOG(data != nullptr && size != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "SaveBinary: input parameter data or size is null!");
+
+    ErrorCode res = imageEffect->imageEffect_->SaveBinary(imageEffect->saveBinary);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, ImageEffect_ErrorCode::EFFECT_PARAM_ERROR,
+        "SaveBinary: save fail! res=%{public}d", res);
+    *data = imageEffect->saveBinary.data();
+    *size = static_cast<uint32_t>(imageEffect->saveBinary.size());
+
+    EventInfo eventInfo;
+    EventReport::ReportHiSysEvent(SAVE_IMAGE_EFFECT_BEHAVIOR, eventInfo);
+    return ImageEffect_ErrorCode::EFFECT_SUCCESS;
+}
+
+EFFECT_EXPORT
+OH_ImageEffect *OH_ImageEffect_RestoreBinary(const uint8_t *data, uint32_t size)
+{
+    CHECK_AND_RETURN_RET_LOG(data != nullptr, nullptr, "RestoreBinary: input parameter data is null!");
+    CHECK_AND_RETURN_RET_LOG(size < static_cast<uint32_t>(MAX_INFO_LEN), nullptr,
+        "RestoreBinary: the size of input parameter data is too large! size = %{public}u", size);
+    std::shared_ptr<const EffectChainPrototype> chain = nullptr;
+    ErrorCode res = EffectBinaryHelper::Decode(data, size, chain);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, nullptr, "RestoreBinary: decode fail! res=%{public}d", res);
+
+    std::unique_ptr<OH_ImageEffect> ohImageEffect(OH_ImageEffect_Create(chain->name_.c_str()));
+    CHECK_AND_RETURN_RET_LOG(ohImageEffect != nullptr, nullptr, "ohImageEffect create failed");
+    for (const auto &filter : chain->filters_) {
+        std::unique_ptr<OH_EffectFilter> nativeEFilter = std::make_unique<OH_EffectFilter>();
+        std::shared_ptr<EFilter> efilter = EFilterFactory::Instance()->Restore(filter, nativeEFilter.get());
+        CHECK_AND_RETURN_RET_LOG(efilter != nullptr, nullptr, "efilter restore fail! name=%{public}s",
+            filter.name_.c_str());
+        nativeEFilter->filter_ = efilter;
+        nativeEFilter->isCreatedBySystem_ = true;
+        ohImageEffect->filters_.emplace_back(nativeEFilter.release(), efilter->GetName());
+        ohImageEffect->imageEffect_->AddEFilter(efilter);
+    }
+
+    EventInfo eventInfo;
+    EventReport::ReportHiSysEvent(RESTORE_IMAGE_EFFECT_BEHAVIOR, eventInfo);
+    return ohImageEffect.release();
+}
+
+EFFECT_EXPORT
+OH_ImageEffect *OH_ImageEffect_Clone(OH_ImageEffect *imageEffect)
+{
+    CHECK_AND_RETURN_RET_LOG(imageEffect != nullptr, nullptr, "Clone: input parameter imageEffect is null!");
+    CHECK_AND_RETURN_RET_LOG(imageEffect->imageEffect_ != nullptr, nullptr, "Clone: imageEffect_ is null!");
+
+    // The native filters of the clone are owned by it, whoever created the ones of the prototype.
+    std::unordered_map<EFilter *, OH_EffectFilter *> nativeEFilters;
+    std::vector<std::unique_ptr<OH_EffectFilter>> clonedEFilters;
+    std::shared_ptr<ImageEffect> clone = imageEffect->imageEffect_->Clone(
+        [&nativeEFilters, &clonedEFilters](const std::shared_ptr<EFilter> &efilter) -> std::shared_ptr<EFilter> {
+            std::unique_ptr<OH_EffectFilter> nativeEFilter = std::make_unique<OH_EffectFilter>();
+            std::shared_ptr<EFilter> cloneEFilter = EFilterFactory::Instance()->Clone(efilter, nativeEFilter.get());
+            CHECK_AND_RETURN_RET_LOG(cloneEFilter != nullptr, nullptr, "efilter clone fail! name=%{public}s",
+                efilter->GetName().c_str());
+            nativeEFilter->filter_ = cloneEFilter;
+            nativeEFilter->isCreatedBySystem_ = true;
+            nativeEFilters.emplace(efilter.get(), nativeEFilter.get());
+            clonedEFilters.emplace_back(std::move(nativeEFilter));
+            return cloneEFilter;
+        });
+    CHECK_AND_RETURN_RET_LOG(clone != nullptr, nullptr, "Clone: imageEffect clone fail!");
+
+    std::unique_ptr<OH_ImageEffect> ohImageEffect = std::make_unique<OH_ImageEffect>();
+    ohImageEffect->imageEffect_ = clone;
+    for (auto &nativeEFilter : clonedEFilters) {
+        nativeEFilter.release();
+    }
+    // Keep the order in which the filters were added to the prototype, the index of OH_ImageEffect_GetFilter.
+    for (const auto &filter : imageEffect->filters_) {
+        auto it = filter.first == nullptr ? nativeEFilters.end() : nativeEFilters.find(filter.first->filter_.get());
+        if (it != nativeEFilters.end()) {
+            ohImageEffect->filters_.emplace_back(it->second, filter.second);
+            nativeEFilters.erase(it);
+        }
+    }
+    for (const auto &nativeEFilter : nativeEFilters) {
+        ohImageEffect->filters_.emplace_back(nativeEFilter.second, nativeEFilter.second->filter_->GetName());
+    }
+    return ohImageEffect.release();
+}
+
+EFFECT_EXPORT
+void OH_ImageEffect_Preload(void)
+{
+    ExternLoader::Instance()->Preload();
+}
+
+EFFECT_EXPORT
+bool OH_ImageEffect_IsPreloadReady(void)
+{
+    return ExternLoader::Instance()->IsReady();
+}
+
+EFFECT_EXPORT
+ImageEffect_ErrorCode OH_ImageEffect_SetShaderCacheDir(const char *path)
+{
+    CHECK_AND_RETURN_RET_LOG(path != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "SetShaderCacheDir: input parameter path is null!");
+    bool res = RenderProgramBinaryCache::Instance().SetCacheDir(path);
+    CHECK_AND_RETURN_RET_LOG(res, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "SetShaderCacheDir: set cache dir fail!");
+    return ImageEffect_ErrorCode::EFFECT_SUCCESS;
+}
+
 EFFECT_EXPORT
 int32_t OH_ImageEffect_GetFilterCount(OH_ImageEffect *imageEffect)
 {
@@ -723,6 +838,33 @@ OH_EffectFilter *OH_ImageEffect_GetFilter(OH_ImageEffect *imageEffect, uint32_t
     return imageEffect->filters_.at(index).first;
 }
 
+EFFECT_EXPORT
+ImageEffect_ErrorCode OH_ImageEffect_GetFrameStatistics(OH_ImageEffect *imageEffect,
+    ImageEffect_FrameStatistics *statistics)
+{
+    CHECK_AND_RETURN_RET_LOG(imageEffect != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "GetFrameStatistics: input parameter imageEffect is null!");
+    CHECK_AND_RETURN_RET_LOG(statistics != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "GetFrameStatistics: input parameter statistics is null!");
+
+    EffectFrameStatistics frameStatistics;
+    imageEffect->imageEffect_->GetFrameStatistics(frameStatistics);
+    statistics->renderedFrames = frameStatistics.renderedFrameNum_;
+    statistics->droppedFrames = frameStatistics.droppedFrameNum_;
+    statistics->queueDepth = frameStatistics.queueDepth_;
+    statistics->maxQueueDepth = frameStatistics.maxQueueDepth_;
+    statistics->fps = frameStatistics.fps_;
+    static_assert(OH_EFFECT_FRAME_STAGE_NUM == FRAME_STAGE_NUM, "frame stage number is mismatched!");
+    for (size_t i = 0; i < FRAME_STAGE_NUM; ++i) {
+        statistics->latency[i] = {
+            .p50 = frameStatistics.latency_[i].p50Us_,
+            .p95 = frameStatistics.latency_[i].p95Us_,
+            .p99 = frameStatistics.latency_[i].p99Us_,
+        };
+    }
+    return ImageEffect_ErrorCode::EFFECT_SUCCESS;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -72,6 +72,33 @@ OH_EffectFilterInfo::~OH_EffectFilterInfo()
     }
 }
 
+static ImageEffect_ErrorCode RegisterFilterDelegate(const OH_EffectFilterInfo *info,
+    const ImageEffect_FilterDelegate *delegate, OH_EffectFilterDelegate_RenderWithDst renderWithDst,
+    OH_EffectFilterDelegate_RenderRegion renderRegion)
+{
+    std::unique_lock<std::mutex> lock(filterMutex_);
+    CHECK_AND_RETURN_RET_LOG(info != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "RegisterFilter: input parameter info is null!");
+    CHECK_AND_RETURN_RET_LOG(delegate != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "RegisterFilter: input parameter delegate is null!");
+    EFFECT_LOGI("Filter register. filterName=%{public}s, renderMode=%{public}d, hasRenderWithDst=%{public}d, "
+        "hasRenderRegion=%{public}d, renderHalo=%{public}u", info->filterName.c_str(), info->renderMode,
+        renderWithDst != nullptr, renderRegion != nullptr, info->renderHalo);
+    std::shared_ptr<FilterDelegate> effectDelegate = std::make_shared<FilterDelegate>(info, delegate, renderWithDst,
+        renderRegion);
+
+    std::shared_ptr<EffectInfo> effectInfo = std::make_shared<EffectInfo>();
+    NativeCommonUtils::SwitchToEffectInfo(info, effectInfo);
+    EFilterFactory::Instance()->RegisterDelegate(info->filterName, effectDelegate, effectInfo);
+
+    EventInfo eventInfo = {
+        .filterName = info->filterName,
+        .supportedFormats = NativeCommonUtils::GetSupportedFormats(info),
+    };
+    EventReport::ReportHiSysEvent(REGISTER_CUSTOM_FILTER_STATISTIC, eventInfo);
+    return ImageEffect_ErrorCode::EFFECT_SUCCESS;
+}
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -238,6 +265,52 @@ ImageEffect_ErrorCode OH_EffectFilterInfo_GetSupportedFormats(OH_EffectFilterInf
     return ImageEffect_ErrorCode::EFFECT_SUCCESS;
 }
 
+EFFECT_EXPORT
+ImageEffect_ErrorCode OH_EffectFilterInfo_SetRenderMode(OH_EffectFilterInfo *info, ImageEffect_RenderMode mode)
+{
+    CHECK_AND_RETURN_RET_LOG(info != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "InfoSetRenderMode: input parameter info is null!");
+    CHECK_AND_RETURN_RET_LOG(mode >= ImageEffect_RenderMode::EFFECT_RENDER_MODE_IN_PLACE &&
+        mode <= ImageEffect_RenderMode::EFFECT_RENDER_MODE_SRC_TO_DST_OR_IN_PLACE,
+        ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID, "InfoSetRenderMode: input parameter mode is invalid! "
+        "mode=%{public}d", mode);
+    EFFECT_LOGD("Set render mode. mode=%{public}d", mode);
+    info->renderMode = mode;
+    return ImageEffect_ErrorCode::EFFECT_SUCCESS;
+}
+
+EFFECT_EXPORT
+ImageEffect_ErrorCode OH_EffectFilterInfo_GetRenderMode(OH_EffectFilterInfo *info, ImageEffect_RenderMode *mode)
+{
+    CHECK_AND_RETURN_RET_LOG(info != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "InfoGetRenderMode: input parameter info is null!");
+    CHECK_AND_RETURN_RET_LOG(mode != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "InfoGetRenderMode: input parameter mode is null!");
+    *mode = info->renderMode;
+    return ImageEffect_ErrorCode::EFFECT_SUCCESS;
+}
+
+EFFECT_EXPORT
+ImageEffect_ErrorCode OH_EffectFilterInfo_SetRenderHalo(OH_EffectFilterInfo *info, uint32_t halo)
+{
+    CHECK_AND_RETURN_RET_LOG(info != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "InfoSetRenderHalo: input parameter info is null!");
+    EFFECT_LOGD("Set render halo. halo=%{public}u", halo);
+    info->renderHalo = halo;
+    return ImageEffect_ErrorCode::EFFECT_SUCCESS;
+}
+
+EFFECT_EXPORT
+ImageEffect_ErrorCode OH_EffectFilterInfo_GetRenderHalo(OH_EffectFilterInfo *info, uint32_t *halo)
+{
+    CHECK_AND_RETURN_RET_LOG(info != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "InfoGetRenderHalo: input parameter info is null!");
+    CHECK_AND_RETURN_RET_LOG(halo != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "InfoGetRenderHalo: input parameter halo is null!");
+    *halo = info->renderHalo;
+    return ImageEffect_ErrorCode::EFFECT_SUCCESS;
+}
+
 EFFECT_EXPORT
 ImageEffect_ErrorCode OH_EffectFilterInfo_Release(OH_EffectFilterInfo *info)
 {
@@ -510,24 +583,25 @@ EFFECT_EXPORT
 ImageEffect_ErrorCode OH_EffectFilter_Register(const OH_EffectFilterInfo *info,
     const ImageEffect_FilterDelegate *delegate)
 {
-    std::unique_lock<std::mutex> lock(filterMutex_);
-    CHECK_AND_RETURN_RET_LOG(info != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
-        "RegisterFilter: input parameter info is null!");
-    CHECK_AND_RETURN_RET_LOG(delegate != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
-        "RegisterFilter: input parameter delegate is null!");
-    EFFECT_LOGI("Filter register. filterName=%{public}s", info->filterName.c_str());
-    std::shared_ptr<FilterDelegate> effectDelegate = std::make_shared<FilterDelegate>(info, delegate);
+    return RegisterFilterDelegate(info, delegate, nullptr, nullptr);
+}
 
-    std::shared_ptr<EffectInfo> effectInfo = std::make_shared<EffectInfo>();
-    NativeCommonUtils::SwitchToEffectInfo(info, effectInfo);
-    EFilterFactory::Instance()->RegisterDelegate(info->filterName, effectDelegate, effectInfo);
+EFFECT_EXPORT
+ImageEffect_ErrorCode OH_EffectFilter_RegisterWithDstRender(const OH_EffectFilterInfo *info,
+    const ImageEffect_FilterDelegate *delegate, OH_EffectFilterDelegate_RenderWithDst renderWithDst)
+{
+    CHECK_AND_RETURN_RET_LOG(renderWithDst != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "RegisterFilterWithDstRender: input parameter renderWithDst is null!");
+    return RegisterFilterDelegate(info, delegate, renderWithDst, nullptr);
+}
 
-    EventInfo eventInfo = {
-        .filterName = info->filterName,
-        .supportedFormats = NativeCommonUtils::GetSupportedFormats(info),
-    };
-    EventReport::ReportHiSysEvent(REGISTER_CUSTOM_FILTER_STATISTIC, eventInfo);
-    return ImageEffect_ErrorCode::EFFECT_SUCCESS;
+EFFECT_EXPORT
+ImageEffect_ErrorCode OH_EffectFilter_RegisterWithRegionRender(const OH_EffectFilterInfo *info,
+    const ImageEffect_FilterDelegate *delegate, OH_EffectFilterDelegate_RenderRegion renderRegion)
+{
+    CHECK_AND_RETURN_RET_LOG(renderRegion != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "RegisterFilterWithRegionRender: input parameter renderRegion is null!");
+    return RegisterFilterDelegate(info, delegate, nullptr, renderRegion);
 }
 
 EFFECT_EXPORT
@@ -47,6 +47,7 @@ struct OH_ImageEffect {
     OH_ImageEffect() = default;
     std::shared_ptr<OHOS::Media::Effect::ImageEffect> imageEffect_ = nullptr;
     char *saveJson = nullptr;
+    std::vector<uint8_t> saveBinary;
     std::vector<std::pair<OH_EffectFilter *, std::string>> filters_;
     ~OH_ImageEffect()
     {
@@ -81,6 +82,8 @@ struct OH_EffectFilterInfo {
     uint32_t bufferTypeArraySize = 0;
     ImageEffect_Format *effectFormat = nullptr;
     uint32_t formatArraySize = 0;
+    ImageEffect_RenderMode renderMode = ImageEffect_RenderMode::EFFECT_RENDER_MODE_IN_PLACE;
+    uint32_t renderHalo = 0;
 };
 
 /**
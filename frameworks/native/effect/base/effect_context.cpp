@@ -65,6 +65,11 @@ std::shared_ptr<ExifMetadata> EffectContext::GetExifMetadata()
     }
 }
 
+ErrorCode EffectContext::CheckCanceled() const
+{
+    return cancelToken_ == nullptr ? ErrorCode::SUCCESS : cancelToken_->Check();
+}
+
 } // namespace Effect
 } // namespace Media
 } // namespace OHOS
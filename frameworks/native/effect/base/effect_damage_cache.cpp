@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "effect_damage_cache.h"
+
+#include <algorithm>
+#include <array>
+
+#include "effect_log.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace {
+constexpr uint32_t RGBA_BYTES_PER_PIXEL = 4;
+constexpr uint32_t CHROMA_SUBSAMPLE = 2;
+constexpr size_t MAX_PLANE_NUM = 2;
+
+struct PlaneLayout {
+    size_t offset = 0;
+    uint32_t rowDiv = 1;
+    uint32_t bytesPerColumn = 1;
+};
+
+// Hdr frames go through the display path of the sink, so only the sdr formats of the cpu filters are handled.
+size_t GetPlaneLayouts(const BufferInfo &frame, std::array<PlaneLayout, MAX_PLANE_NUM> &planes)
+{
+    switch (frame.formatType_) {
+        case IEffectFormat::RGBA8888:
+            planes[0] = { 0, 1, RGBA_BYTES_PER_PIXEL };
+            return 1;
+        case IEffectFormat::YUVNV12:
+        case IEffectFormat::YUVNV21:
+            // Every chroma row holds interleaved samples of two pixels, i.e. one byte per pixel column.
+            planes[0] = { 0, 1, 1 };
+            planes[1] = { static_cast<size_t>(frame.rowStride_) * frame.height_, CHROMA_SUBSAMPLE, 1 };
+            return MAX_PLANE_NUM;
+        default:
+            return 0;
+    }
+}
+
+uint32_t DivCeil(uint32_t value, uint32_t div)
+{
+    return (value + div - 1) / div;
+}
+
+size_t GetFrameSize(const BufferInfo &frame, const std::array<PlaneLayout, MAX_PLANE_NUM> &planes, size_t planeNum)
+{
+    const PlaneLayout &lastPlane = planes[planeNum - 1];
+    return lastPlane.offset + static_cast<size_t>(frame.rowStride_) * DivCeil(frame.height_, lastPlane.rowDiv);
+}
+
+// Copies the bytes [left, right) of the plane rows [begin, end), whole rows are copied as one block.
+void CopyRows(const uint8_t *src, uint8_t *dst, uint32_t rowStride, size_t offset, uint32_t begin, uint32_t end,
+    size_t left, size_t right)
+{
+    if (begin >= end || left >= right) {
+        return;
+    }
+    size_t start = offset + static_cast<size_t>(begin) * rowStride;
+    if (left == 0 && right == rowStride) {
+        std::copy_n(src + start, static_cast<size_t>(end - begin) * rowStride, dst + start);
+        return;
+    }
+    for (uint32_t row = begin; row < end; ++row, start += rowStride) {
+        std::copy_n(src + start + left, right - left, dst + start + left);
+    }
+}
+} // namespace
+
+bool EffectDamageCache::AlignDamage(const BufferInfo &frame, RenderRegion &damage)
+{
+    std::array<PlaneLayout, MAX_PLANE_NUM> planes;
+    size_t planeNum = GetPlaneLayouts(frame, planes);
+    if (planeNum == 0 || frame.width_ == 0 || frame.height_ == 0) {
+        return false;
+    }
+
+    int32_t width = static_cast<int32_t>(frame.width_);
+    int32_t height = static_cast<int32_t>(frame.height_);
+    int32_t x0 = std::clamp(std::min(damage.x0, damage.x1), 0, width);
+    int32_t x1 = std::clamp(std::max(damage.x0, damage.x1), 0, width);
+    int32_t y0 = std::clamp(std::min(damage.y0, damage.y1), 0, height);
+    int32_t y1 = std::clamp(std::max(damage.y0, damage.y1), 0, height);
+    if (planeNum > 1) {
+        const int32_t subsample = static_cast<int32_t>(CHROMA_SUBSAMPLE);
+        x0 -= x0 % subsample;
+        y0 -= y0 % subsample;
+        x1 = std::min(x1 + x1 % subsample, width);
+        y1 = std::min(y1 + y1 % subsample, height);
+    }
+    if (x0 >= x1 || y0 >= y1 || (x0 == 0 && y0 == 0 && x1 == width && y1 == height)) {
+        return false;
+    }
+    damage = { x0, y0, x1, y1 };
+    return true;
+}
+
+bool EffectDamageCache::IsSameLayout(const BufferInfo &frame) const
+{
+    return frame.width_ == width_ && frame.height_ == height_ && frame.rowStride_ == rowStride_ &&
+        frame.formatType_ == format_ && frame.colorSpace_ == colorSpace_;
+}
+
+bool EffectDamageCache::IsReusable(const BufferInfo &frame, uint64_t frameIndex,
+    const std::vector<uint64_t> &settings) const
+{
+    return isValid_ && frameIndex == frameIndex_ + 1 && IsSameLayout(frame) && settings == settings_;
+}
+
+ErrorCode EffectDamageCache::Merge(const BufferInfo &frame, uint64_t frameIndex, const RenderRegion &damage)
+{
+    CHECK_AND_RETURN_RET_LOG(isValid_ && IsSameLayout(frame) && frame.addr_ != nullptr, ErrorCode::ERR_PARAM_INVALID,
+        "EffectDamageCache::Merge: the frame does not match the cache");
+    std::array<PlaneLayout, MAX_PLANE_NUM> planes;
+    size_t planeNum = GetPlaneLayouts(frame, planes);
+    CHECK_AND_RETURN_RET_LOG(planeNum > 0 && frame.len_ >= data_.size(), ErrorCode::ERR_PARAM_INVALID,
+        "EffectDamageCache::Merge: invalid frame, format=%{public}d, len=%{public}u",
+        frame.formatType_, frame.len_);
+
+    uint8_t *addr = static_cast<uint8_t *>(frame.addr_);
+    for (size_t i = 0; i < planeNum; ++i) {
+        const PlaneLayout &plane = planes[i];
+        uint32_t rowNum = DivCeil(height_, plane.rowDiv);
+        uint32_t begin = static_cast<uint32_t>(damage.y0) / plane.rowDiv;
+        uint32_t end = DivCeil(static_cast<uint32_t>(damage.y1), plane.rowDiv);
+        size_t left = static_cast<size_t>(damage.x0) * plane.bytesPerColumn;
+        size_t right = static_cast<size_t>(damage.x1) * plane.bytesPerColumn;
+        size_t rowBytes = static_cast<size_t>(width_) * plane.bytesPerColumn;
+
+        // The previous output outside of the damage.
+        CopyRows(data_.data(), addr, rowStride_, plane.offset, 0, begin, 0, rowStride_);
+        CopyRows(data_.data(), addr, rowStride_, plane.offset, end, rowNum, 0, rowStride_);
+        CopyRows(data_.data(), addr, rowStride_, plane.offset, begin, end, 0, left);
+        CopyRows(data_.data(), addr, rowStride_, plane.offset, begin, end, right, rowBytes);
+
+        // The damage becomes the output for the next frame.
+        CopyRows(addr, data_.data(), rowStride_, plane.offset, begin, end, left, right);
+    }
+    frameIndex_ = frameIndex;
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode EffectDamageCache::Update(const BufferInfo &frame, uint64_t frameIndex,
+    const std::vector<uint64_t> &settings)
+{
+    isValid_ = false;
+    std::array<PlaneLayout, MAX_PLANE_NUM> planes;
+    size_t planeNum = GetPlaneLayouts(frame, planes);
+    CHECK_AND_RETURN_RET_LOG(planeNum > 0 && frame.addr_ != nullptr, ErrorCode::ERR_PARAM_INVALID,
+        "EffectDamageCache::Update: invalid frame, format=%{public}d", frame.formatType_);
+    size_t size = GetFrameSize(frame, planes, planeNum);
+    CHECK_AND_RETURN_RET_LOG(frame.len_ >= size, ErrorCode::ERR_PARAM_INVALID,
+        "EffectDamageCache::Update: frame len is too small, len=%{public}u, size=%{public}zu", frame.len_, size);
+
+    data_.resize(size);
+    std::copy_n(static_cast<const uint8_t *>(frame.addr_), size, data_.data());
+    width_ = frame.width_;
+    height_ = frame.height_;
+    rowStride_ = frame.rowStride_;
+    format_ = frame.formatType_;
+    colorSpace_ = frame.colorSpace_;
+    frameIndex_ = frameIndex;
+    settings_ = settings;
+    isValid_ = true;
+    return ErrorCode::SUCCESS;
+}
+
+void EffectDamageCache::Invalidate()
+{
+    // The memory is kept, the stream is likely to send partial damages again.
+    isValid_ = false;
+}
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
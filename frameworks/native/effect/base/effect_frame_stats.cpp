@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "effect_frame_stats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <vector>
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace {
+constexpr int64_t NS_PER_US = 1000;
+constexpr double NS_PER_SECOND = 1e9;
+constexpr uint32_t PERCENT_50 = 50;
+constexpr uint32_t PERCENT_95 = 95;
+constexpr uint32_t PERCENT_99 = 99;
+constexpr uint32_t PERCENT_100 = 100;
+
+struct StageRange {
+    FrameCheckpoint begin;
+    FrameCheckpoint end;
+};
+
+constexpr std::array<StageRange, FRAME_STAGE_NUM> STAGE_RANGES = { {
+    { FrameCheckpoint::ACQUIRED, FrameCheckpoint::FENCE_SIGNALED },
+    { FrameCheckpoint::FENCE_SIGNALED, FrameCheckpoint::CACHE_INVALIDATED },
+    { FrameCheckpoint::CACHE_INVALIDATED, FrameCheckpoint::BUFFER_REQUESTED },
+    { FrameCheckpoint::QUEUED, FrameCheckpoint::RENDER_BEGIN },
+    { FrameCheckpoint::RENDER_BEGIN, FrameCheckpoint::RENDER_END },
+    { FrameCheckpoint::RENDER_END, FrameCheckpoint::FLUSHED },
+    { FrameCheckpoint::ACQUIRED, FrameCheckpoint::FLUSHED },
+} };
+
+int64_t GetNowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint32_t GetStageDurationUs(const EffectFrameTimestamps &timestamps, const StageRange &range)
+{
+    int64_t beginNs = timestamps.checkpointNs_[static_cast<size_t>(range.begin)];
+    int64_t endNs = timestamps.checkpointNs_[static_cast<size_t>(range.end)];
+    if (beginNs == 0 || endNs < beginNs) {
+        return 0;
+    }
+    int64_t durationUs = (endNs - beginNs) / NS_PER_US;
+    return static_cast<uint32_t>(std::min<int64_t>(durationUs, std::numeric_limits<uint32_t>::max()));
+}
+
+// The values must be sorted.
+uint32_t GetPercentile(const std::vector<uint32_t> &values, uint32_t percent)
+{
+    if (values.empty()) {
+        return 0;
+    }
+    size_t index = (values.size() * percent + PERCENT_100 - 1) / PERCENT_100;
+    return values[std::clamp<size_t>(index, 1, values.size()) - 1];
+}
+} // namespace
+
+void EffectFrameTimestamps::Mark(FrameCheckpoint checkpoint)
+{
+    checkpointNs_[static_cast<size_t>(checkpoint)] = GetNowNs();
+}
+
+void EffectFrameStats::Commit(const EffectFrameTimestamps &timestamps)
+{
+    uint64_t index = writeIndex_.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = slots_[index % FRAME_WINDOW_SIZE];
+
+    // An odd sequence marks the slot as being written.
+    slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < FRAME_STAGE_NUM; ++i) {
+        slot.durationUs[i].store(GetStageDurationUs(timestamps, STAGE_RANGES[i]), std::memory_order_relaxed);
+    }
+    slot.flushedNs.store(timestamps.checkpointNs_[static_cast<size_t>(FrameCheckpoint::FLUSHED)],
+        std::memory_order_relaxed);
+    slot.sequence.store(index * 2 + 2, std::memory_order_release);
+}
+
+void EffectFrameStats::RecordDrop(uint32_t droppedNum)
+{
+    droppedFrameNum_.fetch_add(droppedNum, std::memory_order_relaxed);
+}
+
+void EffectFrameStats::RecordQueueDepth(uint32_t queueDepth)
+{
+    queueDepth_.store(queueDepth, std::memory_order_relaxed);
+    uint32_t maxQueueDepth = maxQueueDepth_.load(std::memory_order_relaxed);
+    while (queueDepth > maxQueueDepth &&
+        !maxQueueDepth_.compare_exchange_weak(maxQueueDepth, queueDepth, std::memory_order_relaxed)) {
+    }
+}
+
+void EffectFrameStats::GetStatistics(EffectFrameStatistics &statistics) const
+{
+    statistics.renderedFrameNum_ = writeIndex_.load(std::memory_order_relaxed);
+    statistics.droppedFrameNum_ = droppedFrameNum_.load(std::memory_order_relaxed);
+    statistics.queueDepth_ = queueDepth_.load(std::memory_order_relaxed);
+    statistics.maxQueueDepth_ = maxQueueDepth_.load(std::memory_order_relaxed);
+
+    std::array<std::vector<uint32_t>, FRAME_STAGE_NUM> durations;
+    int64_t firstFlushedNs = std::numeric_limits<int64_t>::max();
+    int64_t lastFlushedNs = 0;
+    size_t frameNum = 0;
+    for (const Slot &slot : slots_) {
+        uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence == 0 || sequence % 2 == 1) {
+            continue;
+        }
+        std::array<uint32_t, FRAME_STAGE_NUM> durationUs;
+        for (size_t i = 0; i < FRAME_STAGE_NUM; ++i) {
+            durationUs[i] = slot.durationUs[i].load(std::memory_order_relaxed);
+        }
+        int64_t flushedNs = slot.flushedNs.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+            continue; // overwritten while reading
+        }
+        for (size_t i = 0; i < FRAME_STAGE_NUM; ++i) {
+            durations[i].push_back(durationUs[i]);
+        }
+        if (flushedNs > 0) {
+            firstFlushedNs = std::min(firstFlushedNs, flushedNs);
+            lastFlushedNs = std::max(lastFlushedNs, flushedNs);
+            frameNum++;
+        }
+    }
+
+    for (size_t i = 0; i < FRAME_STAGE_NUM; ++i) {
+        std::sort(durations[i].begin(), durations[i].end());
+        statistics.latency_[i] = {
+            .p50Us_ = GetPercentile(durations[i], PERCENT_50),
+            .p95Us_ = GetPercentile(durations[i], PERCENT_95),
+            .p99Us_ = GetPercentile(durations[i], PERCENT_99),
+        };
+    }
+    statistics.fps_ = frameNum > 1 && lastFlushedNs > firstFlushedNs ?
+        static_cast<float>((frameNum - 1) * NS_PER_SECOND / (lastFlushedNs - firstFlushedNs)) : 0.f;
+}
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "effect_render_profile.h"
+
+#include <array>
+#include <chrono>
+#include <ctime>
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace {
+constexpr int64_t NS_PER_SECOND = 1000000000;
+constexpr double NS_PER_US = 1000.0;
+
+constexpr std::array<const char *, static_cast<size_t>(ProfileStage::STAGE_BUTT)> STAGE_NAMES = {
+    "GetImageInfo",
+    "LockAll",
+    "Prepare",
+    "ConvertColorSpace",
+    "FilterRender",
+    "MemoryAlloc",
+    "MemoryReuse",
+    "Memcpy",
+    "FormatConvert",
+    "Sink",
+};
+
+thread_local EffectRenderProfile *g_currentProfile = nullptr;
+
+int64_t GetWallNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t GetThreadCpuNs()
+{
+    struct timespec ts = { 0, 0 };
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0;
+    }
+    return static_cast<int64_t>(ts.tv_sec) * NS_PER_SECOND + ts.tv_nsec;
+}
+} // namespace
+
+void EffectRenderProfile::AddRecord(EffectProfileRecord &&record)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    records_.emplace_back(std::move(record));
+}
+
+std::vector<EffectProfileRecord> EffectRenderProfile::GetRecords() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return records_;
+}
+
+EffectJsonPtr EffectRenderProfile::ToJson() const
+{
+    std::vector<EffectProfileRecord> records = GetRecords();
+    EffectJsonPtr stages = EffectJsonHelper::CreateArray();
+    for (const auto &record : records) {
+        EffectJsonPtr item = EffectJsonHelper::CreateObject();
+        item->Put("stage", GetStageName(record.stage_));
+        item->Put("name", record.name_);
+        item->Put("wallUs", static_cast<double>(record.wallNs_) / NS_PER_US);
+        item->Put("cpuUs", static_cast<double>(record.cpuNs_) / NS_PER_US);
+        if (record.bytes_ != 0) {
+            item->Put("bytes", static_cast<double>(record.bytes_));
+        }
+        if (!record.detail_.empty()) {
+            item->Put("detail", record.detail_);
+        }
+        stages->Add(item);
+    }
+
+    EffectJsonPtr root = EffectJsonHelper::CreateObject();
+    root->Put("stages", stages);
+    return root;
+}
+
+const char *EffectRenderProfile::GetStageName(ProfileStage stage)
+{
+    size_t index = static_cast<size_t>(stage);
+    return index < STAGE_NAMES.size() ? STAGE_NAMES[index] : "Unknown";
+}
+
+EffectRenderProfile *EffectRenderProfile::GetCurrent()
+{
+    return g_currentProfile;
+}
+
+EffectRenderProfile *EffectRenderProfile::SetCurrent(EffectRenderProfile *profile)
+{
+    EffectRenderProfile *previous = g_currentProfile;
+    g_currentProfile = profile;
+    return previous;
+}
+
+EffectProfileBinder::EffectProfileBinder(EffectRenderProfile *profile)
+    : previous_(EffectRenderProfile::SetCurrent(profile))
+{
+}
+
+EffectProfileBinder::~EffectProfileBinder()
+{
+    EffectRenderProfile::SetCurrent(previous_);
+}
+
+EffectProfileScope::EffectProfileScope(EffectRenderProfile *profile, ProfileStage stage, const std::string &name)
+    : profile_(profile)
+{
+    if (profile_ == nullptr) {
+        return;
+    }
+    record_.stage_ = stage;
+    record_.name_ = name;
+    wallBeginNs_ = GetWallNs();
+    cpuBeginNs_ = GetThreadCpuNs();
+}
+
+EffectProfileScope::EffectProfileScope(ProfileStage stage, const std::string &name)
+    : EffectProfileScope(EffectRenderProfile::GetCurrent(), stage, name)
+{
+}
+
+EffectProfileScope::~EffectProfileScope()
+{
+    if (profile_ == nullptr) {
+        return;
+    }
+    record_.wallNs_ = GetWallNs() - wallBeginNs_;
+    record_.cpuNs_ = GetThreadCpuNs() - cpuBeginNs_;
+    profile_->AddRecord(std::move(record_));
+}
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
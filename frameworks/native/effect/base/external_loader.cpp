@@ -16,11 +16,21 @@
 #include "external_loader.h"
 #include "effect_trace.h"
 
+#include <chrono>
 #include <dlfcn.h>
+#include <thread>
 
 namespace OHOS {
 namespace Media {
 namespace Effect {
+namespace {
+int64_t GetNowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+} // namespace
+
 ExternLoader *ExternLoader::Instance()
 {
     static ExternLoader instance;
@@ -36,7 +46,9 @@ void ExternLoader::LoadExtSo()
         return;
     }
 
+    int64_t beginNs = GetNowNs();
     void *effectExtHandle = dlopen("libimage_effect_ext.so", RTLD_NOW);
+    dlopenNs_ = GetNowNs() - beginNs;
     if (effectExtHandle == nullptr) {
         EFFECT_LOGE("EFilterFactory: dlopen libimage_effect_ext.so failed! dlerror=%{public}s", dlerror());
         isExtLoad_ = false;
@@ -45,6 +57,7 @@ void ExternLoader::LoadExtSo()
     EFFECT_LOGI("EFilterFactory: dlopen libimage_effect_ext.so success!");
 
     bool allSymbolsLoaded = true;  // 用于跟踪所有符号是否加载成功
+    beginNs = GetNowNs();
 
     void* initFunc = dlsym(effectExtHandle, "Init");
     if (!initFunc) {
@@ -70,6 +83,8 @@ void ExternLoader::LoadExtSo()
         allSymbolsLoaded = false;
     }
 
+    dlsymNs_ = GetNowNs() - beginNs;
+
     // 如果dlsym调用成功， 将临时指针赋值给类成员
     if (allSymbolsLoaded) {
         initFunc_ = reinterpret_cast<InitModuleFunc>(initFunc);
@@ -113,6 +128,10 @@ DeinitModuleFunc ExternLoader::GetDeinitModuleFunc() const
 
 void ExternLoader::InitExt()
 {
+    // Called before every filter creation and lookup, nothing is left to do once the library is loaded and initialized.
+    if (hasInitExt_ && IsExtLoad()) {
+        return;
+    }
     std::unique_lock<std::mutex> lock(initExtSo_);
     if (!IsExtLoad()) {
         LoadExtSo();
@@ -124,12 +143,43 @@ void ExternLoader::InitExt()
 
     auto initFunc = ExternLoader::Instance()->GetInitFunc();
     if (initFunc) {
+        int64_t beginNs = GetNowNs();
         initFunc();
+        initNs_ = GetNowNs() - beginNs;
     } else {
         EFFECT_LOGE("EFilterFactory: shared lib so not find function!");
     }
     hasInitExt_ = true;
 }
+
+void ExternLoader::Preload()
+{
+    bool expected = false;
+    if (hasInitExt_ || !hasPreload_.compare_exchange_strong(expected, true)) {
+        return;
+    }
+    EFFECT_LOGI("ExternLoader: preload enter!");
+    std::thread([]() {
+        EFFECT_TRACE_NAME("ExternLoader::Preload");
+        ExternLoader::Instance()->InitExt();
+    }).detach();
+}
+
+bool ExternLoader::IsReady() const
+{
+    return hasInitExt_;
+}
+
+ExternLoaderStats ExternLoader::GetStartupStats() const
+{
+    ExternLoaderStats stats;
+    stats.dlopenNs_ = dlopenNs_;
+    stats.dlsymNs_ = dlsymNs_;
+    stats.initNs_ = initNs_;
+    stats.isExtLoad_ = isExtLoad_;
+    stats.isReady_ = hasInitExt_;
+    return stats;
+}
 } // namespace Effect
 } // namespace Media
 } // namespace OHOS
\ No newline at end of file
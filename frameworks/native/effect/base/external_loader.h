@@ -35,6 +35,16 @@ using InitModuleFunc = void (*)();
 // Type alias for module deinitialization function
 using DeinitModuleFunc = void (*)();
 
+// Startup costs of the external library in nanoseconds, 0 for the steps that have not run.
+struct ExternLoaderStats {
+    int64_t dlopenNs_ = 0;
+    // Resolution of Init, Deinit, InitMoudle and DeinitModule together.
+    int64_t dlsymNs_ = 0;
+    int64_t initNs_ = 0;
+    bool isExtLoad_ = false;
+    bool isReady_ = false;
+};
+
 // Class responsible for loading and managing external shared libraries
 class ExternLoader {
 public:
@@ -60,6 +70,15 @@ public:
 
     // Initializes the external library
     void InitExt();
+
+    // Starts InitExt on a background thread, so that the first filter or effect created does not pay for it. Only the
+    // first call has an effect, the callers of InitExt meanwhile wait for it to finish.
+    IMAGE_EFFECT_EXPORT void Preload();
+
+    // Whether InitExt has finished, loaded or not. It does not block.
+    IMAGE_EFFECT_EXPORT bool IsReady() const;
+
+    IMAGE_EFFECT_EXPORT ExternLoaderStats GetStartupStats() const;
 private:
     ExternLoader() = default;
 
@@ -76,6 +95,13 @@ private:
     std::atomic<bool> isExtLoad_ = false;
     // Atomic flag indicating if the external library has been initialized
     std::atomic<bool> hasInitExt_ = false;
+    // Atomic flag indicating if the preload thread has been started
+    std::atomic<bool> hasPreload_ = false;
+
+    // Startup costs, each written once under the mutex of its step
+    std::atomic<int64_t> dlopenNs_ = 0;
+    std::atomic<int64_t> dlsymNs_ = 0;
+    std::atomic<int64_t> initNs_ = 0;
 
     // Mutex for synchronizing loading of the external shared library
     std::mutex loadExtSo_;
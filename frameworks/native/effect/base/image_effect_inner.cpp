@@ -29,12 +29,14 @@
 #include "image_source_filter.h"
 #include "effect_surface_adapter.h"
 #include "pipeline_core.h"
+#include "effect_binary_helper.h"
 #include "effect_json_helper.h"
 #include "efilter_factory.h"
 #include "external_loader.h"
 #include "effect_context.h"
 #include "colorspace_helper.h"
 #include "memcpy_helper.h"
+#include "region_helper.h"
 
 #include "v1_1/buffer_handle_meta_key_type.h"
 #include "effect_log.h"
@@ -44,9 +46,12 @@
 #include "native_window.h"
 #include "image_source.h"
 #include "capability_negotiate.h"
+#include "render_perf_stats.h"
 
 #define RENDER_QUEUE_SIZE 8
 #define COMMON_TASK_TAG 0
+#define MIN_IN_FLIGHT_DEPTH 1
+#define MAX_IN_FLIGHT_DEPTH 3
 namespace OHOS {
 namespace Media {
 namespace Effect {
@@ -59,6 +64,11 @@ enum class EffectState {
 
 const int QUALITY_MAX_CONSTANT = 100;
 const std::string FUNCTION_FLUSH_SURFACE_BUFFER = "flushSurfaceBuffer";
+const std::string FUNCTION_RENDER_TIMEOUT = "renderTimeout";
+const std::string FUNCTION_RENDER_PRIORITY = "renderPriority";
+const std::string FUNCTION_IN_FLIGHT_DEPTH = "inFlightDepth";
+const std::string FUNCTION_RENDER_PROFILE = "renderProfile";
+const std::string FUNCTION_RENDER_REGION = "renderRegion";
 
 class ImageEffect::Impl {
 public:
@@ -219,16 +229,12 @@ ImageEffect::ImageEffect(const char *name)
     ExternLoader::Instance()->InitExt();
     ExtInitModule();
 
-    if (m_renderThread == nullptr) {
-        auto func = [this]() {
-            EFFECT_LOGD("ImageEffect has no render work to do!");
-        };
-        m_renderThread = new RenderThread<>(RENDER_QUEUE_SIZE, func);
-        m_renderThread->Start();
+    if (m_renderStrand == nullptr) {
+        m_renderStrand = RenderExecutor::Instance().CreateStrand(RENDER_QUEUE_SIZE);
         if (name != nullptr && strcmp(name, "Photo") == 0) {
             auto task = std::make_shared<RenderTask<>>([this]() { this->InitEGLEnv(); }, COMMON_TASK_TAG,
                 RequestTaskId());
-            m_renderThread->AddTask(task);
+            m_renderStrand->AddTask(task);
             task->Wait();
         }
     }
@@ -244,15 +250,16 @@ ImageEffect::~ImageEffect()
     if (impl_->surfaceAdapter_) {
         impl_->surfaceAdapter_->Destroy();
     }
-    m_renderThread->ClearTask();
+    Cancel();
+    m_renderStrand->ClearTask();
     auto task = std::make_shared<RenderTask<>>([this]() { this->DestroyEGLEnv(); }, COMMON_TASK_TAG,
         RequestTaskId());
-    m_renderThread->AddTask(task);
+    m_renderStrand->AddTask(task);
     task->Wait();
     EFFECT_LOGI("ImageEffect destruct destroy egl env!");
     ExtDeinitModule();
-    m_renderThread->Stop();
-    delete m_renderThread;
+    m_renderStrand->Stop();
+    m_renderStrand = nullptr;
 
     impl_->effectContext_->renderEnvironment_ = nullptr;
     if (toProducerSurface_) {
@@ -263,6 +270,7 @@ ImageEffect::~ImageEffect()
     }
     fromProducerSurface_ = nullptr;
     impl_ = nullptr;
+    RenderPerfStats::Instance().Flush();
     EFFECT_LOGI("ImageEffect destruct end!");
 }
 
@@ -440,17 +448,38 @@ ErrorCode ChooseIPType(const std::shared_ptr<EffectBuffer> &srcEffectBuffer,
     return ErrorCode::SUCCESS;
 }
 
+void MakeEGLEnvCurrent(const std::shared_ptr<RenderEnvironment> &renderEnvironment)
+{
+    // Strands of several effects may be pinned to the same worker, each with its own context, so every GL task
+    // makes the context of its effect current before touching GL objects.
+    if (renderEnvironment == nullptr || renderEnvironment->GetEGLStatus() != EGLStatus::READY) {
+        return;
+    }
+    if (!renderEnvironment->BeginFrame()) {
+        EFFECT_LOGE("MakeEGLEnvCurrent: make current fail!");
+    }
+}
+
 ErrorCode ProcessPipelineTask(std::shared_ptr<PipelineCore> pipeline, const EffectParameters &effectParameters)
 {
     EFFECT_TRACE_NAME("ProcessPipelineTask");
+    ErrorCode res = effectParameters.effectContext_->CheckCanceled();
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "ProcessPipelineTask: canceled before start!");
+    EffectRenderProfile *profile = effectParameters.effectContext_->renderProfile_.get();
+    EffectProfileBinder profileBinder(profile);
+
     EFFECT_TRACE_BEGIN("ConvertColorSpace");
-    ErrorCode res = ColorSpaceHelper::ConvertColorSpace(effectParameters.srcEffectBuffer_,
-        effectParameters.effectContext_);
+    {
+        EffectProfileScope profileScope(profile, ProfileStage::CONVERT_COLOR_SPACE, "ColorSpaceHelper");
+        res = ColorSpaceHelper::ConvertColorSpace(effectParameters.srcEffectBuffer_, effectParameters.effectContext_);
+    }
     EFFECT_TRACE_END();
     if (res != ErrorCode::SUCCESS) {
         EFFECT_LOGE("ProcessPipelineTask:ConvertColorSpace fail! res=%{public}d", res);
         return res;
     }
+    res = effectParameters.effectContext_->CheckCanceled();
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "ProcessPipelineTask: canceled after convert!");
 
     IPType runningIPType;
     res = ChooseIPType(effectParameters.srcEffectBuffer_, effectParameters.effectContext_, effectParameters.config_,
@@ -464,6 +493,9 @@ ErrorCode ProcessPipelineTask(std::shared_ptr<PipelineCore> pipeline, const Effe
         bool isCustomEnv = effectParameters.srcEffectBuffer_->extraInfo_->dataType == DataType::TEX;
         effectParameters.effectContext_->renderEnvironment_->Init(isCustomEnv);
         effectParameters.effectContext_->renderEnvironment_->Prepare();
+        RenderExecutor::PinCurrentStrand();
+    } else {
+        MakeEGLEnvCurrent(effectParameters.effectContext_->renderEnvironment_);
     }
     effectParameters.effectContext_->ipType_ = runningIPType;
     effectParameters.effectContext_->memoryManager_->SetIPType(runningIPType);
@@ -477,7 +509,8 @@ ErrorCode ProcessPipelineTask(std::shared_ptr<PipelineCore> pipeline, const Effe
 }
 
 ErrorCode StartPipelineInner(std::shared_ptr<PipelineCore> &pipeline, const EffectParameters &effectParameters,
-    unsigned long int taskId, RenderThread<> *thread, bool isNeedCreateThread = false)
+    unsigned long int taskId, const std::shared_ptr<RenderStrand> &thread, bool isNeedCreateThread = false,
+    RenderTaskPriority priority = RenderTaskPriority::PREVIEW)
 {
     if (thread == nullptr) {
         EFFECT_LOGE("pipeline Prepare fail! render thread is nullptr");
@@ -494,8 +527,18 @@ ErrorCode StartPipelineInner(std::shared_ptr<PipelineCore> &pipeline, const Effe
             prom->set_value(res);
             return;
         }, 0, taskId);
+        task->SetPriority(priority);
+        const std::shared_ptr<EffectCancelToken> &cancelToken = effectParameters.effectContext_->cancelToken_;
+        if (cancelToken != nullptr) {
+            task->SetDeadline(cancelToken->GetDeadline());
+        }
         thread->AddTask(task);
         task->Wait();
+        if (fut.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ErrorCode canceledRes = effectParameters.effectContext_->CheckCanceled();
+            EFFECT_LOGE("pipeline task is dropped by render thread! res=%{public}d", canceledRes);
+            return canceledRes != ErrorCode::SUCCESS ? canceledRes : ErrorCode::ERR_INVALID_OPERATION;
+        }
         ErrorCode res = fut.get();
         return res;
     }
@@ -503,7 +546,8 @@ ErrorCode StartPipelineInner(std::shared_ptr<PipelineCore> &pipeline, const Effe
 }
 
 ErrorCode StartPipeline(std::shared_ptr<PipelineCore> &pipeline, const EffectParameters &effectParameters,
-    unsigned long int taskId, RenderThread<> *thread, bool isNeedCreateThread = false)
+    unsigned long int taskId, const std::shared_ptr<RenderStrand> &thread, bool isNeedCreateThread = false,
+    RenderTaskPriority priority = RenderTaskPriority::PREVIEW)
 {
     effectParameters.effectContext_->renderStrategy_->Init(effectParameters.srcEffectBuffer_,
         effectParameters.dstEffectBuffer_);
@@ -511,7 +555,7 @@ ErrorCode StartPipeline(std::shared_ptr<PipelineCore> &pipeline, const EffectPar
         effectParameters.dstEffectBuffer_);
     effectParameters.effectContext_->memoryManager_->Init(effectParameters.srcEffectBuffer_,
         effectParameters.dstEffectBuffer_);
-    ErrorCode res = StartPipelineInner(pipeline, effectParameters, taskId, thread, isNeedCreateThread);
+    ErrorCode res = StartPipelineInner(pipeline, effectParameters, taskId, thread, isNeedCreateThread, priority);
     effectParameters.effectContext_->memoryManager_->Deinit();
     effectParameters.effectContext_->colorSpaceManager_->Deinit();
     effectParameters.effectContext_->renderStrategy_->Deinit();
@@ -558,13 +602,40 @@ void ImageEffect::Stop()
         EFFECT_LOGD("ImageEffect::Stop in wait tasks.");
         lock.unlock();
 
-        m_renderThread->WaitTaskFinished();
+        m_renderStrand->WaitTaskFinished();
     }
     impl_->effectContext_->memoryManager_->ClearMemory();
 
     EFFECT_LOGD("ImageEffect::Stop end.");
 }
 
+void ImageEffect::GetFrameStatistics(EffectFrameStatistics &statistics) const
+{
+    frameStats_.GetStatistics(statistics);
+}
+
+std::shared_ptr<EffectRenderProfile> ImageEffect::GetRenderProfile() const
+{
+    std::lock_guard<std::mutex> lock(renderProfileMutex_);
+    return renderProfile_;
+}
+
+void ImageEffect::Cancel()
+{
+    std::lock_guard<std::mutex> lock(cancelTokenMutex_);
+    if (cancelToken_ != nullptr) {
+        EFFECT_LOGI("ImageEffect::Cancel in-flight render.");
+        cancelToken_->Cancel();
+    }
+}
+
+std::shared_ptr<EffectCancelToken> ImageEffect::CreateCancelToken()
+{
+    std::lock_guard<std::mutex> lock(cancelTokenMutex_);
+    cancelToken_ = std::make_shared<EffectCancelToken>(renderTimeoutMs_);
+    return cancelToken_;
+}
+
 ErrorCode ImageEffect::SetInputSurfaceBuffer(OHOS::SurfaceBuffer *surfaceBuffer)
 {
     CHECK_AND_RETURN_RET_LOG(surfaceBuffer != nullptr, ErrorCode::ERR_INVALID_SRC_SURFACEBUFFER,
@@ -926,21 +997,48 @@ ErrorCode ImageEffect::Render()
 {
     EFFECT_TRACE_NAME("ImageEffect::Render");
     CHECK_AND_RETURN_RET_LOG(!efilters_.empty(), ErrorCode::ERR_NOT_FILTERS_WITH_RENDER, "efilters is empty");
+    impl_->effectContext_->cancelToken_ = CreateCancelToken();
+
+    std::shared_ptr<EffectRenderProfile> profile =
+        isRenderProfileEnabled_ ? std::make_shared<EffectRenderProfile>() : nullptr;
+    impl_->effectContext_->renderProfile_ = profile;
+    ErrorCode res;
+    {
+        EffectProfileBinder profileBinder(profile.get());
+        res = RenderInner(profile.get());
+    }
+    impl_->effectContext_->renderProfile_ = nullptr;
+    if (profile != nullptr) {
+        std::lock_guard<std::mutex> lock(renderProfileMutex_);
+        renderProfile_ = profile;
+    }
+    return res;
+}
 
+ErrorCode ImageEffect::RenderInner(EffectRenderProfile *profile)
+{
     uint32_t width = 0;
     uint32_t height = 0;
     PixelFormat pixelFormat = PixelFormat::RGBA_8888;
     std::shared_ptr<ExifMetadata> exifMetadata = nullptr;
 
-    ErrorCode res = GetImageInfo(width, height, pixelFormat, exifMetadata);
+    ErrorCode res;
+    {
+        EffectProfileScope profileScope(profile, ProfileStage::GET_IMAGE_INFO, "ImageEffect::GetImageInfo");
+        res = GetImageInfo(width, height, pixelFormat, exifMetadata);
+    }
     CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "set image info fail! res = %{public}d", res);
     IEffectFormat format = CommonUtils::SwitchToEffectFormat(pixelFormat);
     impl_->effectContext_->exifMetadata_ = exifMetadata;
     impl_->effectContext_->configIpType_ = static_cast<IPType>(configIpType_);
+    impl_->effectContext_->renderRegion_ = GetRenderRegion();
     std::shared_ptr<ImageSourceFilter> &sourceFilter = impl_->srcFilter_;
     sourceFilter->SetNegotiateParameter(width, height, format, impl_->effectContext_);
 
-    res = impl_->pipeline_->Prepare();
+    {
+        EffectProfileScope profileScope(profile, ProfileStage::PREPARE, "PipelineCore::Prepare");
+        res = impl_->pipeline_->Prepare();
+    }
     CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "pipeline prepare fail! res=%{public}d", res);
 
     RemoveGainMapIfNeed();
@@ -954,7 +1052,10 @@ ErrorCode ImageEffect::Render()
 
     std::shared_ptr<EffectBuffer> srcEffectBuffer = nullptr;
     std::shared_ptr<EffectBuffer> dstEffectBuffer = nullptr;
-    res = InitEffectBuffer(srcEffectBuffer, dstEffectBuffer, format);
+    {
+        EffectProfileScope profileScope(profile, ProfileStage::LOCK_ALL, "ImageEffect::LockAll");
+        res = InitEffectBuffer(srcEffectBuffer, dstEffectBuffer, format);
+    }
     CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "init effectBuffer fail! res=%{puiblic}d", res);
 
     res = ConfigureFilters(srcEffectBuffer, dstEffectBuffer);
@@ -964,9 +1065,13 @@ ErrorCode ImageEffect::Render()
     impl_->effectContext_->renderEnvironment_->SetOutputType(outBuffer->extraInfo_->dataType);
     EffectParameters effectParameters(srcEffectBuffer, dstEffectBuffer, config_, impl_->effectContext_);
     bool isNeedCreateThread = !impl_->isQosEnabled_ && srcEffectBuffer->extraInfo_->dataType != DataType::TEX;
-    res = StartPipeline(impl_->pipeline_, effectParameters, RequestTaskId(), m_renderThread, isNeedCreateThread);
+    res = StartPipeline(impl_->pipeline_, effectParameters, RequestTaskId(), m_renderStrand, isNeedCreateThread,
+        renderPriority_);
     if (res != ErrorCode::SUCCESS) {
         EFFECT_LOGE("StartPipeline fail! res=%{public}d", res);
+        if (EffectCancelToken::IsCancelError(res)) {
+            impl_->effectContext_->memoryManager_->ClearMemory();
+        }
         UnLockAll();
         return res;
     }
@@ -1026,6 +1131,90 @@ std::shared_ptr<ImageEffect> ImageEffect::Restore(std::string &info)
     return imageEffect;
 }
 
+ErrorCode ImageEffect::SaveBinary(std::vector<uint8_t> &data)
+{
+    EffectChainPrototype chain;
+    chain.name_ = name_;
+    for (const auto &efilter : efilters_) {
+        const std::string &name = efilter->GetName();
+        CHECK_AND_RETURN_RET_LOG(EFilterFactory::Instance()->GetDelegate(name) == nullptr,
+            ErrorCode::ERR_CUSTOM_EFILTER_SAVE_FAIL, "SaveBinary: delegate filter not support! name=%{public}s",
+            name.c_str());
+        EffectFilterPrototype filter;
+        filter.name_ = name;
+        for (const auto &value : efilter->GetValues()) {
+            filter.values_.emplace_back(value.first, value.second);
+        }
+        chain.filters_.emplace_back(std::move(filter));
+    }
+    return EffectBinaryHelper::Encode(chain, data);
+}
+
+std::shared_ptr<ImageEffect> ImageEffect::RestoreBinary(const uint8_t *data, size_t size)
+{
+    EFFECT_TRACE_NAME("ImageEffect::RestoreBinary");
+    std::shared_ptr<const EffectChainPrototype> chain = nullptr;
+    ErrorCode res = EffectBinaryHelper::Decode(data, size, chain);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, nullptr, "RestoreBinary: decode fail! res=%{public}d", res);
+
+    std::shared_ptr<ImageEffect> imageEffect = std::make_unique<ImageEffect>(chain->name_.c_str());
+    for (const auto &filter : chain->filters_) {
+        std::shared_ptr<EFilter> efilter = EFilterFactory::Instance()->Restore(filter, nullptr);
+        CHECK_AND_RETURN_RET_LOG(efilter != nullptr, nullptr,
+            "RestoreBinary: efilter restore fail! name=%{public}s", filter.name_.c_str());
+        imageEffect->AddEFilter(efilter);
+    }
+    imageEffect->needsDecodeDfxData_ = true;
+    imageEffect->needsPackDfxData_ = true;
+    return imageEffect;
+}
+
+std::shared_ptr<ImageEffect> ImageEffect::Clone()
+{
+    return Clone([](const std::shared_ptr<EFilter> &efilter) {
+        return EFilterFactory::Instance()->Clone(efilter, nullptr);
+    });
+}
+
+std::shared_ptr<ImageEffect> ImageEffect::Clone(const EFilterCloner &cloner)
+{
+    EFFECT_TRACE_NAME("ImageEffect::Clone");
+    CHECK_AND_RETURN_RET_LOG(cloner != nullptr, nullptr, "Clone: cloner is null!");
+    std::shared_ptr<ImageEffect> imageEffect = std::make_shared<ImageEffect>(name_.c_str());
+    {
+        std::unique_lock<std::mutex> lock(innerEffectMutex_);
+        for (const auto &efilter : efilters_) {
+            std::shared_ptr<EFilter> clone = cloner(efilter);
+            CHECK_AND_RETURN_RET_LOG(clone != nullptr, nullptr, "Clone: clone efilter fail! name=%{public}s",
+                efilter->GetName().c_str());
+            imageEffect->efilters_.emplace_back(clone);
+        }
+        // The filters are already in the order AddEFilter gave them, so the pipeline is linked once for the chain.
+        imageEffect->impl_->CreatePipeline(imageEffect->efilters_);
+
+        imageEffect->config_ = config_;
+        imageEffect->configIpType_ = configIpType_;
+        imageEffect->needPreFlush_ = needPreFlush_;
+        imageEffect->inFlightDepth_.store(inFlightDepth_.load());
+        imageEffect->defaultQuality_ = defaultQuality_;
+        imageEffect->renderPriority_ = renderPriority_;
+        imageEffect->isRenderProfileEnabled_ = isRenderProfileEnabled_;
+        imageEffect->needsDecodeDfxData_ = needsDecodeDfxData_;
+        imageEffect->needsPackDfxData_ = needsPackDfxData_;
+        if (extraInfo_ != nullptr) {
+            // Save writes into the extra info, so each effect keeps its own copy.
+            imageEffect->extraInfo_ = EffectJsonHelper::ParseJsonData(extraInfo_->ToString());
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(cancelTokenMutex_);
+        imageEffect->renderTimeoutMs_ = renderTimeoutMs_;
+    }
+    // The region is never changed in place, the clone shares it until either effect configures a new one.
+    std::atomic_store(&imageEffect->renderRegion_, std::atomic_load(&renderRegion_));
+    return imageEffect;
+}
+
 ErrorCode ImageEffect::Load(std::string &info)
 {
     EFFECT_TRACE_NAME("ImageEffect::Load");
@@ -1186,7 +1375,9 @@ void ImageEffect::RenderBuffer()
 {
     auto entry = bufferPool_->TryPop(false);
     CHECK_AND_RETURN_LOG(entry != std::nullopt, "ProcessRender: No available buffer in bufferPool!");
+    frameStats_.RecordQueueDepth(static_cast<uint32_t>(bufferPool_->Size()));
     std::unique_lock<std::mutex> lock(innerEffectMutex_);
+    entry->frameTimestamps_.Mark(FrameCheckpoint::RENDER_BEGIN);
     inDateInfo_.surfaceBufferInfo_ = {
         .surfaceBuffer_ = entry->buffer_,
         .timestamp_ = entry->timestamp_,
@@ -1196,14 +1387,110 @@ void ImageEffect::RenderBuffer()
         .timestamp_ = entry->timestamp_,
     };
     impl_->effectContext_->renderEnvironment_->NotifyInputChanged();
-    this->Render();
+    std::shared_ptr<EffectBuffer> frame = nullptr;
+    std::vector<uint64_t> settings;
+    bool isDamageTracked = PrepareDamageRender(*entry, frame, settings);
+    ErrorCode res = this->Render();
+    entry->frameTimestamps_.Mark(FrameCheckpoint::RENDER_END);
     if (impl_->effectContext_->logStrategy_ == LOG_STRATEGY::NORMAL) {
         impl_->effectContext_->logStrategy_ = LOG_STRATEGY::LIMITED;
     }
+    bool isPartial = FinishDamageRender(*entry, frame, settings, isDamageTracked && res == ErrorCode::SUCCESS);
+    if (EffectCancelToken::IsCancelError(res)) {
+        // The frame is rendered in place and the render may have stopped between two bands, so the buffer holds a
+        // mix of the input and the output. Give it back unflushed, the consumer keeps showing the previous frame.
+        EFFECT_LOGW("ProcessRender: render canceled, drop the frame. seq=%{public}u, res=%{public}d",
+            entry->seqNum_, res);
+        frameStats_.RecordDrop();
+        DropBuffer(*entry);
+        return;
+    }
 
     EFFECT_LOGD("ProcessRender: FlushBuffer: %{public}d", entry->buffer_->GetSeqNum());
-    auto ret = FlushBuffer(entry->buffer_, entry->syncFence_, true, true, entry->timestamp_);
+    auto ret = FlushBuffer(entry->buffer_, entry->syncFence_, true, true, entry->timestamp_,
+        isPartial ? &entry->damage_ : nullptr);
+    if (ret != GSError::GSERROR_OK) {
+        // The consumer did not get the frame, so the next damage is not relative to the cached output.
+        damageCache_.Invalidate();
+    }
     CHECK_AND_RETURN_LOG(ret == GSError::GSERROR_OK, "ProcessRender: FlushBuffer fail! ret=%{public}d", ret);
+    entry->frameTimestamps_.Mark(FrameCheckpoint::FLUSHED);
+    frameStats_.Commit(entry->frameTimestamps_);
+}
+
+bool ImageEffect::PrepareDamageRender(BufferEntry& entry, std::shared_ptr<EffectBuffer>& frame,
+    std::vector<uint64_t>& settings)
+{
+    damageRegion_ = nullptr;
+    bool isRegionSupported = !efilters_.empty() && std::all_of(efilters_.begin(), efilters_.end(),
+        [](const std::shared_ptr<EFilter> &efilter) { return efilter->IsRegionSupported(); });
+    if (!isRegionSupported || CommonUtils::ParseSurfaceData(entry.buffer_, frame, DataType::SURFACE,
+        LOG_STRATEGY::LIMITED) != ErrorCode::SUCCESS || !EffectDamageCache::AlignDamage(*frame->bufferInfo_,
+        entry.damage_)) {
+        return false;
+    }
+
+    GetRenderSettings(settings);
+    if (damageCache_.IsReusable(*frame->bufferInfo_, entry.frameIndex_, settings)) {
+        damageRegion_ = std::make_shared<RenderRegion>(entry.damage_);
+    }
+    return true;
+}
+
+bool ImageEffect::FinishDamageRender(const BufferEntry& entry, const std::shared_ptr<EffectBuffer>& frame,
+    const std::vector<uint64_t>& settings, bool isRendered)
+{
+    bool isPartial = damageRegion_ != nullptr;
+    damageRegion_ = nullptr;
+    if (!isRendered) {
+        damageCache_.Invalidate();
+        return false;
+    }
+    if (!isPartial) {
+        // The stream sends partial damages, so keep the whole output for the next frame.
+        (void)damageCache_.Update(*frame->bufferInfo_, entry.frameIndex_, settings);
+        return false;
+    }
+    if (damageCache_.Merge(*frame->bufferInfo_, entry.frameIndex_, entry.damage_) != ErrorCode::SUCCESS) {
+        damageCache_.Invalidate();
+        return false;
+    }
+    EFFECT_LOGD("FinishDamageRender: rendered damage [%{public}d, %{public}d, %{public}d, %{public}d]",
+        entry.damage_.x0, entry.damage_.y0, entry.damage_.x1, entry.damage_.y1);
+    return true;
+}
+
+void ImageEffect::GetRenderSettings(std::vector<uint64_t>& settings)
+{
+    // Anything changing the output of an unchanged input, the versions of the values are unique among the filters.
+    settings.clear();
+    settings.emplace_back(static_cast<uint64_t>(configIpType_));
+    std::shared_ptr<RenderRegion> region = std::atomic_load(&renderRegion_);
+    settings.emplace_back(region != nullptr);
+    if (region != nullptr) {
+        for (int32_t coordinate : { region->x0, region->y0, region->x1, region->y1 }) {
+            settings.emplace_back(static_cast<uint32_t>(coordinate));
+        }
+    }
+    for (const auto &efilter : efilters_) {
+        settings.emplace_back(efilter->GetValuesVersion());
+    }
+}
+
+std::shared_ptr<RenderRegion> ImageEffect::GetRenderRegion() const
+{
+    std::shared_ptr<RenderRegion> region = std::atomic_load(&renderRegion_);
+    if (damageRegion_ == nullptr || region == nullptr) {
+        return damageRegion_ != nullptr ? damageRegion_ : region;
+    }
+
+    // Pixels of the damage outside of the configured region are passed through, as in a full render.
+    auto intersection = std::make_shared<RenderRegion>();
+    intersection->x0 = std::max(std::min(region->x0, region->x1), damageRegion_->x0);
+    intersection->y0 = std::max(std::min(region->y0, region->y1), damageRegion_->y0);
+    intersection->x1 = std::max(std::min(std::max(region->x0, region->x1), damageRegion_->x1), intersection->x0);
+    intersection->y1 = std::max(std::min(std::max(region->y0, region->y1), damageRegion_->y1), intersection->y0);
+    return intersection;
 }
 
 BufferRequestConfig ImageEffect::GetBufferRequestConfig(const sptr<SurfaceBuffer>& buffer)
@@ -1221,7 +1508,7 @@ BufferRequestConfig ImageEffect::GetBufferRequestConfig(const sptr<SurfaceBuffer
 }
 
 GSError ImageEffect::FlushBuffer(sptr<SurfaceBuffer>& flushBuffer, sptr<SyncFence>& syncFence, bool isNeedAttach,
-    bool isSendFence, int64_t& timestamp)
+    bool isSendFence, int64_t& timestamp, const RenderRegion *damage)
 {
     BufferFlushConfig flushConfig = {
         .damage = {
@@ -1230,6 +1517,14 @@ GSError ImageEffect::FlushBuffer(sptr<SurfaceBuffer>& flushBuffer, sptr<SyncFenc
         },
         .timestamp = timestamp,
     };
+    if (damage != nullptr) {
+        flushConfig.damage = {
+            .x = damage->x0,
+            .y = damage->y0,
+            .w = damage->x1 - damage->x0,
+            .h = damage->y1 - damage->y0,
+        };
+    }
 
     CHECK_AND_RETURN_RET_LOG(imageEffectFlag_.load(std::memory_order_acquire) == STRUCT_IMAGE_EFFECT_CONSTANT,
         GSERROR_NOT_INIT, "FlushBuffer: ImageEffect not exist.");
@@ -1263,26 +1558,52 @@ GSError ImageEffect::ReleaseBuffer(sptr<OHOS::SurfaceBuffer> &buffer, sptr<OHOS:
     return ret;
 }
 
+void ImageEffect::DropBuffer(BufferEntry &entry)
+{
+    CHECK_AND_RETURN_LOG(toProducerSurface_ != nullptr, "DropBuffer: toProducerSurface is nullptr.");
+    // The buffer was swapped out of the consumer queue for an output buffer, so give it back to the output queue.
+    auto ret = toProducerSurface_->AttachBufferToQueue(entry.buffer_);
+    CHECK_AND_RETURN_LOG(ret == GSError::GSERROR_OK, "DropBuffer: AttachBufferToQueue failed. %{public}d", ret);
+    ret = toProducerSurface_->CancelBuffer(entry.buffer_);
+    CHECK_AND_RETURN_LOG(ret == GSError::GSERROR_OK, "DropBuffer: CancelBuffer failed. %{public}d", ret);
+}
+
 bool ImageEffect::SubmitRenderTask(BufferEntry &&entry)
 {
-    bool success = bufferPool_->TryPush(std::move(entry));
-    EFFECT_LOGD("SubmitRenderTask: bufferPool size: %{public}d", (int)bufferPool_->Size());
-    CHECK_AND_RETURN_RET_LOG(m_renderThread, true, "SubmitRenderTask: m_renderThread is null!");
-    CHECK_AND_RETURN_RET_LOG(success, true, "SubmitRenderTask: bufferPool push failed!");
+    std::vector<BufferEntry> droppedEntries;
+    entry.frameTimestamps_.Mark(FrameCheckpoint::QUEUED);
+    bufferPool_->PushLatest(std::move(entry), droppedEntries);
+    size_t queueDepth = bufferPool_->Size();
+    EFFECT_LOGD("SubmitRenderTask: bufferPool size: %{public}zu", queueDepth);
+    frameStats_.RecordQueueDepth(static_cast<uint32_t>(queueDepth));
+    frameStats_.RecordDrop(static_cast<uint32_t>(droppedEntries.size()));
+    for (auto &droppedEntry : droppedEntries) {
+        EFFECT_LOGW("SubmitRenderTask: render falls behind, drop the stale frame. seq=%{public}u",
+            droppedEntry.seqNum_);
+        DropBuffer(droppedEntry);
+    }
+    CHECK_AND_RETURN_RET_LOG(m_renderStrand, true, "SubmitRenderTask: m_renderStrand is null!");
+    if (!droppedEntries.empty()) {
+        // The render task queued for the dropped frame picks up the newer one.
+        return false;
+    }
 
     auto task = std::make_shared<RenderTask<>>([this]() {
         RenderBuffer();
     }, COMMON_TASK_TAG + 1, m_currentTaskId.fetch_add(1));
-    m_renderThread->AddTask(task);
+    task->SetPriority(RenderTaskPriority::PREVIEW);
+    m_renderStrand->AddTask(task);
     return false;
 }
 
 void ImageEffect::ProcessRender(BufferProcessInfo& bufferProcessInfo, bool& isNeedSwap, int64_t& timestamp)
 {
-    auto& [inBuffer, outBuffer, inBufferSyncFence, outBufferSyncFence, isSrcHebcData] = bufferProcessInfo;
+    auto& [inBuffer, outBuffer, inBufferSyncFence, outBufferSyncFence, isSrcHebcData, frameTimestamps, frameIndex,
+        damage] = bufferProcessInfo;
 
     constexpr uint32_t waitForEver = -1;
     (void)inBufferSyncFence->Wait(waitForEver);
+    frameTimestamps.Mark(FrameCheckpoint::FENCE_SIGNALED);
     CHECK_AND_RETURN_LOG(inBuffer, "ProcessRender: inBuffer is nullptr!");
 
     {
@@ -1290,6 +1611,7 @@ void ImageEffect::ProcessRender(BufferProcessInfo& bufferProcessInfo, bool& isNe
         (void)inBuffer->InvalidateCache();
         EFFECT_TRACE_END();
     }
+    frameTimestamps.Mark(FrameCheckpoint::CACHE_INVALIDATED);
 
     CHECK_AND_RETURN_LOG(toProducerSurface_ != nullptr, "ProcessRender: toProducerSurface is nullptr.");
     auto requestConfig = GetBufferRequestConfig(inBuffer);
@@ -1298,6 +1620,7 @@ void ImageEffect::ProcessRender(BufferProcessInfo& bufferProcessInfo, bool& isNe
         EFFECT_LOGE("ProcessRender::RequestAndDetachBuffer failed. %{public}d", ret);
         return;
     }
+    frameTimestamps.Mark(FrameCheckpoint::BUFFER_REQUESTED);
     EFFECT_LOGD("ProcessRender: inBuffer: %{public}d, outBuffer: %{public}d",
         inBuffer->GetSeqNum(), outBuffer->GetSeqNum());
 
@@ -1324,7 +1647,8 @@ void ImageEffect::ProcessRender(BufferProcessInfo& bufferProcessInfo, bool& isNe
 
     SetSurfaceBufferHebcAccessType(inBuffer, isSrcHebcData ?
         V1_1::HebcAccessType::HEBC_ACCESS_HW_ONLY : V1_1::HebcAccessType::HEBC_ACCESS_CPU_ACCESS);
-    isNeedSwap = SubmitRenderTask({inBuffer->GetSeqNum(), inBuffer, inBufferSyncFence, timestamp});
+    isNeedSwap = SubmitRenderTask({inBuffer->GetSeqNum(), inBuffer, inBufferSyncFence, timestamp, frameTimestamps,
+        frameIndex, damage});
 }
 
 void ImageEffect::ProcessSwapBuffers(BufferProcessInfo& bufferProcessInfo, int64_t& timestamp)
@@ -1392,6 +1716,9 @@ void ImageEffect::OnBufferAvailableWithCPU()
 
     auto ret = impl_->AcquireConsumerSurfaceBuffer(inBuffer, inBufferSyncFence, timestamp, damages);
     CHECK_AND_RETURN_LOG(ret == 0 && inBuffer != nullptr, "AcquireBuffer failed. %{public}d", ret);
+    EffectFrameTimestamps frameTimestamps;
+    frameTimestamps.Mark(FrameCheckpoint::ACQUIRED);
+    uint64_t frameIndex = ++acquiredFrameNum_;
 
     outDateInfo_.dataType_ = DataType::SURFACE;
     UpdateProducerSurfaceInfo();
@@ -1413,6 +1740,9 @@ void ImageEffect::OnBufferAvailableWithCPU()
         .inBufferSyncFence_ = inBufferSyncFence,
         .outBufferSyncFence_ = SyncFence::INVALID_FENCE,
         .isSrcHebcData_ = isSrcHebcData,
+        .timestamps_ = frameTimestamps,
+        .frameIndex_ = frameIndex,
+        .damage_ = { damages.x, damages.y, damages.x + damages.w, damages.y + damages.h },
     };
 
     if (isNeedRender) {
@@ -1479,8 +1809,12 @@ sptr<Surface> ImageEffect::GetInputSurface()
         int maxBufferPoolSize = std::max((int)fromProducerSurface_->GetQueueSize(),
             (int)consumerSurface->GetQueueSize());
         maxBufferPoolSize = std::min(maxBufferPoolSize, RENDER_QUEUE_SIZE);
-        EFFECT_LOGD("GetInputSurface: maxBufferPoolSize=%{public}d", maxBufferPoolSize);
-        bufferPool_ = std::make_shared<ThreadSafeBufferQueue<BufferEntry>>(maxBufferPoolSize);
+        maxBufferPoolSize_.store(maxBufferPoolSize);
+        int32_t inFlightDepth = inFlightDepth_.load();
+        EFFECT_LOGD("GetInputSurface: maxBufferPoolSize=%{public}d, inFlightDepth=%{public}d", maxBufferPoolSize,
+            inFlightDepth);
+        bufferPool_ = std::make_shared<ThreadSafeBufferQueue<BufferEntry>>(std::min(maxBufferPoolSize,
+            inFlightDepth));
     }
 
     return fromProducerSurface_;
@@ -1511,6 +1845,62 @@ ErrorCode ImageEffect::Configure(const std::string &key, const Any &value)
         needPreFlush_ = true;
         return ErrorCode::SUCCESS;
     }
+    if (FUNCTION_RENDER_TIMEOUT.compare(key) == 0) {
+        int32_t timeoutMs = 0;
+        ErrorCode result = CommonUtils::ParseAny(value, timeoutMs);
+        CHECK_AND_RETURN_RET_LOG(result == ErrorCode::SUCCESS, result,
+            "parse any fail! expect type is int32_t! key=%{public}s", key.c_str());
+        CHECK_AND_RETURN_RET_LOG(timeoutMs >= 0, ErrorCode::ERR_INVALID_PARAMETER_VALUE,
+            "render timeout is invalid! timeoutMs=%{public}d", timeoutMs);
+        std::lock_guard<std::mutex> lock(cancelTokenMutex_);
+        renderTimeoutMs_ = static_cast<uint32_t>(timeoutMs);
+        return ErrorCode::SUCCESS;
+    }
+    if (FUNCTION_RENDER_PRIORITY.compare(key) == 0) {
+        int32_t priority = 0;
+        ErrorCode result = CommonUtils::ParseAny(value, priority);
+        CHECK_AND_RETURN_RET_LOG(result == ErrorCode::SUCCESS, result,
+            "parse any fail! expect type is int32_t! key=%{public}s", key.c_str());
+        CHECK_AND_RETURN_RET_LOG(priority >= static_cast<int32_t>(RenderTaskPriority::INTERACTIVE) &&
+            priority <= static_cast<int32_t>(RenderTaskPriority::BACKGROUND), ErrorCode::ERR_INVALID_PARAMETER_VALUE,
+            "render priority is invalid! priority=%{public}d", priority);
+        renderPriority_ = static_cast<RenderTaskPriority>(priority);
+        return ErrorCode::SUCCESS;
+    }
+    if (FUNCTION_RENDER_PROFILE.compare(key) == 0) {
+        bool isEnabled = false;
+        ErrorCode result = CommonUtils::ParseAny(value, isEnabled);
+        CHECK_AND_RETURN_RET_LOG(result == ErrorCode::SUCCESS, result,
+            "parse any fail! expect type is bool! key=%{public}s", key.c_str());
+        isRenderProfileEnabled_ = isEnabled;
+        return ErrorCode::SUCCESS;
+    }
+    if (FUNCTION_IN_FLIGHT_DEPTH.compare(key) == 0) {
+        int32_t depth = 0;
+        ErrorCode result = CommonUtils::ParseAny(value, depth);
+        CHECK_AND_RETURN_RET_LOG(result == ErrorCode::SUCCESS, result,
+            "parse any fail! expect type is int32_t! key=%{public}s", key.c_str());
+        CHECK_AND_RETURN_RET_LOG(depth >= MIN_IN_FLIGHT_DEPTH && depth <= MAX_IN_FLIGHT_DEPTH,
+            ErrorCode::ERR_INVALID_PARAMETER_VALUE, "in flight depth is invalid! depth=%{public}d", depth);
+        inFlightDepth_.store(depth);
+        if (bufferPool_ != nullptr) {
+            bufferPool_->SetCapacity(std::min(maxBufferPoolSize_.load(), depth));
+        }
+        return ErrorCode::SUCCESS;
+    }
+    if (FUNCTION_RENDER_REGION.compare(key) == 0) {
+        void *area = nullptr;
+        if (CommonUtils::ParseAny(value, area) == ErrorCode::SUCCESS && area == nullptr) {
+            std::atomic_store(&renderRegion_, std::shared_ptr<RenderRegion>());
+            return ErrorCode::SUCCESS;
+        }
+        auto region = std::make_shared<RenderRegion>();
+        ErrorCode result = RegionHelper::ParseRenderRegion(value, *region);
+        CHECK_AND_RETURN_RET_LOG(result == ErrorCode::SUCCESS, result,
+            "parse any fail! expect type is region! key=%{public}s", key.c_str());
+        std::atomic_store(&renderRegion_, region);
+        return ErrorCode::SUCCESS;
+    }
     auto configTypeIt = std::find_if(configTypeTab_.begin(), configTypeTab_.end(),
         [&key](const std::pair<std::string, ConfigType> &item) { return item.first.compare(key) == 0; });
 
@@ -1677,6 +2067,7 @@ void ImageEffect::InitEGLEnv()
     EFFECT_TRACE_NAME("ImageEffect::InitEGLEnv");
     impl_->effectContext_->renderEnvironment_->Init();
     impl_->effectContext_->renderEnvironment_->Prepare();
+    RenderExecutor::PinCurrentStrand();
 }
 
 void ImageEffect::DestroyEGLEnv()
@@ -1685,6 +2076,7 @@ void ImageEffect::DestroyEGLEnv()
     if (impl_->effectContext_->renderEnvironment_ == nullptr) {
         return;
     }
+    MakeEGLEnvCurrent(impl_->effectContext_->renderEnvironment_);
     impl_->effectContext_->renderEnvironment_->ReleaseParam();
     impl_->effectContext_->renderEnvironment_->Release();
     EFFECT_LOGI("ImageEffect DestroyEGLEnv end!");
@@ -19,6 +19,7 @@
 
 #include "metadata_helper.h"
 #include "colorspace_processor.h"
+#include "cpu_colorspace_converter.h"
 #include "metadata_processor.h"
 #include "effect_log.h"
 
@@ -291,6 +292,32 @@ ErrorCode ApplyColorSpaceIfNeed(std::shared_ptr<EffectBuffer> &srcBuffer, const
     return ErrorCode::SUCCESS;
 }
 
+// When filters that only move pixels lead the chain, the gamut conversion of a pixel map goes behind them, so that
+// it only touches the pixels they leave. The first filter that depends on the color space converts on the cpu.
+ErrorCode DeferColorSpaceIfNeed(const std::shared_ptr<EffectBuffer> &srcBuffer,
+    const std::shared_ptr<EffectContext> &context, EffectColorSpace &colorSpace)
+{
+    if (!context->hasColorSpaceFilter_ || !context->isColorSpaceAgnosticHead_ ||
+        !ColorSpaceManager::IsNeedConvertColorSpace(colorSpace) ||
+        srcBuffer->extraInfo_->dataType != DataType::PIXEL_MAP) {
+        return ErrorCode::SUCCESS;
+    }
+
+    EffectColorSpace targetColorSpace = EffectColorSpace::DEFAULT;
+    ErrorCode res = context->colorSpaceManager_->GetTargetColorSpace(colorSpace, targetColorSpace);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res,
+        "DeferColorSpaceIfNeed: GetTargetColorSpace fail! res=%{public}d, colorSpace=%{public}d", res, colorSpace);
+    if (!CpuColorSpaceConverter::IsSupported(colorSpace, targetColorSpace, srcBuffer->bufferInfo_->formatType_)) {
+        return ErrorCode::SUCCESS;
+    }
+
+    EFFECT_LOGD("DeferColorSpaceIfNeed: colorSpace=%{public}d, targetColorSpace=%{public}d", colorSpace,
+        targetColorSpace);
+    context->pendingColorSpace_ = targetColorSpace;
+    colorSpace = targetColorSpace;
+    return ErrorCode::SUCCESS;
+}
+
 bool isNeedDecomposeHdrImage(const EffectColorSpace &colorSpace, const EffectColorSpace &chosenColorSpace,
     std::shared_ptr<EffectBuffer> &buffer, const std::shared_ptr<EffectContext> &context)
 {
@@ -353,6 +380,7 @@ ErrorCode ColorSpaceHelper::ConvertColorSpace(std::shared_ptr<EffectBuffer> &src
 {
     EffectColorSpace colorSpace = srcBuffer->bufferInfo_->colorSpace_;
     EFFECT_LOGD("ConvertColorSpace: colorSpace=%{public}d", colorSpace);
+    context->pendingColorSpace_ = EffectColorSpace::DEFAULT;
 
     if (srcBuffer->extraInfo_->dataType == DataType::TEX && !IsTexSupportedColorSpace(colorSpace)) {
         return ErrorCode::ERR_NOT_SUPPORT_INPUT_OUTPUT_COLORSPACE;
@@ -366,8 +394,17 @@ ErrorCode ColorSpaceHelper::ConvertColorSpace(std::shared_ptr<EffectBuffer> &src
         return ErrorCode::SUCCESS;
     }
 
+    // No conversion at all when no filter depends on the color space and the output keeps the one of the source.
+    if (!context->hasColorSpaceFilter_ && context->colorSpaceManager_->IsOutputColorSpaceKept(colorSpace)) {
+        EFFECT_LOGD("ConvertColorSpace: no filter depends on the color space! colorSpace=%{public}d", colorSpace);
+        return ErrorCode::SUCCESS;
+    }
+
     EFFECT_LOGD("ColorSpaceHelper::ConvertColorSpace colorSpace=%{public}d", colorSpace);
-    ErrorCode res = ApplyColorSpaceIfNeed(srcBuffer, context, colorSpace);
+    ErrorCode res = DeferColorSpaceIfNeed(srcBuffer, context, colorSpace);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "ConvertColorSpace: DeferColorSpaceIfNeed fail! "
+        "res=%{public}d, colorSpace=%{public}d", res, colorSpace);
+    res = ApplyColorSpaceIfNeed(srcBuffer, context, colorSpace);
     CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "ConvertColorSpace: ConvertColorSpaceIfNeed fail! "
         "res=%{public}d, colorSpace=%{public}d", res, colorSpace);
 
@@ -70,6 +70,27 @@ ErrorCode ColorSpaceManager::ApplyColorSpace(EffectBuffer *effectBuffer, const E
     return ErrorCode::SUCCESS;
 }
 
+ErrorCode ColorSpaceManager::GetTargetColorSpace(const EffectColorSpace &colorSpace,
+    EffectColorSpace &targetColorSpace)
+{
+    if (!IsNeedConvertColorSpace(colorSpace)) {
+        targetColorSpace = colorSpace;
+        return ErrorCode::SUCCESS;
+    }
+
+    EffectColorSpace converterColorSpace = ColorSpaceStrategy::GetTargetColorSpace(colorSpace);
+    ErrorCode res = strategy_->CheckConverterColorSpace(converterColorSpace);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res,
+        "GetTargetColorSpace: CheckConverterColorSpace fail! res=%{public}d", res);
+    targetColorSpace = converterColorSpace;
+    return ErrorCode::SUCCESS;
+}
+
+bool ColorSpaceManager::IsOutputColorSpaceKept(const EffectColorSpace &colorSpace)
+{
+    return strategy_->IsOutputColorSpaceKept(colorSpace);
+}
+
 ErrorCode ColorSpaceManager::ChooseColorSpace(const std::unordered_set<EffectColorSpace> &filtersSupportedColorSpace,
     const EffectColorSpace &srcRealColorSpace, EffectColorSpace &outputColorSpace)
 {
@@ -21,6 +21,8 @@
 #include "effect_log.h"
 #include "v1_0/cm_color_space.h"
 #include "colorspace_helper.h"
+#include "cpu_colorspace_converter.h"
+#include "cpu_hdr_processor.h"
 #include "format_helper.h"
 #include "common_utils.h"
 #include "pixel_map.h"
@@ -47,6 +49,15 @@ ColorSpaceProcessor::~ColorSpaceProcessor()
 {
 }
 
+bool ColorSpaceProcessor::IsVpeAvailable() const
+{
+#ifdef VPE_ENABLE
+    return converter != nullptr;
+#else
+    return false;
+#endif
+}
+
 SurfaceBuffer *AllocSurfaceBuffer(std::vector<std::shared_ptr<MemoryData>> &memoryDataArray, MemoryInfo &allocMemInfo,
     CM_HDR_Metadata_Type type, CM_ColorSpaceType colorSpace)
 {
@@ -121,12 +132,175 @@ void PrintColorSpaceInfo(const sptr<SurfaceBuffer> &surfaceBuffer, const std::st
         tag.c_str(), metadataType, colorSpaceType, surfaceBuffer->GetFormat());
 }
 
+void ToIsoMetadata(const CpuGainmapMetadata &metadata, ISOMetadata &isoMetadata)
+{
+    isoMetadata.gainmapChannelNum = GAINMAP_CHANNEL_NUM;
+    isoMetadata.useBaseColorFlag = metadata.useBaseColor ? 1 : 0;
+    isoMetadata.baseHeadroom = metadata.baseHeadroom;
+    isoMetadata.alternateHeadroom = metadata.alternateHeadroom;
+    for (uint32_t channel = 0; channel < GAINMAP_CHANNEL_NUM; ++channel) {
+        isoMetadata.enhanceClippedThreholdMinGainmap[channel] = metadata.minLog2[channel];
+        isoMetadata.enhanceClippedThreholdMaxGainmap[channel] = metadata.maxLog2[channel];
+        isoMetadata.enhanceMappingGamma[channel] = metadata.gamma[channel];
+        isoMetadata.enhanceMappingBaselineOffset[channel] = metadata.baseOffset[channel];
+        isoMetadata.enhanceMappingAlternateOffset[channel] = metadata.alternateOffset[channel];
+    }
+}
+
+void FromIsoMetadata(const ISOMetadata &isoMetadata, CpuGainmapMetadata &metadata)
+{
+    metadata.useBaseColor = isoMetadata.useBaseColorFlag != 0;
+    metadata.baseHeadroom = isoMetadata.baseHeadroom;
+    metadata.alternateHeadroom = isoMetadata.alternateHeadroom;
+    for (uint32_t channel = 0; channel < GAINMAP_CHANNEL_NUM; ++channel) {
+        // A single channel gain map carries its parameters in the first channel only.
+        uint32_t index = isoMetadata.gainmapChannelNum == 1 ? 0 : channel;
+        metadata.minLog2[channel] = isoMetadata.enhanceClippedThreholdMinGainmap[index];
+        metadata.maxLog2[channel] = isoMetadata.enhanceClippedThreholdMaxGainmap[index];
+        metadata.gamma[channel] = isoMetadata.enhanceMappingGamma[index];
+        metadata.baseOffset[channel] = isoMetadata.enhanceMappingBaselineOffset[index];
+        metadata.alternateOffset[channel] = isoMetadata.enhanceMappingAlternateOffset[index];
+    }
+}
+
+ErrorCode GetGainmapMetadata(SurfaceBuffer *gainmapSb, CpuGainmapMetadata &metadata)
+{
+    std::vector<uint8_t> dynamicMetadata;
+    ColorSpaceHelper::GetHDRDynamicMetadata(gainmapSb, dynamicMetadata);
+    HDRVividExtendMetadata extendMetadata = {};
+    int32_t memCpyRes = EOK;
+    if (dynamicMetadata.size() == sizeof(HDRVividExtendMetadata)) {
+        memCpyRes = memcpy_s(&extendMetadata, sizeof(HDRVividExtendMetadata), dynamicMetadata.data(),
+            dynamicMetadata.size());
+    } else if (dynamicMetadata.size() == sizeof(ISOMetadata)) {
+        memCpyRes = memcpy_s(&extendMetadata.metaISO, sizeof(ISOMetadata), dynamicMetadata.data(),
+            dynamicMetadata.size());
+    } else {
+        EFFECT_LOGE("GetGainmapMetadata: unknown gainmap metadata! size=%{public}zu", dynamicMetadata.size());
+        return ErrorCode::ERR_GET_METADATA_FAIL;
+    }
+    CHECK_AND_RETURN_RET_LOG(memCpyRes == EOK, ErrorCode::ERR_GET_METADATA_FAIL,
+        "GetGainmapMetadata: memcpy_s fail! res=%{public}d", memCpyRes);
+    FromIsoMetadata(extendMetadata.metaISO, metadata);
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode ParseDisplayP3SurfaceBuffer(const sptr<SurfaceBuffer> &surfaceBuffer, const EffectBuffer *inputHdr,
+    std::shared_ptr<EffectBuffer> &buffer)
+{
+    ErrorCode errorCode = CommonUtils::ParseSurfaceData(surfaceBuffer, buffer, inputHdr->extraInfo_->dataType);
+    CHECK_AND_RETURN_RET_LOG(errorCode == ErrorCode::SUCCESS, errorCode,
+        "ParseDisplayP3SurfaceBuffer: ParseSurfaceData fail! errorCode=%{public}d", errorCode);
+    buffer->bufferInfo_->colorSpace_ = EffectColorSpace::DISPLAY_P3;
+    return ErrorCode::SUCCESS;
+}
+
+void UpdateSdrBuffer(const sptr<SurfaceBuffer> &sdrSb, const EffectBuffer *inputHdr,
+    std::shared_ptr<EffectBuffer> &buffer)
+{
+    *buffer->extraInfo_ = *inputHdr->extraInfo_;
+    buffer->bufferInfo_->surfaceBuffer_ = sdrSb;
+    buffer->extraInfo_->bufferType = BufferType::DMA_BUFFER;
+}
+
+ErrorCode ComposeHdrImageOnCpu(const EffectBuffer *inputSdr, const SurfaceBuffer *inputGainmap,
+    EffectBuffer *outputHdr)
+{
+    CHECK_AND_RETURN_RET_LOG(inputSdr != nullptr && inputGainmap != nullptr && outputHdr != nullptr,
+        ErrorCode::ERR_INPUT_NULL, "ComposeHdrImageOnCpu: inputSdr or inputGainmap or outputHdr is null!");
+    SurfaceBuffer *gainmapSb = const_cast<SurfaceBuffer *>(inputGainmap);
+    PrintColorSpaceInfo(gainmapSb, "ComposeHdrImageOnCpu:GainmapSurfaceBuffer");
+
+    CpuGainmapMetadata metadata;
+    ErrorCode res = GetGainmapMetadata(gainmapSb, metadata);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "ComposeHdrImageOnCpu: get metadata fail!");
+    std::shared_ptr<EffectBuffer> gainmap = nullptr;
+    res = CommonUtils::ParseSurfaceData(gainmapSb, gainmap, inputSdr->extraInfo_->dataType);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res,
+        "ComposeHdrImageOnCpu: ParseSurfaceData fail! res=%{public}d", res);
+
+    res = CpuHdrProcessor::Compose(inputSdr, gainmap.get(), metadata, outputHdr);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "ComposeHdrImageOnCpu: compose fail! res=%{public}d",
+        res);
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode DecomposeHdrImageOnCpu(std::vector<std::shared_ptr<MemoryData>> &memoryDataArray,
+    const EffectBuffer *inputHdr, std::shared_ptr<EffectBuffer> &outputSdr, SurfaceBuffer **outputGainmap)
+{
+    CHECK_AND_RETURN_RET_LOG(inputHdr != nullptr && outputGainmap != nullptr,
+        ErrorCode::ERR_INPUT_NULL, "DecomposeHdrImageOnCpu: inputHdr or outputGainmap is null!");
+    CHECK_AND_RETURN_RET_LOG(CpuHdrProcessor::IsHdrSupported(*inputHdr->bufferInfo_),
+        ErrorCode::ERR_COLORSPACE_NOT_SUPPORT_CONVERT, "DecomposeHdrImageOnCpu: not support! format=%{public}d, "
+        "colorSpace=%{public}d", inputHdr->bufferInfo_->formatType_, inputHdr->bufferInfo_->colorSpace_);
+
+    sptr<SurfaceBuffer> sdrSb = AllocSdrSurfaceBuffer(memoryDataArray, inputHdr, CM_IMAGE_HDR_VIVID_DUAL, CM_P3_FULL,
+        EffectColorSpace::DISPLAY_P3);
+    sptr<SurfaceBuffer> gainmapSb = AllocGainmapSurfaceBuffer(memoryDataArray, inputHdr, CM_METADATA_NONE, CM_P3_FULL,
+        EffectColorSpace::DISPLAY_P3);
+    CHECK_AND_RETURN_RET_LOG(sdrSb != nullptr && gainmapSb != nullptr, ErrorCode::ERR_INVALID_SURFACE_BUFFER,
+        "DecomposeHdrImageOnCpu: invalid surface buffer! sdrSb=%{public}d, gainmapSb=%{public}d",
+        sdrSb == nullptr, gainmapSb == nullptr);
+
+    std::shared_ptr<EffectBuffer> buffer = nullptr;
+    ErrorCode res = ParseDisplayP3SurfaceBuffer(sdrSb, inputHdr, buffer);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "DecomposeHdrImageOnCpu: parse sdr fail!");
+    std::shared_ptr<EffectBuffer> gainmap = nullptr;
+    res = ParseDisplayP3SurfaceBuffer(gainmapSb, inputHdr, gainmap);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "DecomposeHdrImageOnCpu: parse gainmap fail!");
+
+    CpuGainmapMetadata metadata;
+    res = CpuHdrProcessor::Decompose(inputHdr, buffer.get(), gainmap.get(), metadata);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "DecomposeHdrImageOnCpu: decompose fail! "
+        "res=%{public}d", res);
+
+    ISOMetadata isoMetadata = {};
+    ToIsoMetadata(metadata, isoMetadata);
+    const auto *isoMetadataBytes = reinterpret_cast<const uint8_t *>(&isoMetadata);
+    res = ColorSpaceHelper::SetHDRDynamicMetadata(gainmapSb,
+        std::vector<uint8_t>(isoMetadataBytes, isoMetadataBytes + sizeof(ISOMetadata)));
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, ErrorCode::ERR_SET_METADATA_FAIL,
+        "DecomposeHdrImageOnCpu: set gainmap metadata fail! res=%{public}d", res);
+
+    UpdateSdrBuffer(sdrSb, inputHdr, buffer);
+    outputSdr = buffer;
+    *outputGainmap = gainmapSb;
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode ProcessHdrImageOnCpu(std::vector<std::shared_ptr<MemoryData>> &memoryDataArray,
+    const EffectBuffer *inputHdr, std::shared_ptr<EffectBuffer> &outputSdr)
+{
+    CHECK_AND_RETURN_RET_LOG(inputHdr != nullptr, ErrorCode::ERR_INPUT_NULL,
+        "ProcessHdrImageOnCpu: inputHdr is null!");
+    CHECK_AND_RETURN_RET_LOG(CpuHdrProcessor::IsHdrSupported(*inputHdr->bufferInfo_),
+        ErrorCode::ERR_COLORSPACE_NOT_SUPPORT_CONVERT, "ProcessHdrImageOnCpu: not support! format=%{public}d, "
+        "colorSpace=%{public}d", inputHdr->bufferInfo_->formatType_, inputHdr->bufferInfo_->colorSpace_);
+
+    sptr<SurfaceBuffer> sdrSb = AllocSdrSurfaceBuffer(memoryDataArray, inputHdr, CM_IMAGE_HDR_VIVID_DUAL, CM_P3_FULL,
+        EffectColorSpace::DISPLAY_P3);
+    CHECK_AND_RETURN_RET_LOG(sdrSb != nullptr, ErrorCode::ERR_INVALID_SURFACE_BUFFER,
+        "ProcessHdrImageOnCpu: invalid sdr surface buffer!");
+
+    std::shared_ptr<EffectBuffer> buffer = nullptr;
+    ErrorCode res = ParseDisplayP3SurfaceBuffer(sdrSb, inputHdr, buffer);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "ProcessHdrImageOnCpu: parse sdr fail!");
+    res = CpuHdrProcessor::ToneMap(inputHdr, buffer.get());
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "ProcessHdrImageOnCpu: tone map fail! res=%{public}d",
+        res);
+
+    UpdateSdrBuffer(sdrSb, inputHdr, buffer);
+    outputSdr = buffer;
+    return ErrorCode::SUCCESS;
+}
+
 ErrorCode ColorSpaceProcessor::ComposeHdrImage(const EffectBuffer *inputSdr, const SurfaceBuffer *inputGainmap,
     EffectBuffer *outputHdr)
 {
+    if (!IsVpeAvailable()) {
+        return ComposeHdrImageOnCpu(inputSdr, inputGainmap, outputHdr);
+    }
 #ifdef VPE_ENABLE
-    CHECK_AND_RETURN_RET_LOG(converter != nullptr, ErrorCode::ERR_INVALID_VPE_INSTANCE,
-        "DecomposeHdrImageInner: invalid vpe instance!");
     CHECK_AND_RETURN_RET_LOG(inputSdr != nullptr && inputGainmap != nullptr && outputHdr != nullptr,
         ErrorCode::ERR_INPUT_NULL, "ComposeHdrImageInner: inputSdr or inputGainmap or outputHdr is null!");
 
@@ -155,9 +329,10 @@ ErrorCode ColorSpaceProcessor::ComposeHdrImage(const EffectBuffer *inputSdr, con
 ErrorCode ColorSpaceProcessor::DecomposeHdrImage(const EffectBuffer *inputHdr, std::shared_ptr<EffectBuffer> &outputSdr,
     SurfaceBuffer **outputGainmap)
 {
+    if (!IsVpeAvailable()) {
+        return DecomposeHdrImageOnCpu(memoryDataArray_, inputHdr, outputSdr, outputGainmap);
+    }
 #ifdef VPE_ENABLE
-    CHECK_AND_RETURN_RET_LOG(converter != nullptr, ErrorCode::ERR_INVALID_VPE_INSTANCE,
-        "DecomposeHdrImageInner: invalid vpe instance!");
     CHECK_AND_RETURN_RET_LOG(inputHdr != nullptr && outputGainmap != nullptr,
         ErrorCode::ERR_INPUT_NULL, "DecomposeHdrImageInner: inputHdr or outputGainmap is null!");
 
@@ -205,9 +380,10 @@ ErrorCode ColorSpaceProcessor::DecomposeHdrImage(const EffectBuffer *inputHdr, s
 
 ErrorCode ColorSpaceProcessor::ProcessHdrImage(const EffectBuffer *inputHdr, std::shared_ptr<EffectBuffer> &outputSdr)
 {
+    if (!IsVpeAvailable()) {
+        return ProcessHdrImageOnCpu(memoryDataArray_, inputHdr, outputSdr);
+    }
 #ifdef VPE_ENABLE
-    CHECK_AND_RETURN_RET_LOG(converter != nullptr, ErrorCode::ERR_INVALID_VPE_INSTANCE,
-        "DecomposeHdrImageInner: invalid vpe instance!");
     CHECK_AND_RETURN_RET_LOG(inputHdr != nullptr, ErrorCode::ERR_INPUT_NULL,
         "ProcessHdrImageInner: inputHdr is null!");
 
@@ -303,6 +479,50 @@ PixelMap *GetPixelMap(EffectBuffer *effectBuffer)
     }
 }
 
+ErrorCode ApplyColorSpaceOnCpu(EffectBuffer *effectBuffer, EffectColorSpace targetColorSpace,
+    ColorSpaceName colorSpaceName)
+{
+    OHOS::ColorManager::ColorSpace grColorSpace(colorSpaceName);
+    const std::shared_ptr<ExtraInfo> &extraInfo = effectBuffer->extraInfo_;
+    if (extraInfo->dataType != DataType::SURFACE && extraInfo->dataType != DataType::SURFACE_BUFFER) {
+        // The pixels belong to the pixel map of the input, which is converted in place.
+        PixelMap *pixelMap = GetPixelMap(effectBuffer);
+        ErrorCode res = CpuColorSpaceConverter::Convert(effectBuffer, effectBuffer, targetColorSpace);
+        CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "ApplyColorSpaceOnCpu: convert fail! "
+            "res=%{public}d, colorSpaceName=%{public}d", res, colorSpaceName);
+        if (pixelMap != nullptr && pixelMap->GetPixels() == effectBuffer->buffer_) {
+            pixelMap->InnerSetColorSpace(grColorSpace);
+        }
+        return ErrorCode::SUCCESS;
+    }
+
+    // The surface buffer still belongs to the producer, so the pixels are converted into a new pixel map.
+    std::shared_ptr<BufferInfo> &bufferInfo = effectBuffer->bufferInfo_;
+    InitializationOptions options = {
+        .size = {
+            .width = static_cast<int32_t>(bufferInfo->width_),
+            .height = static_cast<int32_t>(bufferInfo->height_),
+        },
+        .srcPixelFormat = CommonUtils::SwitchToPixelFormat(bufferInfo->formatType_),
+        .pixelFormat = CommonUtils::SwitchToPixelFormat(bufferInfo->formatType_),
+    };
+    std::unique_ptr<PixelMap> pixelMap = PixelMap::Create(options);
+    CHECK_AND_RETURN_RET_LOG(pixelMap != nullptr, ErrorCode::ERR_CREATE_PIXELMAP_FAIL,
+        "ApplyColorSpaceOnCpu: create pixelmap fail!");
+    std::shared_ptr<EffectBuffer> buffer;
+    ErrorCode res = CommonUtils::LockPixelMap(pixelMap.get(), buffer);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "ApplyColorSpaceOnCpu: pixelMap parse fail!");
+    res = CpuColorSpaceConverter::Convert(effectBuffer, buffer.get(), targetColorSpace);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "ApplyColorSpaceOnCpu: convert fail! "
+        "res=%{public}d, colorSpaceName=%{public}d", res, colorSpaceName);
+    pixelMap->InnerSetColorSpace(grColorSpace);
+    extraInfo->innerPixelMap = std::move(pixelMap);
+
+    effectBuffer->bufferInfo_ = buffer->bufferInfo_;
+    effectBuffer->buffer_ = buffer->buffer_;
+    return ErrorCode::SUCCESS;
+}
+
 ErrorCode ColorSpaceProcessor::ApplyColorSpace(EffectBuffer *effectBuffer, EffectColorSpace targetColorSpace)
 {
     CHECK_AND_RETURN_RET_LOG(effectBuffer != nullptr && effectBuffer->bufferInfo_ != nullptr &&
@@ -313,6 +533,12 @@ ErrorCode ColorSpaceProcessor::ApplyColorSpace(EffectBuffer *effectBuffer, Effec
     CHECK_AND_RETURN_RET_LOG(colorSpaceName != ColorSpaceName::NONE, ErrorCode::ERR_INVALID_COLORSPACE,
         "ApplyColorSpace: invalid color space! targetColorSpace=%{public}d", targetColorSpace);
 
+    // A pure gamut change of sdr pixels does not need the pixel map framework.
+    if (CpuColorSpaceConverter::IsSupported(effectBuffer->bufferInfo_->colorSpace_, targetColorSpace,
+        effectBuffer->bufferInfo_->formatType_)) {
+        return ApplyColorSpaceOnCpu(effectBuffer, targetColorSpace, colorSpaceName);
+    }
+
     PixelMap *pixelMap = GetPixelMap(effectBuffer);
     CHECK_AND_RETURN_RET_LOG(pixelMap != nullptr, ErrorCode::ERR_CREATE_PIXELMAP_FAIL,
         "ApplyColorSpace create pixelmap fail!");
@@ -190,6 +190,23 @@ ErrorCode ColorSpaceStrategy::CheckConverterColorSpace(const EffectColorSpace &t
     return ErrorCode::SUCCESS;
 }
 
+bool ColorSpaceStrategy::IsOutputColorSpaceKept(const EffectColorSpace &colorSpace)
+{
+    CHECK_AND_RETURN_RET_LOG(src_ != nullptr, false, "IsOutputColorSpaceKept: src_ is null!");
+
+    // only input data
+    if (dst_ == nullptr || dst_->buffer_ == src_->buffer_) {
+        return true;
+    }
+
+    // the native window takes the color space of the rendered buffer.
+    if (dst_->extraInfo_->dataType == DataType::NATIVE_WINDOW) {
+        return true;
+    }
+
+    return dst_->bufferInfo_ != nullptr && dst_->bufferInfo_->colorSpace_ == colorSpace;
+}
+
 void ColorSpaceStrategy::Deinit()
 {
     src_ = nullptr;
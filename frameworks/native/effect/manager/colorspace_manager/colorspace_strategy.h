@@ -89,6 +89,9 @@ public:
     // Checks and validates the target color space for conversion
     IMAGE_EFFECT_EXPORT ErrorCode CheckConverterColorSpace(const EffectColorSpace &targetColorSpace);
 
+    // Checks whether the output keeps the given color space of the source, so that it needs no conversion.
+    IMAGE_EFFECT_EXPORT bool IsOutputColorSpaceKept(const EffectColorSpace &colorSpace);
+
     /**
      * Deinitializes the strategy
      */
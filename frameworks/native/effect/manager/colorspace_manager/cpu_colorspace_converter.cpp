@@ -0,0 +1,486 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cpu_colorspace_converter.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "effect_log.h"
+#include "effect_render_profile.h"
+#include "effect_trace.h"
+#include "memcpy_helper.h"
+#include "render_executor.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace {
+// Linear light is kept in fixed point with LINEAR_BITS bits, enough for one code value of 10 bits near black.
+constexpr uint32_t LINEAR_BITS = 14;
+constexpr int32_t LINEAR_MAX = 1 << LINEAR_BITS;
+constexpr uint32_t MATRIX_BITS = 12;
+constexpr double MATRIX_ONE = static_cast<double>(1 << MATRIX_BITS);
+constexpr int32_t MATRIX_ROUND = 1 << (MATRIX_BITS - 1);
+constexpr size_t MATRIX_SIZE = 9;
+constexpr size_t MATRIX_DIM = 3;
+constexpr uint32_t RGBA_BYTES_PER_PIXEL = 4;
+constexpr uint32_t RGBA_ALPHA_INDEX = 3;
+constexpr uint32_t DEPTH_8 = 8;
+constexpr uint32_t DEPTH_10 = 10;
+constexpr uint32_t CHANNEL_10_MASK = 0x3FF;
+constexpr uint32_t GREEN_10_SHIFT = 10;
+constexpr uint32_t BLUE_10_SHIFT = 20;
+constexpr uint32_t ALPHA_2_MASK = 0xC0000000;
+// Pixels converted per pass. The table lookups stay scalar, the matrix in between runs over the whole block with a
+// fixed trip count, so that the compiler vectorizes it, e.g. with NEON on arm64.
+constexpr uint32_t PIXEL_BLOCK_SIZE = 64;
+// Conversions smaller than this per participating thread are not worth a hand over to the render workers.
+constexpr uint64_t PARALLEL_MIN_PIXELS_PER_TASK = 512 * 1024;
+
+constexpr double SRGB_DECODE_THRESHOLD = 0.04045;
+constexpr double SRGB_ENCODE_THRESHOLD = 0.0031308;
+constexpr double SRGB_LINEAR_SLOPE = 12.92;
+constexpr double SRGB_OFFSET = 0.055;
+constexpr double SRGB_GAMMA = 2.4;
+// Adobe RGB (1998) uses a pure power function of 563 / 256, which is gamma 2.2 in practice.
+constexpr double ADOBE_RGB_GAMMA = 2.19921875;
+
+enum class TransferFunction : uint8_t {
+    SRGB = 0,
+    GAMMA_2_2,
+    TRANSFER_BUTT,
+};
+
+enum class Primaries : uint8_t {
+    BT709 = 0,
+    DISPLAY_P3,
+    ADOBE_RGB,
+    BT2020,
+    PRIMARIES_BUTT,
+};
+
+struct Chromaticity {
+    double x;
+    double y;
+};
+
+struct PrimariesInfo {
+    Chromaticity red;
+    Chromaticity green;
+    Chromaticity blue;
+};
+
+constexpr Chromaticity D65_WHITE = { 0.3127, 0.3290 };
+
+constexpr std::array<PrimariesInfo, static_cast<size_t>(Primaries::PRIMARIES_BUTT)> PRIMARIES_INFOS = { {
+    { { 0.640, 0.330 }, { 0.300, 0.600 }, { 0.150, 0.060 } },
+    { { 0.680, 0.320 }, { 0.265, 0.690 }, { 0.150, 0.060 } },
+    { { 0.640, 0.330 }, { 0.210, 0.710 }, { 0.150, 0.060 } },
+    { { 0.708, 0.292 }, { 0.170, 0.797 }, { 0.131, 0.046 } },
+} };
+
+struct ColorSpaceInfo {
+    Primaries primaries;
+    TransferFunction transfer;
+};
+
+using Matrix3 = std::array<double, MATRIX_SIZE>;
+using Vector3 = std::array<double, MATRIX_DIM>;
+
+bool GetColorSpaceInfo(EffectColorSpace colorSpace, ColorSpaceInfo &info)
+{
+    // The limited range only applies to yuv, the rgba pixels of the limited color spaces are full range.
+    switch (colorSpace) {
+        case EffectColorSpace::SRGB:
+        case EffectColorSpace::SRGB_LIMIT:
+            info = { Primaries::BT709, TransferFunction::SRGB };
+            return true;
+        case EffectColorSpace::DISPLAY_P3:
+        case EffectColorSpace::DISPLAY_P3_LIMIT:
+            info = { Primaries::DISPLAY_P3, TransferFunction::SRGB };
+            return true;
+        case EffectColorSpace::ADOBE_RGB:
+            info = { Primaries::ADOBE_RGB, TransferFunction::GAMMA_2_2 };
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool GetPrimaries(EffectColorSpace colorSpace, Primaries &primaries)
+{
+    ColorSpaceInfo info;
+    if (GetColorSpaceInfo(colorSpace, info)) {
+        primaries = info.primaries;
+        return true;
+    }
+    switch (colorSpace) {
+        case EffectColorSpace::BT2020_HLG:
+        case EffectColorSpace::BT2020_HLG_LIMIT:
+        case EffectColorSpace::BT2020_PQ:
+        case EffectColorSpace::BT2020_PQ_LIMIT:
+            primaries = Primaries::BT2020;
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool GetChannelDepth(IEffectFormat format, uint32_t &depth)
+{
+    switch (format) {
+        case IEffectFormat::RGBA8888:
+            depth = DEPTH_8;
+            return true;
+        case IEffectFormat::RGBA_1010102:
+            depth = DEPTH_10;
+            return true;
+        default:
+            return false;
+    }
+}
+
+Matrix3 Multiply(const Matrix3 &left, const Matrix3 &right)
+{
+    Matrix3 result = { 0 };
+    for (size_t row = 0; row < MATRIX_DIM; ++row) {
+        for (size_t col = 0; col < MATRIX_DIM; ++col) {
+            for (size_t k = 0; k < MATRIX_DIM; ++k) {
+                result[row * MATRIX_DIM + col] += left[row * MATRIX_DIM + k] * right[k * MATRIX_DIM + col];
+            }
+        }
+    }
+    return result;
+}
+
+Matrix3 Invert(const Matrix3 &m)
+{
+    // Cofactors of the 3x3 matrix, laid out as the transposed adjugate.
+    Matrix3 adjugate = {
+        m[4] * m[8] - m[5] * m[7], m[2] * m[7] - m[1] * m[8], m[1] * m[5] - m[2] * m[4],
+        m[5] * m[6] - m[3] * m[8], m[0] * m[8] - m[2] * m[6], m[2] * m[3] - m[0] * m[5],
+        m[3] * m[7] - m[4] * m[6], m[1] * m[6] - m[0] * m[7], m[0] * m[4] - m[1] * m[3],
+    };
+    double determinant = m[0] * adjugate[0] + m[1] * adjugate[3] + m[2] * adjugate[6];
+    for (double &value : adjugate) {
+        value /= determinant;
+    }
+    return adjugate;
+}
+
+Vector3 ToXyz(const Chromaticity &chromaticity)
+{
+    return { chromaticity.x / chromaticity.y, 1.0, (1.0 - chromaticity.x - chromaticity.y) / chromaticity.y };
+}
+
+Matrix3 GetRgbToXyz(Primaries primaries)
+{
+    const PrimariesInfo &info = PRIMARIES_INFOS[static_cast<size_t>(primaries)];
+    Vector3 red = ToXyz(info.red);
+    Vector3 green = ToXyz(info.green);
+    Vector3 blue = ToXyz(info.blue);
+    Vector3 white = ToXyz(D65_WHITE);
+    Matrix3 columns = {
+        red[0], green[0], blue[0],
+        red[1], green[1], blue[1],
+        red[2], green[2], blue[2],
+    };
+
+    // Scale the primaries so that rgb (1, 1, 1) is the white point.
+    Matrix3 inverse = Invert(columns);
+    Vector3 scale = { 0 };
+    for (size_t row = 0; row < MATRIX_DIM; ++row) {
+        for (size_t k = 0; k < MATRIX_DIM; ++k) {
+            scale[row] += inverse[row * MATRIX_DIM + k] * white[k];
+        }
+    }
+    for (size_t row = 0; row < MATRIX_DIM; ++row) {
+        for (size_t col = 0; col < MATRIX_DIM; ++col) {
+            columns[row * MATRIX_DIM + col] *= scale[col];
+        }
+    }
+    return columns;
+}
+
+double Decode(TransferFunction transfer, double value)
+{
+    if (transfer == TransferFunction::GAMMA_2_2) {
+        return std::pow(value, ADOBE_RGB_GAMMA);
+    }
+    return value <= SRGB_DECODE_THRESHOLD ? value / SRGB_LINEAR_SLOPE :
+        std::pow((value + SRGB_OFFSET) / (1.0 + SRGB_OFFSET), SRGB_GAMMA);
+}
+
+double Encode(TransferFunction transfer, double value)
+{
+    if (transfer == TransferFunction::GAMMA_2_2) {
+        return std::pow(value, 1.0 / ADOBE_RGB_GAMMA);
+    }
+    return value <= SRGB_ENCODE_THRESHOLD ? value * SRGB_LINEAR_SLOPE :
+        (1.0 + SRGB_OFFSET) * std::pow(value, 1.0 / SRGB_GAMMA) - SRGB_OFFSET;
+}
+
+struct TransferTables {
+    std::vector<int32_t> decode; // code value to linear light in [0, LINEAR_MAX]
+    std::vector<uint16_t> encode; // linear light in [0, LINEAR_MAX] to code value
+};
+
+TransferTables BuildTransferTables(TransferFunction transfer, uint32_t depth)
+{
+    const uint32_t codeMax = (1u << depth) - 1;
+    TransferTables tables;
+    tables.decode.resize(codeMax + 1);
+    for (uint32_t code = 0; code <= codeMax; ++code) {
+        double linear = Decode(transfer, static_cast<double>(code) / codeMax);
+        tables.decode[code] = static_cast<int32_t>(std::lround(linear * LINEAR_MAX));
+    }
+    tables.encode.resize(LINEAR_MAX + 1);
+    for (int32_t linear = 0; linear <= LINEAR_MAX; ++linear) {
+        double code = Encode(transfer, static_cast<double>(linear) / LINEAR_MAX);
+        tables.encode[linear] = static_cast<uint16_t>(std::clamp<long>(std::lround(code * codeMax), 0, codeMax));
+    }
+    return tables;
+}
+
+const TransferTables &GetTransferTables(TransferFunction transfer, uint32_t depth)
+{
+    // Built once for every transfer function, for 8 and 10 bits channels.
+    static const std::array<TransferTables, static_cast<size_t>(TransferFunction::TRANSFER_BUTT) * 2> tables = {
+        BuildTransferTables(TransferFunction::SRGB, DEPTH_8),
+        BuildTransferTables(TransferFunction::SRGB, DEPTH_10),
+        BuildTransferTables(TransferFunction::GAMMA_2_2, DEPTH_8),
+        BuildTransferTables(TransferFunction::GAMMA_2_2, DEPTH_10),
+    };
+    return tables[static_cast<size_t>(transfer) * 2 + (depth == DEPTH_10 ? 1 : 0)];
+}
+
+struct ConvertJob {
+    const uint8_t *src = nullptr;
+    uint8_t *dst = nullptr;
+    uint32_t srcStride = 0;
+    uint32_t dstStride = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    const int32_t *decode = nullptr;
+    const uint16_t *encode = nullptr;
+    std::array<int32_t, MATRIX_SIZE> matrix = { 0 };
+    uint32_t rowsPerTask = 0;
+    void (*convertRows)(const ConvertJob &job, uint32_t rowBegin, uint32_t rowEnd) = nullptr;
+};
+
+inline int32_t Transform(const std::array<int32_t, MATRIX_SIZE> &matrix, size_t row, int32_t red, int32_t green,
+    int32_t blue)
+{
+    const int32_t *coefficients = matrix.data() + row * MATRIX_DIM;
+    int32_t linear = (coefficients[0] * red + coefficients[1] * green + coefficients[2] * blue + MATRIX_ROUND) >>
+        MATRIX_BITS;
+    // Colors out of the target gamut are clipped.
+    return std::clamp(linear, 0, LINEAR_MAX);
+}
+
+// Linear light of a block of pixels, channel by channel.
+struct LinearBlock {
+    std::array<int32_t, PIXEL_BLOCK_SIZE> red;
+    std::array<int32_t, PIXEL_BLOCK_SIZE> green;
+    std::array<int32_t, PIXEL_BLOCK_SIZE> blue;
+};
+
+// Transforms the whole block in place. The lanes past the last pixel of a short block hold stale but valid values,
+// which are not stored.
+void TransformBlock(const std::array<int32_t, MATRIX_SIZE> &coefficients, LinearBlock &block)
+{
+    // A local copy tells the compiler that the block does not alias the matrix.
+    const std::array<int32_t, MATRIX_SIZE> matrix = coefficients;
+    for (uint32_t i = 0; i < PIXEL_BLOCK_SIZE; ++i) {
+        int32_t red = block.red[i];
+        int32_t green = block.green[i];
+        int32_t blue = block.blue[i];
+        block.red[i] = Transform(matrix, 0, red, green, blue);
+        block.green[i] = Transform(matrix, 1, red, green, blue);
+        block.blue[i] = Transform(matrix, 2, red, green, blue);
+    }
+}
+
+void ConvertRgba8888Rows(const ConvertJob &job, uint32_t rowBegin, uint32_t rowEnd)
+{
+    LinearBlock block = {};
+    for (uint32_t y = rowBegin; y < rowEnd; ++y) {
+        const uint8_t *srcRow = job.src + static_cast<size_t>(y) * job.srcStride;
+        uint8_t *dstRow = job.dst + static_cast<size_t>(y) * job.dstStride;
+        for (uint32_t x = 0; x < job.width; x += PIXEL_BLOCK_SIZE) {
+            uint32_t count = std::min(PIXEL_BLOCK_SIZE, job.width - x);
+            const uint8_t *src = srcRow + static_cast<size_t>(x) * RGBA_BYTES_PER_PIXEL;
+            for (uint32_t i = 0; i < count; ++i, src += RGBA_BYTES_PER_PIXEL) {
+                block.red[i] = job.decode[src[0]];
+                block.green[i] = job.decode[src[1]];
+                block.blue[i] = job.decode[src[2]];
+            }
+            TransformBlock(job.matrix, block);
+            src = srcRow + static_cast<size_t>(x) * RGBA_BYTES_PER_PIXEL;
+            uint8_t *dst = dstRow + static_cast<size_t>(x) * RGBA_BYTES_PER_PIXEL;
+            for (uint32_t i = 0; i < count; ++i, src += RGBA_BYTES_PER_PIXEL, dst += RGBA_BYTES_PER_PIXEL) {
+                dst[0] = static_cast<uint8_t>(job.encode[block.red[i]]);
+                dst[1] = static_cast<uint8_t>(job.encode[block.green[i]]);
+                dst[2] = static_cast<uint8_t>(job.encode[block.blue[i]]);
+                dst[RGBA_ALPHA_INDEX] = src[RGBA_ALPHA_INDEX];
+            }
+        }
+    }
+}
+
+void ConvertRgba1010102Rows(const ConvertJob &job, uint32_t rowBegin, uint32_t rowEnd)
+{
+    LinearBlock block = {};
+    std::array<uint32_t, PIXEL_BLOCK_SIZE> alpha = { 0 };
+    for (uint32_t y = rowBegin; y < rowEnd; ++y) {
+        const uint8_t *srcRow = job.src + static_cast<size_t>(y) * job.srcStride;
+        uint8_t *dstRow = job.dst + static_cast<size_t>(y) * job.dstStride;
+        for (uint32_t x = 0; x < job.width; x += PIXEL_BLOCK_SIZE) {
+            uint32_t count = std::min(PIXEL_BLOCK_SIZE, job.width - x);
+            const uint8_t *src = srcRow + static_cast<size_t>(x) * RGBA_BYTES_PER_PIXEL;
+            for (uint32_t i = 0; i < count; ++i, src += RGBA_BYTES_PER_PIXEL) {
+                uint32_t pixel = 0;
+                std::memcpy(&pixel, src, sizeof(pixel));
+                block.red[i] = job.decode[pixel & CHANNEL_10_MASK];
+                block.green[i] = job.decode[(pixel >> GREEN_10_SHIFT) & CHANNEL_10_MASK];
+                block.blue[i] = job.decode[(pixel >> BLUE_10_SHIFT) & CHANNEL_10_MASK];
+                alpha[i] = pixel & ALPHA_2_MASK;
+            }
+            TransformBlock(job.matrix, block);
+            uint8_t *dst = dstRow + static_cast<size_t>(x) * RGBA_BYTES_PER_PIXEL;
+            for (uint32_t i = 0; i < count; ++i, dst += RGBA_BYTES_PER_PIXEL) {
+                uint32_t result = alpha[i] | static_cast<uint32_t>(job.encode[block.red[i]]) |
+                    (static_cast<uint32_t>(job.encode[block.green[i]]) << GREEN_10_SHIFT) |
+                    (static_cast<uint32_t>(job.encode[block.blue[i]]) << BLUE_10_SHIFT);
+                std::memcpy(dst, &result, sizeof(result));
+            }
+        }
+    }
+}
+
+bool IsBufferLargeEnough(const BufferInfo &info)
+{
+    if (info.height_ == 0) {
+        return true;
+    }
+    uint64_t rowBytes = static_cast<uint64_t>(info.width_) * RGBA_BYTES_PER_PIXEL;
+    return info.rowStride_ >= rowBytes &&
+        static_cast<uint64_t>(info.rowStride_) * (info.height_ - 1) + rowBytes <= info.len_;
+}
+
+uint32_t GetTaskNum(uint64_t pixelNum)
+{
+    uint64_t taskNum = pixelNum / PARALLEL_MIN_PIXELS_PER_TASK;
+    if (taskNum <= 1) {
+        return 1;
+    }
+    // The calling thread takes part in the conversion as well.
+    return static_cast<uint32_t>(std::min<uint64_t>(taskNum, RenderExecutor::Instance().GetWorkerNum() + 1));
+}
+} // namespace
+
+bool CpuColorSpaceConverter::IsSupported(EffectColorSpace srcColorSpace, EffectColorSpace dstColorSpace,
+    IEffectFormat format)
+{
+    ColorSpaceInfo srcInfo;
+    ColorSpaceInfo dstInfo;
+    uint32_t depth = 0;
+    return srcColorSpace != dstColorSpace && GetColorSpaceInfo(srcColorSpace, srcInfo) &&
+        GetColorSpaceInfo(dstColorSpace, dstInfo) && GetChannelDepth(format, depth);
+}
+
+bool CpuColorSpaceConverter::GetGamutMatrix(EffectColorSpace srcColorSpace, EffectColorSpace dstColorSpace,
+    std::array<float, GAMUT_MATRIX_SIZE> &matrix)
+{
+    Primaries srcPrimaries = Primaries::BT709;
+    Primaries dstPrimaries = Primaries::BT709;
+    if (!GetPrimaries(srcColorSpace, srcPrimaries) || !GetPrimaries(dstColorSpace, dstPrimaries)) {
+        return false;
+    }
+    Matrix3 result = Multiply(Invert(GetRgbToXyz(dstPrimaries)), GetRgbToXyz(srcPrimaries));
+    std::transform(result.begin(), result.end(), matrix.begin(), [](double value) {
+        return static_cast<float>(value);
+    });
+    return true;
+}
+
+ErrorCode CpuColorSpaceConverter::Convert(EffectBuffer *src, EffectBuffer *dst, EffectColorSpace targetColorSpace)
+{
+    EFFECT_TRACE_NAME("CpuColorSpaceConverter::Convert");
+    CHECK_AND_RETURN_RET_LOG(src != nullptr && dst != nullptr && src->bufferInfo_ != nullptr &&
+        dst->bufferInfo_ != nullptr && src->buffer_ != nullptr && dst->buffer_ != nullptr, ErrorCode::ERR_INPUT_NULL,
+        "CpuColorSpaceConverter::Convert: input para is null!");
+    const BufferInfo &srcInfo = *src->bufferInfo_;
+    const BufferInfo &dstInfo = *dst->bufferInfo_;
+    ColorSpaceInfo srcColorSpaceInfo;
+    ColorSpaceInfo dstColorSpaceInfo;
+    uint32_t depth = 0;
+    CHECK_AND_RETURN_RET_LOG(GetColorSpaceInfo(srcInfo.colorSpace_, srcColorSpaceInfo) &&
+        GetColorSpaceInfo(targetColorSpace, dstColorSpaceInfo) && GetChannelDepth(srcInfo.formatType_, depth),
+        ErrorCode::ERR_INVALID_COLORSPACE, "CpuColorSpaceConverter::Convert: not supported! src=%{public}d, "
+        "target=%{public}d, format=%{public}d", srcInfo.colorSpace_, targetColorSpace, srcInfo.formatType_);
+    CHECK_AND_RETURN_RET_LOG(srcInfo.width_ == dstInfo.width_ && srcInfo.height_ == dstInfo.height_ &&
+        srcInfo.formatType_ == dstInfo.formatType_ && IsBufferLargeEnough(srcInfo) && IsBufferLargeEnough(dstInfo),
+        ErrorCode::ERR_INVALID_PARAMETER_VALUE, "CpuColorSpaceConverter::Convert: buffers mismatch! "
+        "src=%{public}ux%{public}u stride=%{public}u, dst=%{public}ux%{public}u stride=%{public}u",
+        srcInfo.width_, srcInfo.height_, srcInfo.rowStride_, dstInfo.width_, dstInfo.height_, dstInfo.rowStride_);
+
+    EffectProfileScope profileScope(ProfileStage::CONVERT_COLOR_SPACE, "CpuColorSpaceConverter::Convert");
+    if (srcColorSpaceInfo.primaries == dstColorSpaceInfo.primaries &&
+        srcColorSpaceInfo.transfer == dstColorSpaceInfo.transfer) {
+        MemcpyHelper::CopyData(src, dst);
+        dst->bufferInfo_->colorSpace_ = targetColorSpace;
+        return ErrorCode::SUCCESS;
+    }
+
+    ConvertJob job;
+    job.src = static_cast<const uint8_t *>(src->buffer_);
+    job.dst = static_cast<uint8_t *>(dst->buffer_);
+    job.srcStride = srcInfo.rowStride_;
+    job.dstStride = dstInfo.rowStride_;
+    job.width = srcInfo.width_;
+    job.height = srcInfo.height_;
+    job.decode = GetTransferTables(srcColorSpaceInfo.transfer, depth).decode.data();
+    job.encode = GetTransferTables(dstColorSpaceInfo.transfer, depth).encode.data();
+    Matrix3 matrix = Multiply(Invert(GetRgbToXyz(dstColorSpaceInfo.primaries)),
+        GetRgbToXyz(srcColorSpaceInfo.primaries));
+    for (size_t i = 0; i < MATRIX_SIZE; ++i) {
+        job.matrix[i] = static_cast<int32_t>(std::lround(matrix[i] * MATRIX_ONE));
+    }
+    job.convertRows = depth == DEPTH_8 ? ConvertRgba8888Rows : ConvertRgba1010102Rows;
+
+    uint32_t taskNum = GetTaskNum(static_cast<uint64_t>(job.width) * job.height);
+    job.rowsPerTask = (job.height + taskNum - 1) / taskNum;
+    RenderExecutor::Instance().ParallelFor(taskNum, [&job](uint32_t task) {
+        uint32_t rowBegin = std::min(job.height, task * job.rowsPerTask);
+        uint32_t rowEnd = std::min(job.height, rowBegin + job.rowsPerTask);
+        job.convertRows(job, rowBegin, rowEnd);
+    });
+    dst->bufferInfo_->colorSpace_ = targetColorSpace;
+
+    if (profileScope.IsEnabled()) {
+        profileScope.SetBytes(static_cast<uint64_t>(job.width) * job.height * RGBA_BYTES_PER_PIXEL);
+        profileScope.SetDetail("src=" + std::to_string(static_cast<int32_t>(srcInfo.colorSpace_)) + ", target=" +
+            std::to_string(static_cast<int32_t>(targetColorSpace)));
+    }
+    return ErrorCode::SUCCESS;
+}
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
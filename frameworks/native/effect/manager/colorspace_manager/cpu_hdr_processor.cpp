@@ -0,0 +1,699 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cpu_hdr_processor.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "cpu_colorspace_converter.h"
+#include "effect_log.h"
+#include "effect_render_profile.h"
+#include "effect_trace.h"
+#include "render_executor.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace {
+constexpr double SDR_WHITE_NITS = 203.0;
+constexpr double PQ_PEAK_NITS = 10000.0;
+constexpr double HLG_PEAK_NITS = 1000.0;
+constexpr double HLG_SYSTEM_GAMMA = 1.2;
+constexpr double HLG_A = 0.17883277;
+constexpr double HLG_B = 0.28466892;
+constexpr double HLG_C = 0.55991073;
+constexpr double HLG_LINEAR_KNEE = 1.0 / 12;
+constexpr double HLG_SIGNAL_KNEE = 0.5;
+constexpr double HLG_LINEAR_SCALE = 3.0;
+constexpr double HLG_LOG_SCALE = 12.0;
+constexpr double PQ_M1 = 2610.0 / 16384;
+constexpr double PQ_M2 = 2523.0 / 4096 * 128;
+constexpr double PQ_C1 = 3424.0 / 4096;
+constexpr double PQ_C2 = 2413.0 / 4096 * 32;
+constexpr double PQ_C3 = 2392.0 / 4096 * 32;
+constexpr double SRGB_DECODE_THRESHOLD = 0.04045;
+constexpr double SRGB_ENCODE_THRESHOLD = 0.0031308;
+constexpr double SRGB_LINEAR_SLOPE = 12.92;
+constexpr double SRGB_OFFSET = 0.055;
+constexpr double SRGB_GAMMA = 2.4;
+
+constexpr uint32_t CODE_8_MAX = 255;
+constexpr uint32_t CODE_10_MAX = 1023;
+constexpr uint32_t CODE_8_NUM = CODE_8_MAX + 1;
+constexpr uint32_t CODE_10_NUM = CODE_10_MAX + 1;
+constexpr uint32_t ALPHA_2_MAX = 3;
+constexpr uint32_t ALPHA_8_TO_2_SHIFT = 6;
+constexpr uint32_t GREEN_10_SHIFT = 10;
+constexpr uint32_t BLUE_10_SHIFT = 20;
+constexpr uint32_t ALPHA_10_SHIFT = 30;
+constexpr uint32_t RGBA_BYTES_PER_PIXEL = 4;
+constexpr uint32_t ALPHA_INDEX = 3;
+// The encode tables are indexed by the square root of the normalized linear light, which keeps the steps small near
+// black where the transfer functions are steep.
+constexpr uint32_t ENCODE_LUT_SIZE = 16384;
+constexpr uint32_t GAINMAP_SCALE = 2;
+constexpr uint32_t GAINMAP_BLOCK_PIXELS = GAINMAP_SCALE * GAINMAP_SCALE;
+constexpr float GAIN_OFFSET = 1.f / 64;
+constexpr float MIN_GAIN_RANGE = 1.f / 64;
+constexpr float LUMA_R = 0.2627f;
+constexpr float LUMA_G = 0.6780f;
+constexpr float LUMA_B = 0.0593f;
+// Luminance below the knee, relative to the sdr white, is kept as is by the tone mapping. The roll off ends at the HLG
+// nominal peak for PQ as well, brighter PQ pixels are clipped and fully restored by the gain map.
+constexpr float TONE_MAP_KNEE = 0.8f;
+constexpr float TONE_MAP_PEAK = static_cast<float>(HLG_PEAK_NITS / SDR_WHITE_NITS);
+constexpr uint64_t PARALLEL_MIN_PIXELS_PER_TASK = 256 * 1024;
+// Pixels processed per pass. The table lookups stay scalar, the arithmetic in between runs over the whole block with a
+// fixed trip count, so that the compiler vectorizes it, e.g. with NEON on arm64.
+constexpr uint32_t PIXEL_BLOCK_SIZE = 64;
+
+using GamutMatrix = std::array<float, CpuColorSpaceConverter::GAMUT_MATRIX_SIZE>;
+
+enum class HdrTransfer : uint8_t {
+    HLG = 0,
+    PQ,
+};
+
+bool GetHdrTransfer(EffectColorSpace colorSpace, HdrTransfer &transfer)
+{
+    switch (colorSpace) {
+        case EffectColorSpace::BT2020_HLG:
+        case EffectColorSpace::BT2020_HLG_LIMIT:
+            transfer = HdrTransfer::HLG;
+            return true;
+        case EffectColorSpace::BT2020_PQ:
+        case EffectColorSpace::BT2020_PQ_LIMIT:
+            transfer = HdrTransfer::PQ;
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool IsSdrColorSpace(EffectColorSpace colorSpace)
+{
+    // The sdr images of the hdr processing use the srgb transfer function.
+    return colorSpace == EffectColorSpace::SRGB || colorSpace == EffectColorSpace::SRGB_LIMIT ||
+        colorSpace == EffectColorSpace::DISPLAY_P3 || colorSpace == EffectColorSpace::DISPLAY_P3_LIMIT;
+}
+
+double PqToNits(double signal)
+{
+    double power = std::pow(signal, 1.0 / PQ_M2);
+    return PQ_PEAK_NITS * std::pow(std::max(power - PQ_C1, 0.0) / (PQ_C2 - PQ_C3 * power), 1.0 / PQ_M1);
+}
+
+double NitsToPq(double nits)
+{
+    double power = std::pow(std::clamp(nits / PQ_PEAK_NITS, 0.0, 1.0), PQ_M1);
+    return std::pow((PQ_C1 + PQ_C2 * power) / (1.0 + PQ_C3 * power), PQ_M2);
+}
+
+// The OOTF of HLG is applied per channel, which is exact for neutral colors.
+double HlgToNits(double signal)
+{
+    double scene = signal <= HLG_SIGNAL_KNEE ? signal * signal / HLG_LINEAR_SCALE :
+        (std::exp((signal - HLG_C) / HLG_A) + HLG_B) / HLG_LOG_SCALE;
+    return HLG_PEAK_NITS * std::pow(scene, HLG_SYSTEM_GAMMA);
+}
+
+double NitsToHlg(double nits)
+{
+    double scene = std::pow(std::clamp(nits / HLG_PEAK_NITS, 0.0, 1.0), 1.0 / HLG_SYSTEM_GAMMA);
+    return scene <= HLG_LINEAR_KNEE ? std::sqrt(HLG_LINEAR_SCALE * scene) :
+        HLG_A * std::log(HLG_LOG_SCALE * scene - HLG_B) + HLG_C;
+}
+
+double SrgbDecode(double value)
+{
+    return value <= SRGB_DECODE_THRESHOLD ? value / SRGB_LINEAR_SLOPE :
+        std::pow((value + SRGB_OFFSET) / (1.0 + SRGB_OFFSET), SRGB_GAMMA);
+}
+
+double SrgbEncode(double value)
+{
+    return value <= SRGB_ENCODE_THRESHOLD ? value * SRGB_LINEAR_SLOPE :
+        (1.0 + SRGB_OFFSET) * std::pow(value, 1.0 / SRGB_GAMMA) - SRGB_OFFSET;
+}
+
+// Linear light of the tables is relative to the sdr white.
+struct HdrTables {
+    float maxLinear = 0.f;
+    std::array<float, CODE_10_NUM> decode;
+    std::vector<uint16_t> encode;
+};
+
+struct SdrTables {
+    std::array<float, CODE_8_NUM> decode;
+    std::vector<uint8_t> encode;
+};
+
+HdrTables BuildHdrTables(HdrTransfer transfer)
+{
+    bool isPq = transfer == HdrTransfer::PQ;
+    HdrTables tables;
+    tables.maxLinear = static_cast<float>((isPq ? PQ_PEAK_NITS : HLG_PEAK_NITS) / SDR_WHITE_NITS);
+    for (uint32_t code = 0; code < CODE_10_NUM; ++code) {
+        double signal = static_cast<double>(code) / CODE_10_MAX;
+        tables.decode[code] = static_cast<float>((isPq ? PqToNits(signal) : HlgToNits(signal)) / SDR_WHITE_NITS);
+    }
+    tables.encode.resize(ENCODE_LUT_SIZE);
+    for (uint32_t i = 0; i < ENCODE_LUT_SIZE; ++i) {
+        double root = static_cast<double>(i) / (ENCODE_LUT_SIZE - 1);
+        double nits = root * root * tables.maxLinear * SDR_WHITE_NITS;
+        double signal = isPq ? NitsToPq(nits) : NitsToHlg(nits);
+        tables.encode[i] = static_cast<uint16_t>(std::lround(std::clamp(signal, 0.0, 1.0) * CODE_10_MAX));
+    }
+    return tables;
+}
+
+SdrTables BuildSdrTables()
+{
+    SdrTables tables;
+    for (uint32_t code = 0; code < CODE_8_NUM; ++code) {
+        tables.decode[code] = static_cast<float>(SrgbDecode(static_cast<double>(code) / CODE_8_MAX));
+    }
+    tables.encode.resize(ENCODE_LUT_SIZE);
+    for (uint32_t i = 0; i < ENCODE_LUT_SIZE; ++i) {
+        double root = static_cast<double>(i) / (ENCODE_LUT_SIZE - 1);
+        tables.encode[i] = static_cast<uint8_t>(std::lround(SrgbEncode(root * root) * CODE_8_MAX));
+    }
+    return tables;
+}
+
+const HdrTables &GetHdrTables(HdrTransfer transfer)
+{
+    static const HdrTables hlgTables = BuildHdrTables(HdrTransfer::HLG);
+    static const HdrTables pqTables = BuildHdrTables(HdrTransfer::PQ);
+    return transfer == HdrTransfer::PQ ? pqTables : hlgTables;
+}
+
+const SdrTables &GetSdrTables()
+{
+    static const SdrTables tables = BuildSdrTables();
+    return tables;
+}
+
+inline uint32_t GetEncodeIndex(float linear, float invMaxLinear)
+{
+    float normalized = std::clamp(linear * invMaxLinear, 0.f, 1.f);
+    // Through int32_t, which unlike uint32_t has a vector conversion on every target.
+    return static_cast<uint32_t>(static_cast<int32_t>(std::sqrt(normalized) * (ENCODE_LUT_SIZE - 1) + 0.5f));
+}
+
+inline void Transform(const GamutMatrix &matrix, float &red, float &green, float &blue)
+{
+    float r = matrix[0] * red + matrix[1] * green + matrix[2] * blue;
+    float g = matrix[3] * red + matrix[4] * green + matrix[5] * blue;
+    float b = matrix[6] * red + matrix[7] * green + matrix[8] * blue;
+    red = r;
+    green = g;
+    blue = b;
+}
+
+// Keeps the luminance below the knee and rolls off smoothly to the sdr white at the peak, with a continuous slope at
+// the knee.
+inline float ToneMapLuminance(float luminance, float peak)
+{
+    // Both sides are computed, so that the blocks can select instead of branch.
+    constexpr float range = 1.f - TONE_MAP_KNEE;
+    float t = (luminance - TONE_MAP_KNEE) / range;
+    float w = (peak - TONE_MAP_KNEE) / range;
+    float mapped = TONE_MAP_KNEE + range * std::min(1.f, t * (1.f + t / (w * w)) / (1.f + t));
+    return luminance <= TONE_MAP_KNEE ? luminance : mapped;
+}
+
+// Colors of a block of pixels, channel by channel.
+struct ColorBlock {
+    std::array<float, PIXEL_BLOCK_SIZE> red;
+    std::array<float, PIXEL_BLOCK_SIZE> green;
+    std::array<float, PIXEL_BLOCK_SIZE> blue;
+};
+
+// Encode table indexes of a block of pixels, channel by channel.
+struct IndexBlock {
+    std::array<uint32_t, PIXEL_BLOCK_SIZE> red;
+    std::array<uint32_t, PIXEL_BLOCK_SIZE> green;
+    std::array<uint32_t, PIXEL_BLOCK_SIZE> blue;
+};
+
+bool IsValidBuffer(const EffectBuffer *buffer, IEffectFormat format)
+{
+    if (buffer == nullptr || buffer->bufferInfo_ == nullptr || buffer->buffer_ == nullptr) {
+        return false;
+    }
+    const BufferInfo &info = *buffer->bufferInfo_;
+    uint64_t rowBytes = static_cast<uint64_t>(info.width_) * RGBA_BYTES_PER_PIXEL;
+    return info.formatType_ == format && info.width_ > 0 && info.height_ > 0 && info.rowStride_ >= rowBytes &&
+        static_cast<uint64_t>(info.rowStride_) * (info.height_ - 1) + rowBytes <= info.len_;
+}
+
+uint32_t GetTaskNum(uint64_t pixelNum, uint32_t maxTaskNum)
+{
+    uint64_t taskNum = pixelNum / PARALLEL_MIN_PIXELS_PER_TASK;
+    taskNum = std::min<uint64_t>(taskNum, RenderExecutor::Instance().GetWorkerNum() + 1);
+    return static_cast<uint32_t>(std::clamp<uint64_t>(taskNum, 1, std::max(maxTaskNum, 1u)));
+}
+
+template <typename Func>
+void ParallelForRows(uint32_t rowNum, uint32_t rowWidth, Func &&func)
+{
+    uint32_t taskNum = GetTaskNum(static_cast<uint64_t>(rowNum) * rowWidth, rowNum);
+    uint32_t rowsPerTask = (rowNum + taskNum - 1) / taskNum;
+    RenderExecutor::Instance().ParallelFor(taskNum, [&func, rowNum, rowsPerTask](uint32_t task) {
+        uint32_t rowBegin = std::min(rowNum, task * rowsPerTask);
+        func(task, rowBegin, std::min(rowNum, rowBegin + rowsPerTask));
+    });
+}
+
+struct ToneMapJob {
+    const uint8_t *hdr = nullptr;
+    uint8_t *sdr = nullptr;
+    uint32_t hdrStride = 0;
+    uint32_t sdrStride = 0;
+    uint32_t width = 0;
+    const HdrTables *hdrTables = nullptr;
+    const SdrTables *sdrTables = nullptr;
+    GamutMatrix matrix = { 0 };
+    float peak = 0.f;
+};
+
+// Tone maps the whole block and converts it to the sdr primaries in place, before the scaling of the tone mapping. The
+// lanes past the last pixel of a short block hold stale but finite values, which are not stored.
+void ToneMapBlock(const ToneMapJob &job, ColorBlock &color, IndexBlock &index)
+{
+    // Local copies tell the compiler that the blocks do not alias the job.
+    const GamutMatrix matrix = job.matrix;
+    const float peak = job.peak;
+    for (uint32_t i = 0; i < PIXEL_BLOCK_SIZE; ++i) {
+        float red = color.red[i];
+        float green = color.green[i];
+        float blue = color.blue[i];
+        float luma = LUMA_R * red + LUMA_G * green + LUMA_B * blue;
+        float scale = luma > 0.f ? ToneMapLuminance(luma, peak) / luma : 0.f;
+        Transform(matrix, red, green, blue);
+        color.red[i] = red;
+        color.green[i] = green;
+        color.blue[i] = blue;
+        index.red[i] = GetEncodeIndex(red * scale, 1.f);
+        index.green[i] = GetEncodeIndex(green * scale, 1.f);
+        index.blue[i] = GetEncodeIndex(blue * scale, 1.f);
+    }
+}
+
+// Tone maps one row. When the block arrays are given, the linear hdr and sdr colors, both in the sdr primaries, are
+// added up for each gain map block of the row, channel by channel.
+void ToneMapRow(const ToneMapJob &job, uint32_t y, float *hdrBlockSum, float *sdrBlockSum, uint32_t blockNum)
+{
+    const uint8_t *srcRow = job.hdr + static_cast<size_t>(y) * job.hdrStride;
+    uint8_t *dstRow = job.sdr + static_cast<size_t>(y) * job.sdrStride;
+    const float *decode = job.hdrTables->decode.data();
+    const float *sdrDecode = job.sdrTables->decode.data();
+    const uint8_t *encode = job.sdrTables->encode.data();
+    ColorBlock color = {};
+    IndexBlock index = {};
+    std::array<uint8_t, PIXEL_BLOCK_SIZE> alpha = { 0 };
+    for (uint32_t x = 0; x < job.width; x += PIXEL_BLOCK_SIZE) {
+        uint32_t count = std::min(PIXEL_BLOCK_SIZE, job.width - x);
+        const uint8_t *src = srcRow + static_cast<size_t>(x) * RGBA_BYTES_PER_PIXEL;
+        for (uint32_t i = 0; i < count; ++i, src += RGBA_BYTES_PER_PIXEL) {
+            uint32_t pixel = 0;
+            std::memcpy(&pixel, src, sizeof(pixel));
+            color.red[i] = decode[pixel & CODE_10_MAX];
+            color.green[i] = decode[(pixel >> GREEN_10_SHIFT) & CODE_10_MAX];
+            color.blue[i] = decode[(pixel >> BLUE_10_SHIFT) & CODE_10_MAX];
+            alpha[i] = static_cast<uint8_t>((pixel >> ALPHA_10_SHIFT) * CODE_8_MAX / ALPHA_2_MAX);
+        }
+        ToneMapBlock(job, color, index);
+        uint8_t *dst = dstRow + static_cast<size_t>(x) * RGBA_BYTES_PER_PIXEL;
+        for (uint32_t i = 0; i < count; ++i, dst += RGBA_BYTES_PER_PIXEL) {
+            dst[0] = encode[index.red[i]];
+            dst[1] = encode[index.green[i]];
+            dst[2] = encode[index.blue[i]];
+            dst[ALPHA_INDEX] = alpha[i];
+
+            uint32_t block = (x + i) / GAINMAP_SCALE;
+            if (hdrBlockSum != nullptr && block < blockNum) {
+                // The gain is measured against the quantized sdr pixel that the composition starts from.
+                float *hdrSum = hdrBlockSum + block * GAINMAP_CHANNEL_NUM;
+                float *sdrSum = sdrBlockSum + block * GAINMAP_CHANNEL_NUM;
+                hdrSum[0] += std::max(color.red[i], 0.f);
+                hdrSum[1] += std::max(color.green[i], 0.f);
+                hdrSum[2] += std::max(color.blue[i], 0.f);
+                sdrSum[0] += sdrDecode[dst[0]];
+                sdrSum[1] += sdrDecode[dst[1]];
+                sdrSum[2] += sdrDecode[dst[2]];
+            }
+        }
+    }
+}
+
+ErrorCode InitToneMapJob(const EffectBuffer *hdr, EffectBuffer *sdr, ToneMapJob &job)
+{
+    CHECK_AND_RETURN_RET_LOG(IsValidBuffer(hdr, IEffectFormat::RGBA_1010102) &&
+        IsValidBuffer(sdr, IEffectFormat::RGBA8888), ErrorCode::ERR_NOT_SUPPORT_CONVERT_FORMAT,
+        "InitToneMapJob: invalid buffers!");
+    const BufferInfo &hdrInfo = *hdr->bufferInfo_;
+    const BufferInfo &sdrInfo = *sdr->bufferInfo_;
+    HdrTransfer transfer = HdrTransfer::HLG;
+    CHECK_AND_RETURN_RET_LOG(GetHdrTransfer(hdrInfo.colorSpace_, transfer) && IsSdrColorSpace(sdrInfo.colorSpace_) &&
+        CpuColorSpaceConverter::GetGamutMatrix(hdrInfo.colorSpace_, sdrInfo.colorSpace_, job.matrix),
+        ErrorCode::ERR_COLORSPACE_NOT_SUPPORT_CONVERT, "InitToneMapJob: not supported! hdr=%{public}d, "
+        "sdr=%{public}d", hdrInfo.colorSpace_, sdrInfo.colorSpace_);
+    CHECK_AND_RETURN_RET_LOG(hdrInfo.width_ == sdrInfo.width_ && hdrInfo.height_ == sdrInfo.height_,
+        ErrorCode::ERR_INVALID_PARAMETER_VALUE, "InitToneMapJob: size mismatch! hdr=%{public}ux%{public}u, "
+        "sdr=%{public}ux%{public}u", hdrInfo.width_, hdrInfo.height_, sdrInfo.width_, sdrInfo.height_);
+
+    job.hdr = static_cast<const uint8_t *>(hdr->buffer_);
+    job.sdr = static_cast<uint8_t *>(sdr->buffer_);
+    job.hdrStride = hdrInfo.rowStride_;
+    job.sdrStride = sdrInfo.rowStride_;
+    job.width = hdrInfo.width_;
+    job.hdrTables = &GetHdrTables(transfer);
+    job.sdrTables = &GetSdrTables();
+    job.peak = std::min(job.hdrTables->maxLinear, TONE_MAP_PEAK);
+    return ErrorCode::SUCCESS;
+}
+
+struct GainmapRow {
+    const uint8_t *top = nullptr;
+    const uint8_t *bottom = nullptr;
+    float weight = 0.f;
+};
+
+struct ComposeJob {
+    const uint8_t *sdr = nullptr;
+    const uint8_t *gainmap = nullptr;
+    uint8_t *hdr = nullptr;
+    uint32_t sdrStride = 0;
+    uint32_t gainmapStride = 0;
+    uint32_t hdrStride = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t gainmapWidth = 0;
+    uint32_t gainmapHeight = 0;
+    const float *decode = nullptr;
+    const HdrTables *hdrTables = nullptr;
+    std::array<std::array<float, CODE_8_NUM>, GAINMAP_CHANNEL_NUM> boost;
+    std::array<float, GAINMAP_CHANNEL_NUM> baseOffset = { 0 };
+    std::array<float, GAINMAP_CHANNEL_NUM> alternateOffset = { 0 };
+    bool useBaseColor = true;
+    GamutMatrix matrix = { 0 };
+    // Left gain map column and its weight for every image column, the right column follows it.
+    std::vector<uint32_t> columns;
+    std::vector<float> columnWeights;
+};
+
+// Maps the center of an image sample onto the gain map, clamped to the centers of the gain map samples.
+void GetSampleWeight(uint32_t index, uint32_t size, uint32_t gainmapSize, uint32_t &first, float &weight)
+{
+    float position = (static_cast<float>(index) + 0.5f) * gainmapSize / size - 0.5f;
+    position = std::clamp(position, 0.f, static_cast<float>(gainmapSize - 1));
+    first = std::min(static_cast<uint32_t>(position), gainmapSize - 1);
+    weight = position - first;
+}
+
+// The gain map samples around a block of pixels, channel by channel, bilinearly interpolated by ComposeBlock.
+struct BoostBlock {
+    std::array<ColorBlock, 2> top;
+    std::array<ColorBlock, 2> bottom;
+    std::array<float, PIXEL_BLOCK_SIZE> weight;
+};
+
+inline void GatherBoost(const ComposeJob &job, const GainmapRow &row, uint32_t x, uint32_t i, BoostBlock &boost)
+{
+    uint32_t left = job.columns[x] * RGBA_BYTES_PER_PIXEL;
+    uint32_t right = std::min(job.columns[x] + 1, job.gainmapWidth - 1) * RGBA_BYTES_PER_PIXEL;
+    const uint8_t *samples[] = { row.top + left, row.top + right, row.bottom + left, row.bottom + right };
+    ColorBlock *blocks[] = { &boost.top[0], &boost.top[1], &boost.bottom[0], &boost.bottom[1] };
+    for (size_t corner = 0; corner < std::size(samples); ++corner) {
+        blocks[corner]->red[i] = job.boost[0][samples[corner][0]];
+        blocks[corner]->green[i] = job.boost[1][samples[corner][1]];
+        blocks[corner]->blue[i] = job.boost[2][samples[corner][2]];
+    }
+    boost.weight[i] = job.columnWeights[x];
+}
+
+inline float InterpolateBoost(const std::array<ColorBlock, 2> &top, const std::array<ColorBlock, 2> &bottom,
+    std::array<float, PIXEL_BLOCK_SIZE> ColorBlock::*channel, float weight, float rowWeight, uint32_t i)
+{
+    float topLeft = (top[0].*channel)[i];
+    float bottomLeft = (bottom[0].*channel)[i];
+    float topBoost = topLeft + ((top[1].*channel)[i] - topLeft) * weight;
+    float bottomBoost = bottomLeft + ((bottom[1].*channel)[i] - bottomLeft) * weight;
+    return topBoost + (bottomBoost - topBoost) * rowWeight;
+}
+
+// Applies the gains to the whole block and converts it to the hdr primaries. The lanes past the last pixel of a short
+// block hold stale but finite values, which are not stored.
+template <bool useBaseColor>
+void ComposeBlock(const ComposeJob &job, float rowWeight, ColorBlock &color, const BoostBlock &boost,
+    IndexBlock &index)
+{
+    // Local copies tell the compiler that the blocks do not alias the job.
+    const GamutMatrix matrix = job.matrix;
+    const std::array<float, GAINMAP_CHANNEL_NUM> baseOffset = job.baseOffset;
+    const std::array<float, GAINMAP_CHANNEL_NUM> alternateOffset = job.alternateOffset;
+    const float invMaxLinear = 1.f / job.hdrTables->maxLinear;
+    for (uint32_t i = 0; i < PIXEL_BLOCK_SIZE; ++i) {
+        float red = color.red[i];
+        float green = color.green[i];
+        float blue = color.blue[i];
+        if (!useBaseColor) {
+            Transform(matrix, red, green, blue);
+        }
+        float weight = boost.weight[i];
+        red = (red + baseOffset[0]) * InterpolateBoost(boost.top, boost.bottom, &ColorBlock::red, weight, rowWeight,
+            i) - alternateOffset[0];
+        green = (green + baseOffset[1]) * InterpolateBoost(boost.top, boost.bottom, &ColorBlock::green, weight,
+            rowWeight, i) - alternateOffset[1];
+        blue = (blue + baseOffset[2]) * InterpolateBoost(boost.top, boost.bottom, &ColorBlock::blue, weight,
+            rowWeight, i) - alternateOffset[2];
+        if (useBaseColor) {
+            Transform(matrix, red, green, blue);
+        }
+        index.red[i] = GetEncodeIndex(red, invMaxLinear);
+        index.green[i] = GetEncodeIndex(green, invMaxLinear);
+        index.blue[i] = GetEncodeIndex(blue, invMaxLinear);
+    }
+}
+
+void ComposeRow(const ComposeJob &job, uint32_t y)
+{
+    GainmapRow row;
+    uint32_t top = 0;
+    GetSampleWeight(y, job.height, job.gainmapHeight, top, row.weight);
+    row.top = job.gainmap + static_cast<size_t>(top) * job.gainmapStride;
+    row.bottom = job.gainmap + static_cast<size_t>(std::min(top + 1, job.gainmapHeight - 1)) * job.gainmapStride;
+
+    const uint8_t *srcRow = job.sdr + static_cast<size_t>(y) * job.sdrStride;
+    uint8_t *dstRow = job.hdr + static_cast<size_t>(y) * job.hdrStride;
+    const uint16_t *encode = job.hdrTables->encode.data();
+    ColorBlock color = {};
+    BoostBlock boost = {};
+    IndexBlock index = {};
+    for (uint32_t x = 0; x < job.width; x += PIXEL_BLOCK_SIZE) {
+        uint32_t count = std::min(PIXEL_BLOCK_SIZE, job.width - x);
+        const uint8_t *src = srcRow + static_cast<size_t>(x) * RGBA_BYTES_PER_PIXEL;
+        for (uint32_t i = 0; i < count; ++i, src += RGBA_BYTES_PER_PIXEL) {
+            color.red[i] = job.decode[src[0]];
+            color.green[i] = job.decode[src[1]];
+            color.blue[i] = job.decode[src[2]];
+            GatherBoost(job, row, x + i, i, boost);
+        }
+        if (job.useBaseColor) {
+            ComposeBlock<true>(job, row.weight, color, boost, index);
+        } else {
+            ComposeBlock<false>(job, row.weight, color, boost, index);
+        }
+        src = srcRow + static_cast<size_t>(x) * RGBA_BYTES_PER_PIXEL;
+        uint8_t *dst = dstRow + static_cast<size_t>(x) * RGBA_BYTES_PER_PIXEL;
+        for (uint32_t i = 0; i < count; ++i, src += RGBA_BYTES_PER_PIXEL, dst += RGBA_BYTES_PER_PIXEL) {
+            uint32_t pixel = static_cast<uint32_t>(encode[index.red[i]]) |
+                (static_cast<uint32_t>(encode[index.green[i]]) << GREEN_10_SHIFT) |
+                (static_cast<uint32_t>(encode[index.blue[i]]) << BLUE_10_SHIFT) |
+                (static_cast<uint32_t>(src[ALPHA_INDEX] >> ALPHA_8_TO_2_SHIFT) << ALPHA_10_SHIFT);
+            std::memcpy(dst, &pixel, sizeof(pixel));
+        }
+    }
+}
+} // namespace
+
+bool CpuHdrProcessor::IsHdrSupported(const BufferInfo &hdrInfo)
+{
+    HdrTransfer transfer = HdrTransfer::HLG;
+    return hdrInfo.formatType_ == IEffectFormat::RGBA_1010102 && GetHdrTransfer(hdrInfo.colorSpace_, transfer);
+}
+
+ErrorCode CpuHdrProcessor::ToneMap(const EffectBuffer *hdr, EffectBuffer *sdr)
+{
+    EFFECT_TRACE_NAME("CpuHdrProcessor::ToneMap");
+    ToneMapJob job;
+    ErrorCode res = InitToneMapJob(hdr, sdr, job);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "ToneMap: init fail! res=%{public}d", res);
+
+    EffectProfileScope profileScope(ProfileStage::CONVERT_COLOR_SPACE, "CpuHdrProcessor::ToneMap");
+    ParallelForRows(hdr->bufferInfo_->height_, job.width, [&job](uint32_t, uint32_t rowBegin, uint32_t rowEnd) {
+        for (uint32_t y = rowBegin; y < rowEnd; ++y) {
+            ToneMapRow(job, y, nullptr, nullptr, 0);
+        }
+    });
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode CpuHdrProcessor::Decompose(const EffectBuffer *hdr, EffectBuffer *sdr, EffectBuffer *gainmap,
+    CpuGainmapMetadata &metadata)
+{
+    EFFECT_TRACE_NAME("CpuHdrProcessor::Decompose");
+    ToneMapJob job;
+    ErrorCode res = InitToneMapJob(hdr, sdr, job);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "Decompose: init fail! res=%{public}d", res);
+    CHECK_AND_RETURN_RET_LOG(IsValidBuffer(gainmap, IEffectFormat::RGBA8888), ErrorCode::ERR_NOT_SUPPORT_CONVERT_FORMAT,
+        "Decompose: invalid gainmap!");
+    const uint32_t height = hdr->bufferInfo_->height_;
+    const uint32_t gainmapWidth = job.width / GAINMAP_SCALE;
+    const uint32_t gainmapHeight = height / GAINMAP_SCALE;
+    CHECK_AND_RETURN_RET_LOG(gainmapWidth > 0 && gainmapHeight > 0 &&
+        gainmap->bufferInfo_->width_ == gainmapWidth && gainmap->bufferInfo_->height_ == gainmapHeight,
+        ErrorCode::ERR_INVALID_PARAMETER_VALUE, "Decompose: gainmap size mismatch! gainmap=%{public}ux%{public}u, "
+        "hdr=%{public}ux%{public}u", gainmap->bufferInfo_->width_, gainmap->bufferInfo_->height_, job.width, height);
+
+    EffectProfileScope profileScope(ProfileStage::CONVERT_COLOR_SPACE, "CpuHdrProcessor::Decompose");
+    // Log2 of the gains of every block, then quantized once the range of the image is known.
+    const size_t gainRowSize = static_cast<size_t>(gainmapWidth) * GAINMAP_CHANNEL_NUM;
+    std::vector<float> gains(gainRowSize * gainmapHeight);
+    std::vector<float> taskMin(RenderExecutor::Instance().GetWorkerNum() + 1, std::numeric_limits<float>::max());
+    std::vector<float> taskMax(taskMin.size(), std::numeric_limits<float>::lowest());
+    ParallelForRows(gainmapHeight, job.width * GAINMAP_SCALE,
+        [&](uint32_t task, uint32_t gainRowBegin, uint32_t gainRowEnd) {
+            std::vector<float> hdrBlockSum(gainRowSize);
+            std::vector<float> sdrBlockSum(gainRowSize);
+            for (uint32_t gainRow = gainRowBegin; gainRow < gainRowEnd; ++gainRow) {
+                std::fill(hdrBlockSum.begin(), hdrBlockSum.end(), 0.f);
+                std::fill(sdrBlockSum.begin(), sdrBlockSum.end(), 0.f);
+                for (uint32_t y = gainRow * GAINMAP_SCALE; y < (gainRow + 1) * GAINMAP_SCALE; ++y) {
+                    ToneMapRow(job, y, hdrBlockSum.data(), sdrBlockSum.data(), gainmapWidth);
+                }
+                float *rowGains = gains.data() + gainRow * gainRowSize;
+                for (size_t i = 0; i < gainRowSize; ++i) {
+                    rowGains[i] = std::log2((hdrBlockSum[i] / GAINMAP_BLOCK_PIXELS + GAIN_OFFSET) /
+                        (sdrBlockSum[i] / GAINMAP_BLOCK_PIXELS + GAIN_OFFSET));
+                    taskMin[task] = std::min(taskMin[task], rowGains[i]);
+                    taskMax[task] = std::max(taskMax[task], rowGains[i]);
+                }
+            }
+            // The odd last row has no gain map block of its own.
+            if (gainRowEnd == gainmapHeight) {
+                for (uint32_t y = gainmapHeight * GAINMAP_SCALE; y < height; ++y) {
+                    ToneMapRow(job, y, nullptr, nullptr, 0);
+                }
+            }
+        });
+
+    float minLog2 = std::min(0.f, *std::min_element(taskMin.begin(), taskMin.end()));
+    float maxLog2 = std::max(minLog2 + MIN_GAIN_RANGE, *std::max_element(taskMax.begin(), taskMax.end()));
+    float scale = CODE_8_MAX / (maxLog2 - minLog2);
+    uint8_t *gainmapAddr = static_cast<uint8_t *>(gainmap->buffer_);
+    uint32_t gainmapStride = gainmap->bufferInfo_->rowStride_;
+    ParallelForRows(gainmapHeight, gainmapWidth, [&](uint32_t, uint32_t rowBegin, uint32_t rowEnd) {
+        for (uint32_t y = rowBegin; y < rowEnd; ++y) {
+            const float *rowGains = gains.data() + y * gainRowSize;
+            uint8_t *dst = gainmapAddr + static_cast<size_t>(y) * gainmapStride;
+            for (uint32_t x = 0; x < gainmapWidth; ++x, dst += RGBA_BYTES_PER_PIXEL, rowGains += GAINMAP_CHANNEL_NUM) {
+                for (uint32_t channel = 0; channel < GAINMAP_CHANNEL_NUM; ++channel) {
+                    dst[channel] = static_cast<uint8_t>(std::clamp((rowGains[channel] - minLog2) * scale + 0.5f, 0.f,
+                        static_cast<float>(CODE_8_MAX)));
+                }
+                dst[ALPHA_INDEX] = CODE_8_MAX;
+            }
+        }
+    });
+
+    metadata = CpuGainmapMetadata();
+    for (uint32_t channel = 0; channel < GAINMAP_CHANNEL_NUM; ++channel) {
+        metadata.minLog2[channel] = minLog2;
+        metadata.maxLog2[channel] = maxLog2;
+        metadata.baseOffset[channel] = GAIN_OFFSET;
+        metadata.alternateOffset[channel] = GAIN_OFFSET;
+    }
+    metadata.alternateHeadroom = std::log2(job.peak);
+    metadata.useBaseColor = true;
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode CpuHdrProcessor::Compose(const EffectBuffer *sdr, const EffectBuffer *gainmap,
+    const CpuGainmapMetadata &metadata, EffectBuffer *hdr)
+{
+    EFFECT_TRACE_NAME("CpuHdrProcessor::Compose");
+    CHECK_AND_RETURN_RET_LOG(IsValidBuffer(sdr, IEffectFormat::RGBA8888) &&
+        IsValidBuffer(gainmap, IEffectFormat::RGBA8888) && IsValidBuffer(hdr, IEffectFormat::RGBA_1010102),
+        ErrorCode::ERR_NOT_SUPPORT_CONVERT_FORMAT, "Compose: invalid buffers!");
+    const BufferInfo &sdrInfo = *sdr->bufferInfo_;
+    const BufferInfo &hdrInfo = *hdr->bufferInfo_;
+    ComposeJob job;
+    HdrTransfer transfer = HdrTransfer::HLG;
+    CHECK_AND_RETURN_RET_LOG(GetHdrTransfer(hdrInfo.colorSpace_, transfer) && IsSdrColorSpace(sdrInfo.colorSpace_) &&
+        CpuColorSpaceConverter::GetGamutMatrix(sdrInfo.colorSpace_, hdrInfo.colorSpace_, job.matrix),
+        ErrorCode::ERR_COLORSPACE_NOT_SUPPORT_CONVERT, "Compose: not supported! sdr=%{public}d, hdr=%{public}d",
+        sdrInfo.colorSpace_, hdrInfo.colorSpace_);
+    CHECK_AND_RETURN_RET_LOG(hdrInfo.width_ == sdrInfo.width_ && hdrInfo.height_ == sdrInfo.height_,
+        ErrorCode::ERR_INVALID_PARAMETER_VALUE, "Compose: size mismatch! sdr=%{public}ux%{public}u, "
+        "hdr=%{public}ux%{public}u", sdrInfo.width_, sdrInfo.height_, hdrInfo.width_, hdrInfo.height_);
+
+    EffectProfileScope profileScope(ProfileStage::CONVERT_COLOR_SPACE, "CpuHdrProcessor::Compose");
+    job.sdr = static_cast<const uint8_t *>(sdr->buffer_);
+    job.gainmap = static_cast<const uint8_t *>(gainmap->buffer_);
+    job.hdr = static_cast<uint8_t *>(hdr->buffer_);
+    job.sdrStride = sdrInfo.rowStride_;
+    job.gainmapStride = gainmap->bufferInfo_->rowStride_;
+    job.hdrStride = hdrInfo.rowStride_;
+    job.width = sdrInfo.width_;
+    job.height = sdrInfo.height_;
+    job.gainmapWidth = gainmap->bufferInfo_->width_;
+    job.gainmapHeight = gainmap->bufferInfo_->height_;
+    job.decode = GetSdrTables().decode.data();
+    job.hdrTables = &GetHdrTables(transfer);
+    job.useBaseColor = metadata.useBaseColor;
+    for (uint32_t channel = 0; channel < GAINMAP_CHANNEL_NUM; ++channel) {
+        float gamma = metadata.gamma[channel] > 0.f ? metadata.gamma[channel] : 1.f;
+        for (uint32_t code = 0; code < CODE_8_NUM; ++code) {
+            float recovery = std::pow(static_cast<float>(code) / CODE_8_MAX, 1.f / gamma);
+            float log2Boost = metadata.minLog2[channel] * (1.f - recovery) + metadata.maxLog2[channel] * recovery;
+            job.boost[channel][code] = std::exp2(log2Boost);
+        }
+        job.baseOffset[channel] = metadata.baseOffset[channel];
+        job.alternateOffset[channel] = metadata.alternateOffset[channel];
+    }
+    job.columns.resize(job.width);
+    job.columnWeights.resize(job.width);
+    for (uint32_t x = 0; x < job.width; ++x) {
+        GetSampleWeight(x, job.width, job.gainmapWidth, job.columns[x], job.columnWeights[x]);
+    }
+
+    ParallelForRows(job.height, job.width, [&job](uint32_t, uint32_t rowBegin, uint32_t rowEnd) {
+        for (uint32_t y = rowBegin; y < rowEnd; ++y) {
+            ComposeRow(job, y);
+        }
+    });
+    return ErrorCode::SUCCESS;
+}
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -15,9 +15,12 @@
 
 #include "effect_memory_manager.h"
 
+#include <algorithm>
+
 #include "effect_log.h"
 #include "effect_buffer.h"
 #include "colorspace_helper.h"
+#include "effect_render_profile.h"
 
 using namespace OHOS::ColorManager;
 using namespace OHOS::HDI::Display::Graphic::Common::V1_0;
@@ -95,6 +98,8 @@ std::shared_ptr<Memory> AllocMemoryInner(MemoryInfo &allocMemInfo, BufferType al
 
 MemoryData *EffectMemoryManager::AllocMemory(void *srcAddr, MemoryInfo &allocMemInfo)
 {
+    EffectProfileScope profileScope(ProfileStage::MEMORY_ALLOC, "EffectMemoryManager::AllocMemory");
+    profileScope.SetBytes(allocMemInfo.bufferInfo.len_);
     for (const auto &memory : memorys_) {
         if (!memory->isAllowModify_ || memory->memoryData_->data == srcAddr) {
             continue;
@@ -109,6 +114,7 @@ MemoryData *EffectMemoryManager::AllocMemory(void *srcAddr, MemoryInfo &allocMem
             EFFECT_LOGD("reuse memory. width=%{public}d, height=%{public}d, format=%{public}d, "
                 "bufferType=%{public}d, allocBufType=%{public}d", bufferInfo.width_, bufferInfo.height_,
                 bufferInfo.formatType_, memInfo.bufferType, allocMemInfo.bufferType);
+            profileScope.SetStage(ProfileStage::MEMORY_REUSE);
             return memory->memoryData_.get();
         }
     }
@@ -120,6 +126,9 @@ MemoryData *EffectMemoryManager::AllocMemory(void *srcAddr, MemoryInfo &allocMem
     if (allocMemInfo.bufferType != BufferType::DEFAULT) {
         allocBufferType = allocMemInfo.bufferType;
     }
+    if (profileScope.IsEnabled()) {
+        profileScope.SetDetail("bufferType=" + std::to_string(static_cast<int32_t>(allocBufferType)));
+    }
     std::shared_ptr<Memory> memory = AllocMemoryInner(allocMemInfo, allocBufferType);
     CHECK_AND_RETURN_RET_LOG(memory != nullptr, nullptr,
         "AllocMemory fail! bufferType=%{public}d", allocBufferType);
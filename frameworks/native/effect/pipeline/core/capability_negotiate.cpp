@@ -14,6 +14,9 @@
  */
 
 #include "capability_negotiate.h"
+
+#include <algorithm>
+
 #include "effect_log.h"
 
 namespace OHOS {
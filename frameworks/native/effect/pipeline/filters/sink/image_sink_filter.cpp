@@ -88,6 +88,17 @@ void CopyDataToPixelMap(PixelMap *pixelMap, const std::shared_ptr<EffectBuffer>
     MemcpyHelper::CopyData(buffer.get(), dst);
 }
 
+// The gamut conversion of the source may be deferred behind the filters, so the copied pixels are not always in the
+// color space the pixel map had at the pipeline entry.
+void UpdatePixelMapColorSpace(PixelMap *pixelMap, EffectColorSpace colorSpace)
+{
+    if (colorSpace == EffectColorSpace::DEFAULT || ColorSpaceHelper::IsHdrColorSpace(colorSpace)) {
+        return;
+    }
+    OHOS::ColorManager::ColorSpace grColorSpace(ColorSpaceHelper::ConvertToColorSpaceName(colorSpace));
+    pixelMap->InnerSetColorSpace(grColorSpace);
+}
+
 ErrorCode ModifyPixelMap(EffectBuffer *src, const std::shared_ptr<EffectBuffer> &buffer,
     std::shared_ptr<EffectContext> &context)
 {
@@ -117,8 +128,13 @@ ErrorCode ModifyPixelMap(EffectBuffer *src, const std::shared_ptr<EffectBuffer>
     if (static_cast<uint32_t>(pixelMap->GetRowStride()) == buffer->bufferInfo_->rowStride_ &&
         static_cast<uint32_t>(pixelMap->GetHeight()) == buffer->bufferInfo_->height_ &&
         CommonUtils::SwitchToEffectFormat(pixelMap->GetPixelFormat()) == buffer->bufferInfo_->formatType_) {
+        if (CommonUtils::IsBufferAdoptable(pixelMap, buffer, context)) {
+            EFFECT_LOGD("Adopt buffer to pixel map.");
+            return CommonUtils::ModifyPixelMapProperty(pixelMap, buffer, context);
+        }
         EFFECT_LOGD("Copy data to pixel map.");
         CopyDataToPixelMap(pixelMap, buffer);
+        UpdatePixelMapColorSpace(pixelMap, buffer->bufferInfo_->colorSpace_);
         ColorSpaceHelper::UpdateMetadata(buffer.get(), context);
         return ErrorCode::SUCCESS;
     }
@@ -443,6 +459,13 @@ ErrorCode ModifyDataInfo(EffectBuffer *src, const std::shared_ptr<EffectBuffer>
     }
 }
 
+bool IsSameImageSize(PixelMap *pixelMap, const std::shared_ptr<EffectBuffer> &buffer)
+{
+    return static_cast<uint32_t>(pixelMap->GetWidth()) == buffer->bufferInfo_->width_ &&
+        static_cast<uint32_t>(pixelMap->GetHeight()) == buffer->bufferInfo_->height_ &&
+        CommonUtils::SwitchToEffectFormat(pixelMap->GetPixelFormat()) == buffer->bufferInfo_->formatType_;
+}
+
 ErrorCode FillOutputData(const std::shared_ptr<EffectBuffer> &inputBuffer, std::shared_ptr<EffectBuffer> &outputBuffer,
     const std::shared_ptr<EffectContext> &context)
 {
@@ -467,6 +490,15 @@ ErrorCode FillOutputData(const std::shared_ptr<EffectBuffer> &inputBuffer, std::
     uint32_t inputRowStride = inputBuffer->bufferInfo_->rowStride_;
     EFFECT_LOGI("outputBufferSize=%{public}zu, inputBufferSize=%{public}zu, outputRowStride=%{public}d, "
         "inputRowStride=%{public}d", outputBufferSize, inputBufferSize, outputRowStride, inputRowStride);
+    // hand the last intermediate buffer over to the output pixel map instead of copying it.
+    PixelMap *outputPixelMap = outputBuffer->bufferInfo_->pixelMap_;
+    if (outputBuffer->extraInfo_->dataType == DataType::PIXEL_MAP && outputPixelMap != nullptr &&
+        IsSameImageSize(outputPixelMap, inputBuffer) &&
+        CommonUtils::IsBufferAdoptable(outputPixelMap, inputBuffer, context)) {
+        EFFECT_LOGD("Adopt buffer to output pixel map.");
+        return CommonUtils::ModifyPixelMapProperty(outputPixelMap, inputBuffer, context);
+    }
+
     // update nativePixelMap
     if (inputBuffer->extraInfo_->dataType == DataType::TEX) {
         context->renderEnvironment_->ConvertTextureToBuffer(inputBuffer->bufferInfo_->tex_, outputBuffer.get(), true);
@@ -1113,6 +1145,7 @@ ErrorCode ImageSinkFilter::PushData(const std::string &inPort, const std::shared
     std::shared_ptr<EffectContext> &context)
 {
     EFFECT_LOGD("image sink effect push data started, state: %{public}d", state_.load());
+    EffectProfileScope profileScope(context->renderProfile_.get(), ProfileStage::SINK, name_);
     EffectBuffer *output = nullptr;
     if (sinkBuffer_ != nullptr) {
         output = sinkBuffer_.get();
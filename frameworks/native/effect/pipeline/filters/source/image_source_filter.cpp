@@ -150,6 +150,8 @@ ErrorCode ImageSourceFilter::DoNegotiate()
         HdrFormat::HDR8_GAINMAP,
         HdrFormat::HDR10
     };
+    context_->hasColorSpaceFilter_ = false;
+    context_->isColorSpaceAgnosticHead_ = false;
     context_->cacheNegotiate_->ClearConfig();
 
     if (outPorts_[0] == nullptr) {
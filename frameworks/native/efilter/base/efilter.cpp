@@ -23,9 +23,11 @@
 #include "memcpy_helper.h"
 #include "format_helper.h"
 #include "colorspace_helper.h"
+#include "cpu_colorspace_converter.h"
 #include "render_thread.h"
 #include "render_task.h"
 #include "render_environment.h"
+#include "render_perf_stats.h"
 
 namespace OHOS {
 namespace Media {
@@ -34,7 +36,8 @@ const std::string EFilter::Parameter::KEY_DEFAULT_VALUE = "default_value";
 const std::string START_CACHE_CONFIG = "START_CACHE";
 const std::string CANCEL_CACHE_CONFIG = "CANCEL_CACHE";
 
-EFilter::EFilter(const std::string &name) : EFilterBase(name)
+EFilter::EFilter(const std::string &name)
+    : EFilterBase(name), valuesVersion_(NextValuesVersion()), nameHash_(std::hash<std::string>()(name_))
 {
     cacheConfig_ = std::make_shared<EFilterCacheConfig>();
 }
@@ -52,14 +55,31 @@ ErrorCode EFilter::ProcessConfig(const std::string &key)
     return ErrorCode::SUCCESS;
 }
 
+void EFilter::BindParamBlock(const EFilterParamSchema *schema, void *block)
+{
+    paramSchema_ = schema;
+    paramData_ = block;
+    setParams_ = 0;
+    dirtyParams_.store(0, std::memory_order_release);
+}
+
 ErrorCode EFilter::SetValue(const std::string &key, Any &value)
 {
+    const EFilterParamDesc *desc = paramSchema_ != nullptr ? paramSchema_->Find(key) : nullptr;
+    if (desc != nullptr) {
+        ErrorCode res = EFilterParamSchema::Write(*desc, value, paramData_);
+        CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "write param fail! key=%{public}s, filter=%{public}s",
+            key.c_str(), name_.c_str());
+        setParams_ |= EFilterParamSchema::ToMask(desc->index_);
+        dirtyParams_.fetch_or(EFilterParamSchema::ToMask(desc->index_), std::memory_order_acq_rel);
+    }
     auto it = values_.find(key);
     if (it == values_.end()) {
         values_.emplace(key, value);
     } else {
         values_[key] = value;
     }
+    valuesVersion_.store(NextValuesVersion(), std::memory_order_release);
     return ErrorCode::SUCCESS;
 }
 
@@ -83,6 +103,22 @@ bool EFilter::IsTextureInput()
     return false;
 }
 
+bool EFilter::IsInPlaceSupported()
+{
+    return true;
+}
+
+bool EFilter::IsRegionSupported()
+{
+    return false;
+}
+
+uint64_t EFilter::NextValuesVersion()
+{
+    static std::atomic<uint64_t> version { 0 };
+    return version.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
 ErrorCode EFilter::Save(EffectJsonPtr &res)
 {
     res->Put("name", name_);
@@ -109,14 +145,14 @@ ErrorCode EFilter::PreRender(IEffectFormat &format)
     return ErrorCode::SUCCESS;
 }
 
-std::shared_ptr<PixelFormatCap> GetPixelFormatCap(std::string &name)
+std::shared_ptr<PixelFormatCap> GetPixelFormatCap(const EFilterKey &key)
 {
     std::shared_ptr<PixelFormatCap> pixelFormatCap = std::make_shared<PixelFormatCap>();
     CHECK_AND_RETURN_RET_LOG(pixelFormatCap != nullptr, pixelFormatCap,
-        "GetPixelFormatCap: PixelFormatCap fail! name=%{public}s", name.c_str());
-    std::shared_ptr<EffectInfo> effectInfo = EFilterFactory::Instance()->GetEffectInfo(name);
+        "GetPixelFormatCap: PixelFormatCap fail! name=%{public}s", key.name_->c_str());
+    std::shared_ptr<EffectInfo> effectInfo = EFilterFactory::Instance()->GetEffectInfo(key);
     if (effectInfo == nullptr) {
-        EFFECT_LOGE("GetPixelFormatCap: GetEffectInfo fail! name=%{public}s", name.c_str());
+        EFFECT_LOGE("GetPixelFormatCap: GetEffectInfo fail! name=%{public}s", key.name_->c_str());
         return pixelFormatCap;
     }
 
@@ -124,12 +160,12 @@ std::shared_ptr<PixelFormatCap> GetPixelFormatCap(std::string &name)
     return pixelFormatCap;
 }
 
-std::shared_ptr<HdrFormatCap> GetHdrFormatCap(std::string &name)
+std::shared_ptr<HdrFormatCap> GetHdrFormatCap(const EFilterKey &key)
 {
     std::shared_ptr<HdrFormatCap> hdrFormatCap = std::make_shared<HdrFormatCap>();
-    std::shared_ptr<EffectInfo> effectInfo = EFilterFactory::Instance()->GetEffectInfo(name);
+    std::shared_ptr<EffectInfo> effectInfo = EFilterFactory::Instance()->GetEffectInfo(key);
     if (effectInfo == nullptr) {
-        EFFECT_LOGE("GetHdrFormatCap: GetEffectInfo fail! name=%{public}s", name.c_str());
+        EFFECT_LOGE("GetHdrFormatCap: GetEffectInfo fail! name=%{public}s", key.name_->c_str());
         return hdrFormatCap;
     }
 
@@ -137,12 +173,12 @@ std::shared_ptr<HdrFormatCap> GetHdrFormatCap(std::string &name)
     return hdrFormatCap;
 }
 
-std::shared_ptr<ColorSpaceCap> GetColorSpaceCap(std::string &name)
+std::shared_ptr<ColorSpaceCap> GetColorSpaceCap(const EFilterKey &key)
 {
     std::shared_ptr<ColorSpaceCap> colorSpaceCap = std::make_shared<ColorSpaceCap>();
-    std::shared_ptr<EffectInfo> effectInfo = EFilterFactory::Instance()->GetEffectInfo(name);
+    std::shared_ptr<EffectInfo> effectInfo = EFilterFactory::Instance()->GetEffectInfo(key);
     if (effectInfo == nullptr) {
-        EFFECT_LOGE("GetColorSpaceCap: GetEffectInfo fail! name=%{public}s", name.c_str());
+        EFFECT_LOGE("GetColorSpaceCap: GetEffectInfo fail! name=%{public}s", key.name_->c_str());
         return colorSpaceCap;
     }
 
@@ -150,6 +186,12 @@ std::shared_ptr<ColorSpaceCap> GetColorSpaceCap(std::string &name)
     return colorSpaceCap;
 }
 
+bool IsColorSpaceAgnostic(const EFilterKey &key)
+{
+    std::shared_ptr<EffectInfo> effectInfo = EFilterFactory::Instance()->GetEffectInfo(key);
+    return effectInfo != nullptr && effectInfo->isColorSpaceAgnostic_;
+}
+
 void NegotiateHdrFormat(std::vector<HdrFormat> &hdrFormats, std::unordered_set<HdrFormat> &filtersSupportedHDRFormat)
 {
     for (auto it = filtersSupportedHDRFormat.begin(); it != filtersSupportedHDRFormat.end();) {
@@ -176,17 +218,25 @@ void NegotiateColorSpace(std::vector<EffectColorSpace> &colorSpaces,
 void EFilter::Negotiate(const std::string &inPort, const std::shared_ptr<Capability> &capability,
     std::shared_ptr<EffectContext> &context)
 {
+    EFilterKey key(name_, nameHash_);
     std::shared_ptr<Capability> outputCap = std::make_shared<Capability>(name_);
-    outputCap->pixelFormatCap_ = GetPixelFormatCap(name_);
+    outputCap->pixelFormatCap_ = GetPixelFormatCap(key);
     outputCap->memNegotiatedCap_ = Negotiate(capability->memNegotiatedCap_, context);
-    outputCap->colorSpaceCap_ = GetColorSpaceCap(name_);
-    outputCap->hdrFormatCap_ = GetHdrFormatCap(name_);
+    outputCap->colorSpaceCap_ = GetColorSpaceCap(key);
+    outputCap->hdrFormatCap_ = GetHdrFormatCap(key);
     logStrategy_ = context->logStrategy_;
 
     context->capNegotiate_->AddCapability(outputCap);
     context->cacheNegotiate_->NegotiateConfig(cacheConfig_);
 
-    NegotiateColorSpace(outputCap->colorSpaceCap_->colorSpaces, context->filtersSupportedColorSpace_);
+    isColorSpaceConvertPoint_ = false;
+    if (IsColorSpaceAgnostic(key)) {
+        context->isColorSpaceAgnosticHead_ = context->isColorSpaceAgnosticHead_ || !context->hasColorSpaceFilter_;
+    } else {
+        isColorSpaceConvertPoint_ = !context->hasColorSpaceFilter_;
+        context->hasColorSpaceFilter_ = true;
+        NegotiateColorSpace(outputCap->colorSpaceCap_->colorSpaces, context->filtersSupportedColorSpace_);
+    }
     NegotiateHdrFormat(outputCap->hdrFormatCap_->hdrFormats, context->filtersSupportedHdrFormat_);
     EFFECT_LOGD("Negotiate::filtersSupportedHdrFormat count: %{public}d, colorSpace count: %{public}d",
         static_cast<int>(context->filtersSupportedHdrFormat_.size()),
@@ -233,7 +283,7 @@ std::shared_ptr<EffectBuffer> EFilter::IpTypeConvert(const std::shared_ptr<Effec
 {
     IPType runningIPType = context->ipType_;
     IEffectFormat formatType = buffer->bufferInfo_->formatType_;
-    std::shared_ptr<PixelFormatCap> pixelFormatCap = GetPixelFormatCap(name_);
+    std::shared_ptr<PixelFormatCap> pixelFormatCap = GetPixelFormatCap(EFilterKey(name_, nameHash_));
     std::map<IEffectFormat, std::vector<IPType>> &formats = pixelFormatCap->formats;
     auto it = formats.find(formatType);
     if (it == formats.end() && runningIPType == IPType::CPU) {
@@ -375,6 +425,26 @@ std::shared_ptr<EffectBuffer> EFilter::ConvertFromCPU2GPU(const std::shared_ptr<
     return source;
 }
 
+template <typename RenderFunc>
+ErrorCode RenderWithStats(const std::string &filterName, std::shared_ptr<EffectContext> &context, IPType ipType,
+    const EffectBuffer *buffer, uint64_t allocBytes, RenderFunc &&render)
+{
+    uint32_t len = 0;
+    uint32_t format = 0;
+    if (buffer != nullptr && buffer->bufferInfo_ != nullptr) {
+        len = buffer->bufferInfo_->len_;
+        format = static_cast<uint32_t>(buffer->bufferInfo_->formatType_);
+    }
+    EffectProfileScope profileScope(context->renderProfile_.get(), ProfileStage::FILTER_RENDER, filterName);
+    if (profileScope.IsEnabled()) {
+        profileScope.SetBytes(len);
+        profileScope.SetDetail("ipType=" + std::to_string(static_cast<int32_t>(ipType)) +
+            ",format=" + std::to_string(format));
+    }
+    RenderPerfScope perfScope(filterName, format, static_cast<uint32_t>(ipType), len, allocBytes);
+    return render();
+}
+
 void EFilter::HandleCacheStart(const std::shared_ptr<EffectBuffer>& source, std::shared_ptr<EffectContext>& context)
 {
     if (cacheConfig_->GetStatus() == CacheStatus::CACHE_START && !context->cacheNegotiate_->HasCached()) {
@@ -383,9 +453,51 @@ void EFilter::HandleCacheStart(const std::shared_ptr<EffectBuffer>& source, std:
     }
 }
 
-ErrorCode EFilter::PushData(const std::string &inPort, const std::shared_ptr<EffectBuffer> &buffer,
+ErrorCode EFilter::ApplyPendingColorSpace(std::shared_ptr<EffectContext> &context,
+    std::shared_ptr<EffectBuffer> &buffer)
+{
+    EffectColorSpace colorSpace = context->pendingColorSpace_;
+    context->pendingColorSpace_ = EffectColorSpace::DEFAULT;
+    EFFECT_LOGD("ApplyPendingColorSpace: colorSpace=%{public}d, targetColorSpace=%{public}d, name=%{public}s",
+        buffer->bufferInfo_->colorSpace_, colorSpace, name_.c_str());
+    EffectProfileScope profileScope(context->renderProfile_.get(), ProfileStage::CONVERT_COLOR_SPACE, name_);
+
+    // The filters in front only moved pixels, the buffer is normally theirs and is converted in place.
+    std::shared_ptr<EffectBuffer> output = buffer;
+    std::shared_ptr<Memory> memory = context->memoryManager_->GetMemoryByAddr(buffer->buffer_);
+    if (memory != nullptr && !memory->isAllowModify_) {
+        std::shared_ptr<MemNegotiatedCap> memNegotiatedCap = std::make_shared<MemNegotiatedCap>();
+        memNegotiatedCap->width = buffer->bufferInfo_->width_;
+        memNegotiatedCap->height = buffer->bufferInfo_->height_;
+        memNegotiatedCap->format = buffer->bufferInfo_->formatType_;
+        ErrorCode res = AllocBuffer(context, memNegotiatedCap, buffer, output);
+        CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS && output != nullptr, ErrorCode::ERR_ALLOC_MEMORY_FAIL,
+            "ApplyPendingColorSpace: alloc buffer fail! res=%{public}d", res);
+    }
+
+    ErrorCode res = CpuColorSpaceConverter::Convert(buffer.get(), output.get(), colorSpace);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res,
+        "ApplyPendingColorSpace: convert fail! res=%{public}d, name=%{public}s", res, name_.c_str());
+    std::shared_ptr<Memory> outputMemory = context->memoryManager_->GetMemoryByAddr(output->buffer_);
+    if (outputMemory != nullptr) {
+        outputMemory->memoryData_->memoryInfo.bufferInfo.colorSpace_ = colorSpace;
+    }
+    buffer = output;
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode EFilter::PushData(const std::string &inPort, const std::shared_ptr<EffectBuffer> &input,
     std::shared_ptr<EffectContext> &context)
 {
+    ErrorCode cancelRes = context->CheckCanceled();
+    CHECK_AND_RETURN_RET_LOG(cancelRes == ErrorCode::SUCCESS, cancelRes,
+        "PushData: render canceled before filter! filterName=%{public}s, res=%{public}d", name_.c_str(), cancelRes);
+    std::shared_ptr<EffectBuffer> buffer = input;
+    if (isColorSpaceConvertPoint_ && context->pendingColorSpace_ != EffectColorSpace::DEFAULT) {
+        ErrorCode res = ApplyPendingColorSpace(context, buffer);
+        CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res,
+            "PushData: apply color space fail! filterName=%{public}s, res=%{public}d", name_.c_str(), res);
+    }
     bool needCache = context->cacheNegotiate_->needCache();
     if (needCache && context->cacheNegotiate_->HasCached() && !context->cacheNegotiate_->HasUseCache()) {
         if (cacheConfig_->GetStatus() == CacheStatus::CACHE_USED) {
@@ -404,16 +516,19 @@ ErrorCode EFilter::PushData(const std::string &inPort, const std::shared_ptr<Eff
             CacheBuffer(source.get(), context);
             cacheConfig_->SetStatus(CacheStatus::CACHE_ENABLED);
         }
-        ErrorCode res = Render(source.get(), context);
+        ErrorCode res = RenderWithStats(name_, context, runningIPType, source.get(), 0,
+            [this, &source, &context]() { return Render(source.get(), context); });
         return res;
     }
     CHECK_AND_RETURN_RET_LOG(outputCap_ != nullptr, ErrorCode::ERR_INPUT_NULL, "outputCap is null.");
     std::shared_ptr<MemNegotiatedCap> &memNegotiatedCap = outputCap_->memNegotiatedCap_;
-    EffectBuffer *output = preIPType != runningIPType ? source.get()
-        : context->renderStrategy_->ChooseBestOutput(source.get(), memNegotiatedCap);
+    bool isInPlaceSupported = IsInPlaceSupported();
+    EffectBuffer *output = preIPType != runningIPType ? (isInPlaceSupported ? source.get() : nullptr)
+        : context->renderStrategy_->ChooseBestOutput(source.get(), memNegotiatedCap, isInPlaceSupported);
     if (source.get() == output) {
         HandleCacheStart(source, context);
-        ErrorCode res = Render(source.get(), context);
+        ErrorCode res = RenderWithStats(name_, context, runningIPType, source.get(), 0,
+            [this, &source, &context]() { return Render(source.get(), context); });
         CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res,
             "Render input fail! filterName=%{public}s", name_.c_str());
         return ErrorCode::SUCCESS;
@@ -427,7 +542,12 @@ ErrorCode EFilter::PushData(const std::string &inPort, const std::shared_ptr<Eff
         output = effectBuffer.get();
     }
     HandleCacheStart(source, context);
-    ErrorCode res = Render(source.get(), output, context);
+    uint64_t allocBytes = 0;
+    if (effectBuffer != nullptr && effectBuffer->bufferInfo_ != nullptr) {
+        allocBytes = effectBuffer->bufferInfo_->len_;
+    }
+    ErrorCode res = RenderWithStats(name_, context, runningIPType, output, allocBytes,
+        [this, &source, output, &context]() { return Render(source.get(), output, context); });
     CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "Render inout fail! filterName=%{public}s", name_.c_str());
     return PushData(output, context);
 }
@@ -549,7 +669,7 @@ std::shared_ptr<MemNegotiatedCap> EFilter::Negotiate(const std::shared_ptr<MemNe
 
 ErrorCode EFilter::CalculateEFilterIPType(IEffectFormat &formatType, IPType &ipType)
 {
-    std::shared_ptr<PixelFormatCap> pixelFormatCap = GetPixelFormatCap(name_);
+    std::shared_ptr<PixelFormatCap> pixelFormatCap = GetPixelFormatCap(EFilterKey(name_, nameHash_));
     std::map<IEffectFormat, std::vector<IPType>> &formats = pixelFormatCap->formats;
     auto it = formats.find(formatType);
     CHECK_AND_RETURN_RET_LOG(it != formats.end(), ErrorCode::ERR_UNSUPPORTED_FORMAT_TYPE,
@@ -637,7 +757,7 @@ void GetSupportedHdrFormat(std::string &name, std::unordered_set<HdrFormat> &fil
         HdrFormat::HDR10
     };
 
-    std::shared_ptr<HdrFormatCap> hdrFormatCap = GetHdrFormatCap(name);
+    std::shared_ptr<HdrFormatCap> hdrFormatCap = GetHdrFormatCap(EFilterKey(name));
     NegotiateHdrFormat(hdrFormatCap->hdrFormats, filtersSupportedHDRFormat);
 }
 
@@ -648,7 +768,7 @@ void GetSupportedColorSpace(std::string &name, std::unordered_set<EffectColorSpa
         filtersSupportedColorSpace.emplace(item);
     });
 
-    std::shared_ptr<ColorSpaceCap> colorSpaceCap = GetColorSpaceCap(name);
+    std::shared_ptr<ColorSpaceCap> colorSpaceCap = GetColorSpaceCap(EFilterKey(name));
     NegotiateColorSpace(colorSpaceCap->colorSpaces, filtersSupportedColorSpace);
 }
 
@@ -15,6 +15,10 @@
 
 #include "efilter_factory.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
 #include "custom_efilter.h"
 #include "effect_log.h"
 #include "external_loader.h"
@@ -23,6 +27,23 @@
 namespace OHOS {
 namespace Media {
 namespace Effect {
+namespace {
+int64_t GetNowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Snapshot last read by this thread. Lookups compare its version with the published one and take the mutex only after
+// a registration, so the common path neither locks nor touches the shared reference count. A replaced snapshot, and
+// the delegates in it, stays alive until every thread which read it has looked up again or exited.
+struct RegistryCache {
+    uint64_t version_ = 0;
+    std::shared_ptr<const EFilterRegistry> registry_;
+};
+
+thread_local RegistryCache g_registryCache;
+} // namespace
 
 EFilterFactory *EFilterFactory::Instance()
 {
@@ -30,15 +51,58 @@ EFilterFactory *EFilterFactory::Instance()
     return &instance;
 }
 
-EFilterFactory::~EFilterFactory()
+EFilterFactory::EFilterFactory() : registry_(std::make_shared<EFilterRegistry>()), registryVersion_(1)
+{
+}
+
+EFilterFactory::~EFilterFactory() = default;
+
+const EFilterRegistry &EFilterFactory::GetRegistry() const
+{
+    if (g_registryCache.version_ != registryVersion_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        g_registryCache.registry_ = registry_;
+        g_registryCache.version_ = registryVersion_.load(std::memory_order_relaxed);
+    }
+    return *g_registryCache.registry_;
+}
+
+EFilterKey EFilterFactory::InternName(const std::string &name)
 {
-    ClearFunctions();
+    return EFilterKey(*effectNames_.emplace(name).first);
+}
+
+void EFilterFactory::UpdateRegistry(const std::function<void(EFilterRegistry &registry)> &update)
+{
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    std::shared_ptr<EFilterRegistry> registry = std::make_shared<EFilterRegistry>(*registry_);
+    update(*registry);
+    registry->names_.clear();
+    registry->names_.reserve(registry->functions_.size());
+    for (const auto &function : registry->functions_) {
+        registry->names_.emplace_back(function.first.name_->c_str());
+    }
+    std::sort(registry->names_.begin(), registry->names_.end(),
+        [](const char *left, const char *right) { return strcmp(left, right) < 0; });
+    registry_ = std::move(registry);
+    uint64_t version = registryVersion_.load(std::memory_order_relaxed) + 1;
+    registryVersion_.store(version, std::memory_order_release);
+    // Let go of the replaced snapshot on this thread right away, a delegate cleared here is released here.
+    g_registryCache.registry_ = registry_;
+    g_registryCache.version_ = version;
 }
 
 void EFilterFactory::ClearFunctions()
 {
-    std::lock_guard<std::recursive_mutex> lock(functionsMutex_);
-    functions_.clear();
+    UpdateRegistry([](EFilterRegistry &registry) { registry.functions_.clear(); });
+}
+
+void EFilterFactory::ClearDelegates()
+{
+    UpdateRegistry([](EFilterRegistry &registry) {
+        registry.delegates_.clear();
+        registry.delegateInfos_.clear();
+    });
 }
 
 void EFilterFactory::RegisterFunction(const std::string &name, const EFilterFunction &function)
@@ -46,16 +110,24 @@ void EFilterFactory::RegisterFunction(const std::string &name, const EFilterFunc
     EFFECT_LOGI("register efilter. name=%{public}s", name.c_str());
     CHECK_AND_RETURN_LOG(name.c_str() != nullptr,
         "RegisterFunction: register RegisterFunction name fail! name=%{public}s", name.c_str());
-    std::lock_guard<std::recursive_mutex> lock(functionsMutex_);
-    auto it = functions_.find(name);
-    if (it == functions_.end()) {
-        auto result = functions_.emplace(name, function);
-        if (!result.second) {
-            result.first->second = function;
-        }
-    } else {
-        functions_[name] = function;
-    }
+    int64_t beginNs = GetNowNs();
+    UpdateRegistry([this, &name, &function](EFilterRegistry &registry) {
+        registry.functions_[InternName(name)] = function;
+    });
+    AddRegisterCost(beginNs);
+}
+
+void EFilterFactory::AddRegisterCost(int64_t beginNs)
+{
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    registerStats_.count_++;
+    registerStats_.costNs_ += GetNowNs() - beginNs;
+}
+
+EFilterRegisterStats EFilterFactory::GetRegisterStats() const
+{
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    return registerStats_;
 }
 
 void EFilterFactory::RegisterDelegate(const std::string &name, const std::shared_ptr<IFilterDelegate> &delegate,
@@ -63,26 +135,35 @@ void EFilterFactory::RegisterDelegate(const std::string &name, const std::shared
 {
     EFFECT_LOGI("register delegate. name=%{public}s", name.c_str());
     ExternLoader::Instance()->InitExt();
-    RegisterEFilter<CustomEFilter>(name);
-
-    CustomEFilter::SetEffectInfo(name, effectInfo);
-    std::lock_guard<std::recursive_mutex> lock(delegatesMutex_);
-    auto it = delegates_.find(name);
-    if (it == delegates_.end()) {
-        auto result = delegates_.emplace(name, delegate);
-        if (!result.second) {
-            result.first->second = delegate;
-        }
-    } else {
-        delegates_[name] = delegate;
-    }
+    int64_t beginNs = GetNowNs();
+    CustomEFilter::SetEffectInfo(effectInfo);
+    // The function, the delegate and its info go out in the same snapshot, a lookup in between would create a custom
+    // filter without its delegate.
+    EFilterFunction function = GetFunction<CustomEFilter>();
+    UpdateRegistry([this, &name, &function, &delegate, &effectInfo](EFilterRegistry &registry) {
+        EFilterKey key = InternName(name);
+        registry.functions_[key] = function;
+        registry.delegates_[key] = delegate;
+        registry.delegateInfos_[key] = effectInfo;
+    });
+    AddRegisterCost(beginNs);
 }
 
 std::shared_ptr<IFilterDelegate> EFilterFactory::GetDelegate(const std::string &name)
 {
-    std::lock_guard<std::recursive_mutex> lock(delegatesMutex_);
-    auto it = delegates_.find(name);
-    if (it != delegates_.end()) {
+    const EFilterRegistry &registry = GetRegistry();
+    auto it = registry.delegates_.find(EFilterKey(name));
+    if (it != registry.delegates_.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+std::shared_ptr<EffectInfo> EFilterFactory::GetDelegateInfo(const std::string &name)
+{
+    const EFilterRegistry &registry = GetRegistry();
+    auto it = registry.delegateInfos_.find(EFilterKey(name));
+    if (it != registry.delegateInfos_.end()) {
         return it->second;
     }
     return nullptr;
@@ -107,19 +188,52 @@ std::shared_ptr<EFilter> EFilterFactory::Restore(const std::string &name, const
     return efilter;
 }
 
+std::shared_ptr<EFilter> EFilterFactory::Restore(const EffectFilterPrototype &prototype, void *handler)
+{
+    const std::string &name = prototype.name_;
+    std::shared_ptr<EFilter> efilter = EFilterFactory::Instance()->Create(name, handler);
+    CHECK_AND_RETURN_RET_LOG(efilter != nullptr, nullptr, "Restore: create filter fail! name=%{public}s", name.c_str());
+    for (const auto &value : prototype.values_) {
+        Any any = value.second;
+        ErrorCode res = efilter->SetValue(value.first, any);
+        CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, nullptr,
+            "Restore: set value fail! name=%{public}s, key=%{public}s, res=%{public}d", name.c_str(),
+            value.first.c_str(), res);
+    }
+    return efilter;
+}
+
+std::shared_ptr<EFilter> EFilterFactory::Clone(const std::shared_ptr<EFilter> &efilter, void *handler)
+{
+    CHECK_AND_RETURN_RET_LOG(efilter != nullptr, nullptr, "Clone: input efilter is null!");
+    const std::string &name = efilter->GetName();
+    std::shared_ptr<EFilter> clone = EFilterFactory::Instance()->Create(name, handler);
+    CHECK_AND_RETURN_RET_LOG(clone != nullptr, nullptr, "Clone: create filter fail! name=%{public}s", name.c_str());
+    // Values go through SetValue so that the delegate of a custom filter receives them as well.
+    for (const auto &value : efilter->GetValues()) {
+        Any any = value.second;
+        ErrorCode res = clone->SetValue(value.first, any);
+        CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, nullptr,
+            "Clone: set value fail! name=%{public}s, key=%{public}s, res=%{public}d", name.c_str(),
+            value.first.c_str(), res);
+    }
+    return clone;
+}
+
 std::shared_ptr<EFilter> EFilterFactory::Create(const std::string &name, void *handler)
 {
     ExternLoader::Instance()->InitExt();
     CHECK_AND_RETURN_RET_LOG(name.c_str() != nullptr, nullptr,
         "Create: register Create name fail! name=%{public}s", name.c_str());
+    // Both are read before the generator runs, a lookup made by the filter constructor may replace the snapshot.
+    const EFilterRegistry &registry = GetRegistry();
+    EFilterKey key(name);
     EFilterGenerator generator = nullptr;
-    {
-        std::lock_guard<std::recursive_mutex> lock(functionsMutex_);
-        auto it = functions_.find(name);
-        if (it != functions_.end()) {
-            generator = it->second.generator_;
-        }
+    auto it = registry.functions_.find(key);
+    if (it != registry.functions_.end()) {
+        generator = it->second.generator_;
     }
+    bool isCustom = registry.delegates_.find(key) != registry.delegates_.end();
 
     CHECK_AND_RETURN_RET_LOG(generator != nullptr, nullptr,
         "create effect fail! functions has no %{public}s", name.c_str());
@@ -128,37 +242,38 @@ std::shared_ptr<EFilter> EFilterFactory::Create(const std::string &name, void *h
     CHECK_AND_RETURN_RET_LOG(efilter != nullptr, nullptr,
         "create effect fail! generator returned nullptr for %{public}s", name.c_str());
 
-    if (GetDelegate(name)) {
+    if (isCustom) {
         static_cast<CustomEFilter *>(efilter.get())->SetHandler(handler);
     }
     return efilter;
 }
 
 std::shared_ptr<EffectInfo> EFilterFactory::GetEffectInfo(const std::string &name)
+{
+    return GetEffectInfo(EFilterKey(name));
+}
+
+std::shared_ptr<EffectInfo> EFilterFactory::GetEffectInfo(const EFilterKey &key)
 {
     ExternLoader::Instance()->InitExt();
 
+    const EFilterRegistry &registry = GetRegistry();
     EFilterInfoGetter infoGetter = nullptr;
-    {
-        std::lock_guard<std::recursive_mutex> lock(functionsMutex_);
-        auto it = functions_.find(name);
-        if (it != functions_.end()) {
-            infoGetter = it->second.infoGetter_;
-        }
+    auto it = registry.functions_.find(key);
+    if (it != registry.functions_.end()) {
+        infoGetter = it->second.infoGetter_;
     }
 
     CHECK_AND_RETURN_RET_LOG(infoGetter != nullptr, nullptr,
-        "get effect info fail! functions has no %{public}s", name.c_str());
+        "get effect info fail! functions has no %{public}s", key.name_->c_str());
 
-    return infoGetter(name);
+    return infoGetter(*key.name_);
 }
 
 void EFilterFactory::GetAllEffectNames(std::vector<const char *> &names)
 {
-    std::lock_guard<std::recursive_mutex> lock(functionsMutex_);
-    for (const auto &pair : functions_) {
-        names.push_back(pair.first.c_str());
-    }
+    const EFilterRegistry &registry = GetRegistry();
+    names.insert(names.end(), registry.names_.begin(), registry.names_.end());
 }
 } // namespace Effect
 } // namespace Media
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "efilter_param_schema.h"
+
+#include "effect_log.h"
+#include "effect_type.h"
+#include "securec.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace {
+template <typename T>
+ErrorCode WriteField(const Any &value, void *block, size_t offset)
+{
+    auto valuePtr = AnyCast<T>(&value);
+    CHECK_AND_RETURN_RET_LOG(valuePtr != nullptr, ErrorCode::ERR_ANY_CAST_TYPE_NOT_MATCH,
+        "WriteField: the type of the value does not match the schema!");
+    errno_t res = memcpy_s(static_cast<uint8_t *>(block) + offset, sizeof(T), valuePtr, sizeof(T));
+    CHECK_AND_RETURN_RET_LOG(res == 0, ErrorCode::ERR_MEMCPY_FAIL, "WriteField: memcpy fail! res=%{public}d", res);
+    return ErrorCode::SUCCESS;
+}
+} // namespace
+
+ErrorCode EFilterParamSchema::Add(const std::string &key, EFilterParamType type, size_t offset)
+{
+    CHECK_AND_RETURN_RET_LOG(!key.empty(), ErrorCode::ERR_INPUT_NULL, "Add: the key is empty!");
+    CHECK_AND_RETURN_RET_LOG(params_.size() < MAX_PARAM_NUM, ErrorCode::ERR_VALUE_OUT_OF_RANGE,
+        "Add: too many parameters! key=%{public}s", key.c_str());
+    CHECK_AND_RETURN_RET_LOG(indexes_.find(key) == indexes_.end(), ErrorCode::ERR_INVALID_OPERATION,
+        "Add: the key is already added! key=%{public}s", key.c_str());
+
+    EFilterParamDesc desc;
+    desc.key_ = key;
+    desc.type_ = type;
+    desc.offset_ = offset;
+    desc.index_ = static_cast<uint32_t>(params_.size());
+    indexes_.emplace(key, desc.index_);
+    params_.emplace_back(std::move(desc));
+    return ErrorCode::SUCCESS;
+}
+
+const EFilterParamDesc *EFilterParamSchema::Find(const std::string &key) const
+{
+    auto it = indexes_.find(key);
+    return it == indexes_.end() ? nullptr : &params_[it->second];
+}
+
+ErrorCode EFilterParamSchema::Write(const EFilterParamDesc &desc, const Any &value, void *block)
+{
+    CHECK_AND_RETURN_RET_LOG(block != nullptr, ErrorCode::ERR_INPUT_NULL, "Write: the block is null!");
+    switch (desc.type_) {
+        case EFilterParamType::FLOAT:
+            return WriteField<float>(value, block, desc.offset_);
+        case EFilterParamType::INT32:
+            return WriteField<int32_t>(value, block, desc.offset_);
+        case EFilterParamType::UINT32:
+            return WriteField<uint32_t>(value, block, desc.offset_);
+        case EFilterParamType::REGION:
+            return WriteField<RenderRegion>(value, block, desc.offset_);
+        default:
+            EFFECT_LOGE("Write: unsupported param type! type=%{public}d, key=%{public}s", desc.type_,
+                desc.key_.c_str());
+            return ErrorCode::ERR_INVALID_PARAMETER_TYPE;
+    }
+}
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
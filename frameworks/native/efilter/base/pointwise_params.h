@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_POINTWISE_PARAMS_H
+#define IMAGE_EFFECT_POINTWISE_PARAMS_H
+
+#include <memory>
+
+#include "effect_buffer.h"
+#include "effect_context.h"
+#include "effect_type.h"
+#include "error_code.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+constexpr uint32_t POINTWISE_LUT_SIZE = 256;
+
+// Parameter struct of the pointwise filters with an intensity and a region, Brightness and Contrast.
+struct PointwiseParamBlock {
+    enum Index : uint32_t {
+        INTENSITY = 0,
+        REGION,
+    };
+
+    float intensity_ = 0.f;
+    RenderRegion region_;
+};
+
+// What the algorithms read on each frame. The region is null when the filter has none, the lut is the one of the
+// intensity when the filter keeps it, the algorithm builds it otherwise.
+struct PointwiseParams {
+    float intensity_ = 0.f;
+    const RenderRegion *region_ = nullptr;
+    const uint8_t *lut_ = nullptr;
+};
+
+using PointwiseApplyFunc = ErrorCode (*)(EffectBuffer *src, EffectBuffer *dst, const PointwiseParams &params,
+    std::shared_ptr<EffectContext> &context);
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+#endif // IMAGE_EFFECT_POINTWISE_PARAMS_H
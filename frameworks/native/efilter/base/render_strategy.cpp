@@ -61,15 +61,23 @@ EffectBuffer *ChooseBufOnSetInOutput(EffectBuffer *buffer, EffectBuffer *src, Ef
 }
 
 EffectBuffer *RenderStrategy::ChooseBestOutput(EffectBuffer *buffer,
-    std::shared_ptr<MemNegotiatedCap> &memNegotiatedCap)
+    std::shared_ptr<MemNegotiatedCap> &memNegotiatedCap, bool isInPlaceSupported)
 {
     CHECK_AND_RETURN_RET_LOG(src_ != nullptr && buffer != nullptr, buffer,
         "src or input buffer is null! src_=%{public}d", src_ == nullptr);
+    EffectBuffer *output = nullptr;
     if (dst_ == nullptr || dst_->buffer_ == nullptr || src_->buffer_ == dst_->buffer_
         || dst_->extraInfo_->dataType == DataType::NATIVE_WINDOW) {
-        return ChooseBufOnSetInput(buffer, src_.get(), memNegotiatedCap);
+        output = ChooseBufOnSetInput(buffer, src_.get(), memNegotiatedCap);
+    } else {
+        output = ChooseBufOnSetInOutput(buffer, src_.get(), dst_.get(), memNegotiatedCap);
+    }
+
+    // An out-of-place filter renders into a new buffer rather than into a copy of its input.
+    if (!isInPlaceSupported && output == buffer) {
+        return nullptr;
     }
-    return ChooseBufOnSetInOutput(buffer, src_.get(), dst_.get(), memNegotiatedCap);
+    return output;
 }
 
 EffectBuffer *RenderStrategy::GetInput()
@@ -29,7 +29,9 @@ public:
 
     void Init(const std::shared_ptr<EffectBuffer> &src, const std::shared_ptr<EffectBuffer> &dst);
 
-    EffectBuffer *ChooseBestOutput(EffectBuffer *buffer, std::shared_ptr<MemNegotiatedCap> &memNegotiatedCap);
+    // Return the buffer to render into, the input buffer itself for in-place rendering or nullptr to allocate one.
+    EffectBuffer *ChooseBestOutput(EffectBuffer *buffer, std::shared_ptr<MemNegotiatedCap> &memNegotiatedCap,
+        bool isInPlaceSupported = true);
 
     EffectBuffer *GetInput();
 
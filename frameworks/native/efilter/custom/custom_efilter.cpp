@@ -21,9 +21,6 @@
 namespace OHOS {
 namespace Media {
 namespace Effect {
-std::map<std::string, std::shared_ptr<EffectInfo>> CustomEFilter::effectInfos_;
-std::mutex CustomEFilter::effectInfosMutex_;
-
 ErrorCode CustomEFilter::Render(EffectBuffer *src, EffectBuffer *dst, std::shared_ptr<EffectContext> &context)
 {
     CHECK_AND_RETURN_RET_LOG(delegate_ != nullptr, ErrorCode::ERR_INPUT_NULL, "delegate_ is null");
@@ -44,6 +41,11 @@ ErrorCode CustomEFilter::Render(EffectBuffer *buffer, std::shared_ptr<EffectCont
     return ErrorCode::SUCCESS;
 }
 
+bool CustomEFilter::IsInPlaceSupported()
+{
+    return delegate_ == nullptr || delegate_->IsInPlaceSupported();
+}
+
 ErrorCode CustomEFilter::SetValue(const std::string &key, Any &value)
 {
     CHECK_AND_RETURN_RET_LOG(delegate_ != nullptr, ErrorCode::ERR_INPUT_NULL, "delegate_ is null");
@@ -82,26 +84,23 @@ ErrorCode CustomEFilter::Restore(const EffectJsonPtr &value)
     return ErrorCode::SUCCESS;
 }
 
-void CustomEFilter::SetEffectInfo(const std::string &name, const std::shared_ptr<EffectInfo> &effectInfo)
+void CustomEFilter::SetEffectInfo(const std::shared_ptr<EffectInfo> &effectInfo)
 {
-    std::unique_lock<std::mutex> lock(effectInfosMutex_);
     effectInfo->colorSpaces_.clear();
     std::unordered_set<EffectColorSpace> allSupportedColorSpaces = ColorSpaceManager::GetAllSupportedColorSpaces();
     std::for_each(allSupportedColorSpaces.begin(), allSupportedColorSpaces.end(), [&](const auto &item) {
         effectInfo->colorSpaces_.emplace_back(item);
     });
-    effectInfos_[name] = effectInfo;
 }
 
 std::shared_ptr<EffectInfo> CustomEFilter::GetEffectInfo(const std::string &name)
 {
-    std::unique_lock<std::mutex> lock(effectInfosMutex_);
-    auto it = effectInfos_.find(name);
-    if (it == effectInfos_.end()) {
+    std::shared_ptr<EffectInfo> effectInfo = EFilterFactory::Instance()->GetDelegateInfo(name);
+    if (effectInfo == nullptr) {
         EFFECT_LOGE("effect info not find! name=%{public}s", name.c_str());
         return nullptr;
     }
-    return it->second;
+    return effectInfo;
 }
 } // namespace Effect
 } // namespace Media
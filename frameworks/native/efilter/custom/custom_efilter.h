@@ -17,7 +17,6 @@
 #define IMAGE_EFFECT_CUSTOM_EFILTER_H
 
 #include <string>
-#include <mutex>
 
 #include "any.h"
 #include "effect_log.h"
@@ -47,7 +46,10 @@ public:
 
     ErrorCode Restore(const EffectJsonPtr &value) override;
 
-    static void SetEffectInfo(const std::string &name, const std::shared_ptr<EffectInfo> &effectInfo);
+    bool IsInPlaceSupported() override;
+
+    // Completes the effect info given with a delegate, the factory keeps it with the delegate.
+    static void SetEffectInfo(const std::shared_ptr<EffectInfo> &effectInfo);
 
     static std::shared_ptr<EffectInfo> GetEffectInfo(const std::string &name);
 
@@ -59,8 +61,6 @@ public:
 private:
     std::shared_ptr<IFilterDelegate> delegate_;
     void *handler_ = nullptr;
-    static std::map<std::string, std::shared_ptr<EffectInfo>> effectInfos_;
-    static std::mutex effectInfosMutex_;
 };
 } // namespace Effect
 } // namespace Media
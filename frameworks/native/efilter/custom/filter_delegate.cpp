@@ -15,6 +15,10 @@
 
 #include "filter_delegate.h"
 
+#include <algorithm>
+#include <atomic>
+#include <new>
+
 #include "common_utils.h"
 #include "effect_log.h"
 #include "efilter.h"
@@ -25,6 +29,7 @@
 #include "event_report.h"
 #include "graphic/render_texture.h"
 #include "render_environment.h"
+#include "render_executor.h"
 
 namespace OHOS {
 namespace Media {
@@ -32,6 +37,8 @@ namespace Effect {
 constexpr char const *PARA_SRC_EFFECT_BUFFER = "PARA_SRC_EFFECT_BUFFER";
 constexpr char const *PARA_RENDER_WITH_SRC_AND_DST = "PARA_RENDER_WITH_SRC_AND_DST";
 constexpr char const *PARA_RENDER_INFO = "PARA_RENDER_INFO";
+// Regions smaller than this are not worth a hand over to the render workers.
+constexpr uint64_t PARALLEL_RENDER_MIN_PIXELS_PER_REGION = 256 * 1024;
 
 bool FilterDelegate::Render(void *efilter, EffectBuffer *src, EffectBuffer *dst,
     std::shared_ptr<EffectContext> &context)
@@ -40,6 +47,11 @@ bool FilterDelegate::Render(void *efilter, EffectBuffer *src, EffectBuffer *dst,
     OH_EffectFilter *ohEFilter = (OH_EffectFilter *)efilter;
     CHECK_AND_RETURN_RET_LOG(ohEFilter != nullptr && ohEFilter->filter_ != nullptr, false,
         "FilterDelegateRender: filter is null!");
+    if (IsRenderWithDst(src)) {
+        // The filter writes dst by itself, so the input is not copied into dst first.
+        return RenderWithDst(ohEFilter, src, dst, context);
+    }
+
     Any param = true;
     ohEFilter->SetParameter(PARA_RENDER_WITH_SRC_AND_DST, param);
     Any any = context;
@@ -59,21 +71,17 @@ bool FilterDelegate::Render(void *efilter, EffectBuffer *src, EffectBuffer *dst,
 bool FilterDelegate::Render(void *efilter, EffectBuffer *src, std::shared_ptr<EffectContext> &context)
 {
     EFFECT_LOGD("FilterDelegate Render.");
-    std::unique_ptr<OH_EffectBufferInfo> srcBuffer = std::make_unique<OH_EffectBufferInfo>();
-    srcBuffer->addr = src->buffer_;
-    if (src->bufferInfo_->tex_ != nullptr) {
-        srcBuffer->textureId = static_cast<int32_t>(src->bufferInfo_->tex_->GetName());
-    }
-
-    srcBuffer->width = static_cast<int32_t>(src->bufferInfo_->width_);
-    srcBuffer->height = static_cast<int32_t>(src->bufferInfo_->height_);
-    srcBuffer->rowSize = static_cast<int32_t>(src->bufferInfo_->rowStride_);
-    NativeCommonUtils::SwitchToOHFormatType(src->bufferInfo_->formatType_, srcBuffer->format);
-    srcBuffer->timestamp = src->extraInfo_->timestamp;
-
     OH_EffectFilter *ohEFilter = static_cast<OH_EffectFilter *>(efilter);
     CHECK_AND_RETURN_RET_LOG(ohEFilter != nullptr && ohEFilter->filter_ != nullptr, false,
         "FilterDelegateRender: filter is null!");
+    if (IsRenderWithDst(src)) {
+        bool res = IsInPlaceSupported() ? RenderWithDst(ohEFilter, src, src, context) :
+            RenderFromCopy(ohEFilter, src, context);
+        CHECK_AND_RETURN_RET_LOG(res, false, "FilterDelegateRender: render with dst fail!");
+        return ohEFilter->filter_->PushData(src, context) == ErrorCode::SUCCESS;
+    }
+
+    std::unique_ptr<OH_EffectBufferInfo> srcBuffer = GenOHBufferInfo(src);
 
     Any any = src;
     ohEFilter->SetParameter(PARA_SRC_EFFECT_BUFFER, any);
@@ -85,14 +93,7 @@ bool FilterDelegate::Render(void *efilter, EffectBuffer *src, std::shared_ptr<Ef
     };
 
     bool res = ohDelegate_->render((OH_EffectFilter *)efilter, srcBuffer.get(), pushData);
-    BufferType bufferType = src->bufferInfo_->bufferType_;
-    if (bufferType == BufferType::DMA_BUFFER) {
-        auto pixelMap = src->bufferInfo_->pixelMap_;
-        if (pixelMap && pixelMap->GetFd()) {
-            src->bufferInfo_->surfaceBuffer_ = reinterpret_cast<SurfaceBuffer *>(pixelMap->GetFd());
-        }
-        FlushCacheIfNeed(src);
-    }
+    FlushDmaCacheIfNeed(src);
 
     ohEFilter->RemoveParameter(PARA_SRC_EFFECT_BUFFER);
     ohEFilter->RemoveParameter(PARA_RENDER_INFO);
@@ -135,6 +136,118 @@ void *FilterDelegate::GetEffectInfo()
     return &ohInfo_;
 }
 
+bool FilterDelegate::IsInPlaceSupported()
+{
+    if (renderRegion_ != nullptr) {
+        // The regions are rendered at the same time, so a region must not read the pixels written by another one.
+        return ohInfo_.renderHalo == 0;
+    }
+    return renderWithDst_ == nullptr || ohInfo_.renderMode != ImageEffect_RenderMode::EFFECT_RENDER_MODE_SRC_TO_DST;
+}
+
+bool FilterDelegate::IsRenderWithDst(const EffectBuffer *src) const
+{
+    if (src->extraInfo_->dataType == DataType::TEX) {
+        return false;
+    }
+    return renderRegion_ != nullptr ||
+        (renderWithDst_ != nullptr && ohInfo_.renderMode != ImageEffect_RenderMode::EFFECT_RENDER_MODE_IN_PLACE);
+}
+
+bool FilterDelegate::RenderWithDst(OH_EffectFilter *ohEFilter, EffectBuffer *src, EffectBuffer *dst,
+    std::shared_ptr<EffectContext> &context)
+{
+    EFFECT_LOGD("FilterDelegate RenderWithDst. inPlace=%{public}d", src == dst);
+    std::unique_ptr<OH_EffectBufferInfo> srcBuffer = GenOHBufferInfo(src);
+    std::unique_ptr<OH_EffectBufferInfo> dstBuffer = src == dst ? nullptr : GenOHBufferInfo(dst);
+    Any parameter = context;
+    ohEFilter->SetParameter(PARA_RENDER_INFO, parameter);
+
+    OH_EffectBufferInfo *dstInfo = dstBuffer == nullptr ? srcBuffer.get() : dstBuffer.get();
+    bool res = renderRegion_ != nullptr ? RenderRegions(ohEFilter, srcBuffer.get(), dstInfo) :
+        renderWithDst_(ohEFilter, srcBuffer.get(), dstInfo);
+    FlushDmaCacheIfNeed(dst);
+
+    ohEFilter->RemoveParameter(PARA_RENDER_INFO);
+    return res;
+}
+
+bool FilterDelegate::RenderRegions(OH_EffectFilter *ohEFilter, OH_EffectBufferInfo *src, OH_EffectBufferInfo *dst)
+{
+    RenderExecutor &executor = RenderExecutor::Instance();
+    uint32_t height = static_cast<uint32_t>(dst->height);
+    uint64_t pixels = static_cast<uint64_t>(dst->width) * height;
+    // Split the image into bands of whole rows, the calling thread renders one of them as well.
+    uint64_t regionNum = std::min<uint64_t>(pixels / PARALLEL_RENDER_MIN_PIXELS_PER_REGION,
+        executor.GetWorkerNum() + 1);
+    uint32_t taskNum = static_cast<uint32_t>(std::clamp<uint64_t>(regionNum, 1, std::max<uint32_t>(height / 2, 1)));
+    EFFECT_LOGD("FilterDelegate RenderRegions. width=%{public}d, height=%{public}u, taskNum=%{public}u", dst->width,
+        height, taskNum);
+
+    std::atomic<bool> res = true;
+    executor.ParallelFor(taskNum, [this, ohEFilter, src, dst, height, taskNum, &res](uint32_t task) {
+        // Even boundaries keep the chroma rows of a YUV image in one region.
+        auto bound = [height, taskNum](uint32_t index) {
+            return index == taskNum ? height :
+                static_cast<uint32_t>(static_cast<uint64_t>(height) * index / taskNum) & ~1u;
+        };
+        ImageEffect_Region region = { 0, static_cast<int32_t>(bound(task)), dst->width,
+            static_cast<int32_t>(bound(task + 1)) };
+        if (!renderRegion_(ohEFilter, src, dst, &region)) {
+            EFFECT_LOGE("FilterDelegate RenderRegions: render region fail! y0=%{public}d, y1=%{public}d", region.y0,
+                region.y1);
+            res.store(false);
+        }
+    });
+    return res.load();
+}
+
+bool FilterDelegate::RenderFromCopy(OH_EffectFilter *ohEFilter, EffectBuffer *buffer,
+    std::shared_ptr<EffectContext> &context)
+{
+    // The filter can not run in place, so it reads from a heap copy of the input and writes back to the buffer.
+    uint32_t len = buffer->bufferInfo_->len_;
+    std::unique_ptr<uint8_t[]> data(new (std::nothrow) uint8_t[len]);
+    CHECK_AND_RETURN_RET_LOG(data != nullptr, false, "RenderFromCopy: alloc fail! len=%{public}u", len);
+
+    std::shared_ptr<BufferInfo> bufferInfo = std::make_shared<BufferInfo>(*buffer->bufferInfo_);
+    bufferInfo->addr_ = data.get();
+    bufferInfo->bufferType_ = BufferType::HEAP_MEMORY;
+    bufferInfo->surfaceBuffer_ = nullptr;
+    bufferInfo->pixelMap_ = nullptr;
+    std::shared_ptr<ExtraInfo> extraInfo = std::make_shared<ExtraInfo>(*buffer->extraInfo_);
+    extraInfo->bufferType = BufferType::HEAP_MEMORY;
+    EffectBuffer copy(bufferInfo, data.get(), extraInfo);
+    MemcpyHelper::CopyData(buffer, &copy);
+    return RenderWithDst(ohEFilter, &copy, buffer, context);
+}
+
+std::unique_ptr<OH_EffectBufferInfo> FilterDelegate::GenOHBufferInfo(const EffectBuffer *buffer)
+{
+    std::unique_ptr<OH_EffectBufferInfo> bufferInfo = std::make_unique<OH_EffectBufferInfo>();
+    bufferInfo->addr = buffer->buffer_;
+    if (buffer->bufferInfo_->tex_ != nullptr) {
+        bufferInfo->textureId = static_cast<int32_t>(buffer->bufferInfo_->tex_->GetName());
+    }
+
+    bufferInfo->width = static_cast<int32_t>(buffer->bufferInfo_->width_);
+    bufferInfo->height = static_cast<int32_t>(buffer->bufferInfo_->height_);
+    bufferInfo->rowSize = static_cast<int32_t>(buffer->bufferInfo_->rowStride_);
+    NativeCommonUtils::SwitchToOHFormatType(buffer->bufferInfo_->formatType_, bufferInfo->format);
+    bufferInfo->timestamp = buffer->extraInfo_->timestamp;
+    return bufferInfo;
+}
+
+void FilterDelegate::FlushDmaCacheIfNeed(EffectBuffer *buffer)
+{
+    CHECK_AND_RETURN(buffer->bufferInfo_->bufferType_ == BufferType::DMA_BUFFER);
+    auto pixelMap = buffer->bufferInfo_->pixelMap_;
+    if (pixelMap && pixelMap->GetFd()) {
+        buffer->bufferInfo_->surfaceBuffer_ = reinterpret_cast<SurfaceBuffer *>(pixelMap->GetFd());
+    }
+    FlushCacheIfNeed(buffer);
+}
+
 void FilterDelegate::PushData(OH_EffectFilter *filter, OH_EffectBufferInfo *dst)
 {
     CHECK_AND_RETURN_LOG(dst != nullptr && filter != nullptr && filter->filter_ != nullptr,
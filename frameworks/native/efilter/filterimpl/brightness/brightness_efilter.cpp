@@ -15,11 +15,13 @@
 
 #include "brightness_efilter.h"
 
+#include <cstddef>
 #include <unordered_map>
 
 #include "effect_log.h"
 #include "effect_json_helper.h"
 #include "common_utils.h"
+#include "region_helper.h"
 #include "cpu_brightness_algo.h"
 #include "efilter_factory.h"
 
@@ -30,17 +32,19 @@ REGISTER_EFILTER_FACTORY(BrightnessEFilter, "Brightness");
 std::shared_ptr<EffectInfo> BrightnessEFilter::info_ = nullptr;
 const float BrightnessEFilter::Parameter::INTENSITY_RANGE[] = { -100.f, 100.f };
 const std::string BrightnessEFilter::Parameter::KEY_INTENSITY = "FilterIntensity";
+const std::string BrightnessEFilter::Parameter::KEY_REGION = "FilterRegion";
 
 BrightnessEFilter::BrightnessEFilter(const std::string &name) : EFilter(name)
 {
     gpuBrightnessAlgo_ = std::make_shared<GpuBrightnessAlgo>();
+    BindParamBlock(&GetParamSchema(), &paramBlock_);
     brightnessFilterInfo_ = {
         {
             IPType::CPU,
             {
-                { IEffectFormat::RGBA8888, CpuBrightnessAlgo::OnApplyRGBA8888 },
-                { IEffectFormat::YUVNV12, CpuBrightnessAlgo::OnApplyYUVNV12 },
-                { IEffectFormat::YUVNV21, CpuBrightnessAlgo::OnApplyYUVNV21 },
+                { IEffectFormat::RGBA8888, static_cast<PointwiseApplyFunc>(CpuBrightnessAlgo::OnApplyRGBA8888) },
+                { IEffectFormat::YUVNV12, static_cast<PointwiseApplyFunc>(CpuBrightnessAlgo::OnApplyYUVNV12) },
+                { IEffectFormat::YUVNV21, static_cast<PointwiseApplyFunc>(CpuBrightnessAlgo::OnApplyYUVNV21) },
             }
         },
         {
@@ -48,9 +52,9 @@ BrightnessEFilter::BrightnessEFilter(const std::string &name) : EFilter(name)
             {
                 {
                     IEffectFormat::RGBA8888,
-                    [this](EffectBuffer *src, EffectBuffer *dst, std::map<std::string, Any> &value,
+                    [this](EffectBuffer *src, EffectBuffer *dst, const PointwiseParams &params,
                         std::shared_ptr<EffectContext> &context)
-                        { return gpuBrightnessAlgo_->OnApplyRGBA8888(src, dst, value, context); }
+                        { return gpuBrightnessAlgo_->OnApplyRGBA8888(src, dst, params, context); }
                 },
             }
         }
@@ -86,16 +90,43 @@ ErrorCode BrightnessEFilter::Render(EffectBuffer *src, EffectBuffer *dst, std::s
         "ipType=%{public}d is not support! filter=%{public}s", ipType, name_.c_str());
 
     IEffectFormat formatType = src->bufferInfo_->formatType_;
-    std::unordered_map<IEffectFormat, ApplyFunc> formatFuncs = it->second;
+    const std::unordered_map<IEffectFormat, ApplyFunc> &formatFuncs = it->second;
     auto formatIter = formatFuncs.find(formatType);
     CHECK_AND_RETURN_RET_LOG(formatIter != formatFuncs.end(), ErrorCode::ERR_UNSUPPORTED_FORMAT_TYPE,
         "format=%{public}d is not support! filter=%{public}s", formatType, name_.c_str());
 
-    return formatIter->second(src, dst, values_, context);
+    return formatIter->second(src, dst, GetRenderParams(ipType), context);
+}
+
+PointwiseParams BrightnessEFilter::GetRenderParams(IPType ipType)
+{
+    if ((TakeDirtyParams() & EFilterParamSchema::ToMask(PointwiseParamBlock::INTENSITY)) != 0) {
+        isLutValid_ = false;
+    }
+    PointwiseParams params;
+    params.intensity_ = paramBlock_.intensity_;
+    params.region_ = IsParamSet(PointwiseParamBlock::REGION) ? &paramBlock_.region_ : nullptr;
+    if (ipType == IPType::CPU) {
+        if (!isLutValid_) {
+            CpuBrightnessAlgo::BuildLut(paramBlock_.intensity_, lut_);
+            isLutValid_ = true;
+        }
+        params.lut_ = lut_;
+    }
+    return params;
 }
 
 ErrorCode BrightnessEFilter::SetValue(const std::string &key, Any &value)
 {
+    if (Parameter::KEY_REGION.compare(key) == 0) {
+        RenderRegion region;
+        ErrorCode res = RegionHelper::ParseRenderRegion(value, region);
+        CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "the type is not region! key=%{public}s", key.c_str());
+        // Keep a copy of the region, the memory of the developer may not outlive the filter.
+        Any regionAny = region;
+        return EFilter::SetValue(key, regionAny);
+    }
+
     if (Parameter::KEY_INTENSITY.compare(key) != 0) {
         EFFECT_LOGE("key is not support! key=%{public}s", key.c_str());
         return ErrorCode::ERR_UNSUPPORTED_VALUE_KEY;
@@ -122,6 +153,12 @@ ErrorCode BrightnessEFilter::Restore(const EffectJsonPtr &values)
     // If the developer does not set parameters, the function returns a failure, but it is a normal case.
     CHECK_AND_RETURN_RET_LOG(values != nullptr, ErrorCode::ERR_INPUT_NULL,
         "BrightnessEFilter::Restore values is null, filter=%{public}s", name_.c_str());
+    RenderRegion region;
+    if (RegionHelper::GetFilterRegion(values, region)) {
+        Any regionAny = region;
+        ErrorCode res = SetValue(Parameter::KEY_REGION, regionAny);
+        CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "BrightnessEFilter::Restore region fail!");
+    }
     if (!values->HasElement(Parameter::KEY_INTENSITY)) {
         EFFECT_LOGW("not set value! key=%{public}s", Parameter::KEY_INTENSITY.c_str());
         return ErrorCode::SUCCESS;
@@ -135,6 +172,23 @@ ErrorCode BrightnessEFilter::Restore(const EffectJsonPtr &values)
     return SetValue(Parameter::KEY_INTENSITY, any);
 }
 
+const EFilterParamSchema &BrightnessEFilter::GetParamSchema()
+{
+    // The order of the parameters follows PointwiseParamBlock::Index.
+    static const EFilterParamSchema schema = [] {
+        EFilterParamSchema paramSchema;
+        paramSchema.Add(Parameter::KEY_INTENSITY, EFilterParamType::FLOAT, offsetof(PointwiseParamBlock, intensity_));
+        paramSchema.Add(Parameter::KEY_REGION, EFilterParamType::REGION, offsetof(PointwiseParamBlock, region_));
+        return paramSchema;
+    }();
+    return schema;
+}
+
+bool BrightnessEFilter::IsRegionSupported()
+{
+    return true;
+}
+
 std::shared_ptr<EffectInfo> BrightnessEFilter::GetEffectInfo(const std::string &name)
 {
     if (info_ != nullptr) {
@@ -15,11 +15,15 @@
 
 #include "cpu_brightness_algo.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 
 #include "common_utils.h"
 #include "effect_log.h"
 #include "format_helper.h"
+#include "memcpy_helper.h"
+#include "region_helper.h"
 #include "securec.h"
 #include "effect_trace.h"
 
@@ -29,10 +33,15 @@ namespace Effect {
 
 constexpr float ESP = 1e-5;
 constexpr uint32_t SCALE_FACTOR = 100;
-constexpr uint32_t UNSIGHED_CHAR_DATA_RECORDS = 256;
 constexpr uint32_t BYTES_PER_INT = 4;
 constexpr uint32_t RGBA_ALPHA_INDEX = 3;
 const int RGBA_SIZE = 4;
+constexpr uint32_t CANCEL_CHECK_BAND_ROWS = 64; // rows processed between two cancel checks
+
+static bool IsRenderCanceled(const std::shared_ptr<EffectContext> &context)
+{
+    return context != nullptr && context->CheckCanceled() != ErrorCode::SUCCESS;
+}
 
 ErrorCode BrightnessCheckBufferInfolen(EffectBuffer *src, EffectBuffer *dst, uint32_t src_width, uint32_t src_height)
 {
@@ -58,39 +67,78 @@ float CpuBrightnessAlgo::ParseBrightness(std::map<std::string, Any> &value)
     return brightness;
 }
 
+void CpuBrightnessAlgo::BuildLut(float brightness, uint8_t lut[POINTWISE_LUT_SIZE])
+{
+    float eps = ESP;
+    float scale = brightness / SCALE_FACTOR;
+    scale = pow(2.4f, scale); // 2.4 is algorithm parameter.
+    for (uint32_t idx = 0; idx < POINTWISE_LUT_SIZE; idx++) {
+        float current = CommonUtils::Clip(1.f - (float)(idx) / UNSIGHED_CHAR_MAX, 0, 1) + eps;
+        current = 1.f - pow(current, scale);
+        current = CommonUtils::Clip(current, 0, 1);
+        lut[idx] = (unsigned char)(current * UNSIGHED_CHAR_MAX);
+    }
+}
+
+PointwiseParams CpuBrightnessAlgo::ParseParams(std::map<std::string, Any> &value, RenderRegion &region)
+{
+    PointwiseParams params;
+    params.intensity_ = ParseBrightness(value);
+    params.region_ = RegionHelper::GetFilterRegion(value, region) ? &region : nullptr;
+    return params;
+}
+
 ErrorCode CpuBrightnessAlgo::OnApplyRGBA8888(EffectBuffer *src, EffectBuffer *dst,
     std::map<std::string, Any> &value, std::shared_ptr<EffectContext> &context)
+{
+    RenderRegion region;
+    return OnApplyRGBA8888(src, dst, ParseParams(value, region), context);
+}
+
+ErrorCode CpuBrightnessAlgo::OnApplyYUVNV21(EffectBuffer *src, EffectBuffer *dst,
+    std::map<std::string, Any> &value, std::shared_ptr<EffectContext> &context)
+{
+    RenderRegion region;
+    return OnApplyYUVNV21(src, dst, ParseParams(value, region), context);
+}
+
+ErrorCode CpuBrightnessAlgo::OnApplyYUVNV12(EffectBuffer *src, EffectBuffer *dst,
+    std::map<std::string, Any> &value, std::shared_ptr<EffectContext> &context)
+{
+    RenderRegion region;
+    return OnApplyYUVNV12(src, dst, ParseParams(value, region), context);
+}
+
+ErrorCode CpuBrightnessAlgo::OnApplyRGBA8888(EffectBuffer *src, EffectBuffer *dst,
+    const PointwiseParams &params, std::shared_ptr<EffectContext> &context)
 {
     EFFECT_LOGI("CpuBrightnessAlgo::OnApplyRGBA8888 enter!");
     CHECK_AND_RETURN_RET_LOG(src != nullptr && dst != nullptr, ErrorCode::ERR_INPUT_NULL, "input para is null!");
-    float brightness = ParseBrightness(value);
+    float brightness = params.intensity_;
     auto *srcRgb = static_cast<unsigned char *>(src->buffer_);
     auto *dstRgb = static_cast<unsigned char *>(dst->buffer_);
 
     uint32_t width = src->bufferInfo_->width_;
     uint32_t height = src->bufferInfo_->height_;
+    RenderROI roi = RegionHelper::GetRenderROI(params.region_, context, width, height);
 
     if (BrightnessCheckBufferInfolen(src, dst, width, height) != ErrorCode::SUCCESS) {
         return ErrorCode::ERR_INVALID_PARAMETER_VALUE;
     }
 
     float eps = ESP;
-    if (fabs(brightness) < eps) {
+    if (fabs(brightness) < eps || roi.IsEmpty()) {
         if (src != dst) {
             errno_t result = memcpy_s(dstRgb, dst->bufferInfo_->len_, srcRgb, src->bufferInfo_->len_);
             CHECK_AND_RETURN_RET_LOG(result == 0, ErrorCode::ERR_MEMCPY_FAIL, "memory copy failed: %{public}d", result);
         }
         return ErrorCode::SUCCESS;
     }
-    float scale = brightness / SCALE_FACTOR;
-    scale = pow(2.4f, scale); // 2.4 is algorithm parameter.
-
-    unsigned char lut[UNSIGHED_CHAR_DATA_RECORDS] = {0};
-    for (uint32_t idx = 0; idx < UNSIGHED_CHAR_DATA_RECORDS; idx++) {
-        float current = CommonUtils::Clip(1.f - (float)(idx) / UNSIGHED_CHAR_MAX, 0, 1) + eps;
-        current = 1.f - pow(current, scale);
-        current = CommonUtils::Clip(current, 0, 1);
-        lut[idx] = (unsigned char)(current * UNSIGHED_CHAR_MAX);
+    uint8_t lutStorage[POINTWISE_LUT_SIZE];
+    const uint8_t *lut = params.lut_;
+    if (lut == nullptr) {
+        BuildLut(brightness, lutStorage);
+        lut = lutStorage;
     }
 
     uint32_t srcRowStride = src->bufferInfo_->rowStride_;
@@ -100,134 +148,188 @@ ErrorCode CpuBrightnessAlgo::OnApplyRGBA8888(EffectBuffer *src, EffectBuffer *ds
     dstRowStride * (height - 1) + (width - 1) * BYTES_PER_INT + BYTES_PER_INT > src->bufferInfo_->len_) {
         return ErrorCode::ERR_INVALID_PARAMETER_VALUE;
     }
-#pragma omp parallel for default(none) shared(height, width, dstRgb, srcRgb, lut, srcRowStride, dstRowStride)
-    for (uint32_t y = 0; y < height; ++y) {
-        for (uint32_t x = 0; x < width; ++x) {
-            for (uint32_t i = 0; i < BYTES_PER_INT; ++i) {
-                uint32_t srcIndex = srcRowStride * y + x * BYTES_PER_INT + i;
-                uint32_t dstIndex = dstRowStride * y + x * BYTES_PER_INT + i;
-                dstRgb[dstIndex] = (i == RGBA_ALPHA_INDEX) ? srcRgb[srcIndex] : lut[srcRgb[srcIndex]];
+    if (src != dst && !roi.IsFullFrame()) {
+        // The pixels outside the region pass through unchanged.
+        MemcpyHelper::CopyData(src, dst);
+    }
+    uint32_t left = static_cast<uint32_t>(roi.Left());
+    uint32_t right = static_cast<uint32_t>(roi.Right());
+    uint32_t bottom = static_cast<uint32_t>(roi.Bottom());
+    uint32_t top = static_cast<uint32_t>(roi.Top());
+    std::atomic<bool> isCanceled = false;
+    uint32_t bandCount = (top - bottom + CANCEL_CHECK_BAND_ROWS - 1) / CANCEL_CHECK_BAND_ROWS;
+#pragma omp parallel for default(none) shared(bandCount, bottom, top, left, right, width, dstRgb, srcRgb, lut, \
+    srcRowStride, dstRowStride, context, isCanceled)
+    for (uint32_t band = 0; band < bandCount; ++band) {
+        if (isCanceled.load(std::memory_order_relaxed) || IsRenderCanceled(context)) {
+            isCanceled.store(true, std::memory_order_relaxed);
+            continue;
+        }
+        uint32_t rowBegin = bottom + band * CANCEL_CHECK_BAND_ROWS;
+        uint32_t rowEnd = std::min(top, rowBegin + CANCEL_CHECK_BAND_ROWS);
+        for (uint32_t y = rowBegin; y < rowEnd; ++y) {
+            for (uint32_t x = left; x < right; ++x) {
+                for (uint32_t i = 0; i < BYTES_PER_INT; ++i) {
+                    uint32_t srcIndex = srcRowStride * y + x * BYTES_PER_INT + i;
+                    uint32_t dstIndex = dstRowStride * y + x * BYTES_PER_INT + i;
+                    dstRgb[dstIndex] = (i == RGBA_ALPHA_INDEX) ? srcRgb[srcIndex] : lut[srcRgb[srcIndex]];
+                }
             }
         }
     }
+    CHECK_AND_RETURN_RET_LOG(!isCanceled.load(), context->CheckCanceled(), "render canceled!");
     return ErrorCode::SUCCESS;
 }
 
 ErrorCode CpuBrightnessAlgo::OnApplyYUVNV21(EffectBuffer *src, EffectBuffer *dst,
-    std::map<std::string, Any> &value, std::shared_ptr<EffectContext> &context)
+    const PointwiseParams &params, std::shared_ptr<EffectContext> &context)
 {
     EFFECT_TRACE_NAME("CpuBrightnessAlgo::OnApplyYUVNV21");
     EFFECT_LOGI("CpuBrightnessAlgo::OnApplyYUVNV21 enter!");
     CHECK_AND_RETURN_RET_LOG(src != nullptr && dst != nullptr, ErrorCode::ERR_INPUT_NULL, "input para is null!");
-    float brightness = ParseBrightness(value);
+    float brightness = params.intensity_;
     auto *srcNV21 = static_cast<unsigned char *>(src->buffer_);
     auto *dstNV21 = static_cast<unsigned char *>(dst->buffer_);
 
     uint32_t width = src->bufferInfo_->width_;
     uint32_t height = src->bufferInfo_->height_;
+    RenderROI roi = RegionHelper::GetRenderROI(params.region_, context, width, height, true);
 
     float eps = ESP;
-    if (fabs(brightness) < eps) {
+    if (fabs(brightness) < eps || roi.IsEmpty()) {
         if (src != dst) {
             errno_t result = memcpy_s(dstNV21, dst->bufferInfo_->len_, srcNV21, src->bufferInfo_->len_);
             CHECK_AND_RETURN_RET_LOG(result == 0, ErrorCode::ERR_MEMCPY_FAIL, "memory copy failed: %{public}d", result);
         }
         return ErrorCode::SUCCESS;
     }
-    float scale = brightness / SCALE_FACTOR;
-    scale = pow(2.4f, scale); // 2.4 is algorithm parameter.
-
-    unsigned char lut[UNSIGHED_CHAR_DATA_RECORDS] = {0};
-    for (uint32_t idx = 0; idx < UNSIGHED_CHAR_DATA_RECORDS; idx++) {
-        float current = CommonUtils::Clip(1.f - (float)(idx) / UNSIGHED_CHAR_MAX, 0, 1) + eps;
-        current = 1.f - pow(current, scale);
-        current = CommonUtils::Clip(current, 0, 1);
-        lut[idx] = (unsigned char)(current * UNSIGHED_CHAR_MAX);
+    uint8_t lutStorage[POINTWISE_LUT_SIZE];
+    const uint8_t *lut = params.lut_;
+    if (lut == nullptr) {
+        BuildLut(brightness, lutStorage);
+        lut = lutStorage;
     }
 
     uint8_t *srcNV21UV = srcNV21 + width * height;
     uint8_t *dstNV21UV = dstNV21 + width * height;
 
-#pragma omp parallel for default(none) shared(height, width, srcNV21, dstNV21, lut)
-    for (uint32_t i = 0; i < height; i++) {
-        for (uint32_t j = 0; j < width; j++) {
-            uint32_t y_index = i * width + j;
-            uint32_t nv_index = i / 2 * width + j - j % 2; // 2 mean u/v split factor
-
-            uint8_t y = srcNV21[y_index];
-            uint8_t v = srcNV21UV[nv_index];
-            uint8_t u = srcNV21UV[nv_index + 1];
-            uint8_t r = FormatHelper::YuvToR(y, u, v);
-            uint8_t g = FormatHelper::YuvToG(y, u, v);
-            uint8_t b = FormatHelper::YuvToB(y, u, v);
-            r = lut[r];
-            g = lut[g];
-            b = lut[b];
-            dstNV21[y_index] = FormatHelper::RGBToY(r, g, b);
-            dstNV21UV[nv_index] = FormatHelper::RGBToV(r, g, b);
-            dstNV21UV[nv_index + 1] = FormatHelper::RGBToU(r, g, b);
+    if (src != dst && !roi.IsFullFrame()) {
+        // The pixels outside the region pass through unchanged.
+        MemcpyHelper::CopyData(src, dst);
+    }
+    uint32_t left = static_cast<uint32_t>(roi.Left());
+    uint32_t right = static_cast<uint32_t>(roi.Right());
+    uint32_t bottom = static_cast<uint32_t>(roi.Bottom());
+    uint32_t top = static_cast<uint32_t>(roi.Top());
+    std::atomic<bool> isCanceled = false;
+    uint32_t bandCount = (top - bottom + CANCEL_CHECK_BAND_ROWS - 1) / CANCEL_CHECK_BAND_ROWS;
+#pragma omp parallel for default(none) shared(bandCount, bottom, top, left, right, width, srcNV21, dstNV21, lut, \
+    context, isCanceled)
+    for (uint32_t band = 0; band < bandCount; ++band) {
+        if (isCanceled.load(std::memory_order_relaxed) || IsRenderCanceled(context)) {
+            isCanceled.store(true, std::memory_order_relaxed);
+            continue;
+        }
+        uint32_t rowBegin = bottom + band * CANCEL_CHECK_BAND_ROWS;
+        uint32_t rowEnd = std::min(top, rowBegin + CANCEL_CHECK_BAND_ROWS);
+        for (uint32_t i = rowBegin; i < rowEnd; i++) {
+            for (uint32_t j = left; j < right; j++) {
+                uint32_t y_index = i * width + j;
+                uint32_t nv_index = i / 2 * width + j - j % 2; // 2 mean u/v split factor
+
+                uint8_t y = srcNV21[y_index];
+                uint8_t v = srcNV21UV[nv_index];
+                uint8_t u = srcNV21UV[nv_index + 1];
+                uint8_t r = FormatHelper::YuvToR(y, u, v);
+                uint8_t g = FormatHelper::YuvToG(y, u, v);
+                uint8_t b = FormatHelper::YuvToB(y, u, v);
+                r = lut[r];
+                g = lut[g];
+                b = lut[b];
+                dstNV21[y_index] = FormatHelper::RGBToY(r, g, b);
+                dstNV21UV[nv_index] = FormatHelper::RGBToV(r, g, b);
+                dstNV21UV[nv_index + 1] = FormatHelper::RGBToU(r, g, b);
+            }
         }
     }
+    CHECK_AND_RETURN_RET_LOG(!isCanceled.load(), context->CheckCanceled(), "render canceled!");
 
     return ErrorCode::SUCCESS;
 }
 
 ErrorCode CpuBrightnessAlgo::OnApplyYUVNV12(EffectBuffer *src, EffectBuffer *dst,
-    std::map<std::string, Any> &value, std::shared_ptr<EffectContext> &context)
+    const PointwiseParams &params, std::shared_ptr<EffectContext> &context)
 {
     EFFECT_TRACE_NAME("CpuBrightnessAlgo::OnApplyYUVNV12");
     EFFECT_LOGI("CpuBrightnessAlgo::OnApplyYUVNV12 enter!");
     CHECK_AND_RETURN_RET_LOG(src != nullptr && dst != nullptr, ErrorCode::ERR_INPUT_NULL, "input para is null!");
-    float brightness = ParseBrightness(value);
+    float brightness = params.intensity_;
     auto *srcNV12 = static_cast<unsigned char *>(src->buffer_);
     auto *dstNV12 = static_cast<unsigned char *>(dst->buffer_);
 
     uint32_t width = src->bufferInfo_->width_;
     uint32_t height = src->bufferInfo_->height_;
+    RenderROI roi = RegionHelper::GetRenderROI(params.region_, context, width, height, true);
 
     float eps = ESP;
-    if (fabs(brightness) < eps) {
+    if (fabs(brightness) < eps || roi.IsEmpty()) {
         if (src != dst) {
             errno_t result = memcpy_s(dstNV12, dst->bufferInfo_->len_, srcNV12, src->bufferInfo_->len_);
             CHECK_AND_RETURN_RET_LOG(result == 0, ErrorCode::ERR_MEMCPY_FAIL, "memory copy failed: %{public}d", result);
         }
         return ErrorCode::SUCCESS;
     }
-    float brightnessScale = brightness / SCALE_FACTOR;
-    brightnessScale = pow(2.4f, brightnessScale); // 2.4 is algorithm parameter.
-
-    unsigned char lut[UNSIGHED_CHAR_DATA_RECORDS] = {0};
-    for (uint32_t i = 0; i < UNSIGHED_CHAR_DATA_RECORDS; i++) {
-        float current = CommonUtils::Clip(1.f - (float)(i) / UNSIGHED_CHAR_MAX, 0, 1) + eps;
-        current = 1.f - pow(current, brightnessScale);
-        current = CommonUtils::Clip(current, 0, 1);
-        lut[i] = (unsigned char)(current * UNSIGHED_CHAR_MAX);
+    uint8_t lutStorage[POINTWISE_LUT_SIZE];
+    const uint8_t *lut = params.lut_;
+    if (lut == nullptr) {
+        BuildLut(brightness, lutStorage);
+        lut = lutStorage;
     }
 
     uint8_t *srcNV12UV = srcNV12 + width * height;
     uint8_t *dstNV12UV = dstNV12 + width * height;
 
-#pragma omp parallel for default(none) shared(height, width, srcNV12, dstNV12, lut)
-    for (uint32_t i = 0; i < height; i++) {
-        for (uint32_t j = 0; j < width; j++) {
-            uint32_t nv_index = i / 2 * width + j - j % 2; // 2 mean u/v split factor
-            uint32_t y_index = i * width + j;
-
-            uint8_t y = srcNV12[y_index];
-            uint8_t u = srcNV12UV[nv_index];
-            uint8_t v = srcNV12UV[nv_index + 1];
-            uint8_t r = FormatHelper::YuvToR(y, u, v);
-            uint8_t g = FormatHelper::YuvToG(y, u, v);
-            uint8_t b = FormatHelper::YuvToB(y, u, v);
-            r = lut[r];
-            g = lut[g];
-            b = lut[b];
-
-            dstNV12[y_index] = FormatHelper::RGBToY(r, g, b);
-            dstNV12UV[nv_index] = FormatHelper::RGBToU(r, g, b);
-            dstNV12UV[nv_index + 1] = FormatHelper::RGBToV(r, g, b);
+    if (src != dst && !roi.IsFullFrame()) {
+        // The pixels outside the region pass through unchanged.
+        MemcpyHelper::CopyData(src, dst);
+    }
+    uint32_t left = static_cast<uint32_t>(roi.Left());
+    uint32_t right = static_cast<uint32_t>(roi.Right());
+    uint32_t bottom = static_cast<uint32_t>(roi.Bottom());
+    uint32_t top = static_cast<uint32_t>(roi.Top());
+    std::atomic<bool> isCanceled = false;
+    uint32_t bandCount = (top - bottom + CANCEL_CHECK_BAND_ROWS - 1) / CANCEL_CHECK_BAND_ROWS;
+#pragma omp parallel for default(none) shared(bandCount, bottom, top, left, right, width, srcNV12, dstNV12, lut, \
+    context, isCanceled)
+    for (uint32_t band = 0; band < bandCount; ++band) {
+        if (isCanceled.load(std::memory_order_relaxed) || IsRenderCanceled(context)) {
+            isCanceled.store(true, std::memory_order_relaxed);
+            continue;
+        }
+        uint32_t rowBegin = bottom + band * CANCEL_CHECK_BAND_ROWS;
+        uint32_t rowEnd = std::min(top, rowBegin + CANCEL_CHECK_BAND_ROWS);
+        for (uint32_t i = rowBegin; i < rowEnd; i++) {
+            for (uint32_t j = left; j < right; j++) {
+                uint32_t nv_index = i / 2 * width + j - j % 2; // 2 mean u/v split factor
+                uint32_t y_index = i * width + j;
+
+                uint8_t y = srcNV12[y_index];
+                uint8_t u = srcNV12UV[nv_index];
+                uint8_t v = srcNV12UV[nv_index + 1];
+                uint8_t r = FormatHelper::YuvToR(y, u, v);
+                uint8_t g = FormatHelper::YuvToG(y, u, v);
+                uint8_t b = FormatHelper::YuvToB(y, u, v);
+                r = lut[r];
+                g = lut[g];
+                b = lut[b];
+
+                dstNV12[y_index] = FormatHelper::RGBToY(r, g, b);
+                dstNV12UV[nv_index] = FormatHelper::RGBToU(r, g, b);
+                dstNV12UV[nv_index + 1] = FormatHelper::RGBToV(r, g, b);
+            }
         }
     }
+    CHECK_AND_RETURN_RET_LOG(!isCanceled.load(), context->CheckCanceled(), "render canceled!");
     return ErrorCode::SUCCESS;
 }
 } // namespace Effect
@@ -22,6 +22,7 @@
 #include "effect_buffer.h"
 #include "any.h"
 #include "effect_context.h"
+#include "pointwise_params.h"
 
 namespace OHOS {
 namespace Media {
@@ -37,8 +38,21 @@ public:
     static ErrorCode OnApplyYUVNV12(EffectBuffer *src, EffectBuffer *dst, std::map<std::string, Any> &value,
         std::shared_ptr<EffectContext> &context);
 
+    static ErrorCode OnApplyRGBA8888(EffectBuffer *src, EffectBuffer *dst, const PointwiseParams &params,
+        std::shared_ptr<EffectContext> &context);
+
+    static ErrorCode OnApplyYUVNV21(EffectBuffer *src, EffectBuffer *dst, const PointwiseParams &params,
+        std::shared_ptr<EffectContext> &context);
+
+    static ErrorCode OnApplyYUVNV12(EffectBuffer *src, EffectBuffer *dst, const PointwiseParams &params,
+        std::shared_ptr<EffectContext> &context);
+
+    static void BuildLut(float brightness, uint8_t lut[POINTWISE_LUT_SIZE]);
+
 private:
     static float ParseBrightness(std::map<std::string, Any> &value);
+
+    static PointwiseParams ParseParams(std::map<std::string, Any> &value, RenderRegion &region);
 };
 } // namespace Effect
 } // namespace Media
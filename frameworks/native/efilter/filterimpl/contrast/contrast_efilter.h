@@ -17,6 +17,7 @@
 #define IMAGE_EFFECT_CONTRAST_EFILTER_H
 
 #include "efilter.h"
+#include "pointwise_params.h"
 #include "gpu_contrast_algo.h"
 #include "image_effect_marco_define.h"
 
@@ -29,6 +30,7 @@ public:
     public:
         static const float INTENSITY_RANGE[];
         static const std::string KEY_INTENSITY;
+        static const std::string KEY_REGION;
     };
 
     IMAGE_EFFECT_EXPORT explicit ContrastEFilter(const std::string &name);
@@ -45,15 +47,25 @@ public:
 
     IMAGE_EFFECT_EXPORT static std::shared_ptr<EffectInfo> GetEffectInfo(const std::string &name);
 
+    static const EFilterParamSchema &GetParamSchema();
+
     ErrorCode PreRender(IEffectFormat &format) override;
+
+    bool IsRegionSupported() override;
 private:
     using ApplyFunc =
-        std::function<ErrorCode(EffectBuffer *src, EffectBuffer *dst, std::map<std::string, Any> &value,
+        std::function<ErrorCode(EffectBuffer *src, EffectBuffer *dst, const PointwiseParams &params,
             std::shared_ptr<EffectContext> &context)>;
 
+    PointwiseParams GetRenderParams(IPType ipType);
+
     static std::shared_ptr<EffectInfo> info_;
     std::unordered_map<IPType, std::unordered_map<IEffectFormat, ApplyFunc>> contrastFilterInfo_;
     std::shared_ptr<GpuContrastAlgo> gpuContrastAlgo_;
+    PointwiseParamBlock paramBlock_;
+    // Lut of the cpu algorithms, rebuilt when the intensity changes.
+    uint8_t lut_[POINTWISE_LUT_SIZE] = { 0 };
+    bool isLutValid_ = false;
 };
 } // namespace Effect
 } // namespace Media
@@ -16,7 +16,7 @@
 #include "gpu_contrast_algo.h"
 #include <string>
 
-#include "common_utils.h"
+#include "region_helper.h"
 #include "effect_log.h"
 #include "graphic/gl_utils.h"
 #include "effect_trace.h"
@@ -41,8 +41,17 @@ const std::string FS_CONTENT =
     "uniform sampler2D Texture;\n"
     "varying vec2 textureCoordinate;\n"
     "uniform float ratio;\n"
+    "uniform float roiLeft;\n"
+    "uniform float roiRight;\n"
+    "uniform float roiBottom;\n"
+    "uniform float roiTop;\n"
     "void main() {\n"
     "    vec4 curColor = texture2D(Texture, textureCoordinate);\n"
+    "    if (textureCoordinate.x < roiLeft || textureCoordinate.x >= roiRight ||\n"
+    "        textureCoordinate.y < roiBottom || textureCoordinate.y >= roiTop) {\n"
+    "        gl_FragColor = curColor;\n"
+    "        return;\n"
+    "    }\n"
     "    vec3 res = curColor.xyz;\n"
     "    float scale = pow(2.4, ratio);\n"
     "    float eps = 1.0e-5;\n"
@@ -86,6 +95,11 @@ void GpuContrastAlgo::PreDraw(GLenum target)
             shader_->BindTexture("Texture", 0, renderEffectData_->inputTexture_->GetName(), target);
         }
         shader_->SetFloat("ratio", renderEffectData_->ratio);
+        const RenderROI &roi = renderEffectData_->roi;
+        shader_->SetFloat("roiLeft", static_cast<float>(roi.l));
+        shader_->SetFloat("roiRight", static_cast<float>(roi.r));
+        shader_->SetFloat("roiBottom", static_cast<float>(roi.b));
+        shader_->SetFloat("roiTop", static_cast<float>(roi.t));
     }
 }
 
@@ -99,19 +113,8 @@ void GpuContrastAlgo::PostDraw(GLenum target)
     }
 }
 
-float GpuContrastAlgo::ParseContrast(std::map<std::string, Any> &value)
-{
-    float contrast = 0.f;
-    ErrorCode res = CommonUtils::GetValue("FilterIntensity", value, contrast);
-    if (res != ErrorCode::SUCCESS) {
-        EFFECT_LOGW("get value fail! res=%{public}d. use default value: %{public}f", res, contrast);
-    }
-    EFFECT_LOGI("get value success! contrast=%{public}f", contrast);
-    return contrast;
-}
-
 ErrorCode GpuContrastAlgo::OnApplyRGBA8888(EffectBuffer *src, EffectBuffer *dst,
-    std::map<std::string, Any> &value, const std::shared_ptr<EffectContext> &context)
+    const PointwiseParams &params, const std::shared_ptr<EffectContext> &context)
 {
     EFFECT_LOGI("GpuContrastFilter::OnApplyRGBA8888 enter!");
     CHECK_AND_RETURN_RET_LOG(src != nullptr && dst != nullptr, ErrorCode::ERR_INPUT_NULL, "input para is null!");
@@ -129,10 +132,19 @@ ErrorCode GpuContrastAlgo::OnApplyRGBA8888(EffectBuffer *src, EffectBuffer *dst,
         inEffectBuffer = src;
     }
     Init();
+    RenderGeneralProgram *program = context->renderEnvironment_->GetResourceCache()->GetOrCreateShader(
+        vertexShaderCode_, fragmentShaderCode_);
+    CHECK_AND_RETURN_RET_LOG(program != nullptr, ErrorCode::ERR_GL_CREATE_PROGRAM_FAILED, "create program fail!");
+    if (shader_ == nullptr || shader_->GetShader() != program) {
+        delete shader_;
+        shader_ = new AlgorithmProgram(program);
+    }
     renderEffectData_->inputTexture_ = inEffectBuffer->bufferInfo_->tex_;
     renderEffectData_->outputHeight_ = inEffectBuffer->bufferInfo_->tex_->Height();
     renderEffectData_->outputWidth_ = inEffectBuffer->bufferInfo_->tex_->Width();
-    renderEffectData_->ratio = ParseContrast(value) / MAX_CONTRAST;
+    renderEffectData_->ratio = params.intensity_ / MAX_CONTRAST;
+    renderEffectData_->roi = RegionHelper::GetRenderROI(params.region_, context, renderEffectData_->outputWidth_,
+        renderEffectData_->outputHeight_);
 
     RenderTexturePtr tex = context->renderEnvironment_->RequestBuffer(renderEffectData_->outputWidth_,
         renderEffectData_->outputHeight_, renderEffectData_->inputTexture_->Format());
@@ -152,10 +164,7 @@ ErrorCode GpuContrastAlgo::OnApplyRGBA8888(EffectBuffer *src, EffectBuffer *dst,
 
 void GpuContrastAlgo::Render(GLenum target, RenderTexturePtr tex)
 {
-    if (shader_ == nullptr) {
-        shader_ = new AlgorithmProgram(vertexShaderCode_, fragmentShaderCode_);
-    }
-
+    CHECK_AND_RETURN_LOG(shader_ != nullptr, "Render: shader is null!");
     glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, target, tex->GetName(), 0);
 
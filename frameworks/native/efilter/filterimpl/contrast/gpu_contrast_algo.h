@@ -23,8 +23,10 @@
 
 #include "core/render_default_data.h"
 #include "core/algorithm_program.h"
+#include "base/math/render_roi.h"
 #include "render_environment.h"
 #include "effect_context.h"
+#include "pointwise_params.h"
 
 namespace OHOS {
 namespace Media {
@@ -35,18 +37,18 @@ public:
     unsigned int outputWidth_;
     unsigned int outputHeight_;
     float ratio;
+    RenderROI roi;
 };
 using ContrastFilterDataPtr = std::shared_ptr<ContrastFilterData>;
 class GpuContrastAlgo {
 public:
     IMAGE_EFFECT_EXPORT
-    ErrorCode OnApplyRGBA8888(EffectBuffer *src, EffectBuffer *dst, std::map<std::string, Any> &value,
+    ErrorCode OnApplyRGBA8888(EffectBuffer *src, EffectBuffer *dst, const PointwiseParams &params,
         const std::shared_ptr<EffectContext> &context);
     ErrorCode Release();
     ErrorCode Init();
     void Render(GLenum target, RenderTexturePtr tex);
 private:
-    float ParseContrast(std::map<std::string, Any> &value);
     ContrastFilterDataPtr renderEffectData_;
     void PreDraw(GLenum target);
     void PostDraw(GLenum target);
@@ -237,6 +237,7 @@ std::shared_ptr<EffectInfo> CropEFilter::GetEffectInfo(const std::string &name)
     info_->formats_.emplace(IEffectFormat::RGBA8888, std::vector<IPType>{ IPType::CPU });
     info_->formats_.emplace(IEffectFormat::RGBA_1010102, std::vector<IPType>{ IPType::CPU });
     info_->category_ = Category::SHAPE_ADJUST;
+    info_->isColorSpaceAgnostic_ = true;
     info_->colorSpaces_ = {
         EffectColorSpace::SRGB,
         EffectColorSpace::SRGB_LIMIT,
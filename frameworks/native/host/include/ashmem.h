@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef IMAGE_EFFECT_HOST_ASHMEM_H
+#define IMAGE_EFFECT_HOST_ASHMEM_H
+
+#include <cstddef>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Host stand-in of ashmem on top of memfd, the protection is given at mmap time on Linux.
+inline int AshmemCreate(const char *name, size_t size)
+{
+    int fd = memfd_create(name, MFD_CLOEXEC);
+    if (fd < 0) {
+        return fd;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+inline int AshmemSetProt(int fd, int prot)
+{
+    (void)fd;
+    (void)prot;
+    return 0;
+}
+
+#endif // IMAGE_EFFECT_HOST_ASHMEM_H
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef IMAGE_EFFECT_HOST_COLOR_SPACE_H
+#define IMAGE_EFFECT_HOST_COLOR_SPACE_H
+
+#include <cstdint>
+
+namespace OHOS {
+namespace ColorManager {
+enum ColorSpaceName : uint32_t {
+    NONE = 0,
+    ADOBE_RGB = 1,
+    DCI_P3 = 2,
+    DISPLAY_P3 = 3,
+    SRGB = 4,
+    BT2020_HLG = 9,
+    BT2020_PQ = 10,
+    DISPLAY_BT2020_SRGB = 13,
+    SRGB_LIMIT = 21,
+    DISPLAY_P3_LIMIT = 22,
+    BT2020_HLG_LIMIT = 25,
+    BT2020_PQ_LIMIT = 26,
+    CUSTOM = 5,
+};
+
+// Host stand-in of the color manager color space, which only carries the name.
+class ColorSpace {
+public:
+    explicit ColorSpace(ColorSpaceName name = ColorSpaceName::SRGB) : name_(name) {}
+
+    ColorSpaceName GetColorSpaceName() const
+    {
+        return name_;
+    }
+
+private:
+    ColorSpaceName name_;
+};
+} // namespace ColorManager
+} // namespace OHOS
+#endif // IMAGE_EFFECT_HOST_COLOR_SPACE_H
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef IMAGE_EFFECT_HOST_EXIF_METADATA_H
+#define IMAGE_EFFECT_HOST_EXIF_METADATA_H
+
+#include <string>
+
+namespace OHOS {
+namespace Media {
+// Host stand-in of the exif metadata, there is no exif support off device.
+class ExifMetadata {
+public:
+    int GetValue(const std::string &key, std::string &value) const
+    {
+        (void)key;
+        value.clear();
+        return -1;
+    }
+
+    bool SetValue(const std::string &key, const std::string &value)
+    {
+        (void)key;
+        (void)value;
+        return false;
+    }
+};
+} // namespace Media
+} // namespace OHOS
+#endif // IMAGE_EFFECT_HOST_EXIF_METADATA_H
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_HOST_HILOG_LOG_H
+#define IMAGE_EFFECT_HOST_HILOG_LOG_H
+
+// Host stand-in of hilog. Logs are dropped, the arguments are still consumed so that values only logged stay used.
+typedef enum {
+    LOG_APP = 0,
+    LOG_INIT = 1,
+    LOG_CORE = 3,
+} LogType;
+
+typedef enum {
+    LOG_DEBUG = 3,
+    LOG_INFO = 4,
+    LOG_WARN = 5,
+    LOG_ERROR = 6,
+    LOG_FATAL = 7,
+} LogLevel;
+
+static inline int HiLogHostDrop(LogType type, ...)
+{
+    (void)type;
+    return 0;
+}
+
+#define HILOG_DEBUG(type, ...) HiLogHostDrop(type, __VA_ARGS__)
+#define HILOG_INFO(type, ...) HiLogHostDrop(type, __VA_ARGS__)
+#define HILOG_WARN(type, ...) HiLogHostDrop(type, __VA_ARGS__)
+#define HILOG_ERROR(type, ...) HiLogHostDrop(type, __VA_ARGS__)
+#define HILOG_FATAL(type, ...) HiLogHostDrop(type, __VA_ARGS__)
+
+#endif // IMAGE_EFFECT_HOST_HILOG_LOG_H
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_HOST_HITRACE_METER_H
+#define IMAGE_EFFECT_HOST_HITRACE_METER_H
+
+#include <cstdint>
+#include <string>
+
+// Host stand-in of hitrace, all the traces are no-op. Use perf or VTune on the host instead.
+constexpr uint64_t HITRACE_TAG_ZIMAGE = (1ULL << 27);
+
+inline void StartTrace(uint64_t label, const std::string &value, float limit = -1)
+{
+    (void)label;
+    (void)value;
+    (void)limit;
+}
+
+inline void FinishTrace(uint64_t label)
+{
+    (void)label;
+}
+
+#endif // IMAGE_EFFECT_HOST_HITRACE_METER_H
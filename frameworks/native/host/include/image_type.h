@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef IMAGE_EFFECT_HOST_IMAGE_TYPE_H
+#define IMAGE_EFFECT_HOST_IMAGE_TYPE_H
+
+#include <cstdint>
+
+namespace OHOS {
+namespace Media {
+enum class PixelFormat : int32_t {
+    UNKNOWN = 0,
+    ARGB_8888 = 1,
+    RGB_565 = 2,
+    RGBA_8888 = 3,
+    BGRA_8888 = 4,
+    RGB_888 = 5,
+    ALPHA_8 = 6,
+    RGBA_F16 = 7,
+    NV21 = 8,
+    NV12 = 9,
+    RGBA_1010102 = 10,
+    YCBCR_P010 = 11,
+    YCRCB_P010 = 12,
+};
+
+enum class AllocatorType : int32_t {
+    DEFAULT = 0,
+    HEAP_ALLOC = 1,
+    SHARE_MEM_ALLOC = 2,
+    CUSTOM_ALLOC = 3,
+    DMA_ALLOC = 4,
+};
+
+enum class AlphaType : int32_t {
+    IMAGE_ALPHA_TYPE_UNKNOWN = 0,
+    IMAGE_ALPHA_TYPE_OPAQUE = 1,
+    IMAGE_ALPHA_TYPE_PREMUL = 2,
+    IMAGE_ALPHA_TYPE_UNPREMUL = 3,
+};
+
+struct Size {
+    int32_t width = 0;
+    int32_t height = 0;
+};
+
+struct ImageInfo {
+    Size size;
+    PixelFormat pixelFormat = PixelFormat::UNKNOWN;
+    AlphaType alphaType = AlphaType::IMAGE_ALPHA_TYPE_UNKNOWN;
+};
+
+struct InitializationOptions {
+    Size size;
+    PixelFormat srcPixelFormat = PixelFormat::BGRA_8888;
+    PixelFormat pixelFormat = PixelFormat::UNKNOWN;
+    AlphaType alphaType = AlphaType::IMAGE_ALPHA_TYPE_UNKNOWN;
+    bool editable = false;
+    AllocatorType allocatorType = AllocatorType::DEFAULT;
+};
+
+using CustomFreePixelMap = void (*)(void *addr, void *context, uint32_t size);
+} // namespace Media
+} // namespace OHOS
+#endif // IMAGE_EFFECT_HOST_IMAGE_TYPE_H
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef IMAGE_EFFECT_HOST_MESSAGE_PARCEL_H
+#define IMAGE_EFFECT_HOST_MESSAGE_PARCEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+// Host stand-in of the ipc parcel, which serializes the base types used by Any into a plain byte buffer.
+class MessageParcel {
+public:
+    bool WriteBool(bool value)
+    {
+        return WritePod(static_cast<int32_t>(value));
+    }
+
+    bool WriteInt32(int32_t value)
+    {
+        return WritePod(value);
+    }
+
+    bool WriteInt64(int64_t value)
+    {
+        return WritePod(value);
+    }
+
+    bool WriteFloat(float value)
+    {
+        return WritePod(value);
+    }
+
+    bool WriteDouble(double value)
+    {
+        return WritePod(value);
+    }
+
+    bool WriteString(const std::string &value)
+    {
+        return WriteVector(std::vector<char>(value.begin(), value.end()));
+    }
+
+    bool WriteUInt8Vector(const std::vector<uint8_t> &value)
+    {
+        return WriteVector(value);
+    }
+
+    bool WriteInt32Vector(const std::vector<int32_t> &value)
+    {
+        return WriteVector(value);
+    }
+
+    bool ReadBool()
+    {
+        return ReadPod<int32_t>() != 0;
+    }
+
+    int32_t ReadInt32()
+    {
+        return ReadPod<int32_t>();
+    }
+
+    int64_t ReadInt64()
+    {
+        return ReadPod<int64_t>();
+    }
+
+    float ReadFloat()
+    {
+        return ReadPod<float>();
+    }
+
+    double ReadDouble()
+    {
+        return ReadPod<double>();
+    }
+
+    std::string ReadString()
+    {
+        std::vector<char> value;
+        ReadVector(&value);
+        return std::string(value.begin(), value.end());
+    }
+
+    bool ReadUInt8Vector(std::vector<uint8_t> *value)
+    {
+        return ReadVector(value);
+    }
+
+    bool ReadInt32Vector(std::vector<int32_t> *value)
+    {
+        return ReadVector(value);
+    }
+
+private:
+    template <typename T>
+    bool WritePod(const T &value)
+    {
+        const auto *bytes = reinterpret_cast<const uint8_t *>(&value);
+        data_.insert(data_.end(), bytes, bytes + sizeof(T));
+        return true;
+    }
+
+    template <typename T>
+    T ReadPod()
+    {
+        T value {};
+        if (readPos_ + sizeof(T) <= data_.size()) {
+            memcpy(&value, data_.data() + readPos_, sizeof(T));
+            readPos_ += sizeof(T);
+        }
+        return value;
+    }
+
+    template <typename T>
+    bool WriteVector(const std::vector<T> &value)
+    {
+        WritePod(static_cast<uint64_t>(value.size()));
+        for (const T &item : value) {
+            WritePod(item);
+        }
+        return true;
+    }
+
+    template <typename T>
+    bool ReadVector(std::vector<T> *value)
+    {
+        if (value == nullptr) {
+            return false;
+        }
+        uint64_t size = ReadPod<uint64_t>();
+        if (size > (data_.size() - readPos_) / sizeof(T)) {
+            return false;
+        }
+        value->resize(size);
+        for (uint64_t i = 0; i < size; ++i) {
+            (*value)[i] = ReadPod<T>();
+        }
+        return true;
+    }
+
+    std::vector<uint8_t> data_;
+    size_t readPos_ = 0;
+};
+} // namespace OHOS
+#endif // IMAGE_EFFECT_HOST_MESSAGE_PARCEL_H
@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef IMAGE_EFFECT_HOST_NATIVE_BUFFER_H
+#define IMAGE_EFFECT_HOST_NATIVE_BUFFER_H
+
+typedef enum OH_NativeBuffer_ColorSpace {
+    OH_COLORSPACE_NONE = 0,
+    OH_COLORSPACE_BT2020_HLG_FULL = 5,
+    OH_COLORSPACE_BT2020_PQ_FULL = 6,
+    OH_COLORSPACE_BT2020_HLG_LIMIT = 9,
+    OH_COLORSPACE_BT2020_PQ_LIMIT = 10,
+    OH_COLORSPACE_SRGB_FULL = 11,
+    OH_COLORSPACE_P3_FULL = 12,
+    OH_COLORSPACE_ADOBERGB_FULL = 14,
+    OH_COLORSPACE_SRGB_LIMIT = 15,
+    OH_COLORSPACE_P3_LIMIT = 16,
+    OH_COLORSPACE_DISPLAY_BT2020_SRGB = 25,
+} OH_NativeBuffer_ColorSpace;
+
+#endif // IMAGE_EFFECT_HOST_NATIVE_BUFFER_H
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef IMAGE_EFFECT_HOST_PICTURE_H
+#define IMAGE_EFFECT_HOST_PICTURE_H
+
+#include <memory>
+
+#include "exif_metadata.h"
+#include "pixel_map.h"
+
+namespace OHOS {
+namespace Media {
+// Host stand-in of the picture, which only holds the main pixel map.
+class Picture {
+public:
+    virtual ~Picture() = default;
+
+    virtual std::shared_ptr<PixelMap> GetMainPixel()
+    {
+        return mainPixelMap_;
+    }
+
+    virtual void SetMainPixel(const std::shared_ptr<PixelMap> &pixelMap)
+    {
+        mainPixelMap_ = pixelMap;
+    }
+
+    virtual std::shared_ptr<ExifMetadata> GetExifMetadata()
+    {
+        return nullptr;
+    }
+
+private:
+    std::shared_ptr<PixelMap> mainPixelMap_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // IMAGE_EFFECT_HOST_PICTURE_H
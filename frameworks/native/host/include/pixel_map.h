@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef IMAGE_EFFECT_HOST_PIXEL_MAP_H
+#define IMAGE_EFFECT_HOST_PIXEL_MAP_H
+
+#include <cstdint>
+#include <memory>
+
+#include "exif_metadata.h"
+#include "image_type.h"
+
+namespace OHOS {
+namespace Media {
+/*
+ * Host stand-in of the pixel map backed by heap memory, modeled on the unittest MockPixelMap. Only the packed pixel
+ * formats RGBA_8888, NV12 and NV21 are supported.
+ */
+class PixelMap {
+public:
+    PixelMap() = default;
+    virtual ~PixelMap();
+
+    PixelMap(const PixelMap &) = delete;
+    PixelMap &operator=(const PixelMap &) = delete;
+
+    static std::unique_ptr<PixelMap> Create(const InitializationOptions &opts);
+
+    virtual int32_t GetWidth();
+    virtual int32_t GetHeight();
+    virtual PixelFormat GetPixelFormat();
+    virtual int32_t GetRowBytes();
+    virtual int32_t GetRowStride();
+    virtual int32_t GetByteCount();
+    virtual uint32_t GetCapacity();
+    virtual const uint8_t *GetPixels();
+    virtual uint8_t *GetWritablePixels() const;
+    virtual int32_t GetPixelBytes();
+    virtual void GetImageInfo(ImageInfo &imageInfo);
+    virtual AllocatorType GetAllocatorType();
+    virtual void SetPixelsAddr(void *addr, void *context, uint32_t size, AllocatorType type,
+        CustomFreePixelMap func);
+    virtual std::shared_ptr<ExifMetadata> GetExifMetadata();
+
+private:
+    void FreePixels();
+
+    ImageInfo imageInfo_;
+    int32_t rowStride_ = 0;
+    uint32_t capacity_ = 0;
+    uint8_t *data_ = nullptr;
+    void *context_ = nullptr;
+    AllocatorType allocatorType_ = AllocatorType::HEAP_ALLOC;
+    CustomFreePixelMap freeFunc_ = nullptr;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // IMAGE_EFFECT_HOST_PIXEL_MAP_H
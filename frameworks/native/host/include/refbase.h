@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef IMAGE_EFFECT_HOST_REFBASE_H
+#define IMAGE_EFFECT_HOST_REFBASE_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace OHOS {
+// Host stand-in of the c_utils strong reference counting, only the strong count is kept.
+class RefBase {
+public:
+    RefBase() = default;
+    virtual ~RefBase() = default;
+
+    RefBase(const RefBase &) = delete;
+    RefBase &operator=(const RefBase &) = delete;
+
+    void IncStrongRef(const void *objectId)
+    {
+        (void)objectId;
+        strongCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void DecStrongRef(const void *objectId)
+    {
+        (void)objectId;
+        if (strongCount_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    int32_t GetSptrRefCount() const
+    {
+        return strongCount_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<int32_t> strongCount_ = 0;
+};
+
+template <typename T>
+class sptr {
+public:
+    sptr() = default;
+
+    sptr(T *other) : refs_(other)
+    {
+        if (refs_ != nullptr) {
+            refs_->IncStrongRef(this);
+        }
+    }
+
+    sptr(const sptr<T> &other) : sptr(other.refs_) {}
+
+    template <typename O>
+    sptr(const sptr<O> &other) : sptr(other.GetRefPtr()) {}
+
+    ~sptr()
+    {
+        if (refs_ != nullptr) {
+            refs_->DecStrongRef(this);
+        }
+    }
+
+    sptr<T> &operator=(const sptr<T> &other)
+    {
+        sptr<T> tmp(other);
+        T *refs = refs_;
+        refs_ = tmp.refs_;
+        tmp.refs_ = refs;
+        return *this;
+    }
+
+    T *GetRefPtr() const
+    {
+        return refs_;
+    }
+
+    T *operator->() const
+    {
+        return refs_;
+    }
+
+    T &operator*() const
+    {
+        return *refs_;
+    }
+
+    operator T *() const
+    {
+        return refs_;
+    }
+
+    explicit operator bool() const
+    {
+        return refs_ != nullptr;
+    }
+
+private:
+    T *refs_ = nullptr;
+};
+} // namespace OHOS
+#endif // IMAGE_EFFECT_HOST_REFBASE_H
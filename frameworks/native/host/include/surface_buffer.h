@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef IMAGE_EFFECT_HOST_SURFACE_BUFFER_H
+#define IMAGE_EFFECT_HOST_SURFACE_BUFFER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "native_buffer.h"
+#include "refbase.h"
+
+enum GraphicPixelFormat {
+    GRAPHIC_PIXEL_FMT_RGBA_8888 = 12,
+    GRAPHIC_PIXEL_FMT_YCBCR_420_SP = 24,
+    GRAPHIC_PIXEL_FMT_YCRCB_420_SP = 25,
+    GRAPHIC_PIXEL_FMT_RGBA_1010102 = 35,
+    GRAPHIC_PIXEL_FMT_YCBCR_P010 = 36,
+    GRAPHIC_PIXEL_FMT_YCRCB_P010 = 37,
+    GRAPHIC_PIXEL_FMT_BUTT = 0x7FFFFFFF,
+};
+
+enum GraphicColorGamut {
+    GRAPHIC_COLOR_GAMUT_INVALID = -1,
+    GRAPHIC_COLOR_GAMUT_NATIVE = 0,
+    GRAPHIC_COLOR_GAMUT_SRGB = 4,
+};
+
+enum GraphicTransformType {
+    GRAPHIC_ROTATE_NONE = 0,
+    GRAPHIC_ROTATE_90,
+    GRAPHIC_ROTATE_180,
+    GRAPHIC_ROTATE_270,
+    GRAPHIC_FLIP_H,
+    GRAPHIC_FLIP_V,
+    GRAPHIC_FLIP_H_ROT90,
+    GRAPHIC_FLIP_V_ROT90,
+    GRAPHIC_FLIP_H_ROT180,
+    GRAPHIC_FLIP_V_ROT180,
+    GRAPHIC_FLIP_H_ROT270,
+    GRAPHIC_FLIP_V_ROT270,
+    GRAPHIC_ROTATE_BUTT,
+};
+
+enum {
+    BUFFER_USAGE_CPU_READ = (1ULL << 0),
+    BUFFER_USAGE_CPU_WRITE = (1ULL << 1),
+    BUFFER_USAGE_MEM_MMZ = (1ULL << 2),
+    BUFFER_USAGE_MEM_DMA = (1ULL << 3),
+    BUFFER_USAGE_HW_COMPOSER = (1ULL << 11),
+    BUFFER_USAGE_MEM_MMZ_CACHE = (1ULL << 17),
+    BUFFER_USAGE_CPU_HW_BOTH = (1ULL << 19),
+};
+
+namespace OHOS {
+using GSError = int32_t;
+constexpr GSError GSERROR_OK = 0;
+constexpr GSError GSERROR_INVALID_ARGUMENTS = 40001000;
+constexpr GSError GSERROR_NO_MEM = 40001003;
+
+struct BufferRequestConfig {
+    int32_t width;
+    int32_t height;
+    int32_t strideAlignment;
+    int32_t format;
+    uint64_t usage;
+    int32_t timeout;
+    GraphicColorGamut colorGamut = GraphicColorGamut::GRAPHIC_COLOR_GAMUT_SRGB;
+    GraphicTransformType transform = GraphicTransformType::GRAPHIC_ROTATE_NONE;
+};
+
+/*
+ * Host stand-in of the surface buffer backed by heap memory, so the dma path of the memory manager works off device.
+ * The metadata is kept in the object instead of the buffer handle.
+ */
+class SurfaceBuffer : public RefBase {
+public:
+    static sptr<SurfaceBuffer> Create();
+
+    GSError Alloc(const BufferRequestConfig &config);
+    GSError Map();
+    GSError Unmap();
+
+    int32_t GetWidth() const;
+    int32_t GetHeight() const;
+    int32_t GetStride() const;
+    int32_t GetFormat() const;
+    uint64_t GetUsage() const;
+    uint32_t GetSize() const;
+    uint32_t GetSeqNum() const;
+    void *GetVirAddr();
+    int32_t GetFileDescriptor() const;
+    GraphicColorGamut GetSurfaceBufferColorGamut() const;
+    GraphicTransformType GetSurfaceBufferTransform() const;
+
+    GSError SetMetadata(uint32_t key, const std::vector<uint8_t> &value);
+    GSError GetMetadata(uint32_t key, std::vector<uint8_t> &value);
+    GSError ListMetadataKeys(std::vector<uint32_t> &keys);
+
+private:
+    BufferRequestConfig config_ = {};
+    int32_t stride_ = 0;
+    uint32_t seqNum_ = 0;
+    std::vector<uint8_t> data_;
+    std::vector<std::pair<uint32_t, std::vector<uint8_t>>> metadata_;
+};
+} // namespace OHOS
+#endif // IMAGE_EFFECT_HOST_SURFACE_BUFFER_H
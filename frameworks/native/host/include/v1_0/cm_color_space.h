@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef IMAGE_EFFECT_HOST_CM_COLOR_SPACE_H
+#define IMAGE_EFFECT_HOST_CM_COLOR_SPACE_H
+
+namespace OHOS {
+namespace HDI {
+namespace Display {
+namespace Graphic {
+namespace Common {
+namespace V1_0 {
+// Host stand-in of the display hdi color space types, the values only need to be distinct off device.
+enum CM_ColorSpaceType {
+    CM_COLORSPACE_NONE = 0,
+    CM_SRGB_FULL,
+    CM_SRGB_LIMIT,
+    CM_P3_FULL,
+    CM_P3_LIMIT,
+    CM_ADOBERGB_FULL,
+    CM_DISPLAY_BT2020_SRGB,
+    CM_BT2020_HLG_FULL,
+    CM_BT2020_HLG_LIMIT,
+    CM_BT2020_PQ_FULL,
+    CM_BT2020_PQ_LIMIT,
+};
+
+enum CM_HDR_Metadata_Type {
+    CM_METADATA_NONE = 0,
+    CM_VIDEO_HLG,
+    CM_VIDEO_HDR10,
+    CM_VIDEO_HDR_VIVID,
+    CM_IMAGE_HDR_VIVID_DUAL,
+    CM_IMAGE_HDR_VIVID_SINGLE,
+};
+} // namespace V1_0
+} // namespace Common
+} // namespace Graphic
+} // namespace Display
+} // namespace HDI
+} // namespace OHOS
+#endif // IMAGE_EFFECT_HOST_CM_COLOR_SPACE_H
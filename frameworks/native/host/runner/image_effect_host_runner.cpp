@@ -0,0 +1,268 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Drives the cpu kernels on a host, so that they can be run under perf, VTune or the sanitizers. Only the kernels are
+ * covered, this is not an end to end run of the engine:
+ *   image_effect_host_runner [width] [height] [rgba|nv12|nv21] [iterations]
+ * Every iteration allocates the output through the memory manager, renders brightness and contrast, converts the
+ * format and copies the result back on a render strand. The profile of the last iteration is printed as json.
+ * The algorithms are called directly, not through EFilter or ImageEffect::Start, which are not built for the host (see
+ * BUILD.gn). The times leave out the filter negotiation and the surface round trip of a device render.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cpu_brightness_algo.h"
+#include "cpu_contrast_algo.h"
+#include "effect_context.h"
+#include "effect_log.h"
+#include "format_helper.h"
+#include "memcpy_helper.h"
+#include "render_executor.h"
+#include "render_task.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace {
+constexpr uint32_t DEFAULT_WIDTH = 4000;
+constexpr uint32_t DEFAULT_HEIGHT = 3000;
+constexpr uint32_t DEFAULT_ITERATIONS = 20;
+constexpr size_t QUEUE_SIZE = 8;
+constexpr float FILTER_INTENSITY = 50.f;
+constexpr uint8_t PIXEL_VALUE = 128;
+constexpr const char *KEY_FILTER_INTENSITY = "FilterIntensity";
+constexpr int64_t NS_PER_MS = 1000 * 1000;
+
+struct RunnerOptions {
+    uint32_t width = DEFAULT_WIDTH;
+    uint32_t height = DEFAULT_HEIGHT;
+    IEffectFormat format = IEffectFormat::RGBA8888;
+    uint32_t iterations = DEFAULT_ITERATIONS;
+};
+
+bool ParseFormat(const char *name, IEffectFormat &format)
+{
+    const std::map<std::string, IEffectFormat> formats = {
+        { "rgba", IEffectFormat::RGBA8888 },
+        { "nv12", IEffectFormat::YUVNV12 },
+        { "nv21", IEffectFormat::YUVNV21 },
+    };
+    auto it = formats.find(name);
+    if (it == formats.end()) {
+        return false;
+    }
+    format = it->second;
+    return true;
+}
+
+bool ParseOptions(int argc, char *argv[], RunnerOptions &options)
+{
+    constexpr int widthIndex = 1;
+    constexpr int heightIndex = 2;
+    constexpr int formatIndex = 3;
+    constexpr int iterationsIndex = 4;
+    if (argc > widthIndex) {
+        options.width = static_cast<uint32_t>(strtoul(argv[widthIndex], nullptr, 0));
+    }
+    if (argc > heightIndex) {
+        options.height = static_cast<uint32_t>(strtoul(argv[heightIndex], nullptr, 0));
+    }
+    if (argc > formatIndex && !ParseFormat(argv[formatIndex], options.format)) {
+        return false;
+    }
+    if (argc > iterationsIndex) {
+        options.iterations = static_cast<uint32_t>(strtoul(argv[iterationsIndex], nullptr, 0));
+    }
+    return options.width > 0 && options.height > 0 && options.iterations > 0;
+}
+
+std::shared_ptr<EffectBuffer> CreateEffectBuffer(uint32_t width, uint32_t height, IEffectFormat format, void *addr)
+{
+    auto bufferInfo = std::make_shared<BufferInfo>();
+    bufferInfo->width_ = width;
+    bufferInfo->height_ = height;
+    bufferInfo->formatType_ = format;
+    bufferInfo->rowStride_ = FormatHelper::CalculateRowStride(width, format);
+    bufferInfo->len_ = FormatHelper::CalculateSize(width, height, format);
+    bufferInfo->bufferType_ = BufferType::HEAP_MEMORY;
+    bufferInfo->addr_ = addr;
+    auto extraInfo = std::make_shared<ExtraInfo>();
+    extraInfo->dataType = DataType::PIXEL_MAP;
+    extraInfo->bufferType = BufferType::HEAP_MEMORY;
+    return std::make_shared<EffectBuffer>(bufferInfo, addr, extraInfo);
+}
+
+class HostRunner {
+public:
+    explicit HostRunner(const RunnerOptions &options) : options_(options)
+    {
+        src_.assign(FormatHelper::CalculateSize(options.width, options.height, options.format), PIXEL_VALUE);
+        srcBuffer_ = CreateEffectBuffer(options.width, options.height, options.format, src_.data());
+        context_ = std::make_shared<EffectContext>();
+        context_->memoryManager_ = std::make_shared<EffectMemoryManager>();
+        context_->memoryManager_->SetIPType(IPType::CPU);
+        context_->ipType_ = IPType::CPU;
+        values_[KEY_FILTER_INTENSITY] = FILTER_INTENSITY;
+    }
+
+    ErrorCode RunOnce()
+    {
+        context_->renderProfile_ = std::make_shared<EffectRenderProfile>();
+        EffectProfileBinder binder(context_->renderProfile_.get());
+
+        std::shared_ptr<EffectBuffer> dst = AllocBuffer(options_.format);
+        CHECK_AND_RETURN_RET_LOG(dst != nullptr, ErrorCode::ERR_ALLOC_MEMORY_FAIL, "RunOnce: alloc dst fail");
+        ErrorCode res = RenderFilters(dst.get());
+        CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "RunOnce: render fail! res=%{public}d", res);
+
+        // Round trip between the packed and the planar formats, as the sink does when the formats differ.
+        IEffectFormat convertFormat = options_.format == IEffectFormat::RGBA8888 ?
+            IEffectFormat::YUVNV12 : IEffectFormat::RGBA8888;
+        std::shared_ptr<EffectBuffer> converted = AllocBuffer(convertFormat);
+        CHECK_AND_RETURN_RET_LOG(converted != nullptr, ErrorCode::ERR_ALLOC_MEMORY_FAIL,
+            "RunOnce: alloc converted fail");
+        FormatConverterInfo srcInfo = { *dst->bufferInfo_, dst->buffer_ };
+        FormatConverterInfo dstInfo = { *converted->bufferInfo_, converted->buffer_ };
+        res = FormatHelper::ConvertFormat(srcInfo, dstInfo);
+        CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "RunOnce: convert fail! res=%{public}d", res);
+
+        MemcpyHelper::CopyData(dst.get(), srcBuffer_.get());
+        context_->memoryManager_->ClearMemory();
+        return ErrorCode::SUCCESS;
+    }
+
+    std::shared_ptr<EffectRenderProfile> GetProfile() const
+    {
+        return context_->renderProfile_;
+    }
+
+private:
+    std::shared_ptr<EffectBuffer> AllocBuffer(IEffectFormat format)
+    {
+        MemoryInfo memoryInfo;
+        memoryInfo.bufferInfo.width_ = options_.width;
+        memoryInfo.bufferInfo.height_ = options_.height;
+        memoryInfo.bufferInfo.formatType_ = format;
+        memoryInfo.bufferInfo.rowStride_ = FormatHelper::CalculateRowStride(options_.width, format);
+        memoryInfo.bufferInfo.len_ = FormatHelper::CalculateSize(options_.width, options_.height, format);
+        MemoryData *memoryData = context_->memoryManager_->AllocMemory(nullptr, memoryInfo);
+        if (memoryData == nullptr) {
+            return nullptr;
+        }
+        return CreateEffectBuffer(options_.width, options_.height, format, memoryData->data);
+    }
+
+    // The algorithms are called without their filters, so the render stages are recorded here.
+    ErrorCode RenderFilters(EffectBuffer *dst)
+    {
+        ErrorCode res;
+        {
+            EffectProfileScope scope(ProfileStage::FILTER_RENDER, "Brightness");
+            scope.SetBytes(srcBuffer_->bufferInfo_->len_);
+            res = RenderBrightness(srcBuffer_.get(), dst);
+        }
+        CHECK_AND_RETURN_RET(res == ErrorCode::SUCCESS, res);
+        EffectProfileScope scope(ProfileStage::FILTER_RENDER, "Contrast");
+        scope.SetBytes(dst->bufferInfo_->len_);
+        return RenderContrast(dst, dst);
+    }
+
+    ErrorCode RenderBrightness(EffectBuffer *src, EffectBuffer *dst)
+    {
+        switch (options_.format) {
+            case IEffectFormat::YUVNV12:
+                return CpuBrightnessAlgo::OnApplyYUVNV12(src, dst, values_, context_);
+            case IEffectFormat::YUVNV21:
+                return CpuBrightnessAlgo::OnApplyYUVNV21(src, dst, values_, context_);
+            default:
+                return CpuBrightnessAlgo::OnApplyRGBA8888(src, dst, values_, context_);
+        }
+    }
+
+    ErrorCode RenderContrast(EffectBuffer *src, EffectBuffer *dst)
+    {
+        switch (options_.format) {
+            case IEffectFormat::YUVNV12:
+                return CpuContrastAlgo::OnApplyYUVNV12(src, dst, values_, context_);
+            case IEffectFormat::YUVNV21:
+                return CpuContrastAlgo::OnApplyYUVNV21(src, dst, values_, context_);
+            default:
+                return CpuContrastAlgo::OnApplyRGBA8888(src, dst, values_, context_);
+        }
+    }
+
+    RunnerOptions options_;
+    std::vector<uint8_t> src_;
+    std::shared_ptr<EffectBuffer> srcBuffer_;
+    std::shared_ptr<EffectContext> context_;
+    std::map<std::string, Any> values_;
+};
+
+int64_t GetNowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int Run(const RunnerOptions &options)
+{
+    HostRunner runner(options);
+    std::shared_ptr<RenderStrand> strand = RenderExecutor::Instance().CreateStrand(QUEUE_SIZE);
+    ErrorCode res = ErrorCode::SUCCESS;
+    int64_t totalNs = 0;
+    for (uint32_t i = 0; i < options.iterations && res == ErrorCode::SUCCESS; ++i) {
+        int64_t beginNs = GetNowNs();
+        auto task = std::make_shared<RenderTask<>>([&runner, &res]() { res = runner.RunOnce(); }, 0, i);
+        strand->AddTask(task);
+        task->Wait();
+        totalNs += GetNowNs() - beginNs;
+    }
+    strand->Stop();
+    if (res != ErrorCode::SUCCESS) {
+        fprintf(stderr, "render fail! res=%d\n", static_cast<int>(res));
+        return EXIT_FAILURE;
+    }
+
+    fprintf(stdout, "path=cpu_algo %ux%u format=%d iterations=%u avg=%.3fms\n", options.width, options.height,
+        static_cast<int>(options.format), options.iterations,
+        static_cast<double>(totalNs) / options.iterations / NS_PER_MS);
+    std::shared_ptr<EffectRenderProfile> profile = runner.GetProfile();
+    if (profile != nullptr) {
+        fprintf(stdout, "%s\n", profile->ToJson()->ToString().c_str());
+    }
+    return EXIT_SUCCESS;
+}
+} // namespace
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+
+int main(int argc, char *argv[])
+{
+    OHOS::Media::Effect::RunnerOptions options;
+    if (!OHOS::Media::Effect::ParseOptions(argc, argv, options)) {
+        fprintf(stderr, "usage: %s [width] [height] [rgba|nv12|nv21] [iterations]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    return OHOS::Media::Effect::Run(options);
+}
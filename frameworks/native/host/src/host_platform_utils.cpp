@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Host implementations of the platform coupled helpers used by the cpu engine. The device implementations live in
+ * common_utils.cpp and colorspace_helper.cpp, which depend on GLES and the graphic metadata helper.
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "colorspace_helper.h"
+#include "common_utils.h"
+#include "v1_0/cm_color_space.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+using namespace OHOS::HDI::Display::Graphic::Common::V1_0;
+
+namespace {
+// Keys of the surface buffer metadata, the values are private to the host build.
+constexpr uint32_t HOST_METADATA_KEY_HDR_METADATA_TYPE = 1;
+constexpr uint32_t HOST_METADATA_KEY_COLORSPACE_TYPE = 2;
+
+template <typename T>
+ErrorCode SetSurfaceBufferValue(SurfaceBuffer *sb, uint32_t key, const T &value, ErrorCode errorCode)
+{
+    CHECK_AND_RETURN_RET_LOG(sb != nullptr, ErrorCode::ERR_INPUT_NULL, "SetSurfaceBufferValue: sb is null");
+    std::vector<uint8_t> data(sizeof(T));
+    errno_t res = memcpy_s(data.data(), data.size(), &value, sizeof(T));
+    CHECK_AND_RETURN_RET_LOG(res == EOK, errorCode, "SetSurfaceBufferValue: memcpy fail! res=%{public}d", res);
+    GSError ret = sb->SetMetadata(key, data);
+    CHECK_AND_RETURN_RET_LOG(ret == GSERROR_OK, errorCode, "SetSurfaceBufferValue: set metadata fail! key=%{public}u",
+        key);
+    return ErrorCode::SUCCESS;
+}
+} // namespace
+
+GraphicPixelFormat CommonUtils::SwitchToGraphicPixelFormat(IEffectFormat formatType)
+{
+    switch (formatType) {
+        case IEffectFormat::RGBA8888:
+            return GraphicPixelFormat::GRAPHIC_PIXEL_FMT_RGBA_8888;
+        case IEffectFormat::YUVNV12:
+            return GraphicPixelFormat::GRAPHIC_PIXEL_FMT_YCBCR_420_SP;
+        case IEffectFormat::YUVNV21:
+            return GraphicPixelFormat::GRAPHIC_PIXEL_FMT_YCRCB_420_SP;
+        case IEffectFormat::RGBA_1010102:
+            return GraphicPixelFormat::GRAPHIC_PIXEL_FMT_RGBA_1010102;
+        case IEffectFormat::YCBCR_P010:
+            return GraphicPixelFormat::GRAPHIC_PIXEL_FMT_YCBCR_P010;
+        case IEffectFormat::YCRCB_P010:
+            return GraphicPixelFormat::GRAPHIC_PIXEL_FMT_YCRCB_P010;
+        default:
+            return GraphicPixelFormat::GRAPHIC_PIXEL_FMT_BUTT;
+    }
+}
+
+bool ColorSpaceHelper::IsHdrColorSpace(EffectColorSpace colorSpace)
+{
+    return colorSpace == EffectColorSpace::BT2020_HLG || colorSpace == EffectColorSpace::BT2020_HLG_LIMIT ||
+        colorSpace == EffectColorSpace::BT2020_PQ || colorSpace == EffectColorSpace::BT2020_PQ_LIMIT;
+}
+
+ErrorCode ColorSpaceHelper::SetSurfaceBufferMetadataType(SurfaceBuffer *sb, const CM_HDR_Metadata_Type &type)
+{
+    return SetSurfaceBufferValue(sb, HOST_METADATA_KEY_HDR_METADATA_TYPE, type, ErrorCode::ERR_SET_METADATA_FAIL);
+}
+
+ErrorCode ColorSpaceHelper::SetSurfaceBufferColorSpaceType(SurfaceBuffer *sb, const CM_ColorSpaceType &type)
+{
+    return SetSurfaceBufferValue(sb, HOST_METADATA_KEY_COLORSPACE_TYPE, type,
+        ErrorCode::ERR_SET_COLORSPACETYPE_FAIL);
+}
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pixel_map.h"
+
+#include <cstdlib>
+
+#include "refbase.h"
+
+namespace OHOS {
+namespace Media {
+namespace {
+constexpr int32_t RGBA_BYTES_PER_PIXEL = 4;
+constexpr int32_t YUV_BYTES_PER_PIXEL = 1;
+constexpr int32_t YUV_CHROMA_ROW_DIVISOR = 2;
+
+int32_t GetBytesPerPixel(PixelFormat format)
+{
+    switch (format) {
+        case PixelFormat::RGBA_8888:
+            return RGBA_BYTES_PER_PIXEL;
+        case PixelFormat::NV12:
+        case PixelFormat::NV21:
+            return YUV_BYTES_PER_PIXEL;
+        default:
+            return 0;
+    }
+}
+
+int32_t GetRowCount(PixelFormat format, int32_t height)
+{
+    if (format == PixelFormat::NV12 || format == PixelFormat::NV21) {
+        return height + (height + 1) / YUV_CHROMA_ROW_DIVISOR;
+    }
+    return height;
+}
+} // namespace
+
+PixelMap::~PixelMap()
+{
+    FreePixels();
+}
+
+std::unique_ptr<PixelMap> PixelMap::Create(const InitializationOptions &opts)
+{
+    PixelFormat format = opts.pixelFormat == PixelFormat::UNKNOWN ? PixelFormat::RGBA_8888 : opts.pixelFormat;
+    int32_t bytesPerPixel = GetBytesPerPixel(format);
+    if (opts.size.width <= 0 || opts.size.height <= 0 || bytesPerPixel == 0) {
+        return nullptr;
+    }
+
+    int32_t rowStride = opts.size.width * bytesPerPixel;
+    uint32_t capacity = static_cast<uint32_t>(rowStride) *
+        static_cast<uint32_t>(GetRowCount(format, opts.size.height));
+    auto *data = static_cast<uint8_t *>(calloc(capacity, 1));
+    if (data == nullptr) {
+        return nullptr;
+    }
+
+    std::unique_ptr<PixelMap> pixelMap = std::make_unique<PixelMap>();
+    pixelMap->imageInfo_.size = opts.size;
+    pixelMap->imageInfo_.pixelFormat = format;
+    pixelMap->imageInfo_.alphaType = opts.alphaType;
+    pixelMap->rowStride_ = rowStride;
+    pixelMap->capacity_ = capacity;
+    pixelMap->data_ = data;
+    pixelMap->allocatorType_ = AllocatorType::HEAP_ALLOC;
+    return pixelMap;
+}
+
+int32_t PixelMap::GetWidth()
+{
+    return imageInfo_.size.width;
+}
+
+int32_t PixelMap::GetHeight()
+{
+    return imageInfo_.size.height;
+}
+
+PixelFormat PixelMap::GetPixelFormat()
+{
+    return imageInfo_.pixelFormat;
+}
+
+int32_t PixelMap::GetRowBytes()
+{
+    return imageInfo_.size.width * GetBytesPerPixel(imageInfo_.pixelFormat);
+}
+
+int32_t PixelMap::GetRowStride()
+{
+    return rowStride_;
+}
+
+int32_t PixelMap::GetByteCount()
+{
+    return rowStride_ * GetRowCount(imageInfo_.pixelFormat, imageInfo_.size.height);
+}
+
+uint32_t PixelMap::GetCapacity()
+{
+    return capacity_;
+}
+
+const uint8_t *PixelMap::GetPixels()
+{
+    return data_;
+}
+
+uint8_t *PixelMap::GetWritablePixels() const
+{
+    return data_;
+}
+
+int32_t PixelMap::GetPixelBytes()
+{
+    return GetBytesPerPixel(imageInfo_.pixelFormat);
+}
+
+void PixelMap::GetImageInfo(ImageInfo &imageInfo)
+{
+    imageInfo = imageInfo_;
+}
+
+AllocatorType PixelMap::GetAllocatorType()
+{
+    return allocatorType_;
+}
+
+void PixelMap::SetPixelsAddr(void *addr, void *context, uint32_t size, AllocatorType type, CustomFreePixelMap func)
+{
+    // The pixel map owns the new pixels, the old ones are released as on device.
+    FreePixels();
+    data_ = static_cast<uint8_t *>(addr);
+    context_ = context;
+    capacity_ = size;
+    allocatorType_ = type;
+    freeFunc_ = func;
+}
+
+std::shared_ptr<ExifMetadata> PixelMap::GetExifMetadata()
+{
+    return nullptr;
+}
+
+void PixelMap::FreePixels()
+{
+    if (data_ == nullptr) {
+        return;
+    }
+    if (freeFunc_ != nullptr) {
+        freeFunc_(data_, context_, capacity_);
+    } else if (allocatorType_ == AllocatorType::DMA_ALLOC) {
+        // The context holds a strong reference of the surface buffer which owns the pixels.
+        if (context_ != nullptr) {
+            static_cast<RefBase *>(context_)->DecStrongRef(context_);
+        }
+    } else {
+        free(data_);
+    }
+    data_ = nullptr;
+    context_ = nullptr;
+    freeFunc_ = nullptr;
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "surface_buffer.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace OHOS {
+namespace {
+constexpr int32_t RGBA_BYTES_PER_PIXEL = 4;
+constexpr int32_t RGBA_1010102_BYTES_PER_PIXEL = 4;
+constexpr int32_t P010_BYTES_PER_LUMA = 2;
+constexpr int32_t YUV_CHROMA_ROW_DIVISOR = 2;
+
+int32_t GetBytesPerPixel(int32_t format)
+{
+    switch (format) {
+        case GRAPHIC_PIXEL_FMT_RGBA_8888:
+            return RGBA_BYTES_PER_PIXEL;
+        case GRAPHIC_PIXEL_FMT_RGBA_1010102:
+            return RGBA_1010102_BYTES_PER_PIXEL;
+        case GRAPHIC_PIXEL_FMT_YCBCR_P010:
+        case GRAPHIC_PIXEL_FMT_YCRCB_P010:
+            return P010_BYTES_PER_LUMA;
+        case GRAPHIC_PIXEL_FMT_YCBCR_420_SP:
+        case GRAPHIC_PIXEL_FMT_YCRCB_420_SP:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+bool IsYuvFormat(int32_t format)
+{
+    return format == GRAPHIC_PIXEL_FMT_YCBCR_420_SP || format == GRAPHIC_PIXEL_FMT_YCRCB_420_SP ||
+        format == GRAPHIC_PIXEL_FMT_YCBCR_P010 || format == GRAPHIC_PIXEL_FMT_YCRCB_P010;
+}
+
+std::atomic<uint32_t> g_seqNum = 0;
+} // namespace
+
+sptr<SurfaceBuffer> SurfaceBuffer::Create()
+{
+    return sptr<SurfaceBuffer>(new SurfaceBuffer());
+}
+
+GSError SurfaceBuffer::Alloc(const BufferRequestConfig &config)
+{
+    int32_t bytesPerPixel = GetBytesPerPixel(config.format);
+    if (config.width <= 0 || config.height <= 0 || bytesPerPixel == 0) {
+        return GSERROR_INVALID_ARGUMENTS;
+    }
+    int32_t alignment = std::max(config.strideAlignment, 1);
+    int32_t stride = (config.width * bytesPerPixel + alignment - 1) / alignment * alignment;
+    int32_t rowCount = IsYuvFormat(config.format) ?
+        config.height + (config.height + 1) / YUV_CHROMA_ROW_DIVISOR : config.height;
+    data_.assign(static_cast<size_t>(stride) * static_cast<size_t>(rowCount), 0);
+    if (data_.empty()) {
+        return GSERROR_NO_MEM;
+    }
+    config_ = config;
+    stride_ = stride;
+    seqNum_ = g_seqNum.fetch_add(1, std::memory_order_relaxed);
+    return GSERROR_OK;
+}
+
+GSError SurfaceBuffer::Map()
+{
+    return GSERROR_OK;
+}
+
+GSError SurfaceBuffer::Unmap()
+{
+    return GSERROR_OK;
+}
+
+int32_t SurfaceBuffer::GetWidth() const
+{
+    return config_.width;
+}
+
+int32_t SurfaceBuffer::GetHeight() const
+{
+    return config_.height;
+}
+
+int32_t SurfaceBuffer::GetStride() const
+{
+    return stride_;
+}
+
+int32_t SurfaceBuffer::GetFormat() const
+{
+    return config_.format;
+}
+
+uint64_t SurfaceBuffer::GetUsage() const
+{
+    return config_.usage;
+}
+
+uint32_t SurfaceBuffer::GetSize() const
+{
+    return static_cast<uint32_t>(data_.size());
+}
+
+uint32_t SurfaceBuffer::GetSeqNum() const
+{
+    return seqNum_;
+}
+
+void *SurfaceBuffer::GetVirAddr()
+{
+    return data_.empty() ? nullptr : data_.data();
+}
+
+int32_t SurfaceBuffer::GetFileDescriptor() const
+{
+    return -1;
+}
+
+GraphicColorGamut SurfaceBuffer::GetSurfaceBufferColorGamut() const
+{
+    return config_.colorGamut;
+}
+
+GraphicTransformType SurfaceBuffer::GetSurfaceBufferTransform() const
+{
+    return config_.transform;
+}
+
+GSError SurfaceBuffer::SetMetadata(uint32_t key, const std::vector<uint8_t> &value)
+{
+    for (auto &item : metadata_) {
+        if (item.first == key) {
+            item.second = value;
+            return GSERROR_OK;
+        }
+    }
+    metadata_.emplace_back(key, value);
+    return GSERROR_OK;
+}
+
+GSError SurfaceBuffer::GetMetadata(uint32_t key, std::vector<uint8_t> &value)
+{
+    for (const auto &item : metadata_) {
+        if (item.first == key) {
+            value = item.second;
+            return GSERROR_OK;
+        }
+    }
+    return GSERROR_INVALID_ARGUMENTS;
+}
+
+GSError SurfaceBuffer::ListMetadataKeys(std::vector<uint32_t> &keys)
+{
+    keys.clear();
+    for (const auto &item : metadata_) {
+        keys.push_back(item.first);
+    }
+    return GSERROR_OK;
+}
+} // namespace OHOS
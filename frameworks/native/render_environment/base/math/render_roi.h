@@ -41,6 +41,38 @@ public:
     {
         return (t - b) * h + 0.5f;
     }
+    // Pixel bounds of the ROI, l and b are inclusive, r and t are exclusive. b is the first row in memory order.
+    int Left() const
+    {
+        return l * w + 0.5f;
+    }
+    int Right() const
+    {
+        return r * w + 0.5f;
+    }
+    int Bottom() const
+    {
+        return b * h + 0.5f;
+    }
+    int Top() const
+    {
+        return t * h + 0.5f;
+    }
+    bool IsEmpty() const
+    {
+        return Left() >= Right() || Bottom() >= Top();
+    }
+    bool IsFullFrame() const
+    {
+        return Left() <= 0 && Bottom() <= 0 && Right() >= w && Top() >= h;
+    }
+    void Intersect(const RenderROI &other)
+    {
+        l = std::max(l, other.l);
+        r = std::min(r, other.r);
+        b = std::max(b, other.b);
+        t = std::min(t, other.t);
+    }
 
     int w;
     int h;
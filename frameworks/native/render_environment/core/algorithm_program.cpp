@@ -29,9 +29,13 @@ AlgorithmProgram::AlgorithmProgram(const std::string &vertex, const std::string
     fragmentShaderCode_ = fragment;
 }
 
+AlgorithmProgram::AlgorithmProgram(RenderGeneralProgram *shader) : shader_(shader), isOwner_(false)
+{
+}
+
 AlgorithmProgram::~AlgorithmProgram()
 {
-    if (shader_) {
+    if (shader_ && isOwner_) {
         shader_->Release();
         delete shader_;
         shader_ = nullptr;
@@ -44,12 +48,13 @@ void AlgorithmProgram::UpdateShader(const std::string &vertex, const std::string
         strcmp(fragment.c_str(), fragmentShaderCode_.c_str()) == 0) {
         return;
     }
-    if (shader_) {
+    if (shader_ && isOwner_) {
         shader_->Release();
         delete shader_;
         shader_ = nullptr;
     }
     shader_ = new RenderGeneralProgram(vertex.c_str(), fragment.c_str());
+    isOwner_ = true;
     shader_->Init();
     vertexShaderCode_ = vertex;
     fragmentShaderCode_ = fragment;
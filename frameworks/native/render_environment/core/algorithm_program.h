@@ -27,6 +27,8 @@ namespace Effect {
 class AlgorithmProgram {
 public:
     AlgorithmProgram(const std::string &vertex, const std::string &fragment);
+    // Wraps a program owned by the resource cache, it is not released with this object.
+    explicit AlgorithmProgram(RenderGeneralProgram *shader);
     ~AlgorithmProgram();
     void UpdateShader(const std::string &vertex, const std::string &fragment);
     void Bind();
@@ -41,6 +43,7 @@ public:
     RenderGeneralProgram *GetShader();
 private:
     RenderGeneralProgram *shader_ = nullptr;
+    bool isOwner_ = true;
     std::string vertexShaderCode_;
     std::string fragmentShaderCode_;
 };
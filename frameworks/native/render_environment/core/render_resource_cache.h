@@ -19,6 +19,7 @@
 #include "base/render_base.h"
 #include "base/cache/render_fifo_cache.h"
 #include "graphic/render_general_program.h"
+#include "graphic/render_program_binary_cache.h"
 #include "render_mesh.h"
 #include "graphic/render_texture.h"
 
@@ -60,6 +61,26 @@ public:
         return ite->second;
     }
 
+    // The programs of the same sources are shared by the filters rendering in the context of the cache, and kept
+    // until the cache is released.
+    RenderGeneralProgram *GetOrCreateShader(const std::string &vss, const std::string &fss)
+    {
+        RenderProgramKey key = RenderProgramBinaryCache::GetProgramKey(vss, fss);
+        std::string name = "program_" + std::to_string(key.sourceKey_) + "_" + std::to_string(key.checkKey_);
+        RenderGeneralProgram *shader = GetShader(name);
+        if (shader != nullptr) {
+            return shader;
+        }
+        shader = new RenderGeneralProgram(vss, fss);
+        if (!shader->Init()) {
+            shader->Release();
+            delete shader;
+            return nullptr;
+        }
+        AddShader(name, shader);
+        return shader;
+    }
+
     RenderMesh *GetMesh(const std::string &name)
     {
         auto ite = meshesMap_.find(name);
@@ -217,6 +238,7 @@ private:
         std::unordered_map<std::string, RenderGeneralProgram *>::iterator iter = shadersMap_.begin();
         while (iter != shadersMap_.end()) {
             iter->second->Release();
+            delete iter->second;
             ++iter;
         }
         shadersMap_.clear();
@@ -200,7 +200,7 @@ unsigned int GLUtils::LoadShader(const std::string &src, unsigned int shaderType
     return shader;
 }
 
-unsigned int GLUtils::CreateProgram(const std::string &vss, const std::string &fss)
+unsigned int GLUtils::CreateProgram(const std::string &vss, const std::string &fss, bool isRetrievable)
 {
     unsigned int vs = LoadShader(vss, GL_VERTEX_SHADER);
     unsigned int fs = LoadShader(fss, GL_FRAGMENT_SHADER);
@@ -213,6 +213,9 @@ unsigned int GLUtils::CreateProgram(const std::string &vss, const std::string &f
     }
     glAttachShader(program, vs);
     glAttachShader(program, fs);
+    if (isRetrievable) {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     glLinkProgram(program);
     CheckError(__FILE__, __LINE__);
     int status = GL_FALSE;
@@ -235,6 +238,24 @@ unsigned int GLUtils::CreateProgram(const std::string &vss, const std::string &f
     return program;
 }
 
+unsigned int GLUtils::CreateProgramFromBinary(GLenum format, const void *data, GLsizei length)
+{
+    unsigned int program = glCreateProgram();
+    CHECK_AND_RETURN_RET_LOG(program != 0, 0, "CreateProgramFromBinary Failed");
+    glProgramBinary(program, format, data, length);
+    int status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (status == GL_FALSE) {
+        // An unknown format is reported as GL_INVALID_ENUM, it is expected here and not left to the next check.
+        GLenum error = glGetError();
+        EFFECT_LOGW("CreateProgramFromBinary: the binary is rejected! format=%{public}u, error=%{public}u", format,
+            error);
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
 EGLImageKHR GLUtils::CreateEGLImage(EGLDisplay display, SurfaceBuffer *buffer)
 {
     NativeWindowBuffer *nBuffer = CreateNativeWindowBufferFromSurfaceBuffer(&buffer);
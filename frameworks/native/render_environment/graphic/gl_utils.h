@@ -43,7 +43,11 @@ public:
 
     static unsigned int LoadShader(const std::string &src, unsigned int shaderType);
 
-    static unsigned int CreateProgram(const std::string &vss, const std::string &fss);
+    // A retrievable program can be read back with glGetProgramBinary.
+    static unsigned int CreateProgram(const std::string &vss, const std::string &fss, bool isRetrievable = false);
+
+    // Returns 0 when the driver rejects the binary, the program is to be compiled from the sources then.
+    static unsigned int CreateProgramFromBinary(GLenum format, const void *data, GLsizei length);
 
     IMAGE_EFFECT_EXPORT
     static GLuint CreateTexWithStorage(GLenum target, int levels, GLenum internalFormat, int width, int height);
@@ -15,6 +15,7 @@
 
 #include "graphic/render_general_program.h"
 #include "graphic/gl_utils.h"
+#include "graphic/render_program_binary_cache.h"
 
 #include "effect_trace.h"
 
@@ -32,7 +33,7 @@ RenderGeneralProgram::~RenderGeneralProgram() = default;
 bool RenderGeneralProgram::Init()
 {
     EFFECT_TRACE_NAME("Init RenderGeneralProgram");
-    program_ = GLUtils::CreateProgram(vss_, fss_);
+    program_ = RenderProgramBinaryCache::Instance().CreateProgram(vss_, fss_);
     SetReady(true);
     return program_ <= 0 ? false : true;
 }
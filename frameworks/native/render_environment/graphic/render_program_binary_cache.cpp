@@ -0,0 +1,322 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graphic/render_program_binary_cache.h"
+
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "effect_log.h"
+#include "effect_trace.h"
+#include "graphic/gl_utils.h"
+#include "securec.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace {
+constexpr uint32_t BINARY_FILE_MAGIC = 0x50454949; // "IIEP"
+constexpr uint16_t BINARY_FILE_VERSION = 2;
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+constexpr uint64_t CHECK_OFFSET_BASIS = 0x84222325cbf29ce4ULL;
+constexpr uint64_t CHECK_MULTIPLIER = 0x9e3779b97f4a7c15ULL;
+constexpr uint32_t HEX_KEY_SIZE = 17;
+constexpr const char *TMP_FILE_SUFFIX = ".XXXXXX";
+
+// The files are only read back on the device that wrote them, the fields are kept in the native byte order.
+struct BinaryFileHeader {
+    uint32_t magic_ = BINARY_FILE_MAGIC;
+    uint16_t version_ = BINARY_FILE_VERSION;
+    uint16_t reserved_ = 0;
+    uint64_t sourceKey_ = 0;
+    uint64_t checkKey_ = 0;
+    uint64_t driverKey_ = 0;
+    uint32_t vsLength_ = 0;
+    uint32_t fsLength_ = 0;
+    uint32_t format_ = 0;
+    uint32_t size_ = 0;
+};
+
+uint64_t HashString(uint64_t hash, const char *str)
+{
+    if (str == nullptr) {
+        return hash;
+    }
+    for (const char *ch = str; *ch != '\0'; ++ch) {
+        hash = (hash ^ static_cast<uint8_t>(*ch)) * FNV_PRIME;
+    }
+    // Separate the strings, so that moving a character from one to the next changes the key.
+    return hash * FNV_PRIME;
+}
+
+// Polynomial hash, unrelated to the FNV one of the source key.
+uint64_t CheckHashString(uint64_t hash, const std::string &str)
+{
+    for (char ch : str) {
+        hash = hash * CHECK_MULTIPLIER + static_cast<uint8_t>(ch) + 1;
+    }
+    return hash * CHECK_MULTIPLIER;
+}
+} // namespace
+
+RenderProgramBinaryCache &RenderProgramBinaryCache::Instance()
+{
+    static RenderProgramBinaryCache instance;
+    return instance;
+}
+
+bool RenderProgramBinaryCache::SetCacheDir(const std::string &dir)
+{
+    std::string cacheDir;
+    if (!dir.empty()) {
+        char realPath[PATH_MAX] = { 0 };
+        CHECK_AND_RETURN_RET_LOG(realpath(dir.c_str(), realPath) != nullptr, false,
+            "SetCacheDir: the dir is invalid! dir=%{public}s", dir.c_str());
+        struct stat dirStat;
+        CHECK_AND_RETURN_RET_LOG(stat(realPath, &dirStat) == 0 && S_ISDIR(dirStat.st_mode), false,
+            "SetCacheDir: the path is not a dir! dir=%{public}s", dir.c_str());
+        cacheDir = realPath;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    cacheDir_ = cacheDir;
+    return true;
+}
+
+GLuint RenderProgramBinaryCache::CreateProgram(const std::string &vss, const std::string &fss)
+{
+    uint64_t driverKey = GetDriverKey();
+    if (driverKey == 0) {
+        return GLUtils::CreateProgram(vss, fss);
+    }
+
+    RenderProgramKey key = GetProgramKey(vss, fss);
+    RenderProgramBinary binary;
+    if (FindBinary(key, driverKey, binary)) {
+        EFFECT_TRACE_NAME("RenderProgramBinaryCache::LoadBinary");
+        GLuint program = GLUtils::CreateProgramFromBinary(binary.format_, binary.data_.data(),
+            static_cast<GLsizei>(binary.data_.size()));
+        if (program != 0) {
+            return program;
+        }
+        EFFECT_LOGW("CreateProgram: the binary is rejected by the driver, compile the sources. key=%{public}llx",
+            static_cast<unsigned long long>(key.sourceKey_));
+        RemoveBinary(key);
+    }
+
+    GLuint program = GLUtils::CreateProgram(vss, fss, true);
+    CHECK_AND_RETURN_RET(program != 0, 0);
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0 || static_cast<uint32_t>(length) > MAX_BINARY_SIZE) {
+        return program;
+    }
+    binary.driverKey_ = driverKey;
+    binary.data_.resize(static_cast<size_t>(length));
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &binary.format_, binary.data_.data());
+    if (written <= 0) {
+        EFFECT_LOGW("CreateProgram: get program binary fail! length=%{public}d", length);
+        return program;
+    }
+    binary.data_.resize(static_cast<size_t>(written));
+    StoreBinary(key, binary);
+    return program;
+}
+
+RenderProgramKey RenderProgramBinaryCache::GetProgramKey(const std::string &vss, const std::string &fss)
+{
+    RenderProgramKey key;
+    key.sourceKey_ = HashString(HashString(FNV_OFFSET_BASIS, vss.c_str()), fss.c_str());
+    key.checkKey_ = CheckHashString(CheckHashString(CHECK_OFFSET_BASIS, vss), fss);
+    key.vsLength_ = static_cast<uint32_t>(vss.size());
+    key.fsLength_ = static_cast<uint32_t>(fss.size());
+    return key;
+}
+
+bool RenderProgramBinaryCache::FindBinary(const RenderProgramKey &key, uint64_t driverKey,
+    RenderProgramBinary &binary)
+{
+    std::shared_ptr<const RenderProgramBinary> found = nullptr;
+    std::string cacheDir;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = binaries_.find(key.sourceKey_);
+        if (it != binaries_.end() && it->second.key_ == key) {
+            found = it->second.binary_;
+        }
+        cacheDir = cacheDir_;
+    }
+    if (found == nullptr) {
+        auto loaded = std::make_shared<RenderProgramBinary>();
+        if (cacheDir.empty() || !LoadFile(cacheDir, key, *loaded)) {
+            return false;
+        }
+        found = loaded;
+        std::lock_guard<std::mutex> lock(mutex_);
+        // A binary stored while the file was read is newer, keep it.
+        binaries_.emplace(key.sourceKey_, BinaryEntry { key, found });
+    }
+    if (found->driverKey_ != driverKey) {
+        // The driver is updated, the binary is replaced once the sources are compiled again.
+        EFFECT_LOGI("FindBinary: the binary is of another driver. key=%{public}llx",
+            static_cast<unsigned long long>(key.sourceKey_));
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = binaries_.find(key.sourceKey_);
+        if (it != binaries_.end() && it->second.binary_ == found) {
+            binaries_.erase(it);
+        }
+        return false;
+    }
+    binary = *found;
+    return true;
+}
+
+void RenderProgramBinaryCache::StoreBinary(const RenderProgramKey &key, const RenderProgramBinary &binary)
+{
+    CHECK_AND_RETURN_LOG(!binary.data_.empty() && binary.data_.size() <= MAX_BINARY_SIZE,
+        "StoreBinary: invalid binary size! size=%{public}zu", binary.data_.size());
+    std::string cacheDir;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        binaries_[key.sourceKey_] = BinaryEntry { key, std::make_shared<const RenderProgramBinary>(binary) };
+        cacheDir = cacheDir_;
+    }
+    if (!cacheDir.empty()) {
+        SaveFile(cacheDir, key, binary);
+    }
+}
+
+void RenderProgramBinaryCache::RemoveBinary(const RenderProgramKey &key)
+{
+    std::string cacheDir;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        binaries_.erase(key.sourceKey_);
+        cacheDir = cacheDir_;
+    }
+    if (!cacheDir.empty()) {
+        std::remove(GetFilePath(cacheDir, key.sourceKey_).c_str());
+    }
+}
+
+size_t RenderProgramBinaryCache::GetBinaryCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return binaries_.size();
+}
+
+void RenderProgramBinaryCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    binaries_.clear();
+}
+
+uint64_t RenderProgramBinaryCache::GetDriverKey()
+{
+    GLint formatNum = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatNum);
+    const GLubyte *vendor = glGetString(GL_VENDOR);
+    const GLubyte *renderer = glGetString(GL_RENDERER);
+    const GLubyte *version = glGetString(GL_VERSION);
+    if (formatNum <= 0 || vendor == nullptr || renderer == nullptr || version == nullptr) {
+        return 0;
+    }
+    uint64_t hash = HashString(FNV_OFFSET_BASIS, reinterpret_cast<const char *>(vendor));
+    hash = HashString(hash, reinterpret_cast<const char *>(renderer));
+    return HashString(hash, reinterpret_cast<const char *>(version));
+}
+
+std::string RenderProgramBinaryCache::GetFilePath(const std::string &dir, uint64_t sourceKey)
+{
+    char name[HEX_KEY_SIZE] = { 0 };
+    int res = sprintf_s(name, sizeof(name), "%016llx", static_cast<unsigned long long>(sourceKey));
+    CHECK_AND_RETURN_RET_LOG(res >= 0, "", "GetFilePath: sprintf fail! res=%{public}d", res);
+    return dir + "/ie_program_" + name + ".bin";
+}
+
+bool RenderProgramBinaryCache::LoadFile(const std::string &dir, const RenderProgramKey &key,
+    RenderProgramBinary &binary)
+{
+    std::ifstream file(GetFilePath(dir, key.sourceKey_), std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    BinaryFileHeader header;
+    file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    CHECK_AND_RETURN_RET_LOG(file.gcount() == sizeof(header) && header.magic_ == BINARY_FILE_MAGIC &&
+        header.version_ == BINARY_FILE_VERSION && header.size_ > 0 && header.size_ <= MAX_BINARY_SIZE, false,
+        "LoadFile: invalid file header! key=%{public}llx", static_cast<unsigned long long>(key.sourceKey_));
+    RenderProgramKey fileKey = { header.sourceKey_, header.checkKey_, header.vsLength_, header.fsLength_ };
+    CHECK_AND_RETURN_RET_LOG(fileKey == key, false, "LoadFile: the file is of other sources! key=%{public}llx",
+        static_cast<unsigned long long>(key.sourceKey_));
+
+    binary.data_.resize(header.size_);
+    file.read(reinterpret_cast<char *>(binary.data_.data()), header.size_);
+    CHECK_AND_RETURN_RET_LOG(file.gcount() == static_cast<std::streamsize>(header.size_) &&
+        file.peek() == std::ifstream::traits_type::eof(), false, "LoadFile: invalid file size! key=%{public}llx",
+        static_cast<unsigned long long>(key.sourceKey_));
+    binary.driverKey_ = header.driverKey_;
+    binary.format_ = header.format_;
+    return true;
+}
+
+void RenderProgramBinaryCache::SaveFile(const std::string &dir, const RenderProgramKey &key,
+    const RenderProgramBinary &binary)
+{
+    BinaryFileHeader header;
+    header.sourceKey_ = key.sourceKey_;
+    header.checkKey_ = key.checkKey_;
+    header.driverKey_ = binary.driverKey_;
+    header.vsLength_ = key.vsLength_;
+    header.fsLength_ = key.fsLength_;
+    header.format_ = binary.format_;
+    header.size_ = static_cast<uint32_t>(binary.data_.size());
+
+    // Write a temporary file first, so that an interrupted write never leaves a truncated binary behind. The name is
+    // unique, as the same binary may be saved by two threads at once.
+    std::string path = GetFilePath(dir, key.sourceKey_);
+    std::vector<char> tmpName(path.begin(), path.end());
+    tmpName.insert(tmpName.end(), TMP_FILE_SUFFIX, TMP_FILE_SUFFIX + strlen(TMP_FILE_SUFFIX) + 1);
+    int fd = mkstemp(tmpName.data());
+    CHECK_AND_RETURN_LOG(fd >= 0, "SaveFile: create file fail! key=%{public}llx",
+        static_cast<unsigned long long>(key.sourceKey_));
+    close(fd);
+    std::string tmpPath = tmpName.data();
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(binary.data_.data()), binary.data_.size());
+        file.close();
+        if (file.fail()) {
+            EFFECT_LOGE("SaveFile: write file fail! key=%{public}llx",
+                static_cast<unsigned long long>(key.sourceKey_));
+            std::remove(tmpPath.c_str());
+            return;
+        }
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        EFFECT_LOGE("SaveFile: rename file fail! key=%{public}llx", static_cast<unsigned long long>(key.sourceKey_));
+        std::remove(tmpPath.c_str());
+    }
+}
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_RENDER_PROGRAM_BINARY_CACHE_H
+#define IMAGE_EFFECT_RENDER_PROGRAM_BINARY_CACHE_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "graphic/render_lib_header.h"
+#include "image_effect_marco_define.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+// Identifies the sources of a program. The binaries are looked up by sourceKey_, the other fields are compared as
+// well, so that a collision of the 64-bit hash is not taken for the same sources.
+struct RenderProgramKey {
+    uint64_t sourceKey_ = 0;
+    // Independent hash of the same sources.
+    uint64_t checkKey_ = 0;
+    uint32_t vsLength_ = 0;
+    uint32_t fsLength_ = 0;
+
+    bool operator==(const RenderProgramKey &other) const
+    {
+        return sourceKey_ == other.sourceKey_ && checkKey_ == other.checkKey_ && vsLength_ == other.vsLength_ &&
+            fsLength_ == other.fsLength_;
+    }
+};
+
+struct RenderProgramBinary {
+    // Hash of the vendor, renderer and version strings of the driver that produced the binary.
+    uint64_t driverKey_ = 0;
+    GLenum format_ = 0;
+    std::vector<uint8_t> data_;
+};
+
+/**
+ * Process-wide cache of the linked program binaries, keyed by the hashes of the shader sources. A program object only
+ * lives in the share group of its context, the binary is what can be reused by every context of the process and, when
+ * a cache directory is set, by the next runs of the application. A binary of another driver, or one the driver rejects,
+ * is dropped and the program is compiled from the sources again.
+ */
+class RenderProgramBinaryCache {
+public:
+    static constexpr uint32_t MAX_BINARY_SIZE = 4 * 1024 * 1024;
+
+    IMAGE_EFFECT_EXPORT static RenderProgramBinaryCache &Instance();
+
+    // The binaries are only kept in memory while no directory is set, an empty dir goes back to that.
+    IMAGE_EFFECT_EXPORT bool SetCacheDir(const std::string &dir);
+
+    // Needs a current context. Returns the program linked from the cached binary when the driver accepts it, the one
+    // compiled from the sources otherwise, 0 on failure.
+    IMAGE_EFFECT_EXPORT GLuint CreateProgram(const std::string &vss, const std::string &fss);
+
+    IMAGE_EFFECT_EXPORT static RenderProgramKey GetProgramKey(const std::string &vss, const std::string &fss);
+
+    // Needs a current context, 0 when the driver has no binary format.
+    IMAGE_EFFECT_EXPORT static uint64_t GetDriverKey();
+
+    // Looks the binary up in memory, then in the cache directory. A binary of another driver is dropped.
+    IMAGE_EFFECT_EXPORT bool FindBinary(const RenderProgramKey &key, uint64_t driverKey, RenderProgramBinary &binary);
+
+    IMAGE_EFFECT_EXPORT void StoreBinary(const RenderProgramKey &key, const RenderProgramBinary &binary);
+
+    IMAGE_EFFECT_EXPORT void RemoveBinary(const RenderProgramKey &key);
+
+    IMAGE_EFFECT_EXPORT size_t GetBinaryCount();
+
+    // Clears the binaries kept in memory, the files are left.
+    IMAGE_EFFECT_EXPORT void Clear();
+
+private:
+    struct BinaryEntry {
+        RenderProgramKey key_;
+        std::shared_ptr<const RenderProgramBinary> binary_;
+    };
+
+    RenderProgramBinaryCache() = default;
+
+    // The files are read and written without holding mutex_, with the dir copied under it.
+    static std::string GetFilePath(const std::string &dir, uint64_t sourceKey);
+    static bool LoadFile(const std::string &dir, const RenderProgramKey &key, RenderProgramBinary &binary);
+    static void SaveFile(const std::string &dir, const RenderProgramKey &key, const RenderProgramBinary &binary);
+
+    std::mutex mutex_;
+    std::string cacheDir_;
+    std::unordered_map<uint64_t, BinaryEntry> binaries_;
+};
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+#endif // IMAGE_EFFECT_RENDER_PROGRAM_BINARY_CACHE_H
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IM_RENDER_PRIORITY_QUEUE_H
+#define IM_RENDER_PRIORITY_QUEUE_H
+
+#include "render_queue_itf.h"
+
+#include <cstdint>
+#include <iterator>
+#include <set>
+
+/*
+ * Task queue ordered by priority class, then by the earliest deadline, then by submission order. Tasks with the
+ * same priority and without deadline keep the FIFO order. T is a task pointer, whose priority and deadline must not
+ * change while it is queued.
+ */
+template <typename T> class RenderPriorityQueue : public RenderQueueItf<T> {
+public:
+    ~RenderPriorityQueue() = default;
+
+    size_t GetSize() override
+    {
+        return _set.size();
+    }
+
+    bool Push(const T &data) override
+    {
+        if (data == nullptr) {
+            return false;
+        }
+        _set.insert(Entry { data, _order++ });
+        return true;
+    }
+
+    bool Pop(T &result) override
+    {
+        if (_set.empty()) {
+            return false; // empty
+        }
+        result = _set.begin()->data;
+        _set.erase(_set.begin());
+        return true;
+    }
+
+    bool PopWithCallBack(T &result, std::function<void(T &)> &callback) override
+    {
+        if (!Pop(result)) {
+            return false;
+        }
+        callback(result);
+        return true;
+    }
+
+    bool Front(T &result) override
+    {
+        if (_set.empty()) {
+            return false; // empty
+        }
+        result = _set.begin()->data;
+        return true;
+    }
+
+    bool Back(T &result) override
+    {
+        if (_set.empty()) {
+            return false; // empty
+        }
+        result = _set.rbegin()->data;
+        return true;
+    }
+
+    void RemoveAll() override
+    {
+        _set.clear();
+    }
+
+    void Remove(const std::function<bool(T &)> &checkFunc) override
+    {
+        try {
+            for (auto it = _set.begin(); it != _set.end();) {
+                T data = it->data;
+                it = checkFunc(data) ? _set.erase(it) : std::next(it);
+            }
+        } catch (std::bad_function_call) {
+            return;
+        }
+    }
+
+private:
+    struct Entry {
+        T data;
+        uint64_t order;
+    };
+
+    struct EntryCompare {
+        bool operator () (const Entry &a, const Entry &b) const
+        {
+            if (a.data->GetPriority() != b.data->GetPriority()) {
+                return a.data->GetPriority() < b.data->GetPriority();
+            }
+            if (a.data->GetDeadline() != b.data->GetDeadline()) {
+                return a.data->GetDeadline() < b.data->GetDeadline();
+            }
+            return a.order < b.order;
+        }
+    };
+
+    std::set<Entry, EntryCompare> _set;
+    uint64_t _order = 0;
+};
+#endif // IM_RENDER_PRIORITY_QUEUE_H
@@ -21,6 +21,8 @@
 template <typename T> class RenderQueueItf {
 public:
     typedef T DataType;
+    // Whether Push may be called concurrently by producers without the lock of the owner.
+    static constexpr bool LOCK_FREE_PUSH = false;
 
     virtual ~RenderQueueItf() = default;
     virtual size_t GetSize() = 0;
@@ -28,6 +30,8 @@ public:
     virtual bool Pop(T &data) = 0;
     virtual bool PopWithCallBack(T &data, std::function<void(T &)> &) = 0;
     virtual bool Front(T &data) = 0;
+    // Returns false when the queue is empty. Queues with LOCK_FREE_PUSH always return false, their newest item may
+    // still be written by a producer.
     virtual bool Back(T &data) = 0;
     virtual void RemoveAll() = 0;
     virtual void Remove(const std::function<bool(T &)> &checkFunc) = 0;
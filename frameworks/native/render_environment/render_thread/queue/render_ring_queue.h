@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IM_RENDER_RING_QUEUE_H
+#define IM_RENDER_RING_QUEUE_H
+
+#include "render_queue_itf.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+constexpr const static size_t DEFAULT_RING_CAPACITY = 8;
+constexpr const static size_t RING_CACHE_LINE_SIZE = 64;
+
+/*
+ * Bounded multi-producer single-consumer ring. Push is lock-free and never waits: it fails when the ring is full.
+ * Every other operation belongs to the consumer side and must be serialized by the owner of the queue.
+ * Remove leaves tombstones in place so that the order of the remaining items is kept.
+ */
+template <typename T> class RenderRingQueue : public RenderQueueItf<T> {
+public:
+    static constexpr bool LOCK_FREE_PUSH = true;
+
+    explicit RenderRingQueue(size_t capacity = DEFAULT_RING_CAPACITY)
+        : capacity_(RoundUpPowerOfTwo(capacity)), mask_(capacity_ - 1), slots_(new Slot[capacity_])
+    {
+        for (size_t i = 0; i < capacity_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~RenderRingQueue() = default;
+
+    size_t GetSize() override
+    {
+        return size_.load(std::memory_order_seq_cst);
+    }
+
+    size_t GetCapacity() const
+    {
+        return capacity_;
+    }
+
+    bool Push(const T &data) override
+    {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        Slot *slot = nullptr;
+        for (;;) {
+            slot = &slots_[pos & mask_];
+            size_t seq = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // full
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+        slot->data = data;
+        slot->removed = false;
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        size_.fetch_add(1, std::memory_order_seq_cst);
+        return true;
+    }
+
+    bool Pop(T &result) override
+    {
+        for (;;) {
+            Slot &slot = slots_[head_ & mask_];
+            if (slot.sequence.load(std::memory_order_acquire) != head_ + 1) {
+                return false; // empty, or the producer of the head slot has not published yet
+            }
+            bool removed = slot.removed;
+            if (!removed) {
+                result = std::move(slot.data);
+            }
+            slot.data = T();
+            slot.sequence.store(head_ + capacity_, std::memory_order_release);
+            ++head_;
+            if (!removed) {
+                size_.fetch_sub(1, std::memory_order_seq_cst);
+                return true;
+            }
+        }
+    }
+
+    bool PopWithCallBack(T &result, std::function<void(T &)> &callback) override
+    {
+        if (!Pop(result)) {
+            return false;
+        }
+        callback(result);
+        return true;
+    }
+
+    bool Front(T &result) override
+    {
+        for (size_t pos = head_;; ++pos) {
+            Slot &slot = slots_[pos & mask_];
+            if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+                return false;
+            }
+            if (!slot.removed) {
+                result = slot.data;
+                return true;
+            }
+        }
+    }
+
+    bool Back(T &) override
+    {
+        // The newest slot may still be written by a producer, so it can not be read safely from the consumer side.
+        return false;
+    }
+
+    void RemoveAll() override
+    {
+        T data;
+        while (Pop(data)) {
+        }
+    }
+
+    void Remove(const std::function<bool(T &)> &checkFunc) override
+    {
+        for (size_t pos = head_;; ++pos) {
+            Slot &slot = slots_[pos & mask_];
+            if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+                return;
+            }
+            if (slot.removed) {
+                continue;
+            }
+            bool matched = false;
+            try {
+                matched = checkFunc(slot.data);
+            } catch (std::bad_function_call) {
+                return;
+            }
+            if (matched) {
+                slot.removed = true;
+                slot.data = T();
+                size_.fetch_sub(1, std::memory_order_seq_cst);
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence { 0 };
+        T data;
+        bool removed = false;
+    };
+
+    static size_t RoundUpPowerOfTwo(size_t value)
+    {
+        size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(RING_CACHE_LINE_SIZE) std::atomic<size_t> tail_ { 0 };
+    alignas(RING_CACHE_LINE_SIZE) std::atomic<size_t> size_ { 0 };
+    alignas(RING_CACHE_LINE_SIZE) size_t head_ = 0;
+};
+#endif // IM_RENDER_RING_QUEUE_H
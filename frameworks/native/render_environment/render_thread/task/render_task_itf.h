@@ -16,9 +16,18 @@
 #ifndef IM_RENDER_TASK_ITF_H
 #define IM_RENDER_TASK_ITF_H
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <future>
 
+// Scheduling class of a task, a smaller value is served first by a priority ordered queue.
+enum class RenderTaskPriority : uint8_t {
+    INTERACTIVE = 0,
+    PREVIEW = 1,
+    BACKGROUND = 2,
+};
+
 template <typename RETURNTYPE, typename... ARGSTYPE> class RenderTaskItf {
 public:
     typedef RETURNTYPE ReturnType;
@@ -62,7 +71,45 @@ public:
     {
         return m_sequenceId;
     }
-    
+
+    void SetPriority(RenderTaskPriority priority)
+    {
+        m_priority = priority;
+    }
+
+    RenderTaskPriority GetPriority()
+    {
+        return m_priority;
+    }
+
+    // A task which is still queued when its deadline passes is dropped by the worker instead of running late.
+    void SetDeadline(std::chrono::steady_clock::time_point deadline)
+    {
+        m_deadline = deadline;
+    }
+
+    std::chrono::steady_clock::time_point GetDeadline()
+    {
+        return m_deadline;
+    }
+
+    bool IsExpired()
+    {
+        return m_deadline != std::chrono::steady_clock::time_point::max() &&
+            std::chrono::steady_clock::now() >= m_deadline;
+    }
+
+    // Latest wins: adding a coalescing task replaces the queued tasks with the same tag, as AddTask with overwrite.
+    void SetCoalesce(bool coalesce)
+    {
+        m_coalesce = coalesce;
+    }
+
+    bool IsCoalesce()
+    {
+        return m_coalesce;
+    }
+
     virtual void Wait() = 0;
 
     virtual RETURNTYPE GetReturn() = 0;
@@ -75,6 +122,9 @@ protected:
     uint64_t m_id;
     uint64_t m_tag;
     uint64_t m_sequenceId;
+    RenderTaskPriority m_priority = RenderTaskPriority::PREVIEW;
+    std::chrono::steady_clock::time_point m_deadline = std::chrono::steady_clock::time_point::max();
+    bool m_coalesce = false;
 };
 
 template <typename RETURNTYPE, typename... ARGSTYPE>
@@ -0,0 +1,374 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "render_executor.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+#include "effect_log.h"
+#include "render_task.h"
+
+namespace {
+constexpr size_t MAX_RENDER_WORKER_NUM = 4;
+constexpr size_t PARALLEL_STRAND_QUEUE_SIZE = 16;
+
+thread_local RenderStrand *g_currentStrand = nullptr;
+thread_local size_t g_currentWorker = 0;
+
+size_t GetDefaultWorkerNum()
+{
+    size_t cpuNum = std::thread::hardware_concurrency();
+    return std::clamp<size_t>(cpuNum, 1, MAX_RENDER_WORKER_NUM);
+}
+
+struct ParallelJob {
+    std::function<void(uint32_t)> func;
+    uint32_t taskNum = 0;
+    std::atomic<uint32_t> nextTask = 0;
+    std::atomic<uint32_t> finishedTask = 0;
+    std::mutex mutex;
+    std::condition_variable cv;
+};
+
+// Run the tasks not taken yet, return true if the calling thread finished the last task of the job.
+bool RunParallelTasks(ParallelJob &job)
+{
+    bool isLast = false;
+    uint32_t task;
+    while ((task = job.nextTask.fetch_add(1)) < job.taskNum) {
+        job.func(task);
+        isLast = job.finishedTask.fetch_add(1) + 1 == job.taskNum;
+    }
+    return isLast;
+}
+} // namespace
+
+RenderStrand::RenderStrand(RenderExecutor &executor, size_t worker, size_t queueSize)
+    : executor_(executor), queue_(queueSize), worker_(worker)
+{
+}
+
+void RenderStrand::AddTask(const RenderCommonTaskPtr &task, bool overwrite)
+{
+    if (!isWorking_.load()) {
+        task->SetDefaultReturn();
+        return;
+    }
+    pendingNum_.fetch_add(1);
+    if (overwrite || task->IsCoalesce()) {
+        uint32_t removedNum = 0;
+        auto isSameTag = [&task, &removedNum](RenderCommonTaskPtr &localTask) {
+            if (GetTag(task) != GetTag(localTask)) {
+                return false;
+            }
+            localTask->SetDefaultReturn();
+            removedNum++;
+            return true;
+        };
+        {
+            std::lock_guard<std::mutex> lock(consumerMutex_);
+            queue_.Remove(isSameTag);
+            orderedQueue_.Remove(isSameTag);
+            orderedNum_.store(orderedQueue_.GetSize());
+        }
+        for (uint32_t i = 0; i < removedNum; ++i) {
+            FinishTask();
+        }
+    }
+    if (!queue_.Push(task)) {
+        EFFECT_LOGW("RenderStrand::AddTask: queue is full, task is rejected! tag=%{public}" PRIu64, GetTag(task));
+        task->SetDefaultReturn();
+        FinishTask();
+        return;
+    }
+    if (!isScheduled_.exchange(true)) {
+        executor_.Schedule(shared_from_this());
+    }
+}
+
+void RenderStrand::ClearTask()
+{
+    std::lock_guard<std::mutex> lock(consumerMutex_);
+    RenderCommonTaskPtr task = nullptr;
+    while (queue_.Pop(task) || orderedQueue_.Pop(task)) {
+        task->SetDefaultReturn();
+        FinishTask();
+    }
+    orderedNum_.store(0);
+}
+
+void RenderStrand::Start()
+{
+    isWorking_.store(true);
+}
+
+void RenderStrand::Stop()
+{
+    isWorking_.store(false);
+    ClearTask();
+    WaitTaskFinished();
+}
+
+void RenderStrand::WaitTaskFinished()
+{
+    if (g_currentStrand == this) {
+        // The running task counts as pending, waiting for it from inside would never return.
+        EFFECT_LOGE("RenderStrand::WaitTaskFinished: called from a task of the same strand!");
+        return;
+    }
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    drainedCv_.wait(lock, [this]() { return pendingNum_.load() == 0; });
+}
+
+bool RenderStrand::IsPinned() const
+{
+    return isPinned_.load();
+}
+
+bool RenderStrand::HasTask()
+{
+    return queue_.GetSize() > 0 || orderedNum_.load() > 0;
+}
+
+void RenderStrand::TakeIncomingTasks()
+{
+    RenderCommonTaskPtr incoming = nullptr;
+    while (queue_.Pop(incoming)) {
+        orderedQueue_.Push(incoming);
+    }
+    orderedNum_.store(orderedQueue_.GetSize());
+}
+
+RenderTaskPriority RenderStrand::GetHeadPriority()
+{
+    std::lock_guard<std::mutex> lock(consumerMutex_);
+    TakeIncomingTasks();
+    RenderCommonTaskPtr task = nullptr;
+    return orderedQueue_.Front(task) ? task->GetPriority() : RenderTaskPriority::BACKGROUND;
+}
+
+void RenderStrand::Run()
+{
+    RenderCommonTaskPtr task = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(consumerMutex_);
+        TakeIncomingTasks();
+        while (orderedQueue_.Pop(task) && task->IsExpired()) {
+            EFFECT_LOGW("RenderStrand::Run: drop the expired task! tag=%{public}" PRIu64 ", id=%{public}" PRIu64,
+                GetTag(task), task->GetId());
+            task->SetDefaultReturn();
+            FinishTask();
+            task = nullptr;
+        }
+        orderedNum_.store(orderedQueue_.GetSize());
+    }
+    if (task == nullptr) {
+        return;
+    }
+    task->Run();
+    FinishTask();
+}
+
+void RenderStrand::FinishTask()
+{
+    if (pendingNum_.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        drainedCv_.notify_all();
+    }
+}
+
+RenderExecutor &RenderExecutor::Instance()
+{
+    static RenderExecutor instance(GetDefaultWorkerNum());
+    return instance;
+}
+
+RenderExecutor::RenderExecutor(size_t workerNum)
+{
+    workerNum = std::max<size_t>(workerNum, 1);
+    for (size_t i = 0; i < workerNum; ++i) {
+        workers_.emplace_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < workerNum; ++i) {
+        workers_[i]->thread = std::thread([this, i]() { WorkerLoop(i); });
+    }
+}
+
+RenderExecutor::~RenderExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isStopped_ = true;
+        for (auto &worker : workers_) {
+            worker->cv.notify_all();
+        }
+    }
+    for (auto &worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+std::shared_ptr<RenderStrand> RenderExecutor::CreateStrand(size_t queueSize)
+{
+    size_t worker = nextWorker_.fetch_add(1) % workers_.size();
+    auto strand = std::make_shared<RenderStrand>(*this, worker, queueSize);
+    strand->Start();
+    return strand;
+}
+
+void RenderExecutor::PinCurrentStrand()
+{
+    if (g_currentStrand == nullptr) {
+        return;
+    }
+    g_currentStrand->worker_.store(g_currentWorker);
+    g_currentStrand->isPinned_.store(true);
+}
+
+size_t RenderExecutor::GetWorkerNum() const
+{
+    return workers_.size();
+}
+
+void RenderExecutor::ParallelFor(uint32_t taskNum, const std::function<void(uint32_t)> &func)
+{
+    if (taskNum <= 1) {
+        if (taskNum == 1) {
+            func(0);
+        }
+        return;
+    }
+
+    // A helper task scheduled after the job is done finds no task left, so the strands are shared by all jobs.
+    std::call_once(parallelStrandsFlag_, [this]() {
+        for (size_t i = 0; i < workers_.size(); ++i) {
+            parallelStrands_.emplace_back(CreateStrand(PARALLEL_STRAND_QUEUE_SIZE));
+        }
+    });
+    auto job = std::make_shared<ParallelJob>();
+    job->func = func;
+    job->taskNum = taskNum;
+    for (uint32_t i = 1; i < taskNum && i <= parallelStrands_.size(); ++i) {
+        auto task = std::make_shared<RenderTask<>>([job]() {
+            if (RunParallelTasks(*job)) {
+                std::lock_guard<std::mutex> lock(job->mutex);
+                job->cv.notify_all();
+            }
+        });
+        parallelStrands_[i - 1]->AddTask(task);
+    }
+    if (RunParallelTasks(*job)) {
+        return;
+    }
+    // Only the tasks already running on the helpers are left.
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->cv.wait(lock, [&job]() { return job->finishedTask.load() == job->taskNum; });
+}
+
+void RenderExecutor::Schedule(const std::shared_ptr<RenderStrand> &strand)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Worker &target = *workers_[strand->worker_.load() % workers_.size()];
+    target.readyStrands.push_back(strand);
+    if (target.isIdle) {
+        target.cv.notify_one();
+        return;
+    }
+    if (strand->IsPinned()) {
+        return;
+    }
+    // The home worker is busy, let an idle worker steal the strand.
+    auto it = std::find_if(workers_.begin(), workers_.end(),
+        [](const std::unique_ptr<Worker> &worker) { return worker->isIdle; });
+    if (it != workers_.end()) {
+        (*it)->cv.notify_one();
+    }
+}
+
+std::deque<std::shared_ptr<RenderStrand>>::iterator RenderExecutor::FindUrgentStrand(
+    std::deque<std::shared_ptr<RenderStrand>> &strands, bool isStealing)
+{
+    auto urgent = strands.end();
+    RenderTaskPriority urgentPriority = RenderTaskPriority::BACKGROUND;
+    for (auto it = strands.begin(); it != strands.end(); ++it) {
+        if (isStealing && (*it)->IsPinned()) {
+            continue;
+        }
+        RenderTaskPriority priority = (*it)->GetHeadPriority();
+        if (urgent == strands.end() || priority < urgentPriority) {
+            urgent = it;
+            urgentPriority = priority;
+        }
+        if (urgentPriority == RenderTaskPriority::INTERACTIVE) {
+            break;
+        }
+    }
+    return urgent;
+}
+
+std::shared_ptr<RenderStrand> RenderExecutor::TakeStrand(size_t workerId)
+{
+    Worker &self = *workers_[workerId];
+    auto urgent = FindUrgentStrand(self.readyStrands, false);
+    if (urgent != self.readyStrands.end()) {
+        std::shared_ptr<RenderStrand> strand = *urgent;
+        self.readyStrands.erase(urgent);
+        return strand;
+    }
+    for (size_t i = 1; i < workers_.size(); ++i) {
+        Worker &victim = *workers_[(workerId + i) % workers_.size()];
+        auto it = FindUrgentStrand(victim.readyStrands, true);
+        if (it != victim.readyStrands.end()) {
+            std::shared_ptr<RenderStrand> strand = *it;
+            victim.readyStrands.erase(it);
+            strand->worker_.store(workerId);
+            return strand;
+        }
+    }
+    return nullptr;
+}
+
+void RenderExecutor::WorkerLoop(size_t workerId)
+{
+    Worker &self = *workers_[workerId];
+    g_currentWorker = workerId;
+    while (true) {
+        std::shared_ptr<RenderStrand> strand = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (!isStopped_ && (strand = TakeStrand(workerId)) == nullptr) {
+                self.isIdle = true;
+                self.cv.wait(lock);
+                self.isIdle = false;
+            }
+            if (strand == nullptr) {
+                return;
+            }
+        }
+
+        g_currentStrand = strand.get();
+        strand->Run();
+        g_currentStrand = nullptr;
+
+        // Run one task per turn so that strands of different effects are served in turn.
+        strand->isScheduled_.store(false);
+        if (strand->HasTask() && !strand->isScheduled_.exchange(true)) {
+            Schedule(strand);
+        }
+    }
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IM_RENDER_EXECUTOR_H
+#define IM_RENDER_EXECUTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "image_effect_marco_define.h"
+#include "render_priority_queue.h"
+#include "render_ring_queue.h"
+#include "render_task_itf.h"
+#include "render_work_itf.h"
+
+class RenderExecutor;
+
+/*
+ * Serial task queue of one effect on the shared executor. Tasks of a strand never run concurrently and run in
+ * priority order, FIFO within the same priority, but consecutive tasks may run on different workers unless the
+ * strand is pinned. Producers push into a lock-free ring which the consumer moves into the priority ordered queue.
+ */
+class RenderStrand : public RenderWorkerItf<RenderCommonTaskPtr>, public std::enable_shared_from_this<RenderStrand> {
+public:
+    RenderStrand(RenderExecutor &executor, size_t worker, size_t queueSize);
+    ~RenderStrand() override = default;
+
+    IMAGE_EFFECT_EXPORT void AddTask(const RenderCommonTaskPtr &task, bool overwrite = false) override;
+    IMAGE_EFFECT_EXPORT void ClearTask() override;
+    IMAGE_EFFECT_EXPORT void Start() override;
+    IMAGE_EFFECT_EXPORT void Stop() override;
+    IMAGE_EFFECT_EXPORT void WaitTaskFinished();
+    IMAGE_EFFECT_EXPORT bool IsPinned() const;
+
+protected:
+    void Run() override;
+
+private:
+    friend class RenderExecutor;
+
+    void FinishTask();
+    bool HasTask();
+    // Moves the tasks pushed so far into the priority ordered queue, called with consumerMutex_ held.
+    void TakeIncomingTasks();
+    // Priority of the task the strand runs next, used by the executor to serve the most urgent strand first.
+    RenderTaskPriority GetHeadPriority();
+
+    RenderExecutor &executor_;
+    RenderRingQueue<RenderCommonTaskPtr> queue_;
+    RenderPriorityQueue<RenderCommonTaskPtr> orderedQueue_;
+    std::atomic<size_t> orderedNum_ = 0;
+    std::mutex consumerMutex_;
+    std::atomic<bool> isWorking_ = false;
+    std::atomic<bool> isScheduled_ = false;
+    std::atomic<bool> isPinned_ = false;
+    std::atomic<size_t> worker_;
+    std::atomic<uint32_t> pendingNum_ = 0;
+    std::mutex stateMutex_;
+    std::condition_variable drainedCv_;
+};
+
+/*
+ * Process-wide pool of render workers shared by all effects. Each worker owns a list of ready strands and serves the
+ * one whose next task has the highest priority, the longest waiting among equals. An idle worker steals unpinned
+ * strands from the others. A strand which created a GL context is pinned to its worker, because the context can only
+ * be current on one thread.
+ */
+class RenderExecutor {
+public:
+    IMAGE_EFFECT_EXPORT static RenderExecutor &Instance();
+
+    IMAGE_EFFECT_EXPORT std::shared_ptr<RenderStrand> CreateStrand(size_t queueSize = DEFAULT_RING_CAPACITY);
+
+    // Pin the strand running on the calling worker to that worker, called after a GL context is made current.
+    IMAGE_EFFECT_EXPORT static void PinCurrentStrand();
+
+    IMAGE_EFFECT_EXPORT size_t GetWorkerNum() const;
+
+    /*
+     * Run func(0) .. func(taskNum - 1) on the calling thread and at most one helper strand per worker, return when
+     * all of them are done. The calling thread takes the tasks no helper has started, so it never waits for a worker
+     * busy with other work and the call is safe from a task of a strand.
+     */
+    IMAGE_EFFECT_EXPORT void ParallelFor(uint32_t taskNum, const std::function<void(uint32_t)> &func);
+
+    IMAGE_EFFECT_EXPORT explicit RenderExecutor(size_t workerNum);
+    IMAGE_EFFECT_EXPORT ~RenderExecutor();
+
+    RenderExecutor(const RenderExecutor &) = delete;
+    RenderExecutor &operator=(const RenderExecutor &) = delete;
+
+private:
+    friend class RenderStrand;
+
+    struct Worker {
+        std::deque<std::shared_ptr<RenderStrand>> readyStrands;
+        std::condition_variable cv;
+        bool isIdle = false;
+        std::thread thread;
+    };
+
+    void Schedule(const std::shared_ptr<RenderStrand> &strand);
+    void WorkerLoop(size_t workerId);
+    std::shared_ptr<RenderStrand> TakeStrand(size_t workerId);
+    static std::deque<std::shared_ptr<RenderStrand>>::iterator FindUrgentStrand(
+        std::deque<std::shared_ptr<RenderStrand>> &strands, bool isStealing);
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    bool isStopped_ = false;
+    std::atomic<size_t> nextWorker_ = 0;
+    std::once_flag parallelStrandsFlag_;
+    std::vector<std::shared_ptr<RenderStrand>> parallelStrands_;
+};
+#endif // IM_RENDER_EXECUTOR_H
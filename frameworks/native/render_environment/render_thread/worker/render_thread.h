@@ -16,6 +16,9 @@
 #ifndef IM_RENDER_THREAD_H
 #define IM_RENDER_THREAD_H
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 #include <type_traits>
 #include <shared_mutex>
@@ -23,12 +26,13 @@
 #include "render_work_itf.h"
 #include "render_queue_itf.h"
 #include "render_fifo_queue.h"
+#include "render_priority_queue.h"
+#include "render_ring_queue.h"
 #include "render_task_itf.h"
 
-#define TIME_FOR_STOP 1000
 constexpr const static int TIME_FOR_WAITING_TASK = 2500;
 
-template <typename QUEUE = RenderFifoQueue<RenderTaskPtr<void>>>
+template <typename QUEUE = RenderRingQueue<RenderTaskPtr<void>>>
 class RenderThread : public RenderWorkerItf<typename QUEUE::DataType> {
 public:
     typedef typename QUEUE::DataType LocalTaskType;
@@ -48,19 +52,22 @@ protected:
     virtual void Run() override;
 
     QUEUE *m_localMsgQueue = nullptr;
-    volatile bool m_isWorking = false;
-    volatile bool m_isStopped = true;
+    std::atomic<bool> m_isWorking = false;
+    std::atomic<bool> m_isStopped = true;
+    std::atomic<bool> m_isIdle = false;
 
     std::mutex cvMutex;
     std::shared_mutex taskMutex_;
-    std::condition_variable cvFull;
+    std::condition_variable cvDrained;
     std::condition_variable cvEmpty;
+    std::condition_variable cvState;
     std::function<void()> idleTask;
 
     std::thread *t{ nullptr };
     size_t qSize;
 
 private:
+    bool PushTask(const LocalTaskType &task, bool overwrite);
     void InternalWait();
 };
 
@@ -68,27 +75,62 @@ template <typename QUEUE>
 RenderThread<QUEUE>::RenderThread(size_t queueSize, std::function<void()> idleTask) : idleTask(idleTask),
     qSize(queueSize)
 {
-    m_localMsgQueue = new QUEUE();
+    if constexpr (std::is_constructible<QUEUE, size_t>::value) {
+        m_localMsgQueue = new QUEUE(queueSize);
+    } else {
+        m_localMsgQueue = new QUEUE();
+    }
 }
 
 template <typename QUEUE> RenderThread<QUEUE>::~RenderThread()
 {
     Stop();
-    t->join();
-    delete t;
+    if (t != nullptr) {
+        if (t->joinable()) {
+            t->join();
+        }
+        delete t;
+    }
     delete m_localMsgQueue;
 }
 
-template <typename QUEUE> void RenderThread<QUEUE>::AddTask(const LocalTaskType &task, bool overwrite)
+template <typename QUEUE> bool RenderThread<QUEUE>::PushTask(const LocalTaskType &task, bool overwrite)
 {
-    std::unique_lock<std::mutex> lk(cvMutex);
-    cvFull.wait(lk, [this]() { return (m_localMsgQueue->GetSize() < this->qSize) || (!m_isWorking); });
-    if (m_isWorking) {
+    auto isSameTag = [&task](LocalTaskType &localTask) {
+        if (GetTag(task) != GetTag(localTask)) {
+            return false;
+        }
+        localTask->SetDefaultReturn();
+        return true;
+    };
+    overwrite = overwrite || task->IsCoalesce();
+    if constexpr (QUEUE::LOCK_FREE_PUSH) {
+        if (overwrite) {
+            std::lock_guard<std::mutex> lk(cvMutex);
+            m_localMsgQueue->Remove(isSameTag);
+        }
+        return m_localMsgQueue->Push(task);
+    } else {
+        std::lock_guard<std::mutex> lk(cvMutex);
         if (overwrite) {
-            m_localMsgQueue->Remove([&task](LocalTaskType &localTask) { return GetTag(task) == GetTag(localTask); });
+            m_localMsgQueue->Remove(isSameTag);
         }
-        m_localMsgQueue->Push(task);
-        lk.unlock();
+        return m_localMsgQueue->GetSize() < this->qSize && m_localMsgQueue->Push(task);
+    }
+}
+
+template <typename QUEUE> void RenderThread<QUEUE>::AddTask(const LocalTaskType &task, bool overwrite)
+{
+    if (!m_isWorking.load()) {
+        return;
+    }
+    if (!PushTask(task, overwrite)) {
+        // Never wait for space on the producer side, release the waiters of the rejected task instead.
+        task->SetDefaultReturn();
+        return;
+    }
+    if (m_isIdle.load()) {
+        std::lock_guard<std::mutex> lk(cvMutex);
         cvEmpty.notify_one();
     }
 }
@@ -96,58 +138,84 @@ template <typename QUEUE> void RenderThread<QUEUE>::AddTask(const LocalTaskType
 template <typename QUEUE> void RenderThread<QUEUE>::ClearTask()
 {
     std::unique_lock<std::mutex> lk(cvMutex);
-    while (m_localMsgQueue->GetSize() > 0) {
-        LocalTaskType task;
-        bool ret = m_localMsgQueue->Pop(task);
-        if (ret) {
-            task->SetDefaultReturn();
-        }
+    LocalTaskType task;
+    while (m_localMsgQueue->Pop(task)) {
+        task->SetDefaultReturn();
     }
     lk.unlock();
+    cvDrained.notify_all();
 }
 
 template <typename QUEUE> void RenderThread<QUEUE>::Start()
 {
-    if (m_isStopped) {
-        m_isWorking = true;
-        t = new std::thread([this]() {
-            this->m_isStopped = false;
-            this->Run();
-            this->m_isStopped = true;
-        });
-        while (m_isStopped) {
-            std::this_thread::sleep_for(std::chrono::microseconds(TIME_FOR_STOP));
+    std::unique_lock<std::mutex> lk(cvMutex);
+    if (!m_isStopped.load()) {
+        return;
+    }
+    if (t != nullptr) {
+        if (t->joinable()) {
+            t->join();
         }
+        delete t;
     }
+    m_isWorking.store(true);
+    t = new std::thread([this]() {
+        {
+            std::lock_guard<std::mutex> lock(cvMutex);
+            this->m_isStopped.store(false);
+        }
+        cvState.notify_all();
+        this->Run();
+        {
+            std::lock_guard<std::mutex> lock(cvMutex);
+            this->m_isStopped.store(true);
+        }
+        cvState.notify_all();
+    });
+    cvState.wait(lk, [this]() { return !m_isStopped.load(); });
 }
 
 template <typename QUEUE> void RenderThread<QUEUE>::Stop()
 {
     std::unique_lock<std::mutex> lk(cvMutex);
-    m_isWorking = false;
-    lk.unlock();
+    m_isWorking.store(false);
     cvEmpty.notify_all();
-    while (!m_isStopped) {
-        std::this_thread::sleep_for(std::chrono::microseconds(TIME_FOR_STOP));
-    }
+    cvDrained.notify_all();
+    cvState.wait(lk, [this]() { return m_isStopped.load(); });
 }
 
 template <typename QUEUE> void RenderThread<QUEUE>::Run()
 {
-    while (m_isWorking) {
+    while (m_isWorking.load()) {
         std::unique_lock<std::mutex> lk(cvMutex);
-        bool cvRet = cvEmpty.wait_for(lk, std::chrono::milliseconds(TIME_FOR_WAITING_TASK),
-            [this]() { return (m_localMsgQueue->GetSize() > 0) || (!m_isWorking); });
-        if (cvRet) {
-            LocalTaskType task;
-            bool ret = m_localMsgQueue->Pop(task);
+        LocalTaskType task;
+        if (m_localMsgQueue->Pop(task)) {
             std::shared_lock<std::shared_mutex> lock(taskMutex_);
+            bool isDrained = m_localMsgQueue->GetSize() == 0;
             lk.unlock();
-            cvFull.notify_one();
-            if (ret) {
-                task->Run();
+            if (isDrained) {
+                cvDrained.notify_all();
+            }
+            if (task->IsExpired()) {
+                // Drop the frame which missed its deadline instead of rendering it late.
+                task->SetDefaultReturn();
+                continue;
             }
-        } else {
+            task->Run();
+            continue;
+        }
+        if (m_localMsgQueue->GetSize() > 0) {
+            // The head slot is reserved by a producer which has not published it yet.
+            lk.unlock();
+            std::this_thread::yield();
+            continue;
+        }
+        m_isIdle.store(true);
+        bool hasTask = cvEmpty.wait_for(lk, std::chrono::milliseconds(TIME_FOR_WAITING_TASK),
+            [this]() { return (m_localMsgQueue->GetSize() > 0) || (!m_isWorking.load()); });
+        m_isIdle.store(false);
+        if (!hasTask) {
+            // Nothing came in for TIME_FOR_WAITING_TASK, the thread is idle.
             lk.unlock();
             idleTask();
         }
@@ -157,7 +225,7 @@ template <typename QUEUE> void RenderThread<QUEUE>::Run()
 template <typename QUEUE>
 void RenderThread<QUEUE>::WaitTaskFinished()
 {
-    if (m_isWorking) {
+    if (m_isWorking.load()) {
         InternalWait();
 
         // Wait again to ensure the condition is met.
@@ -170,9 +238,9 @@ void RenderThread<QUEUE>::InternalWait()
 {
     {
         std::unique_lock<std::mutex> lk(cvMutex);
-        cvFull.wait_for(lk, std::chrono::milliseconds(TIME_FOR_WAITING_TASK),
+        cvDrained.wait_for(lk, std::chrono::milliseconds(TIME_FOR_WAITING_TASK),
             [this]() {
-                return (m_localMsgQueue->GetSize() == 0);
+                return (m_localMsgQueue->GetSize() == 0) || (!m_isWorking.load());
             });
     }
 
@@ -25,6 +25,7 @@
 #include "colorspace_helper.h"
 #include "render_environment.h"
 #include "format_helper.h"
+#include "region_helper.h"
 #include "exif_metadata.h"
 #include "v1_1/buffer_handle_meta_key_type.h"
 #include "surface_buffer.h"
@@ -117,6 +118,17 @@ ErrorCode ParseJson(const std::string &key, Any &any, EffectJsonPtr &json)
     return ErrorCode::SUCCESS;
 }
 
+ErrorCode ParseRegionJson(const std::string &key, Any &any, EffectJsonPtr &json)
+{
+    auto region = AnyCast<RenderRegion>(&any);
+    if (region == nullptr) {
+        return ErrorCode::ERR_ANY_CAST_TYPE_NOT_MATCH;
+    }
+
+    RegionHelper::PutRenderRegion(key, *region, json);
+    return ErrorCode::SUCCESS;
+}
+
 std::shared_ptr<ExtraInfo> CreateExtraInfo(PixelMap* pixelMap)
 {
     BufferType bufferType = CommonUtils::SwitchToEffectBuffType(pixelMap->GetAllocatorType());
@@ -518,6 +530,7 @@ ErrorCode CommonUtils::ParseAnyAndAddToJson(const std::string &key, Any &any, Ef
     CHECK_AND_RETURN_RET(ParseJson<float>(key, any, result) != ErrorCode::SUCCESS, ErrorCode::SUCCESS);
     CHECK_AND_RETURN_RET(ParseJson<int32_t>(key, any, result) != ErrorCode::SUCCESS, ErrorCode::SUCCESS);
     CHECK_AND_RETURN_RET(ParseJson<uint32_t>(key, any, result) != ErrorCode::SUCCESS, ErrorCode::SUCCESS);
+    CHECK_AND_RETURN_RET(ParseRegionJson(key, any, result) != ErrorCode::SUCCESS, ErrorCode::SUCCESS);
 #ifndef HST_ANY_WITH_NO_RTTI
     EFFECT_LOGE("inner any type not support switch to json! type:%{public}s", any.Type().name());
 #else
@@ -1040,6 +1053,8 @@ ErrorCode CommonUtils::ModifyPixelMapProperty(PixelMap *pixelMap, const std::sha
         EFFECT_LOGD("ModifyPixelMapProperty reuse allocated memory.");
         allocMemory->memoryData_->memoryInfo.isAutoRelease = false;
         memoryData = allocMemory->memoryData_;
+        // The pixel map owns the memory from now on, the next render must not reuse it.
+        memoryManager->RemoveMemory(allocMemory);
     } else {
         EFFECT_LOGD("ModifyPixelMapProperty alloc memory.");
         std::unique_ptr<AbsMemory> memory = EffectMemory::CreateMemory(bufferType);
@@ -1063,6 +1078,22 @@ ErrorCode CommonUtils::ModifyPixelMapProperty(PixelMap *pixelMap, const std::sha
     return ModifyPixelMapPropertyInner(memoryData, pixelMap, allocatorType, isUpdateExif, context);
 }
 
+bool CommonUtils::IsBufferAdoptable(PixelMap *pixelMap, const std::shared_ptr<EffectBuffer> &buffer,
+    const std::shared_ptr<EffectContext> &context)
+{
+    CHECK_AND_RETURN_RET(pixelMap != nullptr && buffer != nullptr && buffer->extraInfo_ != nullptr &&
+        context != nullptr && context->memoryManager_ != nullptr, false);
+    if (buffer->extraInfo_->dataType == DataType::TEX) {
+        return false;
+    }
+
+    // Only the memory allocated by the memory manager for the render can be handed over.
+    std::shared_ptr<Memory> allocMemory = context->memoryManager_->GetAllocMemoryByAddr(buffer->buffer_);
+    CHECK_AND_RETURN_RET(allocMemory != nullptr && allocMemory->isAllowModify_, false);
+    BufferType bufferType = SwitchToEffectBuffType(pixelMap->GetAllocatorType());
+    return bufferType != BufferType::DEFAULT && allocMemory->memoryData_->memoryInfo.bufferType == bufferType;
+}
+
 ErrorCode CommonUtils::ModifyPixelMapPropertyForTexture(PixelMap *pixelMap, const std::shared_ptr<EffectBuffer> &buffer,
     const std::shared_ptr<EffectContext> &context, bool isUpdateExif)
 {
@@ -64,6 +64,9 @@ public:
     static bool EndsWithHEIF(const std::string &input);
     static ErrorCode ModifyPixelMapProperty(PixelMap *pixelMap, const std::shared_ptr<EffectBuffer> &buffer,
         const std::shared_ptr<EffectContext> &context, bool isUpdateExif = true);
+    // Whether the pixel map can take the memory of the buffer over instead of a copy of the data.
+    static bool IsBufferAdoptable(PixelMap *pixelMap, const std::shared_ptr<EffectBuffer> &buffer,
+        const std::shared_ptr<EffectContext> &context);
     static ErrorCode ModifyPixelMapPropertyForTexture(PixelMap *pixelMap, const std::shared_ptr<EffectBuffer> &buffer,
         const std::shared_ptr<EffectContext> &context, bool isUpdateExif = true);
     static ErrorCode ParseNativeWindowData(std::shared_ptr<EffectBuffer> &effectBuffer, const DataType &dataType);
@@ -0,0 +1,480 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "effect_binary_helper.h"
+
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "effect_log.h"
+#include "effect_type.h"
+#include "securec.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace {
+constexpr uint32_t BITS_PER_BYTE = 8;
+constexpr uint32_t BYTE_MASK = 0xFF;
+constexpr size_t HEADER_SIZE = 12;
+constexpr size_t SIZE_OFFSET = 8;
+constexpr size_t VALUE_SIZE = 9;
+constexpr size_t FILTER_MIN_SIZE = 8;
+constexpr size_t STRING_MIN_SIZE = 4;
+constexpr uint32_t REGION_PAYLOAD_SIZE = 16;
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+enum class BinaryValueType : uint8_t {
+    FLOAT = 1,
+    INT32 = 2,
+    UINT32 = 3,
+    REGION = 4,
+};
+
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::vector<uint8_t> &data) : data_(data) {}
+
+    void WriteU8(uint8_t value)
+    {
+        data_.push_back(value);
+    }
+
+    void WriteU16(uint16_t value)
+    {
+        WriteLittleEndian(value, sizeof(value));
+    }
+
+    void WriteU32(uint32_t value)
+    {
+        WriteLittleEndian(value, sizeof(value));
+    }
+
+    void WriteString(const std::string &value)
+    {
+        WriteU32(static_cast<uint32_t>(value.size()));
+        data_.insert(data_.end(), value.begin(), value.end());
+    }
+
+    void PatchU32(size_t offset, uint32_t value)
+    {
+        for (size_t i = 0; i < sizeof(value); ++i) {
+            data_[offset + i] = static_cast<uint8_t>((value >> (i * BITS_PER_BYTE)) & BYTE_MASK);
+        }
+    }
+
+private:
+    void WriteLittleEndian(uint32_t value, size_t bytes)
+    {
+        for (size_t i = 0; i < bytes; ++i) {
+            data_.push_back(static_cast<uint8_t>((value >> (i * BITS_PER_BYTE)) & BYTE_MASK));
+        }
+    }
+
+    std::vector<uint8_t> &data_;
+};
+
+class BinaryReader {
+public:
+    BinaryReader(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+
+    size_t GetRemaining() const
+    {
+        return size_ - offset_;
+    }
+
+    bool ReadU8(uint8_t &value)
+    {
+        CHECK_AND_RETURN_RET(GetRemaining() >= sizeof(value), false);
+        value = data_[offset_++];
+        return true;
+    }
+
+    bool ReadU16(uint16_t &value)
+    {
+        uint32_t result = 0;
+        CHECK_AND_RETURN_RET(ReadLittleEndian(result, sizeof(value)), false);
+        value = static_cast<uint16_t>(result);
+        return true;
+    }
+
+    bool ReadU32(uint32_t &value)
+    {
+        return ReadLittleEndian(value, sizeof(value));
+    }
+
+    bool ReadString(std::string &value)
+    {
+        uint32_t length = 0;
+        CHECK_AND_RETURN_RET(ReadU32(length) && GetRemaining() >= length, false);
+        value.assign(reinterpret_cast<const char *>(data_ + offset_), length);
+        offset_ += length;
+        return true;
+    }
+
+private:
+    bool ReadLittleEndian(uint32_t &value, size_t bytes)
+    {
+        CHECK_AND_RETURN_RET(GetRemaining() >= bytes, false);
+        value = 0;
+        for (size_t i = 0; i < bytes; ++i) {
+            value |= static_cast<uint32_t>(data_[offset_++]) << (i * BITS_PER_BYTE);
+        }
+        return true;
+    }
+
+    const uint8_t *data_;
+    size_t size_;
+    size_t offset_ = 0;
+};
+
+class StringTable {
+public:
+    uint32_t Intern(const std::string &value)
+    {
+        auto it = indexes_.find(value);
+        if (it != indexes_.end()) {
+            return it->second;
+        }
+        uint32_t index = static_cast<uint32_t>(strings_.size());
+        strings_.emplace_back(value);
+        indexes_.emplace(value, index);
+        return index;
+    }
+
+    const std::vector<std::string> &GetStrings() const
+    {
+        return strings_;
+    }
+
+private:
+    std::vector<std::string> strings_;
+    std::unordered_map<std::string, uint32_t> indexes_;
+};
+
+template <typename ValueType>
+uint32_t ToBits(ValueType value)
+{
+    static_assert(sizeof(ValueType) == sizeof(uint32_t), "value size is mismatched!");
+    uint32_t bits = 0;
+    (void)memcpy_s(&bits, sizeof(bits), &value, sizeof(value));
+    return bits;
+}
+
+template <typename ValueType>
+ValueType FromBits(uint32_t bits)
+{
+    static_assert(sizeof(ValueType) == sizeof(uint32_t), "value size is mismatched!");
+    ValueType value;
+    (void)memcpy_s(&value, sizeof(value), &bits, sizeof(bits));
+    return value;
+}
+
+struct EncodedValue {
+    uint32_t keyIndex_ = 0;
+    BinaryValueType type_ = BinaryValueType::FLOAT;
+    uint32_t bits_ = 0;
+    // Only for the types longer than 4 bytes, whose bits are then the size of the payload.
+    std::vector<uint32_t> payload_;
+};
+
+bool EncodeValue(const Any &any, EncodedValue &encoded)
+{
+    BinaryValueType &type = encoded.type_;
+    uint32_t &bits = encoded.bits_;
+    if (auto value = AnyCast<float>(&any)) {
+        type = BinaryValueType::FLOAT;
+        bits = ToBits(*value);
+        return true;
+    }
+    if (auto value = AnyCast<int32_t>(&any)) {
+        type = BinaryValueType::INT32;
+        bits = ToBits(*value);
+        return true;
+    }
+    if (auto value = AnyCast<uint32_t>(&any)) {
+        type = BinaryValueType::UINT32;
+        bits = *value;
+        return true;
+    }
+    if (auto region = AnyCast<RenderRegion>(&any)) {
+        type = BinaryValueType::REGION;
+        bits = REGION_PAYLOAD_SIZE;
+        encoded.payload_ = { ToBits(region->x0), ToBits(region->y0), ToBits(region->x1), ToBits(region->y1) };
+        return true;
+    }
+    return false;
+}
+
+bool DecodeRegion(BinaryReader &reader, uint32_t size, Any &any)
+{
+    CHECK_AND_RETURN_RET(size == REGION_PAYLOAD_SIZE, false);
+    uint32_t x0 = 0;
+    uint32_t y0 = 0;
+    uint32_t x1 = 0;
+    uint32_t y1 = 0;
+    CHECK_AND_RETURN_RET(reader.ReadU32(x0) && reader.ReadU32(y0) && reader.ReadU32(x1) && reader.ReadU32(y1), false);
+    RenderRegion region;
+    region.x0 = FromBits<int32_t>(x0);
+    region.y0 = FromBits<int32_t>(y0);
+    region.x1 = FromBits<int32_t>(x1);
+    region.y1 = FromBits<int32_t>(y1);
+    any = region;
+    return true;
+}
+
+bool DecodeValue(BinaryReader &reader, uint8_t type, uint32_t bits, Any &any)
+{
+    switch (static_cast<BinaryValueType>(type)) {
+        case BinaryValueType::FLOAT:
+            any = FromBits<float>(bits);
+            return true;
+        case BinaryValueType::INT32:
+            any = FromBits<int32_t>(bits);
+            return true;
+        case BinaryValueType::UINT32:
+            any = bits;
+            return true;
+        case BinaryValueType::REGION:
+            return DecodeRegion(reader, bits, any);
+        default:
+            return false;
+    }
+}
+
+bool ReadName(BinaryReader &reader, const std::vector<std::string> &strings, std::string &name)
+{
+    uint32_t index = 0;
+    CHECK_AND_RETURN_RET(reader.ReadU32(index) && index < strings.size(), false);
+    name = strings[index];
+    return true;
+}
+
+bool DecodeFilter(BinaryReader &reader, const std::vector<std::string> &strings, EffectFilterPrototype &filter)
+{
+    uint32_t valueCount = 0;
+    CHECK_AND_RETURN_RET_LOG(ReadName(reader, strings, filter.name_) && !filter.name_.empty() &&
+        reader.ReadU32(valueCount) && reader.GetRemaining() / VALUE_SIZE >= valueCount, false,
+        "DecodeFilter: invalid filter!");
+
+    filter.values_.reserve(valueCount);
+    for (uint32_t i = 0; i < valueCount; ++i) {
+        std::string key;
+        uint8_t type = 0;
+        uint32_t bits = 0;
+        Any any;
+        CHECK_AND_RETURN_RET_LOG(ReadName(reader, strings, key) && reader.ReadU8(type) && reader.ReadU32(bits) &&
+            DecodeValue(reader, type, bits, any), false, "DecodeFilter: invalid value! filter=%{public}s, index=%{public}u",
+            filter.name_.c_str(), i);
+        filter.values_.emplace_back(key, std::move(any));
+    }
+    return true;
+}
+
+ErrorCode DecodeChain(const uint8_t *data, size_t size, EffectChainPrototype &chain)
+{
+    BinaryReader reader(data, size);
+    uint32_t magic = 0;
+    uint16_t version = 0;
+    uint16_t reserved = 0;
+    uint32_t dataSize = 0;
+    CHECK_AND_RETURN_RET_LOG(reader.ReadU32(magic) && reader.ReadU16(version) && reader.ReadU16(reserved) &&
+        reader.ReadU32(dataSize), ErrorCode::ERR_INVALID_BINARY_DATA, "DecodeChain: header is too short!");
+    CHECK_AND_RETURN_RET_LOG(magic == EffectBinaryHelper::BINARY_MAGIC && dataSize == size,
+        ErrorCode::ERR_INVALID_BINARY_DATA, "DecodeChain: invalid header! magic=%{public}x, size=%{public}u",
+        magic, dataSize);
+    CHECK_AND_RETURN_RET_LOG(version <= EffectBinaryHelper::BINARY_VERSION, ErrorCode::ERR_INVALID_BINARY_DATA,
+        "DecodeChain: version is too high! version=%{public}u", version);
+
+    uint32_t stringCount = 0;
+    CHECK_AND_RETURN_RET_LOG(reader.ReadU32(stringCount) && reader.GetRemaining() / STRING_MIN_SIZE >= stringCount,
+        ErrorCode::ERR_INVALID_BINARY_DATA, "DecodeChain: invalid string count!");
+    std::vector<std::string> strings(stringCount);
+    for (auto &string : strings) {
+        CHECK_AND_RETURN_RET_LOG(reader.ReadString(string), ErrorCode::ERR_INVALID_BINARY_DATA,
+            "DecodeChain: invalid string!");
+    }
+
+    uint32_t filterCount = 0;
+    CHECK_AND_RETURN_RET_LOG(ReadName(reader, strings, chain.name_) && reader.ReadU32(filterCount) &&
+        reader.GetRemaining() / FILTER_MIN_SIZE >= filterCount, ErrorCode::ERR_INVALID_BINARY_DATA,
+        "DecodeChain: invalid chain!");
+    chain.filters_.resize(filterCount);
+    for (auto &filter : chain.filters_) {
+        CHECK_AND_RETURN_RET(DecodeFilter(reader, strings, filter), ErrorCode::ERR_INVALID_BINARY_DATA);
+    }
+    CHECK_AND_RETURN_RET_LOG(reader.GetRemaining() == 0, ErrorCode::ERR_INVALID_BINARY_DATA,
+        "DecodeChain: trailing data! remaining=%{public}zu", reader.GetRemaining());
+    return ErrorCode::SUCCESS;
+}
+
+uint64_t HashData(const uint8_t *data, size_t size)
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+// Least recently used chains, the data is kept along to tell apart the chains whose hashes collide.
+class ChainCache {
+public:
+    std::shared_ptr<const EffectChainPrototype> Find(uint64_t hash, const uint8_t *data, size_t size)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(hash);
+        if (it == entries_.end()) {
+            return nullptr;
+        }
+        const std::vector<uint8_t> &cachedData = it->second->data_;
+        if (cachedData.size() != size || memcmp(cachedData.data(), data, size) != 0) {
+            return nullptr;
+        }
+        order_.splice(order_.begin(), order_, it->second);
+        return it->second->chain_;
+    }
+
+    void Insert(uint64_t hash, const uint8_t *data, size_t size,
+        const std::shared_ptr<const EffectChainPrototype> &chain)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(hash);
+        if (it != entries_.end()) {
+            order_.erase(it->second);
+            entries_.erase(it);
+        }
+        order_.push_front({ hash, std::vector<uint8_t>(data, data + size), chain });
+        entries_.emplace(hash, order_.begin());
+        if (order_.size() > EffectBinaryHelper::CHAIN_CACHE_CAPACITY) {
+            entries_.erase(order_.back().hash_);
+            order_.pop_back();
+        }
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+        order_.clear();
+    }
+
+    size_t GetSize()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return order_.size();
+    }
+
+private:
+    struct Entry {
+        uint64_t hash_;
+        std::vector<uint8_t> data_;
+        std::shared_ptr<const EffectChainPrototype> chain_;
+    };
+
+    std::mutex mutex_;
+    std::list<Entry> order_;
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> entries_;
+};
+
+ChainCache &GetChainCache()
+{
+    static ChainCache cache;
+    return cache;
+}
+} // namespace
+
+ErrorCode EffectBinaryHelper::Encode(const EffectChainPrototype &chain, std::vector<uint8_t> &data)
+{
+    StringTable strings;
+    std::vector<uint8_t> body;
+    BinaryWriter bodyWriter(body);
+    bodyWriter.WriteU32(strings.Intern(chain.name_));
+    bodyWriter.WriteU32(static_cast<uint32_t>(chain.filters_.size()));
+    for (const auto &filter : chain.filters_) {
+        CHECK_AND_RETURN_RET_LOG(!filter.name_.empty(), ErrorCode::ERR_INPUT_NULL, "Encode: filter name is empty!");
+        std::vector<EncodedValue> values;
+        for (const auto &value : filter.values_) {
+            EncodedValue encoded;
+            if (!EncodeValue(value.second, encoded)) {
+                EFFECT_LOGE("Encode: not support switch to binary! filter=%{public}s, key=%{public}s",
+                    filter.name_.c_str(), value.first.c_str());
+                continue;
+            }
+            encoded.keyIndex_ = strings.Intern(value.first);
+            values.emplace_back(std::move(encoded));
+        }
+
+        bodyWriter.WriteU32(strings.Intern(filter.name_));
+        bodyWriter.WriteU32(static_cast<uint32_t>(values.size()));
+        for (const auto &value : values) {
+            bodyWriter.WriteU32(value.keyIndex_);
+            bodyWriter.WriteU8(static_cast<uint8_t>(value.type_));
+            bodyWriter.WriteU32(value.bits_);
+            for (uint32_t word : value.payload_) {
+                bodyWriter.WriteU32(word);
+            }
+        }
+    }
+
+    data.clear();
+    BinaryWriter writer(data);
+    writer.WriteU32(BINARY_MAGIC);
+    writer.WriteU16(BINARY_VERSION);
+    writer.WriteU16(0);
+    writer.WriteU32(0);
+    writer.WriteU32(static_cast<uint32_t>(strings.GetStrings().size()));
+    for (const auto &string : strings.GetStrings()) {
+        writer.WriteString(string);
+    }
+    data.insert(data.end(), body.begin(), body.end());
+    writer.PatchU32(SIZE_OFFSET, static_cast<uint32_t>(data.size()));
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode EffectBinaryHelper::Decode(const uint8_t *data, size_t size,
+    std::shared_ptr<const EffectChainPrototype> &chain)
+{
+    CHECK_AND_RETURN_RET_LOG(data != nullptr && size >= HEADER_SIZE, ErrorCode::ERR_INVALID_BINARY_DATA,
+        "Decode: data is too short! size=%{public}zu", size);
+    uint64_t hash = HashData(data, size);
+    chain = GetChainCache().Find(hash, data, size);
+    if (chain != nullptr) {
+        return ErrorCode::SUCCESS;
+    }
+
+    std::shared_ptr<EffectChainPrototype> decodedChain = std::make_shared<EffectChainPrototype>();
+    ErrorCode res = DecodeChain(data, size, *decodedChain);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "Decode: decode chain fail! res=%{public}d", res);
+    GetChainCache().Insert(hash, data, size, decodedChain);
+    chain = decodedChain;
+    return ErrorCode::SUCCESS;
+}
+
+void EffectBinaryHelper::ClearCache()
+{
+    GetChainCache().Clear();
+}
+
+size_t EffectBinaryHelper::GetCacheSize()
+{
+    return GetChainCache().GetSize();
+}
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -15,13 +15,190 @@
 
 #include "memcpy_helper.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#if !defined(__clang__) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "securec.h"
 #include "effect_log.h"
 #include "format_helper.h"
+#include "effect_render_profile.h"
+#include "render_executor.h"
 
 namespace OHOS {
 namespace Media {
 namespace Effect {
+namespace {
+// Copies smaller than this per participating thread are not worth a hand over to the render workers.
+constexpr uint64_t PARALLEL_COPY_MIN_BYTES_PER_TASK = 4 * 1024 * 1024;
+// Copies larger than this do not fit in the last level cache of most devices, so the destination is written with
+// non-temporal stores instead of evicting the working set of the filters.
+constexpr uint64_t NON_TEMPORAL_COPY_MIN_BYTES = 8 * 1024 * 1024;
+constexpr uint32_t NON_TEMPORAL_BLOCK_SIZE = 16;
+constexpr uint32_t LINEAR_COPY_CHUNK_SIZE = 256 * 1024;
+
+std::atomic<uint64_t> g_copiedBytes = 0;
+
+// Rows of one plane, a linear copy is split into rows of LINEAR_COPY_CHUNK_SIZE so it can be shared among threads.
+struct CopyPlane {
+    const uint8_t *src = nullptr;
+    uint8_t *dst = nullptr;
+    uint32_t srcStride = 0;
+    uint32_t dstStride = 0;
+    uint32_t rowBytes = 0;
+    uint32_t rowCount = 0;
+};
+
+struct CopyJob {
+    std::vector<CopyPlane> planes;
+    bool nonTemporal = false;
+    uint32_t taskNum = 1;
+};
+
+void CopyRowNonTemporal(uint8_t *dst, const uint8_t *src, size_t len)
+{
+#if defined(__clang__) || defined(__SSE2__)
+    size_t head = (NON_TEMPORAL_BLOCK_SIZE - reinterpret_cast<uintptr_t>(dst) % NON_TEMPORAL_BLOCK_SIZE) %
+        NON_TEMPORAL_BLOCK_SIZE;
+    head = std::min(head, len);
+    memcpy(dst, src, head);
+    size_t blockNum = (len - head) / NON_TEMPORAL_BLOCK_SIZE;
+    uint8_t *blockDst = dst + head;
+    const uint8_t *blockSrc = src + head;
+    for (size_t i = 0; i < blockNum; ++i) {
+#if defined(__clang__)
+        using Block = uint64_t __attribute__((vector_size(NON_TEMPORAL_BLOCK_SIZE)));
+        Block block;
+        memcpy(&block, blockSrc + i * NON_TEMPORAL_BLOCK_SIZE, NON_TEMPORAL_BLOCK_SIZE);
+        __builtin_nontemporal_store(block, reinterpret_cast<Block *>(blockDst) + i);
+#else
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(blockSrc) + i);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(blockDst) + i, block);
+#endif
+    }
+    size_t copied = head + blockNum * NON_TEMPORAL_BLOCK_SIZE;
+    memcpy(dst + copied, src + copied, len - copied);
+#else
+    memcpy(dst, src, len);
+#endif
+}
+
+void RunCopyTask(const CopyJob &job, uint32_t task)
+{
+    for (const CopyPlane &plane : job.planes) {
+        uint32_t beginRow = static_cast<uint32_t>(static_cast<uint64_t>(plane.rowCount) * task / job.taskNum);
+        uint32_t endRow = static_cast<uint32_t>(static_cast<uint64_t>(plane.rowCount) * (task + 1) / job.taskNum);
+        for (uint32_t row = beginRow; row < endRow; ++row) {
+            uint8_t *dst = plane.dst + static_cast<size_t>(row) * plane.dstStride;
+            const uint8_t *src = plane.src + static_cast<size_t>(row) * plane.srcStride;
+            if (job.nonTemporal) {
+                CopyRowNonTemporal(dst, src, plane.rowBytes);
+            } else {
+                errno_t ret = memcpy_s(dst, plane.rowBytes, src, plane.rowBytes);
+                CHECK_AND_RETURN_LOG(ret == EOK, "RunCopyTask: memcpy_s failed. ret=%{public}d, row=%{public}u",
+                    ret, row);
+            }
+        }
+    }
+    if (job.nonTemporal) {
+        // Non-temporal stores are weakly ordered, publish them before the task is reported as finished.
+#if !defined(__clang__) && defined(__SSE2__)
+        _mm_sfence();
+#else
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+#endif
+    }
+}
+
+uint32_t GetCopyTaskNum(uint64_t totalBytes)
+{
+    uint64_t taskNum = totalBytes / PARALLEL_COPY_MIN_BYTES_PER_TASK;
+    if (taskNum <= 1) {
+        return 1;
+    }
+    // The calling thread takes part in the copy as well.
+    return static_cast<uint32_t>(std::min<uint64_t>(taskNum, RenderExecutor::Instance().GetWorkerNum() + 1));
+}
+
+void AddLinearPlane(const uint8_t *src, uint8_t *dst, uint64_t len, std::vector<CopyPlane> &planes)
+{
+    uint32_t chunkNum = static_cast<uint32_t>(len / LINEAR_COPY_CHUNK_SIZE);
+    if (chunkNum > 0) {
+        planes.push_back({ src, dst, LINEAR_COPY_CHUNK_SIZE, LINEAR_COPY_CHUNK_SIZE, LINEAR_COPY_CHUNK_SIZE,
+            chunkNum });
+    }
+    uint64_t chunkBytes = static_cast<uint64_t>(chunkNum) * LINEAR_COPY_CHUNK_SIZE;
+    if (len > chunkBytes) {
+        planes.push_back({ src + chunkBytes, dst + chunkBytes, 0, 0, static_cast<uint32_t>(len - chunkBytes), 1 });
+    }
+}
+
+bool IsYuvFormat(IEffectFormat format)
+{
+    return format == IEffectFormat::YUVNV12 || format == IEffectFormat::YUVNV21 ||
+        format == IEffectFormat::YCBCR_P010 || format == IEffectFormat::YCRCB_P010;
+}
+
+bool CheckPlaneRange(uint32_t offset, uint32_t stride, uint32_t rowCount, uint32_t rowBytes, uint32_t len)
+{
+    if (rowCount == 0) {
+        return true;
+    }
+    uint64_t end = static_cast<uint64_t>(offset) + static_cast<uint64_t>(stride) * (rowCount - 1) + rowBytes;
+    return end <= len;
+}
+
+// Build the rows to copy by plane, so that the chroma plane of yuv lands right after the luma plane of the
+// destination even if the heights of the buffers differ. Only the pixel bytes of a row are copied, not the padding.
+bool BuildStridedPlanes(CopyInfo &src, CopyInfo &dst, std::vector<CopyPlane> &planes)
+{
+    BufferInfo &srcInfo = src.bufferInfo;
+    BufferInfo &dstInfo = dst.bufferInfo;
+    uint32_t rowBytes = std::min(srcInfo.rowStride_, dstInfo.rowStride_);
+    uint32_t pixelRowBytes = FormatHelper::CalculateRowStride(std::max(srcInfo.width_, dstInfo.width_),
+        dstInfo.formatType_);
+    if (pixelRowBytes > 0 && srcInfo.formatType_ == dstInfo.formatType_) {
+        rowBytes = std::min(rowBytes, pixelRowBytes);
+    }
+    uint32_t srcRowCount = FormatHelper::CalculateDataRowCount(srcInfo.height_, srcInfo.formatType_);
+    uint32_t dstRowCount = FormatHelper::CalculateDataRowCount(dstInfo.height_, dstInfo.formatType_);
+
+    bool isPlanar = IsYuvFormat(srcInfo.formatType_) && srcInfo.formatType_ == dstInfo.formatType_;
+    uint32_t lumaRowCount = isPlanar ? std::min(srcInfo.height_, dstInfo.height_) : std::min(srcRowCount, dstRowCount);
+    uint32_t chromaRowCount = isPlanar ?
+        std::min(srcRowCount - srcInfo.height_, dstRowCount - dstInfo.height_) : 0;
+    uint32_t srcChromaOffset = srcInfo.rowStride_ * srcInfo.height_;
+    uint32_t dstChromaOffset = dstInfo.rowStride_ * dstInfo.height_;
+    if (!CheckPlaneRange(0, srcInfo.rowStride_, lumaRowCount, rowBytes, srcInfo.len_) ||
+        !CheckPlaneRange(0, dstInfo.rowStride_, lumaRowCount, rowBytes, dstInfo.len_) ||
+        !CheckPlaneRange(srcChromaOffset, srcInfo.rowStride_, chromaRowCount, rowBytes, srcInfo.len_) ||
+        !CheckPlaneRange(dstChromaOffset, dstInfo.rowStride_, chromaRowCount, rowBytes, dstInfo.len_)) {
+        return false;
+    }
+
+    planes.push_back({ src.data, dst.data, srcInfo.rowStride_, dstInfo.rowStride_, rowBytes, lumaRowCount });
+    if (chromaRowCount > 0) {
+        planes.push_back({ src.data + srcChromaOffset, dst.data + dstChromaOffset, srcInfo.rowStride_,
+            dstInfo.rowStride_, rowBytes, chromaRowCount });
+    }
+    return true;
+}
+
+uint64_t GetPlanesBytes(const std::vector<CopyPlane> &planes)
+{
+    uint64_t bytes = 0;
+    for (const CopyPlane &plane : planes) {
+        bytes += static_cast<uint64_t>(plane.rowBytes) * plane.rowCount;
+    }
+    return bytes;
+}
+} // namespace
+
 void MemcpyHelper::CopyData(CopyInfo &src, CopyInfo &dst)
 {
     uint8_t *srcBuffet = src.data;
@@ -34,50 +211,42 @@ void MemcpyHelper::CopyData(CopyInfo &src, CopyInfo &dst)
 
     BufferInfo &srcInfo = src.bufferInfo;
     BufferInfo &dstInfo = dst.bufferInfo;
+    EffectProfileScope profileScope(ProfileStage::MEMCPY, "MemcpyHelper::CopyData");
     EFFECT_LOGD("CopyData: srcH=%{public}d, srcFormat=%{public}d, srcStride=%{public}d, "
         "srcLen=%{public}d, dstH=%{public}d, dstFormat=%{public}d, dstStride=%{public}d, "
         "dstLen=%{public}d", srcInfo.height_, srcInfo.formatType_, srcInfo.rowStride_, srcInfo.len_,
         dstInfo.height_, dstInfo.formatType_, dstInfo.rowStride_, dstInfo.len_);
-    uint32_t srcRowStride = srcInfo.rowStride_;
-    uint32_t dstRowStride = dstInfo.rowStride_;
-    uint32_t srcBufferLen = srcInfo.len_;
-    uint32_t dstBufferLen = dstInfo.len_;
 
+    CopyJob job;
     // direct copy the date while the size is same.
-    if (srcRowStride == dstRowStride && srcBufferLen == dstBufferLen) {
-        errno_t ret = memcpy_s(dstBuffer, dstBufferLen, srcBuffet, srcBufferLen);
-        if (ret != 0) {
-            EFFECT_LOGE("CopyData memcpy_s failed. ret=%{public}d, dstBufLen=%{public}d,"
-                "srcBufLen=%{public}d", ret, dstBufferLen, srcBufferLen);
-        }
-        return;
-    }
-
-    // copy by row
-    uint32_t srcRowCount = FormatHelper::CalculateDataRowCount(srcInfo.height_, srcInfo.formatType_);
-    uint32_t dstRowCount = FormatHelper::CalculateDataRowCount(dstInfo.height_, dstInfo.formatType_);
-    uint32_t rowCount = srcRowCount > dstRowCount ? dstRowCount : srcRowCount;
-    uint32_t count = srcRowStride > dstRowStride ? dstRowStride : srcRowStride;
-    if (rowCount != 0 && (dstRowStride > dstBufferLen / rowCount || srcRowStride > srcBufferLen / rowCount)) {
+    if (srcInfo.rowStride_ == dstInfo.rowStride_ && srcInfo.len_ == dstInfo.len_) {
+        AddLinearPlane(srcBuffet, dstBuffer, dstInfo.len_, job.planes);
+    } else if (!BuildStridedPlanes(src, dst, job.planes)) {
         EFFECT_LOGE("Out of buffer available range! Copy fail! srcH=%{public}d, srcFormat=%{public}d, "
             "srcStride=%{public}d, srcLen=%{public}d, dstH=%{public}d, dstFormat=%{public}d, dstStride=%{public}d, "
             "dstLen=%{public}d", srcInfo.height_, srcInfo.formatType_, srcInfo.rowStride_, srcInfo.len_,
             dstInfo.height_, dstInfo.formatType_, dstInfo.rowStride_, dstInfo.len_);
         return;
     }
-    for (uint32_t i = 0; i < rowCount; i++) {
-        errno_t ret = memcpy_s(dstBuffer + i * dstRowStride, dstRowStride, srcBuffet + i * srcRowStride, count);
-        if (ret != 0) {
-            EFFECT_LOGE("CopyData: copy by row memcpy_s failed. ret=%{public}d, row=%{public}d, srcH=%{public}d, "
-                "srcFormat=%{public}d, srcStride=%{public}d, srcLen=%{public}d, dstH=%{public}d, dstFormat=%{public}d, "
-                "dstStride=%{public}d, dstLen=%{public}d", ret, i,
-                srcInfo.height_, srcInfo.formatType_, srcInfo.rowStride_, srcInfo.len_,
-                dstInfo.height_, dstInfo.formatType_, dstInfo.rowStride_, dstInfo.len_);
-            continue;
-        }
+
+    uint64_t copyBytes = GetPlanesBytes(job.planes);
+    job.nonTemporal = copyBytes >= NON_TEMPORAL_COPY_MIN_BYTES;
+    job.taskNum = GetCopyTaskNum(copyBytes);
+    RenderExecutor::Instance().ParallelFor(job.taskNum, [&job](uint32_t task) { RunCopyTask(job, task); });
+    g_copiedBytes.fetch_add(copyBytes, std::memory_order_relaxed);
+
+    if (profileScope.IsEnabled()) {
+        profileScope.SetBytes(copyBytes);
+        profileScope.SetDetail("format=" + std::to_string(static_cast<int32_t>(dstInfo.formatType_)) +
+            ",tasks=" + std::to_string(job.taskNum) + ",nonTemporal=" + std::to_string(job.nonTemporal));
     }
 }
 
+uint64_t MemcpyHelper::GetCopiedBytes()
+{
+    return g_copiedBytes.load(std::memory_order_relaxed);
+}
+
 void CreateCopyInfoByEffectBuffer(EffectBuffer *buffer, CopyInfo &info)
 {
     info = {
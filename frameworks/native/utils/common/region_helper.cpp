@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "region_helper.h"
+
+#include <algorithm>
+
+#include "effect_log.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace {
+const std::string KEY_FILTER_REGION = "FilterRegion";
+const std::string KEY_REGION_X0 = "x0";
+const std::string KEY_REGION_Y0 = "y0";
+const std::string KEY_REGION_X1 = "x1";
+const std::string KEY_REGION_Y1 = "y1";
+constexpr int CHROMA_SUBSAMPLE_FACTOR = 2;
+
+RenderROI RegionToROI(const RenderRegion &region, int width, int height)
+{
+    double left = std::clamp(std::min(region.x0, region.x1), 0, width);
+    double right = std::clamp(std::max(region.x0, region.x1), 0, width);
+    double bottom = std::clamp(std::min(region.y0, region.y1), 0, height);
+    double top = std::clamp(std::max(region.y0, region.y1), 0, height);
+    return RenderROI(width, height, left / width, right / width, bottom / height, top / height);
+}
+} // namespace
+
+ErrorCode RegionHelper::ParseRenderRegion(const Any &value, RenderRegion &region)
+{
+    auto regionPtr = AnyCast<RenderRegion>(&value);
+    if (regionPtr != nullptr) {
+        region = *regionPtr;
+        return ErrorCode::SUCCESS;
+    }
+    auto areaPtr = AnyCast<void *>(&value);
+    CHECK_AND_RETURN_RET_LOG(areaPtr != nullptr && *areaPtr != nullptr, ErrorCode::ERR_ANY_CAST_TYPE_NOT_MATCH,
+        "ParseRenderRegion: the value is not a region!");
+    region = *static_cast<const RenderRegion *>(*areaPtr);
+    return ErrorCode::SUCCESS;
+}
+
+bool RegionHelper::GetFilterRegion(const std::map<std::string, Any> &values, RenderRegion &region)
+{
+    auto it = values.find(KEY_FILTER_REGION);
+    return it != values.end() && ParseRenderRegion(it->second, region) == ErrorCode::SUCCESS;
+}
+
+void RegionHelper::PutRenderRegion(const std::string &key, const RenderRegion &region, EffectJsonPtr &json)
+{
+    EffectJsonPtr regionJson = EffectJsonHelper::CreateObject();
+    regionJson->Put(KEY_REGION_X0, region.x0);
+    regionJson->Put(KEY_REGION_Y0, region.y0);
+    regionJson->Put(KEY_REGION_X1, region.x1);
+    regionJson->Put(KEY_REGION_Y1, region.y1);
+    json->Put(key, regionJson);
+}
+
+bool RegionHelper::GetFilterRegion(const EffectJsonPtr &values, RenderRegion &region)
+{
+    CHECK_AND_RETURN_RET(values != nullptr && values->HasElement(KEY_FILTER_REGION), false);
+    EffectJsonPtr regionJson = values->GetElement(KEY_FILTER_REGION);
+    CHECK_AND_RETURN_RET_LOG(regionJson != nullptr && regionJson->IsObject() &&
+        regionJson->HasElement(KEY_REGION_X0) && regionJson->HasElement(KEY_REGION_Y0) &&
+        regionJson->HasElement(KEY_REGION_X1) && regionJson->HasElement(KEY_REGION_Y1), false,
+        "GetFilterRegion: the saved region is malformed!");
+    region.x0 = regionJson->GetInt(KEY_REGION_X0);
+    region.y0 = regionJson->GetInt(KEY_REGION_Y0);
+    region.x1 = regionJson->GetInt(KEY_REGION_X1);
+    region.y1 = regionJson->GetInt(KEY_REGION_Y1);
+    return true;
+}
+
+RenderROI RegionHelper::GetRenderROI(std::map<std::string, Any> &values, const std::shared_ptr<EffectContext> &context,
+    uint32_t width, uint32_t height, bool isChromaAligned)
+{
+    RenderRegion region;
+    bool hasRegion = GetFilterRegion(values, region);
+    return GetRenderROI(hasRegion ? &region : nullptr, context, width, height, isChromaAligned);
+}
+
+RenderROI RegionHelper::GetRenderROI(const RenderRegion *filterRegion, const std::shared_ptr<EffectContext> &context,
+    uint32_t width, uint32_t height, bool isChromaAligned)
+{
+    int w = static_cast<int>(width);
+    int h = static_cast<int>(height);
+    RenderROI roi(w, h, 0.0, 1.0, 0.0, 1.0);
+    CHECK_AND_RETURN_RET(w > 0 && h > 0, roi);
+
+    if (filterRegion != nullptr) {
+        roi.Intersect(RegionToROI(*filterRegion, w, h));
+    }
+    if (context != nullptr && context->renderRegion_ != nullptr) {
+        roi.Intersect(RegionToROI(*context->renderRegion_, w, h));
+    }
+    if (!isChromaAligned || roi.IsEmpty() || roi.IsFullFrame()) {
+        return roi;
+    }
+
+    // A chroma sample is shared by 2x2 pixels, the region is widened to whole samples.
+    RenderRegion region;
+    region.x0 = roi.Left() / CHROMA_SUBSAMPLE_FACTOR * CHROMA_SUBSAMPLE_FACTOR;
+    region.y0 = roi.Bottom() / CHROMA_SUBSAMPLE_FACTOR * CHROMA_SUBSAMPLE_FACTOR;
+    region.x1 = std::min(w, (roi.Right() + 1) / CHROMA_SUBSAMPLE_FACTOR * CHROMA_SUBSAMPLE_FACTOR);
+    region.y1 = std::min(h, (roi.Top() + 1) / CHROMA_SUBSAMPLE_FACTOR * CHROMA_SUBSAMPLE_FACTOR);
+    return RegionToROI(region, w, h);
+}
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
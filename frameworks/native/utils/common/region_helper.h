@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_REGION_HELPER_H
+#define IMAGE_EFFECT_REGION_HELPER_H
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "any.h"
+#include "base/math/render_roi.h"
+#include "effect_context.h"
+#include "effect_json_helper.h"
+#include "effect_type.h"
+#include "error_code.h"
+#include "image_effect_marco_define.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+class RegionHelper final {
+public:
+    // Parses the region value of a filter or an image effect, a pointer to ImageEffect_Region or a RenderRegion.
+    IMAGE_EFFECT_EXPORT static ErrorCode ParseRenderRegion(const Any &value, RenderRegion &region);
+
+    // Part of the width x height buffer rendered by a pointwise filter: the filter region intersected with the region
+    // of the image effect, the full frame when neither is set. Widened to even pixels for the subsampled chroma.
+    IMAGE_EFFECT_EXPORT static RenderROI GetRenderROI(std::map<std::string, Any> &values,
+        const std::shared_ptr<EffectContext> &context, uint32_t width, uint32_t height, bool isChromaAligned = false);
+
+    // Same with the filter region already parsed, null when the filter has none.
+    IMAGE_EFFECT_EXPORT static RenderROI GetRenderROI(const RenderRegion *filterRegion,
+        const std::shared_ptr<EffectContext> &context, uint32_t width, uint32_t height, bool isChromaAligned = false);
+
+    // Parses the region value among the values of a filter, false when it is not set.
+    IMAGE_EFFECT_EXPORT static bool GetFilterRegion(const std::map<std::string, Any> &values, RenderRegion &region);
+
+    // Puts the region under the key as an object of x0, y0, x1 and y1.
+    IMAGE_EFFECT_EXPORT static void PutRenderRegion(const std::string &key, const RenderRegion &region,
+        EffectJsonPtr &json);
+
+    // Parses the region among the saved json values of a filter, false when it is not set or malformed.
+    IMAGE_EFFECT_EXPORT static bool GetFilterRegion(const EffectJsonPtr &values, RenderRegion &region);
+};
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+#endif // IMAGE_EFFECT_REGION_HELPER_H
@@ -28,6 +28,8 @@ static const std::map<ErrorCode, const char*> g_ErrorTypeMap = {
     {ErrorCode::ERR_INVALID_PARAMETER_TYPE, "ERROR_INVALID_PARAMETER_TYPE"},
     {ErrorCode::ERR_INVALID_OPERATION, "ERROR_INVALID_OPERATION"},
     {ErrorCode::ERR_TIMED_OUT, "ERROR_TIMED_OUT"},
+    {ErrorCode::ERR_RENDER_CANCELED, "ERROR_RENDER_CANCELED"},
+    {ErrorCode::ERR_INVALID_BINARY_DATA, "ERROR_INVALID_BINARY_DATA"},
     {ErrorCode::ERR_NO_MEMORY, "ERROR_NO_MEMORY"},
     {ErrorCode::ERR_PERMISSION_DENIED, "ERROR_PERMISSION_DENIED"}
 };
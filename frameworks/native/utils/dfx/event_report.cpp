@@ -17,6 +17,7 @@
 
 #include <vector>
 
+#include "securec.h"
 #include "effect_log.h"
 #include "hisysevent_c.h"
 #include "file_ex.h"
@@ -57,6 +58,9 @@ std::unordered_map<std::string, void (*)(const EventInfo &eventInfo)> EventRepor
     { RESTORE_IMAGE_EFFECT_BEHAVIOR, [](const EventInfo &eventInfo) {
         ReportRestoreImageEffectEvent(eventInfo);
     }},
+    { RENDER_PERFORMANCE_STATISTIC, [](const EventInfo &eventInfo) {
+        ReportRenderPerformanceEvent(eventInfo);
+    }},
 };
 
 std::unordered_map<EventDataType, std::string> EventReport::sysEventDataTypeMap_ = {
@@ -235,6 +239,60 @@ void EventReport::ReportRestoreImageEffectEvent(const EventInfo &eventInfo)
         params);
 }
 
+HiSysEventParam CreateArrayParam(const char *name, HiSysEventParamType type, void *array, size_t size)
+{
+    HiSysEventParam param = {
+        .name = { 0 },
+        .t = type,
+        .v = { .array = array },
+        .arraySize = size,
+    };
+    if (strcpy_s(param.name, sizeof(param.name), name) != EOK) {
+        EFFECT_LOGE("CreateArrayParam: copy param name fail! name=%{public}s", name);
+    }
+    return param;
+}
+
+void EventReport::ReportRenderPerformanceEvent(const EventInfo &eventInfo)
+{
+    const std::vector<EventRenderPerfInfo> &infos = eventInfo.renderPerfInfos;
+    if (infos.empty()) {
+        return;
+    }
+    size_t size = infos.size();
+    std::vector<char *> filterNames(size);
+    std::vector<uint32_t> formats(size);
+    std::vector<uint32_t> ipTypes(size);
+    std::vector<uint64_t> renderNums(size);
+    std::vector<uint64_t> totalDurations(size);
+    std::vector<uint32_t> maxDurations(size);
+    std::vector<uint64_t> processedBytes(size);
+    std::vector<uint64_t> allocBytes(size);
+    for (size_t i = 0; i < size; ++i) {
+        filterNames[i] = const_cast<char *>(infos[i].filterName.c_str());
+        formats[i] = infos[i].format;
+        ipTypes[i] = infos[i].ipType;
+        renderNums[i] = infos[i].renderNum;
+        totalDurations[i] = infos[i].totalDurationUs;
+        maxDurations[i] = infos[i].maxDurationUs;
+        processedBytes[i] = infos[i].processedBytes;
+        allocBytes[i] = infos[i].allocBytes;
+    }
+
+    std::vector<HiSysEventParam> params = {
+        CreateArrayParam("FILTER_NAME", HISYSEVENT_STRING_ARRAY, filterNames.data(), size),
+        CreateArrayParam("FORMAT", HISYSEVENT_UINT32_ARRAY, formats.data(), size),
+        CreateArrayParam("IP_TYPE", HISYSEVENT_UINT32_ARRAY, ipTypes.data(), size),
+        CreateArrayParam("RENDER_COUNT", HISYSEVENT_UINT64_ARRAY, renderNums.data(), size),
+        CreateArrayParam("TOTAL_DURATION", HISYSEVENT_UINT64_ARRAY, totalDurations.data(), size),
+        CreateArrayParam("MAX_DURATION", HISYSEVENT_UINT32_ARRAY, maxDurations.data(), size),
+        CreateArrayParam("PROCESSED_BYTES", HISYSEVENT_UINT64_ARRAY, processedBytes.data(), size),
+        CreateArrayParam("ALLOC_BYTES", HISYSEVENT_UINT64_ARRAY, allocBytes.data(), size),
+    };
+    EventWrite(__FUNCTION__, __LINE__, RENDER_PERFORMANCE_STATISTIC, HiSysEventEventType::HISYSEVENT_STATISTIC,
+        params);
+}
+
 } // namespace Effect
 } // namespace Media
 } // namespace OHOS
\ No newline at end of file
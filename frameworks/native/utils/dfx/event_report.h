@@ -18,6 +18,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include "image_effect_marco_define.h"
 
 namespace OHOS {
@@ -31,6 +32,7 @@ constexpr const char* const OUTPUT_DATA_TYPE_STATISTIC = "OUTPUT_DATA_TYPE";
 constexpr const char* const RENDER_FAILED_FAULT = "RENDER_FAILED";
 constexpr const char* const SAVE_IMAGE_EFFECT_BEHAVIOR = "SAVE_IMAGE_EFFECT";
 constexpr const char* const RESTORE_IMAGE_EFFECT_BEHAVIOR = "RESTORE_IMAGE_EFFECT";
+constexpr const char* const RENDER_PERFORMANCE_STATISTIC = "RENDER_PERFORMANCE";
 
 enum class EventDataType {
     PIXEL_MAP = 0,
@@ -46,12 +48,24 @@ struct EventErrorInfo {
     std::string errorMsg;
 };
 
+struct EventRenderPerfInfo {
+    std::string filterName;
+    uint32_t format = 0;
+    uint32_t ipType = 0;
+    uint64_t renderNum = 0;
+    uint64_t totalDurationUs = 0;
+    uint32_t maxDurationUs = 0;
+    uint64_t processedBytes = 0;
+    uint64_t allocBytes = 0;
+};
+
 struct EventInfo {
     std::string filterName;
     uint32_t supportedFormats = 0;
     int32_t filterNum = 0;
     EventDataType dataType;
     EventErrorInfo errorInfo;
+    std::vector<EventRenderPerfInfo> renderPerfInfos;
 };
 
 class EventReport {
@@ -67,6 +81,7 @@ private:
     static void ReportRenderFailedEvent(const EventInfo &eventInfo);
     static void ReportSaveImageEffectEvent(const EventInfo &eventInfo);
     static void ReportRestoreImageEffectEvent(const EventInfo &eventInfo);
+    static void ReportRenderPerformanceEvent(const EventInfo &eventInfo);
 
     static std::string ConvertDataType(const EventDataType &dataType);
 
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "render_perf_stats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <tuple>
+
+#include "effect_log.h"
+#include "event_report.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace {
+constexpr int64_t NS_PER_US = 1000;
+constexpr int64_t FLUSH_INTERVAL_NS = 10LL * 60 * 1000 * 1000 * 1000; // 10 minutes
+constexpr size_t MAX_REPORT_ENTRY_NUM = 100; // same as the arrsize of the RENDER_PERFORMANCE event
+} // namespace
+
+bool RenderPerfKey::operator<(const RenderPerfKey &other) const
+{
+    return std::tie(filterName_, format_, ipType_) < std::tie(other.filterName_, other.format_, other.ipType_);
+}
+
+void RenderPerfCounter::Merge(const RenderPerfCounter &other)
+{
+    renderNum_ += other.renderNum_;
+    totalDurationUs_ += other.totalDurationUs_;
+    maxDurationUs_ = std::max(maxDurationUs_, other.maxDurationUs_);
+    processedBytes_ += other.processedBytes_;
+    allocBytes_ += other.allocBytes_;
+}
+
+// Owns the counters of one thread and hands them back to the statistics when the thread exits.
+class RenderPerfStats::ThreadHolder {
+public:
+    explicit ThreadHolder(const std::shared_ptr<RenderPerfStats> &stats)
+        : stats_(stats), counters_(std::make_shared<ThreadCounters>())
+    {
+        std::lock_guard<std::mutex> lock(stats_->mutex_);
+        stats_->threadCounters_.emplace_back(counters_);
+    }
+
+    ~ThreadHolder()
+    {
+        stats_->Retire(counters_);
+    }
+
+    ThreadCounters &GetCounters()
+    {
+        return *counters_;
+    }
+
+private:
+    std::shared_ptr<RenderPerfStats> stats_;
+    std::shared_ptr<ThreadCounters> counters_;
+};
+
+RenderPerfStats &RenderPerfStats::Instance()
+{
+    // Held by a shared pointer, so that threads exiting after the static destruction can still retire their counters.
+    static std::shared_ptr<RenderPerfStats> instance(new RenderPerfStats());
+    return *instance;
+}
+
+RenderPerfStats::RenderPerfStats() : lastFlushNs_(GetNowNs())
+{
+}
+
+int64_t RenderPerfStats::GetNowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+RenderPerfStats::ThreadCounters &RenderPerfStats::GetThreadCounters()
+{
+    thread_local ThreadHolder holder(shared_from_this());
+    return holder.GetCounters();
+}
+
+void RenderPerfStats::Record(const RenderPerfKey &key, int64_t durationNs, uint64_t processedBytes,
+    uint64_t allocBytes)
+{
+    uint64_t durationUs = static_cast<uint64_t>(std::max<int64_t>(durationNs, 0) / NS_PER_US);
+    ThreadCounters &threadCounters = GetThreadCounters();
+    {
+        std::lock_guard<std::mutex> lock(threadCounters.mutex_);
+        RenderPerfCounter &counter = threadCounters.counters_[key];
+        counter.renderNum_++;
+        counter.totalDurationUs_ += durationUs;
+        counter.maxDurationUs_ = std::max(counter.maxDurationUs_,
+            static_cast<uint32_t>(std::min<uint64_t>(durationUs, std::numeric_limits<uint32_t>::max())));
+        counter.processedBytes_ += processedBytes;
+        counter.allocBytes_ += allocBytes;
+    }
+
+    int64_t nowNs = GetNowNs();
+    int64_t lastFlushNs = lastFlushNs_.load(std::memory_order_relaxed);
+    if (nowNs - lastFlushNs >= FLUSH_INTERVAL_NS &&
+        lastFlushNs_.compare_exchange_strong(lastFlushNs, nowNs, std::memory_order_relaxed)) {
+        Flush();
+    }
+}
+
+void RenderPerfStats::Retire(const std::shared_ptr<ThreadCounters> &counters)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    {
+        std::lock_guard<std::mutex> counterLock(counters->mutex_);
+        for (const auto &item : counters->counters_) {
+            retiredCounters_[item.first].Merge(item.second);
+        }
+        counters->counters_.clear();
+    }
+    threadCounters_.erase(std::remove(threadCounters_.begin(), threadCounters_.end(), counters),
+        threadCounters_.end());
+}
+
+RenderPerfCounterMap RenderPerfStats::Collect()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    RenderPerfCounterMap result = std::move(retiredCounters_);
+    retiredCounters_.clear();
+    for (const auto &threadCounters : threadCounters_) {
+        RenderPerfCounterMap counters;
+        {
+            std::lock_guard<std::mutex> counterLock(threadCounters->mutex_);
+            counters.swap(threadCounters->counters_);
+        }
+        for (const auto &item : counters) {
+            result[item.first].Merge(item.second);
+        }
+    }
+    return result;
+}
+
+void RenderPerfStats::Flush()
+{
+    RenderPerfCounterMap counters = Collect();
+    if (counters.empty()) {
+        return;
+    }
+    lastFlushNs_.store(GetNowNs(), std::memory_order_relaxed);
+
+    EventInfo eventInfo;
+    for (const auto &item : counters) {
+        eventInfo.renderPerfInfos.push_back({
+            .filterName = item.first.filterName_,
+            .format = item.first.format_,
+            .ipType = item.first.ipType_,
+            .renderNum = item.second.renderNum_,
+            .totalDurationUs = item.second.totalDurationUs_,
+            .maxDurationUs = item.second.maxDurationUs_,
+            .processedBytes = item.second.processedBytes_,
+            .allocBytes = item.second.allocBytes_,
+        });
+    }
+    std::vector<EventRenderPerfInfo> &infos = eventInfo.renderPerfInfos;
+    if (infos.size() > MAX_REPORT_ENTRY_NUM) {
+        // Keep the entries which cost the most time.
+        std::partial_sort(infos.begin(), infos.begin() + MAX_REPORT_ENTRY_NUM, infos.end(),
+            [](const EventRenderPerfInfo &a, const EventRenderPerfInfo &b) {
+                return a.totalDurationUs > b.totalDurationUs;
+            });
+        EFFECT_LOGW("RenderPerfStats::Flush: drop %{public}zu entries", infos.size() - MAX_REPORT_ENTRY_NUM);
+        infos.resize(MAX_REPORT_ENTRY_NUM);
+    }
+    EventReport::ReportHiSysEvent(RENDER_PERFORMANCE_STATISTIC, eventInfo);
+}
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_RENDER_PERF_STATS_H
+#define IMAGE_EFFECT_RENDER_PERF_STATS_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "image_effect_marco_define.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+struct RenderPerfKey {
+    std::string filterName_;
+    uint32_t format_ = 0;
+    uint32_t ipType_ = 0;
+
+    bool operator<(const RenderPerfKey &other) const;
+};
+
+struct RenderPerfCounter {
+    uint64_t renderNum_ = 0;
+    uint64_t totalDurationUs_ = 0;
+    uint32_t maxDurationUs_ = 0;
+    uint64_t processedBytes_ = 0;
+    uint64_t allocBytes_ = 0;
+
+    void Merge(const RenderPerfCounter &other);
+};
+
+using RenderPerfCounterMap = std::map<RenderPerfKey, RenderPerfCounter>;
+
+/**
+ * Process-wide aggregation of the filter renders, reported as one RENDER_PERFORMANCE event. Every thread records into
+ * its own counters, whose lock is only contended while a flush merges them. The counters are flushed periodically from
+ * the recording thread, on destruction of an image effect, and merged into the process counters when a thread exits.
+ */
+class RenderPerfStats : public std::enable_shared_from_this<RenderPerfStats> {
+public:
+    IMAGE_EFFECT_EXPORT static RenderPerfStats &Instance();
+
+    IMAGE_EFFECT_EXPORT void Record(const RenderPerfKey &key, int64_t durationNs, uint64_t processedBytes,
+        uint64_t allocBytes);
+    IMAGE_EFFECT_EXPORT void Flush();
+    IMAGE_EFFECT_EXPORT RenderPerfCounterMap Collect();
+
+    IMAGE_EFFECT_EXPORT static int64_t GetNowNs();
+
+private:
+    struct ThreadCounters {
+        std::mutex mutex_;
+        RenderPerfCounterMap counters_;
+    };
+    class ThreadHolder;
+
+    RenderPerfStats();
+
+    ThreadCounters &GetThreadCounters();
+    void Retire(const std::shared_ptr<ThreadCounters> &counters);
+
+    std::mutex mutex_;
+    std::vector<std::shared_ptr<ThreadCounters>> threadCounters_;
+    RenderPerfCounterMap retiredCounters_;
+    std::atomic<int64_t> lastFlushNs_;
+};
+
+// Record the duration of a filter render into the process statistics when the scope ends.
+class RenderPerfScope {
+public:
+    RenderPerfScope(const std::string &filterName, uint32_t format, uint32_t ipType, uint64_t processedBytes,
+        uint64_t allocBytes)
+        : key_({ filterName, format, ipType }), processedBytes_(processedBytes), allocBytes_(allocBytes),
+        beginNs_(RenderPerfStats::GetNowNs())
+    {
+    }
+
+    ~RenderPerfScope()
+    {
+        RenderPerfStats::Instance().Record(key_, RenderPerfStats::GetNowNs() - beginNs_, processedBytes_, allocBytes_);
+    }
+
+    RenderPerfScope(const RenderPerfScope &) = delete;
+    RenderPerfScope &operator=(const RenderPerfScope &) = delete;
+
+private:
+    RenderPerfKey key_;
+    uint64_t processedBytes_ = 0;
+    uint64_t allocBytes_ = 0;
+    int64_t beginNs_ = 0;
+};
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+#endif // IMAGE_EFFECT_RENDER_PERF_STATS_H
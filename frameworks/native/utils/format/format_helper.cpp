@@ -15,7 +15,11 @@
 
 #include "format_helper.h"
 
+#include <algorithm>
+#include <functional>
+
 #include "effect_log.h"
+#include "effect_render_profile.h"
 
 namespace {
     const float YUV_BYTES_PER_PIXEL = 1.5f;
@@ -166,6 +170,12 @@ ErrorCode FormatHelper::ConvertFormat(FormatConverterInfo &src, FormatConverterI
     ErrorCode res = CheckConverterInfo(src, dst);
     CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "ConvertFormat: invalid para! res=%{public}d", res);
 
+    EffectProfileScope profileScope(ProfileStage::FORMAT_CONVERT, "FormatHelper::ConvertFormat");
+    if (profileScope.IsEnabled()) {
+        profileScope.SetBytes(dst.bufferInfo.len_);
+        profileScope.SetDetail("srcFormat=" + std::to_string(static_cast<int32_t>(srcFormat)) +
+            ",dstFormat=" + std::to_string(static_cast<int32_t>(dstFormat)));
+    }
     func(src, dst);
     return ErrorCode::SUCCESS;
 }
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_EFFECT_CANCEL_TOKEN_H
+#define IMAGE_EFFECT_EFFECT_CANCEL_TOKEN_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "error_code.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+/**
+ * Cancellation state of one render request. The token is created when the request is issued and is polled by the
+ * pipeline at filter boundaries and by the cpu kernels at band boundaries. The deadline is fixed at construction,
+ * so only the canceled flag is shared between threads.
+ */
+class EffectCancelToken {
+public:
+    EffectCancelToken() = default;
+
+    explicit EffectCancelToken(uint32_t timeoutMs) : hasDeadline_(timeoutMs > 0)
+    {
+        if (hasDeadline_) {
+            deadline_ = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        }
+    }
+
+    EffectCancelToken(const EffectCancelToken &) = delete;
+    EffectCancelToken &operator=(const EffectCancelToken &) = delete;
+
+    void Cancel()
+    {
+        canceled_.store(true, std::memory_order_release);
+    }
+
+    ErrorCode Check() const
+    {
+        if (canceled_.load(std::memory_order_acquire)) {
+            return ErrorCode::ERR_RENDER_CANCELED;
+        }
+        if (hasDeadline_ && std::chrono::steady_clock::now() >= deadline_) {
+            return ErrorCode::ERR_TIMED_OUT;
+        }
+        return ErrorCode::SUCCESS;
+    }
+
+    bool IsCanceled() const
+    {
+        return Check() != ErrorCode::SUCCESS;
+    }
+
+    std::chrono::steady_clock::time_point GetDeadline() const
+    {
+        return hasDeadline_ ? deadline_ : std::chrono::steady_clock::time_point::max();
+    }
+
+    static bool IsCancelError(ErrorCode res)
+    {
+        return res == ErrorCode::ERR_RENDER_CANCELED || res == ErrorCode::ERR_TIMED_OUT;
+    }
+
+private:
+    std::atomic<bool> canceled_ { false };
+    const bool hasDeadline_ = false;
+    std::chrono::steady_clock::time_point deadline_;
+};
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+#endif // IMAGE_EFFECT_EFFECT_CANCEL_TOKEN_H
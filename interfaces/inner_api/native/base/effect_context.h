@@ -19,6 +19,9 @@
 #include <unordered_set>
 
 #include "effect_info.h"
+#include "effect_cancel_token.h"
+#include "effect_render_profile.h"
+#include "effect_type.h"
 #include "effect_memory_manager.h"
 #include "render_strategy.h"
 #include "capability_negotiate.h"
@@ -45,11 +48,23 @@ public:
     IPType configIpType_ = IPType::DEFAULT;
     std::unordered_set<EffectColorSpace> filtersSupportedColorSpace_;
     std::unordered_set<HdrFormat> filtersSupportedHdrFormat_;
+    // Filled by the negotiation: whether a filter depends on the color space, and whether filters that only move
+    // pixels come first. The conversion of the source is then left out, or deferred to the first filter that needs it.
+    bool hasColorSpaceFilter_ = true;
+    bool isColorSpaceAgnosticHead_ = false;
+    // Target of the gamut conversion deferred from the pipeline entry, DEFAULT when nothing is pending.
+    EffectColorSpace pendingColorSpace_ = EffectColorSpace::DEFAULT;
     LOG_STRATEGY logStrategy_ = LOG_STRATEGY::NORMAL;
 
     IMAGE_EFFECT_EXPORT std::shared_ptr<ExifMetadata> GetExifMetadata();
 
+    IMAGE_EFFECT_EXPORT ErrorCode CheckCanceled() const;
+
     std::shared_ptr<ExifMetadata> exifMetadata_ = nullptr;
+    std::shared_ptr<EffectCancelToken> cancelToken_ = nullptr;
+    std::shared_ptr<EffectRenderProfile> renderProfile_ = nullptr;
+    // Region of the image effect, the pointwise filters only render the pixels inside it.
+    std::shared_ptr<RenderRegion> renderRegion_ = nullptr;
 };
 } // namespace Effect
 } // namespace Media
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_EFFECT_DAMAGE_CACHE_H
+#define IMAGE_EFFECT_EFFECT_DAMAGE_CACHE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "effect_buffer.h"
+#include "effect_type.h"
+#include "error_code.h"
+#include "image_effect_marco_define.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+/**
+ * Output of the previous surface frame. When the producer only redrew the damage of a frame, a chain of pointwise
+ * filters renders the damage alone and the rest of the frame is taken from the cached output. The cache is only
+ * reusable for the frame right after the cached one, with the same layout and the same filter settings.
+ */
+class EffectDamageCache {
+public:
+    EffectDamageCache() = default;
+    ~EffectDamageCache() = default;
+    EffectDamageCache(const EffectDamageCache &) = delete;
+    EffectDamageCache &operator=(const EffectDamageCache &) = delete;
+
+    // Clamps the damage to the frame and widens it to whole chroma samples. Returns false when the frame can not be
+    // rendered partially: the format is not supported, or the damage is empty or covers the whole frame.
+    IMAGE_EFFECT_EXPORT static bool AlignDamage(const BufferInfo &frame, RenderRegion &damage);
+
+    IMAGE_EFFECT_EXPORT bool IsReusable(const BufferInfo &frame, uint64_t frameIndex,
+        const std::vector<uint64_t> &settings) const;
+
+    // Copies the cached output outside of the aligned damage into the rendered frame, then caches its damage.
+    IMAGE_EFFECT_EXPORT ErrorCode Merge(const BufferInfo &frame, uint64_t frameIndex, const RenderRegion &damage);
+
+    // Caches the whole rendered frame.
+    IMAGE_EFFECT_EXPORT ErrorCode Update(const BufferInfo &frame, uint64_t frameIndex,
+        const std::vector<uint64_t> &settings);
+
+    IMAGE_EFFECT_EXPORT void Invalidate();
+
+    bool IsValid() const
+    {
+        return isValid_;
+    }
+
+private:
+    bool IsSameLayout(const BufferInfo &frame) const;
+
+    std::vector<uint8_t> data_;
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    uint32_t rowStride_ = 0;
+    IEffectFormat format_ = IEffectFormat::DEFAULT;
+    EffectColorSpace colorSpace_ = EffectColorSpace::DEFAULT;
+    uint64_t frameIndex_ = 0;
+    std::vector<uint64_t> settings_;
+    bool isValid_ = false;
+};
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+#endif // IMAGE_EFFECT_EFFECT_DAMAGE_CACHE_H
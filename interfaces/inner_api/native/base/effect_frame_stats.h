@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_EFFECT_FRAME_STATS_H
+#define IMAGE_EFFECT_EFFECT_FRAME_STATS_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "image_effect_marco_define.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+// Points in the life of a surface frame, from the acquire on the consumer side to the flush to the output surface.
+enum class FrameCheckpoint : uint8_t {
+    ACQUIRED = 0,
+    FENCE_SIGNALED,
+    CACHE_INVALIDATED,
+    BUFFER_REQUESTED,
+    QUEUED,
+    RENDER_BEGIN,
+    RENDER_END,
+    FLUSHED,
+    CHECKPOINT_BUTT,
+};
+
+// Intervals between the checkpoints, TOTAL is from ACQUIRED to FLUSHED.
+enum class FrameStage : uint8_t {
+    FENCE_WAIT = 0,
+    INVALIDATE_CACHE,
+    REQUEST_BUFFER,
+    QUEUE,
+    RENDER,
+    FLUSH,
+    TOTAL,
+    STAGE_BUTT,
+};
+
+constexpr size_t FRAME_CHECKPOINT_NUM = static_cast<size_t>(FrameCheckpoint::CHECKPOINT_BUTT);
+constexpr size_t FRAME_STAGE_NUM = static_cast<size_t>(FrameStage::STAGE_BUTT);
+
+struct EffectFrameTimestamps {
+    IMAGE_EFFECT_EXPORT void Mark(FrameCheckpoint checkpoint);
+
+    std::array<int64_t, FRAME_CHECKPOINT_NUM> checkpointNs_ = { 0 };
+};
+
+struct EffectLatencyPercentile {
+    uint32_t p50Us_ = 0;
+    uint32_t p95Us_ = 0;
+    uint32_t p99Us_ = 0;
+};
+
+struct EffectFrameStatistics {
+    uint64_t renderedFrameNum_ = 0;
+    uint64_t droppedFrameNum_ = 0;
+    uint32_t queueDepth_ = 0;
+    uint32_t maxQueueDepth_ = 0;
+    float fps_ = 0.f;
+    std::array<EffectLatencyPercentile, FRAME_STAGE_NUM> latency_;
+};
+
+/**
+ * Rolling statistics of the surface frames. Rendered frames are committed into a fixed ring of the latest
+ * FRAME_WINDOW_SIZE frames without locking, the percentiles and the fps are computed over that window when queried.
+ * Every slot is guarded by a sequence number, so a reader skips the slot which is being written.
+ */
+class EffectFrameStats {
+public:
+    static constexpr size_t FRAME_WINDOW_SIZE = 128;
+
+    EffectFrameStats() = default;
+    ~EffectFrameStats() = default;
+    EffectFrameStats(const EffectFrameStats &) = delete;
+    EffectFrameStats &operator=(const EffectFrameStats &) = delete;
+
+    IMAGE_EFFECT_EXPORT void Commit(const EffectFrameTimestamps &timestamps);
+    IMAGE_EFFECT_EXPORT void RecordDrop(uint32_t droppedNum = 1);
+    IMAGE_EFFECT_EXPORT void RecordQueueDepth(uint32_t queueDepth);
+    IMAGE_EFFECT_EXPORT void GetStatistics(EffectFrameStatistics &statistics) const;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence { 0 };
+        std::atomic<int64_t> flushedNs { 0 };
+        std::array<std::atomic<uint32_t>, FRAME_STAGE_NUM> durationUs {};
+    };
+
+    std::array<Slot, FRAME_WINDOW_SIZE> slots_;
+    std::atomic<uint64_t> writeIndex_ { 0 };
+    std::atomic<uint64_t> droppedFrameNum_ { 0 };
+    std::atomic<uint32_t> queueDepth_ { 0 };
+    std::atomic<uint32_t> maxQueueDepth_ { 0 };
+};
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+#endif // IMAGE_EFFECT_EFFECT_FRAME_STATS_H
@@ -80,6 +80,9 @@ public:
     std::vector<EffectColorSpace> colorSpaces_;
     std::vector<HdrFormat> hdrFormats_;
     Category category_;
+    // The filter only moves pixels around, so it works in any color space and colorSpaces_ does not restrict the
+    // negotiation.
+    bool isColorSpaceAgnostic_ = false;
 };
 } // namespace Effect
 } // namespace Media
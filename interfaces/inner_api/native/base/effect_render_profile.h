@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_EFFECT_RENDER_PROFILE_H
+#define IMAGE_EFFECT_EFFECT_RENDER_PROFILE_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "effect_json_helper.h"
+#include "image_effect_marco_define.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+enum class ProfileStage : uint8_t {
+    GET_IMAGE_INFO = 0,
+    LOCK_ALL,
+    PREPARE,
+    CONVERT_COLOR_SPACE,
+    FILTER_RENDER,
+    MEMORY_ALLOC,
+    MEMORY_REUSE,
+    MEMCPY,
+    FORMAT_CONVERT,
+    SINK,
+    STAGE_BUTT,
+};
+
+struct EffectProfileRecord {
+    ProfileStage stage_ = ProfileStage::STAGE_BUTT;
+    std::string name_;
+    int64_t wallNs_ = 0;
+    int64_t cpuNs_ = 0;
+    uint64_t bytes_ = 0;
+    std::string detail_;
+};
+
+/**
+ * Per-stage timing of one single-image render. Records may be added from the calling thread and from the render
+ * worker, they are kept in the order they are finished. The profile of the running render is also bound to the
+ * current thread, so that helpers without an effect context, such as memory copies, can report into it.
+ */
+class EffectRenderProfile {
+public:
+    EffectRenderProfile() = default;
+    ~EffectRenderProfile() = default;
+
+    IMAGE_EFFECT_EXPORT void AddRecord(EffectProfileRecord &&record);
+    IMAGE_EFFECT_EXPORT std::vector<EffectProfileRecord> GetRecords() const;
+    IMAGE_EFFECT_EXPORT EffectJsonPtr ToJson() const;
+
+    IMAGE_EFFECT_EXPORT static const char *GetStageName(ProfileStage stage);
+    IMAGE_EFFECT_EXPORT static EffectRenderProfile *GetCurrent();
+
+private:
+    friend class EffectProfileBinder;
+
+    static EffectRenderProfile *SetCurrent(EffectRenderProfile *profile);
+
+    mutable std::mutex mutex_;
+    std::vector<EffectProfileRecord> records_;
+};
+
+// Bind a profile to the current thread for the lifetime of the binder, the previous binding is restored after.
+class EffectProfileBinder {
+public:
+    IMAGE_EFFECT_EXPORT explicit EffectProfileBinder(EffectRenderProfile *profile);
+    IMAGE_EFFECT_EXPORT ~EffectProfileBinder();
+    EffectProfileBinder(const EffectProfileBinder &) = delete;
+    EffectProfileBinder &operator=(const EffectProfileBinder &) = delete;
+
+private:
+    EffectRenderProfile *previous_ = nullptr;
+};
+
+// Measure the wall and thread cpu time of a scope. It does nothing when there is no profile.
+class EffectProfileScope {
+public:
+    IMAGE_EFFECT_EXPORT EffectProfileScope(EffectRenderProfile *profile, ProfileStage stage, const std::string &name);
+    IMAGE_EFFECT_EXPORT EffectProfileScope(ProfileStage stage, const std::string &name);
+    IMAGE_EFFECT_EXPORT ~EffectProfileScope();
+    EffectProfileScope(const EffectProfileScope &) = delete;
+    EffectProfileScope &operator=(const EffectProfileScope &) = delete;
+
+    bool IsEnabled() const
+    {
+        return profile_ != nullptr;
+    }
+
+    void SetStage(ProfileStage stage)
+    {
+        record_.stage_ = stage;
+    }
+
+    void SetBytes(uint64_t bytes)
+    {
+        record_.bytes_ = bytes;
+    }
+
+    void SetDetail(const std::string &detail)
+    {
+        record_.detail_ = detail;
+    }
+
+private:
+    EffectRenderProfile *profile_ = nullptr;
+    EffectProfileRecord record_;
+    int64_t wallBeginNs_ = 0;
+    int64_t cpuBeginNs_ = 0;
+};
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+#endif // IMAGE_EFFECT_EFFECT_RENDER_PROFILE_H
@@ -32,6 +32,14 @@ enum class BufferType {
     DMA_BUFFER, // SurfaceBuffer
     SHARED_MEMORY,
 };
+
+// Pixel rectangle with the layout of ImageEffect_Region, the corners are in any order and x1, y1 are exclusive.
+struct RenderRegion {
+    int32_t x0 = 0;
+    int32_t y0 = 0;
+    int32_t x1 = 0;
+    int32_t y1 = 0;
+};
 } // namespace Effect
 } // namespace Media
 } // namespace OHOS
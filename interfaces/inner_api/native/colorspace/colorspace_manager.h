@@ -38,6 +38,10 @@ public:
     IMAGE_EFFECT_EXPORT void Init(std::shared_ptr<EffectBuffer> &src, std::shared_ptr<EffectBuffer> &dst);
     IMAGE_EFFECT_EXPORT ErrorCode ApplyColorSpace(EffectBuffer *effectBuffer, const EffectColorSpace &colorSpace,
         EffectColorSpace &outputColorSpace);
+    // Same checks as ApplyColorSpace, but only gives the target color space and leaves the pixels alone.
+    IMAGE_EFFECT_EXPORT ErrorCode GetTargetColorSpace(const EffectColorSpace &colorSpace,
+        EffectColorSpace &targetColorSpace);
+    IMAGE_EFFECT_EXPORT bool IsOutputColorSpaceKept(const EffectColorSpace &colorSpace);
 
     IMAGE_EFFECT_EXPORT
     ErrorCode ChooseColorSpace(const std::unordered_set<EffectColorSpace> &filtersSupportedColorSpace,
@@ -49,6 +49,9 @@ public:
     IMAGE_EFFECT_EXPORT static ErrorCode ApplyColorSpace(EffectBuffer *effectBuffer, EffectColorSpace targetColorSpace);
 
 private:
+    // Without the video processing engine the hdr images are processed by CpuHdrProcessor.
+    bool IsVpeAvailable() const;
+
     std::shared_ptr<ColorSpaceConverter> converter = nullptr;
     std::vector<std::shared_ptr<MemoryData>> memoryDataArray_;
 };
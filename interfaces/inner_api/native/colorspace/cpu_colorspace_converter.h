@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_CPU_COLORSPACE_CONVERTER_H
+#define IMAGE_EFFECT_CPU_COLORSPACE_CONVERTER_H
+
+#include <array>
+
+#include "effect_buffer.h"
+#include "effect_info.h"
+#include "error_code.h"
+#include "image_effect_marco_define.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+/**
+ * Gamut conversion of rgba pixels on the cpu, without going through the pixel map framework. Every channel is
+ * decoded to linear light with a lookup table of the source transfer function, the pixel is transformed by a fixed
+ * point 3x3 matrix between the primaries, then encoded with a lookup table of the target transfer function. Large
+ * images are split into bands of rows among the render workers.
+ */
+class CpuColorSpaceConverter {
+public:
+    static constexpr size_t GAMUT_MATRIX_SIZE = 9;
+
+    // Whether the conversion only changes the gamut of sdr rgba pixels. The hdr color spaces need a tone mapping,
+    // which is left to the color space processor.
+    IMAGE_EFFECT_EXPORT
+    static bool IsSupported(EffectColorSpace srcColorSpace, EffectColorSpace dstColorSpace, IEffectFormat format);
+
+    // Converts the pixels of src from its color space into dst, which has the same size and format and may be src
+    // itself. The color space of dst is set to the target one.
+    IMAGE_EFFECT_EXPORT
+    static ErrorCode Convert(EffectBuffer *src, EffectBuffer *dst, EffectColorSpace targetColorSpace);
+
+    // Row major matrix from the linear rgb of srcColorSpace to the linear rgb of dstColorSpace. Only the primaries are
+    // looked at, so the hdr color spaces are accepted as well.
+    IMAGE_EFFECT_EXPORT
+    static bool GetGamutMatrix(EffectColorSpace srcColorSpace, EffectColorSpace dstColorSpace,
+        std::array<float, GAMUT_MATRIX_SIZE> &matrix);
+};
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+#endif // IMAGE_EFFECT_CPU_COLORSPACE_CONVERTER_H
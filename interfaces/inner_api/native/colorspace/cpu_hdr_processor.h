@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_CPU_HDR_PROCESSOR_H
+#define IMAGE_EFFECT_CPU_HDR_PROCESSOR_H
+
+#include "effect_buffer.h"
+#include "error_code.h"
+#include "image_effect_marco_define.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+constexpr uint32_t GAINMAP_CHANNEL_NUM = 3;
+
+// Gain map parameters in the terms of ISO 21496-1. The gains are log2 values, the headrooms are log2 of the peak over
+// the sdr white.
+struct CpuGainmapMetadata {
+    float minLog2[GAINMAP_CHANNEL_NUM] = { 0.f, 0.f, 0.f };
+    float maxLog2[GAINMAP_CHANNEL_NUM] = { 0.f, 0.f, 0.f };
+    float gamma[GAINMAP_CHANNEL_NUM] = { 1.f, 1.f, 1.f };
+    float baseOffset[GAINMAP_CHANNEL_NUM] = { 0.f, 0.f, 0.f };
+    float alternateOffset[GAINMAP_CHANNEL_NUM] = { 0.f, 0.f, 0.f };
+    float baseHeadroom = 0.f;
+    float alternateHeadroom = 0.f;
+    // Whether the gain is applied in the primaries of the sdr base image instead of bt2020.
+    bool useBaseColor = true;
+};
+
+/**
+ * Cpu implementation of the hdr processing of the color space processor, used when the video processing engine is
+ * not available. The hdr image is RGBA_1010102 in BT2020 HLG or PQ, the sdr image and the gain map are RGBA8888, the
+ * gain map having half the size of the image. The sdr reference white is 203 nits and the HLG nominal peak is 1000
+ * nits, following BT.2408. Transfer functions go through lookup tables and the rows are split among the render
+ * workers.
+ */
+class CpuHdrProcessor {
+public:
+    IMAGE_EFFECT_EXPORT static bool IsHdrSupported(const BufferInfo &hdrInfo);
+
+    // Tone maps the hdr image into the sdr one, whose color space is one of the sdr color spaces.
+    IMAGE_EFFECT_EXPORT static ErrorCode ToneMap(const EffectBuffer *hdr, EffectBuffer *sdr);
+
+    // Splits the hdr image into the tone mapped sdr base image and the gain map that restores the hdr colors.
+    IMAGE_EFFECT_EXPORT static ErrorCode Decompose(const EffectBuffer *hdr, EffectBuffer *sdr, EffectBuffer *gainmap,
+        CpuGainmapMetadata &metadata);
+
+    // Applies the gain map to the sdr base image at full weight, the gain map is upsampled bilinearly.
+    IMAGE_EFFECT_EXPORT static ErrorCode Compose(const EffectBuffer *sdr, const EffectBuffer *gainmap,
+        const CpuGainmapMetadata &metadata, EffectBuffer *hdr);
+};
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+#endif // IMAGE_EFFECT_CPU_HDR_PROCESSOR_H
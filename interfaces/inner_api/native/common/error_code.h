@@ -108,6 +108,8 @@ enum struct ErrorCode : int32_t {
     ERR_INVALID_TEXTURE = ERR_UNKNOWN + 80,
     ERR_UNSUPPORTED_TEXTURE_FORMAT = ERR_UNKNOWN + 81,
     ERR_NO_DST_TEX = ERR_UNKNOWN + 82,
+    ERR_RENDER_CANCELED = ERR_UNKNOWN + 83,
+    ERR_INVALID_BINARY_DATA = ERR_UNKNOWN + 84,
     ERR_INVALID_PARAMETER_VALUE = ERR_UNKNOWN + 100,
     ERR_INVALID_PARAMETER_TYPE = ERR_UNKNOWN + 101,
     ERR_INVALID_OPERATION = ERR_UNKNOWN + 102,
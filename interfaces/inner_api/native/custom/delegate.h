@@ -45,6 +45,12 @@ public:
     IMAGE_EFFECT_EXPORT virtual void *Restore(const EffectJsonPtr &values) = 0;
 
     IMAGE_EFFECT_EXPORT virtual void *GetEffectInfo() = 0;
+
+    // Whether the delegate may render with the same buffer as input and output.
+    IMAGE_EFFECT_EXPORT virtual bool IsInPlaceSupported()
+    {
+        return true;
+    }
 };
 } // namespace Effect
 } // namespace Media
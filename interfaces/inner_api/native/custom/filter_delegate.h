@@ -32,8 +32,10 @@ namespace Media {
 namespace Effect {
 class FilterDelegate : public IFilterDelegate {
 public:
-    FilterDelegate(const OH_EffectFilterInfo *info, const ImageEffect_FilterDelegate *delegate)
-        : ohInfo_(*info), ohDelegate_(delegate) {}
+    FilterDelegate(const OH_EffectFilterInfo *info, const ImageEffect_FilterDelegate *delegate,
+        OH_EffectFilterDelegate_RenderWithDst renderWithDst = nullptr,
+        OH_EffectFilterDelegate_RenderRegion renderRegion = nullptr)
+        : ohInfo_(*info), ohDelegate_(delegate), renderWithDst_(renderWithDst), renderRegion_(renderRegion) {}
 
     ~FilterDelegate() override = default;
 
@@ -48,11 +50,28 @@ public:
     void *Restore(const EffectJsonPtr &values) override;
 
     void *GetEffectInfo() override;
+
+    bool IsInPlaceSupported() override;
 protected:
     static void PushData(OH_EffectFilter *filter, OH_EffectBufferInfo *dst);
 private:
     OH_EffectFilterInfo ohInfo_;
     const ImageEffect_FilterDelegate *ohDelegate_;
+    OH_EffectFilterDelegate_RenderWithDst renderWithDst_;
+    OH_EffectFilterDelegate_RenderRegion renderRegion_;
+
+    bool IsRenderWithDst(const EffectBuffer *src) const;
+
+    bool RenderWithDst(OH_EffectFilter *ohEFilter, EffectBuffer *src, EffectBuffer *dst,
+        std::shared_ptr<EffectContext> &context);
+
+    bool RenderRegions(OH_EffectFilter *ohEFilter, OH_EffectBufferInfo *src, OH_EffectBufferInfo *dst);
+
+    bool RenderFromCopy(OH_EffectFilter *ohEFilter, EffectBuffer *buffer, std::shared_ptr<EffectContext> &context);
+
+    static std::unique_ptr<OH_EffectBufferInfo> GenOHBufferInfo(const EffectBuffer *buffer);
+
+    static void FlushDmaCacheIfNeed(EffectBuffer *buffer);
 
     static std::shared_ptr<EffectBuffer> GenDstEffectBuffer(const OH_EffectBufferInfo *dst, const EffectBuffer *src);
 
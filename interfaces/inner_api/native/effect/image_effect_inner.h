@@ -16,6 +16,8 @@
 #ifndef IMAGE_EFFECT_IMAGE_EFFECT_H
 #define IMAGE_EFFECT_IMAGE_EFFECT_H
 
+#include <atomic>
+#include <functional>
 #include <vector>
 #include <mutex>
 #include <unordered_set>
@@ -31,10 +33,15 @@
 #include "surface.h"
 #include "pixel_map.h"
 #include "image_effect_marco_define.h"
-#include "render_thread.h"
+#include "render_executor.h"
 #include "picture.h"
+#include "effect_cancel_token.h"
+#include "effect_damage_cache.h"
+#include "effect_frame_stats.h"
+#include "effect_render_profile.h"
 
 #define TIME_FOR_WAITING_BUFFER 2500
+#define DEFAULT_IN_FLIGHT_DEPTH 2
 
 namespace OHOS {
 namespace Media {
@@ -66,6 +73,9 @@ struct BufferProcessInfo {
     sptr<SyncFence> inBufferSyncFence_;
     sptr<SyncFence> outBufferSyncFence_;
     bool isSrcHebcData_ = false;
+    EffectFrameTimestamps timestamps_;
+    uint64_t frameIndex_ = 0;
+    RenderRegion damage_;
 };
 
 struct BufferEntry {
@@ -73,6 +83,11 @@ struct BufferEntry {
     sptr<SurfaceBuffer> buffer_;
     sptr<SyncFence> syncFence_;
     int64_t timestamp_;
+    EffectFrameTimestamps frameTimestamps_;
+    // Index among the acquired frames, a gap means that the previous output does not belong to the previous frame.
+    uint64_t frameIndex_ = 0;
+    // Pixels redrawn by the producer since its previous frame.
+    RenderRegion damage_;
 };
 
 template <typename T>
@@ -100,6 +115,17 @@ public:
         return CommitPush(std::forward<T>(element), lock);
     }
 
+    // Never waits: when the queue is full the oldest elements are evicted into evicted, so the latest one wins.
+    void PushLatest(T&& element, std::vector<T>& evicted)
+    {
+        std::unique_lock lock(mutex_);
+        while (!queue_.empty() && queue_.size() >= max_capacity_) {
+            evicted.emplace_back(std::move(queue_.front()));
+            queue_.pop();
+        }
+        CommitPush(std::forward<T>(element), lock);
+    }
+
     std::optional<T> TryPop(bool wait = true, std::chrono::milliseconds timeout = std::chrono::milliseconds::zero())
     {
         std::unique_lock lock(mutex_);
@@ -120,6 +146,21 @@ public:
         return queue_.size();
     }
 
+    size_t Capacity() const
+    {
+        std::lock_guard lock(mutex_);
+        return max_capacity_;
+    }
+
+    void SetCapacity(size_t max_capacity)
+    {
+        {
+            std::lock_guard lock(mutex_);
+            max_capacity_ = std::max<size_t>(1, max_capacity);
+        }
+        not_full_cv_.notify_all();
+    }
+
 private:
     template<typename Rep = int, typename Period = std::milli>
     bool WaitForSpace(std::unique_lock<std::mutex>& lock, const std::chrono::duration<Rep, Period>& timeout)
@@ -170,7 +211,7 @@ private:
     std::queue<T> queue_;
     std::condition_variable not_full_cv_;
     std::condition_variable not_empty_cv_;
-    const size_t max_capacity_;
+    size_t max_capacity_;
 };
 
 struct ParseOptions {
@@ -204,6 +245,18 @@ public:
 
     IMAGE_EFFECT_EXPORT static std::shared_ptr<ImageEffect> Restore(std::string &info);
 
+    // Binary counterparts of Save and Restore, see EffectBinaryHelper. Chains with delegate filters are not supported.
+    IMAGE_EFFECT_EXPORT ErrorCode SaveBinary(std::vector<uint8_t> &data);
+
+    IMAGE_EFFECT_EXPORT static std::shared_ptr<ImageEffect> RestoreBinary(const uint8_t *data, size_t size);
+
+    // Creates an effect with the filters, the values and the configuration of this one. Inputs, outputs and the render
+    // state are not copied. The cloner creates each filter of the new chain, by default the factory copies it.
+    using EFilterCloner = std::function<std::shared_ptr<EFilter>(const std::shared_ptr<EFilter> &efilter)>;
+    IMAGE_EFFECT_EXPORT std::shared_ptr<ImageEffect> Clone();
+
+    IMAGE_EFFECT_EXPORT std::shared_ptr<ImageEffect> Clone(const EFilterCloner &cloner);
+
     IMAGE_EFFECT_EXPORT virtual ErrorCode SetOutputPixelMap(PixelMap *pixelMap);
 
     IMAGE_EFFECT_EXPORT virtual ErrorCode SetOutputSurface(sptr<Surface> &surface);
@@ -215,6 +268,13 @@ public:
 
     IMAGE_EFFECT_EXPORT void Stop();
 
+    IMAGE_EFFECT_EXPORT void Cancel();
+
+    IMAGE_EFFECT_EXPORT void GetFrameStatistics(EffectFrameStatistics &statistics) const;
+
+    // Profile of the latest single-image render, only produced after configuring "renderProfile" to true.
+    IMAGE_EFFECT_EXPORT std::shared_ptr<EffectRenderProfile> GetRenderProfile() const;
+
     IMAGE_EFFECT_EXPORT ErrorCode SetInputSurfaceBuffer(OHOS::SurfaceBuffer *surfaceBuffer);
 
     IMAGE_EFFECT_EXPORT ErrorCode SetOutputSurfaceBuffer(OHOS::SurfaceBuffer *surfaceBuffer);
@@ -289,13 +349,21 @@ private:
     bool SubmitRenderTask(BufferEntry&& entry);
     void RenderBuffer();
     GSError FlushBuffer(sptr<SurfaceBuffer>& buffer, sptr<SyncFence>& fence, bool isNeedAttach, bool sendFence,
-        int64_t& timestamp);
+        int64_t& timestamp, const RenderRegion *damage = nullptr);
+    bool PrepareDamageRender(BufferEntry& entry, std::shared_ptr<EffectBuffer>& frame,
+        std::vector<uint64_t>& settings);
+    bool FinishDamageRender(const BufferEntry& entry, const std::shared_ptr<EffectBuffer>& frame,
+        const std::vector<uint64_t>& settings, bool isRendered);
+    void GetRenderSettings(std::vector<uint64_t>& settings);
+    std::shared_ptr<RenderRegion> GetRenderRegion() const;
     GSError ReleaseBuffer(sptr<SurfaceBuffer>& buffer, sptr<SyncFence>& fence);
+    void DropBuffer(BufferEntry& entry);
     void ProcessRender(BufferProcessInfo& bufferProcessInfo, bool& isNeedSwap, int64_t& timestamp);
     void ProcessSwapBuffers(BufferProcessInfo& bufferProcessInfo, int64_t& timestamp);
 
     ErrorCode GetImageInfo(uint32_t &width, uint32_t &height, PixelFormat &pixelFormat,
         std::shared_ptr<ExifMetadata> &exifMetadata);
+    ErrorCode RenderInner(EffectRenderProfile *profile);
     ErrorCode ConfigureFilters(std::shared_ptr<EffectBuffer> srcEffectBuffer,
         std::shared_ptr<EffectBuffer> dstEffectBuffer);
     ErrorCode GetImageInfoFromPixelMap(uint32_t &width, uint32_t &height, PixelFormat &pixelFormat,
@@ -315,6 +383,8 @@ private:
     ErrorCode InitEffectBuffer(std::shared_ptr<EffectBuffer> &srcEffectBuffer,
         std::shared_ptr<EffectBuffer> &dstEffectBuffer, IEffectFormat format);
 
+    std::shared_ptr<EffectCancelToken> CreateCancelToken();
+
     sptr<Surface> toProducerSurface_;   // from ImageEffect to XComponent
     sptr<Surface> fromProducerSurface_; // to camera hal
     std::atomic<ImageEffectState> imageEffectFlag_ {IMAGE_EFFECT_NOT_INITIALIZED};
@@ -338,14 +408,32 @@ private:
     std::shared_ptr<Impl> impl_;
     std::mutex innerEffectMutex_;
     std::mutex consumerListenerMutex_;
-    RenderThread<> *m_renderThread{ nullptr };
+    std::shared_ptr<RenderStrand> m_renderStrand = nullptr;
     std::atomic_ullong m_currentTaskId{0};
     bool needPreFlush_ = false;
     uint32_t failureCount_ = 0;
     std::shared_ptr<ThreadSafeBufferQueue<BufferEntry>> bufferPool_;
+    // Configure may run on another thread than GetInputSurface, which sizes the buffer pool from both.
+    std::atomic<int32_t> maxBufferPoolSize_ {0};
+    std::atomic<int32_t> inFlightDepth_ {DEFAULT_IN_FLIGHT_DEPTH};
+    EffectFrameStats frameStats_;
     int32_t configIpType_ = 0;
     bool needsDecodeDfxData_  = false;
     bool needsPackDfxData_ = false;
+    std::mutex cancelTokenMutex_;
+    std::shared_ptr<EffectCancelToken> cancelToken_ = nullptr;
+    uint32_t renderTimeoutMs_ = 0;
+    RenderTaskPriority renderPriority_ = RenderTaskPriority::PREVIEW;
+    bool isRenderProfileEnabled_ = false;
+    mutable std::mutex renderProfileMutex_;
+    std::shared_ptr<EffectRenderProfile> renderProfile_ = nullptr;
+    // Region limiting the pointwise filters, replaced as a whole so that a render in flight keeps its own.
+    std::shared_ptr<RenderRegion> renderRegion_ = nullptr;
+    // Surface frames acquired so far, only touched by the consumer listener.
+    uint64_t acquiredFrameNum_ = 0;
+    // Output of the previous surface frame and the damage rendered now, only touched by the render task.
+    EffectDamageCache damageCache_;
+    std::shared_ptr<RenderRegion> damageRegion_ = nullptr;
 };
 } // namespace Effect
 } // namespace Media
@@ -16,6 +16,7 @@
 #ifndef IMAGE_EFFECT_EFILTER_H
 #define IMAGE_EFFECT_EFILTER_H
 
+#include <atomic>
 #include <map>
 #include <string>
 
@@ -23,6 +24,7 @@
 #include "effect_buffer.h"
 #include "effect_type.h"
 #include "efilter_base.h"
+#include "efilter_param_schema.h"
 #include "error_code.h"
 #include "effect_json_helper.h"
 #include "image_effect_marco_define.h"
@@ -107,6 +109,32 @@ public:
     IMAGE_EFFECT_EXPORT
     virtual bool IsTextureInput();
 
+    // Whether the filter may render with the same buffer as input and output.
+    IMAGE_EFFECT_EXPORT
+    virtual bool IsInPlaceSupported();
+
+    // Whether every output pixel only depends on the input pixel at the same place, so that the filter may render a
+    // region of the image and pass the rest through.
+    IMAGE_EFFECT_EXPORT
+    virtual bool IsRegionSupported();
+
+    // Changes whenever a value is set, and is never shared by two filters of the process.
+    uint64_t GetValuesVersion() const
+    {
+        return valuesVersion_.load(std::memory_order_acquire);
+    }
+
+    // Bits of the schema parameters set since the last call, the call clears them.
+    uint64_t TakeDirtyParams()
+    {
+        return dirtyParams_.exchange(0, std::memory_order_acq_rel);
+    }
+
+    bool IsParamSet(uint32_t index) const
+    {
+        return (setParams_ & EFilterParamSchema::ToMask(index)) != 0;
+    }
+
     IMAGE_EFFECT_EXPORT
     virtual ErrorCode GetEditDataVersion(const EffectJsonPtr& values, uint32_t &editDataVersion);
  
@@ -116,12 +144,26 @@ public:
 protected:
     ErrorCode CalculateEFilterIPType(IEffectFormat &formatType, IPType &ipType);
 
+    // Binds the typed parameter struct of the filter, whose fields SetValue then keeps up to date with values_.
+    IMAGE_EFFECT_EXPORT void BindParamBlock(const EFilterParamSchema *schema, void *block);
+
     std::map<std::string, Any> values_;
 
     std::shared_ptr<EFilterCacheConfig> cacheConfig_ = nullptr;
 
     LOG_STRATEGY logStrategy_ = LOG_STRATEGY::NORMAL;
 private:
+    static uint64_t NextValuesVersion();
+
+    std::atomic<uint64_t> valuesVersion_;
+    // Hash of name_ for the lookups of the effect info, which happen on every negotiation.
+    size_t nameHash_;
+
+    const EFilterParamSchema *paramSchema_ = nullptr;
+    void *paramData_ = nullptr;
+    uint64_t setParams_ = 0;
+    std::atomic<uint64_t> dirtyParams_ = 0;
+
     IMAGE_EFFECT_EXPORT void Negotiate(const std::string &inPort, const std::shared_ptr<Capability> &capability,
         std::shared_ptr<EffectContext> &context) override;
 
@@ -135,6 +177,11 @@ private:
 
     std::shared_ptr<Capability> outputCap_ = nullptr;
 
+    // Set by the negotiation on the first filter that depends on the color space, it applies the deferred conversion.
+    bool isColorSpaceConvertPoint_ = false;
+
+    ErrorCode ApplyPendingColorSpace(std::shared_ptr<EffectContext> &context, std::shared_ptr<EffectBuffer> &buffer);
+
     static std::shared_ptr<EffectBuffer> CreateEffectBufferFromTexture(const std::shared_ptr<EffectBuffer> &buffer,
         const std::shared_ptr<EffectContext> &context);
 
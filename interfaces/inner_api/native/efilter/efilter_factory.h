@@ -16,11 +16,17 @@
 #ifndef IMAGE_EFFECT_EFILTER_FACTORY_H
 #define IMAGE_EFFECT_EFILTER_FACTORY_H
 
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "delegate.h"
 #include "efilter.h"
+#include "effect_binary_helper.h"
 #include "image_effect_marco_define.h"
 
 #define REGISTER_EFILTER_FACTORY(T, U) static AutoRegisterEFilter<T> gAutoRegster_##T(U)
@@ -36,6 +42,45 @@ struct EFilterFunction {
     EFilterInfoGetter infoGetter_ = nullptr;
 };
 
+// Registrations so far, the REGISTER_EFILTER_FACTORY ones run at library load included, and their cost.
+struct EFilterRegisterStats {
+    uint32_t count_ = 0;
+    int64_t costNs_ = 0;
+};
+
+// Filter name with its hash, so that a caller looking up the same name again does not hash it again. The name is not
+// copied, the string it is made from has to outlive the key.
+struct EFilterKey {
+    explicit EFilterKey(const std::string &name) : name_(&name), hash_(std::hash<std::string>()(name)) {}
+
+    EFilterKey(const std::string &name, size_t hash) : name_(&name), hash_(hash) {}
+
+    bool operator==(const EFilterKey &other) const
+    {
+        return hash_ == other.hash_ && *name_ == *other.name_;
+    }
+
+    const std::string *name_ = nullptr;
+    size_t hash_ = 0;
+};
+
+struct EFilterKeyHash {
+    size_t operator()(const EFilterKey &key) const
+    {
+        return key.hash_;
+    }
+};
+
+// Immutable snapshot of the registered filters. Registrations publish a new snapshot instead of changing the current
+// one, so that lookups never wait for them. The keys point into EFilterFactory::effectNames_.
+struct EFilterRegistry {
+    std::unordered_map<EFilterKey, EFilterFunction, EFilterKeyHash> functions_;
+    std::unordered_map<EFilterKey, std::shared_ptr<IFilterDelegate>, EFilterKeyHash> delegates_;
+    std::unordered_map<EFilterKey, std::shared_ptr<EffectInfo>, EFilterKeyHash> delegateInfos_;
+    // Names of the functions in alphabetical order.
+    std::vector<const char *> names_;
+};
+
 class EFilterFactory {
 public:
     ~EFilterFactory();
@@ -63,7 +108,13 @@ public:
     IMAGE_EFFECT_EXPORT
     std::shared_ptr<EFilter> Restore(const std::string &name, const EffectJsonPtr &root, void *handler);
 
-    template <class T> void RegisterEFilter(const std::string &name)
+    // Restores a filter of a binary chain, its values are set without going through json.
+    IMAGE_EFFECT_EXPORT std::shared_ptr<EFilter> Restore(const EffectFilterPrototype &prototype, void *handler);
+
+    // Creates a filter of the same name with a copy of the values of the given one.
+    IMAGE_EFFECT_EXPORT std::shared_ptr<EFilter> Clone(const std::shared_ptr<EFilter> &efilter, void *handler);
+
+    template <class T> static EFilterFunction GetFunction()
     {
         EFilterFunction function;
         function.generator_ = [](const std::string &name) -> std::shared_ptr<EFilter> {
@@ -72,24 +123,55 @@ public:
         function.infoGetter_ = [](const std::string &name) -> std::shared_ptr<EffectInfo> {
             return T::GetEffectInfo(name);
         };
+        return function;
+    }
 
-        RegisterFunction(name, function);
+    template <class T> void RegisterEFilter(const std::string &name)
+    {
+        RegisterFunction(name, GetFunction<T>());
     }
 
     IMAGE_EFFECT_EXPORT std::shared_ptr<EffectInfo> GetEffectInfo(const std::string &name);
 
+    IMAGE_EFFECT_EXPORT std::shared_ptr<EffectInfo> GetEffectInfo(const EFilterKey &key);
+
     IMAGE_EFFECT_EXPORT void GetAllEffectNames(std::vector<const char *> &names);
 
-    void ClearFunctions();
+    // Effect info given with the delegate of a custom filter.
+    std::shared_ptr<EffectInfo> GetDelegateInfo(const std::string &name);
+
+    IMAGE_EFFECT_EXPORT void ClearFunctions();
+
+    IMAGE_EFFECT_EXPORT void ClearDelegates();
+
+    IMAGE_EFFECT_EXPORT EFilterRegisterStats GetRegisterStats() const;
 
 private:
-    EFilterFactory() = default;
+    EFilterFactory();
+
+    // Current snapshot as last seen by the calling thread. The reference stays valid until the next lookup of the
+    // same thread, which may move on to a newer snapshot.
+    const EFilterRegistry &GetRegistry() const;
+
+    // Copies the current snapshot, applies the update to the copy and publishes it.
+    void UpdateRegistry(const std::function<void(EFilterRegistry &registry)> &update);
+
+    // Key of the registered copy of the name, only called with registryMutex_ held.
+    EFilterKey InternName(const std::string &name);
+
+    void AddRegisterCost(int64_t beginNs);
 
-    mutable std::recursive_mutex functionsMutex_;
-    std::map<std::string, EFilterFunction> functions_;
+    // Guarded by registryMutex_. Lookups read it only when registryVersion_ tells them that their thread's copy is
+    // out of date, that is once after each registration.
+    std::shared_ptr<const EFilterRegistry> registry_;
+    std::atomic<uint64_t> registryVersion_ = 0;
 
-    mutable std::recursive_mutex delegatesMutex_;
-    std::map<std::string, std::shared_ptr<IFilterDelegate>> delegates_;
+    // Serializes the registrations and the refresh of the per-thread copies.
+    mutable std::mutex registryMutex_;
+    // Every name registered so far. The snapshot keys and the names handed out by GetAllEffectNames point into it, so
+    // names are never removed.
+    std::unordered_set<std::string> effectNames_;
+    EFilterRegisterStats registerStats_;
 };
 
 template <typename T> class AutoRegisterEFilter {
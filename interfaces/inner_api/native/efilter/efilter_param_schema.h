@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_EFILTER_PARAM_SCHEMA_H
+#define IMAGE_EFFECT_EFILTER_PARAM_SCHEMA_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "any.h"
+#include "error_code.h"
+#include "image_effect_marco_define.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+enum class EFilterParamType : uint8_t {
+    FLOAT = 0,
+    INT32,
+    UINT32,
+    REGION, // RenderRegion
+};
+
+struct EFilterParamDesc {
+    std::string key_;
+    EFilterParamType type_ = EFilterParamType::FLOAT;
+    size_t offset_ = 0;
+    uint32_t index_ = 0;
+};
+
+/**
+ * Typed parameters of a filter, each one a field of a plain parameter struct of the filter. The keys are interned once
+ * when the schema is built, so that a value set by key is written straight into its field and the render reads the
+ * struct without any lookup. The index of a parameter is its bit in the set and dirty masks of the filter.
+ */
+class EFilterParamSchema {
+public:
+    static constexpr uint32_t MAX_PARAM_NUM = 64;
+
+    IMAGE_EFFECT_EXPORT ErrorCode Add(const std::string &key, EFilterParamType type, size_t offset);
+
+    IMAGE_EFFECT_EXPORT const EFilterParamDesc *Find(const std::string &key) const;
+
+    const std::vector<EFilterParamDesc> &GetParams() const
+    {
+        return params_;
+    }
+
+    // Writes the value into the field of the parameter in the block, the type of the value has to match exactly.
+    IMAGE_EFFECT_EXPORT static ErrorCode Write(const EFilterParamDesc &desc, const Any &value, void *block);
+
+    static uint64_t ToMask(uint32_t index)
+    {
+        return static_cast<uint64_t>(1) << index;
+    }
+
+private:
+    std::vector<EFilterParamDesc> params_;
+    std::unordered_map<std::string, uint32_t> indexes_;
+};
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+#endif // IMAGE_EFFECT_EFILTER_PARAM_SCHEMA_H
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_EFFECT_BINARY_HELPER_H
+#define IMAGE_EFFECT_EFFECT_BINARY_HELPER_H
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "any.h"
+#include "error_code.h"
+#include "image_effect_marco_define.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+// Filter of a serialized chain: its name and the values that are float, int32_t, uint32_t or RenderRegion.
+struct EffectFilterPrototype {
+    std::string name_;
+    std::vector<std::pair<std::string, Any>> values_;
+};
+
+struct EffectChainPrototype {
+    std::string name_;
+    std::vector<EffectFilterPrototype> filters_;
+};
+
+/**
+ * Binary form of an effect chain, the counterpart of the json form without going through cJSON. All the integers are
+ * little endian, the strings are length prefixed and the names of the chain, the filters and the values are interned
+ * in a string table:
+ *
+ *   header  : magic u32, version u16, reserved u16, size of the whole data u32
+ *   strings : count u32, then for each string its length u32 and its bytes
+ *   chain   : name index u32, filter count u32
+ *   filter  : name index u32, value count u32
+ *   value   : key index u32, type u8, 4 bytes payload. A region has its payload size 16 there instead, followed by
+ *             x0, y0, x1 and y1 as int32
+ *
+ * Decoded chains are kept in a bounded memo cache keyed by the hash of the data, so that restoring the same data again
+ * skips the parsing.
+ */
+class EffectBinaryHelper {
+public:
+    static constexpr uint32_t BINARY_MAGIC = 0x42464549; // "IEFB"
+    static constexpr uint16_t BINARY_VERSION = 2;
+    static constexpr size_t CHAIN_CACHE_CAPACITY = 64;
+
+    IMAGE_EFFECT_EXPORT static ErrorCode Encode(const EffectChainPrototype &chain, std::vector<uint8_t> &data);
+
+    IMAGE_EFFECT_EXPORT static ErrorCode Decode(const uint8_t *data, size_t size,
+        std::shared_ptr<const EffectChainPrototype> &chain);
+
+    IMAGE_EFFECT_EXPORT static void ClearCache();
+
+    IMAGE_EFFECT_EXPORT static size_t GetCacheSize();
+};
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+#endif // IMAGE_EFFECT_EFFECT_BINARY_HELPER_H
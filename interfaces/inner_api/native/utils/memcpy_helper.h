@@ -31,6 +31,10 @@ struct CopyInfo {
     uint8_t *data = nullptr;
 };
 
+/**
+ * Copies between buffers of possibly different strides. Large copies are split among the render workers and written
+ * with non-temporal stores, yuv buffers are copied plane by plane.
+ */
 class MemcpyHelper {
 public:
     IMAGE_EFFECT_EXPORT static void CopyData(CopyInfo &src, CopyInfo &dst);
@@ -39,6 +43,9 @@ public:
     IMAGE_EFFECT_EXPORT static void CopyData(CopyInfo &src, EffectBuffer *dst);
     IMAGE_EFFECT_EXPORT static void CopyData(EffectBuffer *buffer, MemoryData *memoryData);
     IMAGE_EFFECT_EXPORT static void CopyData(MemoryData *src, MemoryData *dst);
+
+    // Total bytes copied by the process, for profiling.
+    IMAGE_EFFECT_EXPORT static uint64_t GetCopiedBytes();
 };
 } // namespace Effect
 } // namespace Media
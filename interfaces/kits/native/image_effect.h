@@ -419,6 +419,158 @@ ImageEffect_ErrorCode OH_ImageEffect_Save(OH_ImageEffect *imageEffect, char **in
  */
 OH_ImageEffect *OH_ImageEffect_Restore(const char *info);
 
+/**
+ * @brief Convert the OH_ImageEffect and the information of the filters in OH_ImageEffect to a versioned binary data,
+ * which is more compact than the JSON string and is restored without parsing it again when it was restored recently
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @param imageEffect Encapsulate OH_ImageEffect structure instance pointer
+ * @param data Indicates the serialized data, valid until the next call or the release of the OH_ImageEffect
+ * @param size Indicates the size of the serialized data in bytes
+ * @return Returns EFFECT_SUCCESS if the execution is successful, otherwise returns a specific error code, refer to
+ * {@link ImageEffect_ErrorCode}
+ * {@link EFFECT_ERROR_PARAM_INVALID}, the input parameter is a null pointer.
+ * {@link EFFECT_PARAM_ERROR}, the OH_ImageEffect contains a filter registered by OH_EffectFilter_Register.
+ * @since 21
+ */
+ImageEffect_ErrorCode OH_ImageEffect_SaveBinary(OH_ImageEffect *imageEffect, const uint8_t **data, uint32_t *size);
+
+/**
+ * @brief Create an OH_ImageEffect instance by deserializing the binary data
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @param data Indicates the serialized data that is obtained by {@link OH_ImageEffect_SaveBinary}
+ * @param size Indicates the size of the serialized data in bytes
+ * @return Returns a pointer to an OH_ImageEffect instance if the execution is successful, otherwise returns nullptr
+ * @since 21
+ */
+OH_ImageEffect *OH_ImageEffect_RestoreBinary(const uint8_t *data, uint32_t size);
+
+/**
+ * @brief Create an OH_ImageEffect instance with the filters, the filter parameters and the configuration of a prepared
+ * OH_ImageEffect. The input and the output of the prepared OH_ImageEffect are not copied, and the filters of the new
+ * instance are released together with it
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @param imageEffect Encapsulate OH_ImageEffect structure instance pointer to be copied
+ * @return Returns a pointer to an OH_ImageEffect instance if the execution is successful, otherwise returns nullptr
+ * @since 21
+ */
+OH_ImageEffect *OH_ImageEffect_Clone(OH_ImageEffect *imageEffect);
+
+/**
+ * @brief Start loading the image effect extension on a background thread, so that the first OH_ImageEffect or
+ * OH_EffectFilter created does not wait for it. It is meant to be called early at the start of the process, the calls
+ * after the first one have no effect
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @since 21
+ */
+void OH_ImageEffect_Preload(void);
+
+/**
+ * @brief Check whether the loading of the image effect extension has finished, without waiting for it
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @return Returns true if the loading has finished, otherwise returns false
+ * @since 21
+ */
+bool OH_ImageEffect_IsPreloadReady(void);
+
+/**
+ * @brief Set the directory where the compiled shader programs of the filters are kept, so that the next runs of the
+ * application load them instead of compiling the shaders again. It is usually a subdirectory of the cache directory of
+ * the application. The programs are only kept in memory while no directory is set, an empty path goes back to that
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @param path Indicates the path of an existing directory
+ * @return Returns EFFECT_SUCCESS if the execution is successful, returns EFFECT_ERROR_PARAM_INVALID if the path is null
+ * or is not an existing directory
+ * @since 21
+ */
+ImageEffect_ErrorCode OH_ImageEffect_SetShaderCacheDir(const char *path);
+
+/**
+ * @brief Enumerates the stages of a frame processed in the surface mode
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @since 21
+ */
+typedef enum ImageEffect_FrameStage {
+    /** Waiting for the fence of the input buffer */
+    EFFECT_FRAME_STAGE_FENCE_WAIT = 0,
+    /** Invalidating the cache of the input buffer */
+    EFFECT_FRAME_STAGE_INVALIDATE_CACHE = 1,
+    /** Requesting a buffer from the output surface */
+    EFFECT_FRAME_STAGE_REQUEST_BUFFER = 2,
+    /** Waiting for the render thread */
+    EFFECT_FRAME_STAGE_QUEUE = 3,
+    /** Rendering the filters */
+    EFFECT_FRAME_STAGE_RENDER = 4,
+    /** Flushing the buffer to the output surface */
+    EFFECT_FRAME_STAGE_FLUSH = 5,
+    /** From acquiring the input buffer to flushing the output buffer */
+    EFFECT_FRAME_STAGE_TOTAL = 6,
+} ImageEffect_FrameStage;
+
+/**
+ * @brief Number of the stages in {@link ImageEffect_FrameStage}
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @since 21
+ */
+#define OH_EFFECT_FRAME_STAGE_NUM 7
+
+/**
+ * @brief Latency percentiles of a frame stage, in microseconds
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @since 21
+ */
+typedef struct ImageEffect_FrameLatency {
+    /** The 50th percentile */
+    uint32_t p50;
+    /** The 95th percentile */
+    uint32_t p95;
+    /** The 99th percentile */
+    uint32_t p99;
+} ImageEffect_FrameLatency;
+
+/**
+ * @brief Frame statistics of the surface mode. The latencies and the fps are computed over the latest rendered frames
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @since 21
+ */
+typedef struct ImageEffect_FrameStatistics {
+    /** Number of the rendered frames */
+    uint64_t renderedFrames;
+    /** Number of the frames dropped because the render falls behind */
+    uint64_t droppedFrames;
+    /** Number of the frames waiting for the render thread */
+    uint32_t queueDepth;
+    /** Maximum number of the frames waiting for the render thread */
+    uint32_t maxQueueDepth;
+    /** Achieved frames per second */
+    float fps;
+    /** Latency of each stage, indexed by {@link ImageEffect_FrameStage} */
+    ImageEffect_FrameLatency latency[OH_EFFECT_FRAME_STAGE_NUM];
+} ImageEffect_FrameStatistics;
+
+/**
+ * @brief Get the frame statistics of the OH_ImageEffect working in the surface mode
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @param imageEffect Encapsulate OH_ImageEffect structure instance pointer
+ * @param statistics Indicates the frame statistics that is obtained
+ * @return Returns EFFECT_SUCCESS if the execution is successful, otherwise returns a specific error code, refer to
+ * {@link ImageEffect_ErrorCode}
+ * {@link EFFECT_ERROR_PARAM_INVALID}, the input parameter is a null pointer.
+ * @since 21
+ */
+ImageEffect_ErrorCode OH_ImageEffect_GetFrameStatistics(OH_ImageEffect *imageEffect,
+    ImageEffect_FrameStatistics *statistics);
+
 #ifdef __cplusplus
 }
 #endif
@@ -57,6 +57,9 @@ typedef struct OH_EffectFilter OH_EffectFilter;
  * {@link OH_EFFECT_FILTER_INTENSITY_KEY} and the value refer to {@link ImageEffect_Any} that contain the data type of
  * {@link EFFECT_DATA_TYPE_FLOAT}
  *
+ * Since API 21 the filter also takes the optional parameter matched with the key refer to
+ * {@link OH_EFFECT_FILTER_REGION_KEY}, the filter then only changes the pixels inside the region.
+ *
  * @syscap SystemCapability.Multimedia.ImageEffect.Core
  * @since 12
  */
@@ -67,6 +70,9 @@ typedef struct OH_EffectFilter OH_EffectFilter;
  * {@link OH_EFFECT_FILTER_INTENSITY_KEY} and the value refer to {@link ImageEffect_Any} that contain the data type of
  * {@link EFFECT_DATA_TYPE_FLOAT}
  *
+ * Since API 21 the filter also takes the optional parameter matched with the key refer to
+ * {@link OH_EFFECT_FILTER_REGION_KEY}, the filter then only changes the pixels inside the region.
+ *
  * @syscap SystemCapability.Multimedia.ImageEffect.Core
  * @since 12
  */
@@ -297,6 +303,81 @@ ImageEffect_ErrorCode OH_EffectFilterInfo_SetSupportedFormats(OH_EffectFilterInf
 ImageEffect_ErrorCode OH_EffectFilterInfo_GetSupportedFormats(OH_EffectFilterInfo *info, uint32_t *size,
     ImageEffect_Format **formatArray);
 
+/**
+ * @brief Enumerates the ways a delegate filter renders an image
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @since 21
+ */
+typedef enum ImageEffect_RenderMode {
+    /** The filter modifies the image in place, see {@link OH_EffectFilterDelegate_Render}. It is the default mode */
+    EFFECT_RENDER_MODE_IN_PLACE = 0,
+    /**
+     * The filter reads the input image and writes the output image, see {@link OH_EffectFilterDelegate_RenderWithDst}.
+     * The input and the output are always different buffers
+     */
+    EFFECT_RENDER_MODE_SRC_TO_DST = 1,
+    /**
+     * The filter reads the input image and writes the output image, see {@link OH_EffectFilterDelegate_RenderWithDst}.
+     * The filter also works when the input and the output are the same buffer, so it can be rendered in place
+     */
+    EFFECT_RENDER_MODE_SRC_TO_DST_OR_IN_PLACE = 2,
+} ImageEffect_RenderMode;
+
+/**
+ * @brief Set the render mode to OH_EffectFilterInfo structure
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @param info Encapsulate OH_EffectFilterInfo structure instance pointer
+ * @param mode Indicates the render mode of the delegate filter, see {@link ImageEffect_RenderMode}
+ * @return Returns EFFECT_SUCCESS if the execution is successful, otherwise returns a specific error code, refer to
+ * {@link ImageEffect_ErrorCode}
+ * {@link EFFECT_ERROR_PARAM_INVALID}, the input parameter is a null pointer or the mode is invalid.
+ * @since 21
+ */
+ImageEffect_ErrorCode OH_EffectFilterInfo_SetRenderMode(OH_EffectFilterInfo *info, ImageEffect_RenderMode mode);
+
+/**
+ * @brief Get the render mode from OH_EffectFilterInfo structure
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @param info Encapsulate OH_EffectFilterInfo structure instance pointer
+ * @param mode Indicates the render mode of the delegate filter, see {@link ImageEffect_RenderMode}
+ * @return Returns EFFECT_SUCCESS if the execution is successful, otherwise returns a specific error code, refer to
+ * {@link ImageEffect_ErrorCode}
+ * {@link EFFECT_ERROR_PARAM_INVALID}, the input parameter is a null pointer.
+ * @since 21
+ */
+ImageEffect_ErrorCode OH_EffectFilterInfo_GetRenderMode(OH_EffectFilterInfo *info, ImageEffect_RenderMode *mode);
+
+/**
+ * @brief Set the halo to OH_EffectFilterInfo structure. The halo is the number of the pixels around a region that the
+ * delegate filter reads from the input image to render the region, it is 0 for the filters which read the pixel at
+ * the same position only. It is used by {@link OH_EffectFilterDelegate_RenderRegion}
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @param info Encapsulate OH_EffectFilterInfo structure instance pointer
+ * @param halo Indicates the number of the pixels around a region that the filter reads
+ * @return Returns EFFECT_SUCCESS if the execution is successful, otherwise returns a specific error code, refer to
+ * {@link ImageEffect_ErrorCode}
+ * {@link EFFECT_ERROR_PARAM_INVALID}, the input parameter is a null pointer.
+ * @since 21
+ */
+ImageEffect_ErrorCode OH_EffectFilterInfo_SetRenderHalo(OH_EffectFilterInfo *info, uint32_t halo);
+
+/**
+ * @brief Get the halo from OH_EffectFilterInfo structure
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @param info Encapsulate OH_EffectFilterInfo structure instance pointer
+ * @param halo Indicates the number of the pixels around a region that the filter reads
+ * @return Returns EFFECT_SUCCESS if the execution is successful, otherwise returns a specific error code, refer to
+ * {@link ImageEffect_ErrorCode}
+ * {@link EFFECT_ERROR_PARAM_INVALID}, the input parameter is a null pointer.
+ * @since 21
+ */
+ImageEffect_ErrorCode OH_EffectFilterInfo_GetRenderHalo(OH_EffectFilterInfo *info, uint32_t *halo);
+
 /**
  * @brief Clear the internal resources of the OH_EffectFilterInfo and destroy the OH_EffectFilterInfo instance
  *
@@ -563,6 +644,23 @@ typedef void (*OH_EffectFilterDelegate_PushData)(OH_EffectFilter *filter, OH_Eff
 typedef bool (*OH_EffectFilterDelegate_Render)(OH_EffectFilter *filter, OH_EffectBufferInfo *info,
     OH_EffectFilterDelegate_PushData pushData);
 
+/**
+ * @brief When the method of OH_ImageEffect_Start is executed on delegate filter that is registered by
+ * {@link OH_EffectFilter_RegisterWithDstRender}, the function pointer will be called for rendering the input image
+ * to the output image. The output image is passed to the next filter, there is no need to push data. It is used for
+ * the images in memory, the textures are still rendered by {@link OH_EffectFilterDelegate_Render}
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @param filter Encapsulate OH_EffectFilter structure instance pointer
+ * @param src Indicates the information of the input image, see {@link OH_EffectBufferInfo}
+ * @param dst Indicates the information of the output image, which has the same size and format as the input image.
+ * It is the same as src only if the render mode is {@link EFFECT_RENDER_MODE_SRC_TO_DST_OR_IN_PLACE}
+ * @return Returns true if this function point is executed successfully, otherwise returns false
+ * @since 21
+ */
+typedef bool (*OH_EffectFilterDelegate_RenderWithDst)(OH_EffectFilter *filter, OH_EffectBufferInfo *src,
+    OH_EffectBufferInfo *dst);
+
 /**
  * @brief When the method of OH_ImageEffect_Save is executed on delegate filter that is contained in OH_ImageEffect,
  * the function pointer will be called for serializing the delegate filter parameters
@@ -624,6 +722,26 @@ typedef struct ImageEffect_Region {
     int32_t y1;
 } ImageEffect_Region;
 
+/**
+ * @brief When the method of OH_ImageEffect_Start is executed on delegate filter that is registered by
+ * {@link OH_EffectFilter_RegisterWithRegionRender}, the image is split into regions and the function pointer is
+ * called for each region, from several threads at the same time. It is used for the images in memory, the textures
+ * are still rendered by {@link OH_EffectFilterDelegate_Render}
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @param filter Encapsulate OH_EffectFilter structure instance pointer
+ * @param src Indicates the information of the whole input image, see {@link OH_EffectBufferInfo}. The filter reads
+ * the region and the halo around it, see {@link OH_EffectFilterInfo_SetRenderHalo}
+ * @param dst Indicates the information of the whole output image, which has the same size and format as the input
+ * image. The filter only writes the pixels inside the region. It is the same as src only if the halo is 0
+ * @param region Indicates the region to render, x0 and y0 are inclusive and x1 and y1 are exclusive. The y0 and y1
+ * are even unless y1 is the height of the image, so a region covers whole rows of the chroma plane of YUV images
+ * @return Returns true if this function point is executed successfully, otherwise returns false
+ * @since 21
+ */
+typedef bool (*OH_EffectFilterDelegate_RenderRegion)(OH_EffectFilter *filter, const OH_EffectBufferInfo *src,
+    OH_EffectBufferInfo *dst, const ImageEffect_Region *region);
+
 /**
  * @brief Describes the image size information
  *
@@ -687,6 +805,42 @@ ImageEffect_ErrorCode OH_EffectFilter_GetValue(OH_EffectFilter *filter, const ch
 ImageEffect_ErrorCode OH_EffectFilter_Register(const OH_EffectFilterInfo *info,
     const ImageEffect_FilterDelegate *delegate);
 
+/**
+ * @brief Register the delegate filter which reads the input image and writes the output image. The engine does not
+ * copy the input image to the output image before rendering, as it does for {@link OH_EffectFilterDelegate_Render}
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @param info Indicates the capabilities supported by delegate filter, see {@link OH_EffectFilterInfo}. The render
+ * mode should be set by {@link OH_EffectFilterInfo_SetRenderMode}, otherwise the renderWithDst is not used
+ * @param delegate A collection of all callback functions, see {@link ImageEffect_FilterDelegate}
+ * @param renderWithDst Indicates the callback function for rendering the input image to the output image, see
+ * {@link OH_EffectFilterDelegate_RenderWithDst}
+ * @return Returns EFFECT_SUCCESS if the execution is successful, otherwise returns a specific error code, refer to
+ * {@link ImageEffect_ErrorCode}
+ * {@link EFFECT_ERROR_PARAM_INVALID}, the input parameter is a null pointer.
+ * @since 21
+ */
+ImageEffect_ErrorCode OH_EffectFilter_RegisterWithDstRender(const OH_EffectFilterInfo *info,
+    const ImageEffect_FilterDelegate *delegate, OH_EffectFilterDelegate_RenderWithDst renderWithDst);
+
+/**
+ * @brief Register the delegate filter which renders the image by regions, so the engine renders the regions on its
+ * render threads in parallel. The filter must not start its own threads for rendering
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @param info Indicates the capabilities supported by delegate filter, see {@link OH_EffectFilterInfo}. The halo
+ * should be set by {@link OH_EffectFilterInfo_SetRenderHalo} if the filter reads the neighbors of a pixel
+ * @param delegate A collection of all callback functions, see {@link ImageEffect_FilterDelegate}
+ * @param renderRegion Indicates the callback function for rendering a region of the image, see
+ * {@link OH_EffectFilterDelegate_RenderRegion}. It must be safe to be called from several threads at the same time
+ * @return Returns EFFECT_SUCCESS if the execution is successful, otherwise returns a specific error code, refer to
+ * {@link ImageEffect_ErrorCode}
+ * {@link EFFECT_ERROR_PARAM_INVALID}, the input parameter is a null pointer.
+ * @since 21
+ */
+ImageEffect_ErrorCode OH_EffectFilter_RegisterWithRegionRender(const OH_EffectFilterInfo *info,
+    const ImageEffect_FilterDelegate *delegate, OH_EffectFilterDelegate_RenderRegion renderRegion);
+
 /**
  * @brief Lookup for the filter names that matches the lookup condition. It should be noted that the allocated memory of
  * ImageEffect_FilterNames can be manually released by invoking {@link OH_EffectFilter_ReleaseFilterNames} if need
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_BENCHMARK_COMMON_H
+#define IMAGE_EFFECT_BENCHMARK_COMMON_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "effect_buffer.h"
+#include "format_helper.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Benchmark {
+struct Resolution {
+    int64_t width;
+    int64_t height;
+};
+
+// VGA, 1080p, 12MP, 50MP and 200MP.
+const std::vector<Resolution> BENCHMARK_RESOLUTIONS = {
+    { 640, 480 },
+    { 1920, 1080 },
+    { 4000, 3000 },
+    { 8160, 6120 },
+    { 16320, 12240 },
+};
+
+constexpr int BENCHMARK_MAX_THREAD_NUM = 4;
+// Skip the combinations of resolution and thread number which would allocate more than this on a device.
+constexpr int64_t BENCHMARK_MAX_TOTAL_PIXELS = 256LL * 1000 * 1000;
+constexpr uint8_t BENCHMARK_PIXEL_VALUE = 128;
+
+inline void ApplyResolutions(benchmark::internal::Benchmark *bench)
+{
+    bench->ArgNames({ "width", "height" });
+    for (const auto &resolution : BENCHMARK_RESOLUTIONS) {
+        bench->Args({ resolution.width, resolution.height });
+    }
+}
+
+inline void ApplyResolutionsWithStrides(benchmark::internal::Benchmark *bench)
+{
+    // The row padding in bytes of the destination, 0 is a plain copy of the whole buffer.
+    const std::vector<int64_t> paddings = { 0, 64, 256 };
+    bench->ArgNames({ "width", "height", "padding" });
+    for (const auto &resolution : BENCHMARK_RESOLUTIONS) {
+        for (int64_t padding : paddings) {
+            bench->Args({ resolution.width, resolution.height, padding });
+        }
+    }
+}
+
+inline uint32_t GetWidth(const benchmark::State &state)
+{
+    return static_cast<uint32_t>(state.range(0));
+}
+
+inline uint32_t GetHeight(const benchmark::State &state)
+{
+    return static_cast<uint32_t>(state.range(1));
+}
+
+inline bool SkipIfTooLarge(benchmark::State &state)
+{
+    int64_t totalPixels = state.range(0) * state.range(1) * state.threads();
+    if (totalPixels > BENCHMARK_MAX_TOTAL_PIXELS) {
+        state.SkipWithError("resolution is too large for the thread number");
+        return true;
+    }
+    return false;
+}
+
+inline void SetProcessed(benchmark::State &state, uint64_t bytesPerIteration)
+{
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytesPerIteration));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * state.range(1));
+}
+
+// Heap backed effect buffer which owns its memory.
+class HeapEffectBuffer {
+public:
+    HeapEffectBuffer(uint32_t width, uint32_t height, IEffectFormat format, uint32_t padding = 0)
+    {
+        auto bufferInfo = std::make_shared<BufferInfo>();
+        bufferInfo->width_ = width;
+        bufferInfo->height_ = height;
+        bufferInfo->formatType_ = format;
+        bufferInfo->rowStride_ = FormatHelper::CalculateRowStride(width, format) + padding;
+        bufferInfo->len_ = bufferInfo->rowStride_ * FormatHelper::CalculateDataRowCount(height, format);
+        bufferInfo->bufferType_ = BufferType::HEAP_MEMORY;
+        data_ = std::vector<uint8_t>(bufferInfo->len_, BENCHMARK_PIXEL_VALUE);
+        bufferInfo->addr_ = data_.data();
+        auto extraInfo = std::make_shared<ExtraInfo>();
+        extraInfo->dataType = DataType::PIXEL_MAP;
+        extraInfo->bufferType = BufferType::HEAP_MEMORY;
+        buffer_ = std::make_shared<EffectBuffer>(bufferInfo, data_.data(), extraInfo);
+    }
+
+    EffectBuffer *Get() const
+    {
+        return buffer_.get();
+    }
+
+    uint32_t GetLen() const
+    {
+        return buffer_->bufferInfo_->len_;
+    }
+
+private:
+    std::vector<uint8_t> data_;
+    std::shared_ptr<EffectBuffer> buffer_;
+};
+} // namespace Benchmark
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+#endif // IMAGE_EFFECT_BENCHMARK_COMMON_H
@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+
+#include "benchmark_common.h"
+#include "cpu_brightness_algo.h"
+#include "cpu_colorspace_converter.h"
+#include "cpu_contrast_algo.h"
+#include "cpu_hdr_processor.h"
+#include "crop_efilter.h"
+#include "effect_context.h"
+#include "memcpy_helper.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Benchmark {
+namespace {
+constexpr float FILTER_INTENSITY = 50.f;
+
+// Runs the typed entry used by the filters, the lut is built on each frame like for a filter whose intensity changes.
+void RunCpuAlgo(benchmark::State &state, PointwiseApplyFunc func, IEffectFormat format)
+{
+    if (SkipIfTooLarge(state)) {
+        return;
+    }
+    HeapEffectBuffer src(GetWidth(state), GetHeight(state), format);
+    HeapEffectBuffer dst(GetWidth(state), GetHeight(state), format);
+    PointwiseParams params;
+    params.intensity_ = FILTER_INTENSITY;
+    std::shared_ptr<EffectContext> context = std::make_shared<EffectContext>();
+    for (auto _ : state) {
+        ErrorCode res = func(src.Get(), dst.Get(), params, context);
+        if (res != ErrorCode::SUCCESS) {
+            state.SkipWithError("render fail");
+            return;
+        }
+        benchmark::ClobberMemory();
+    }
+    SetProcessed(state, src.GetLen());
+}
+
+void RunConvertFormat(benchmark::State &state, IEffectFormat srcFormat, IEffectFormat dstFormat)
+{
+    if (SkipIfTooLarge(state)) {
+        return;
+    }
+    HeapEffectBuffer src(GetWidth(state), GetHeight(state), srcFormat);
+    HeapEffectBuffer dst(GetWidth(state), GetHeight(state), dstFormat);
+    FormatConverterInfo srcInfo = { *src.Get()->bufferInfo_, src.Get()->buffer_ };
+    FormatConverterInfo dstInfo = { *dst.Get()->bufferInfo_, dst.Get()->buffer_ };
+    for (auto _ : state) {
+        if (FormatHelper::ConvertFormat(srcInfo, dstInfo) != ErrorCode::SUCCESS) {
+            state.SkipWithError("convert format fail");
+            return;
+        }
+        benchmark::ClobberMemory();
+    }
+    SetProcessed(state, src.GetLen() + dst.GetLen());
+}
+
+void RunCpuColorSpace(benchmark::State &state, EffectColorSpace srcColorSpace, EffectColorSpace dstColorSpace)
+{
+    if (SkipIfTooLarge(state)) {
+        return;
+    }
+    HeapEffectBuffer src(GetWidth(state), GetHeight(state), IEffectFormat::RGBA8888);
+    HeapEffectBuffer dst(GetWidth(state), GetHeight(state), IEffectFormat::RGBA8888);
+    src.Get()->bufferInfo_->colorSpace_ = srcColorSpace;
+    for (auto _ : state) {
+        if (CpuColorSpaceConverter::Convert(src.Get(), dst.Get(), dstColorSpace) != ErrorCode::SUCCESS) {
+            state.SkipWithError("convert color space fail");
+            return;
+        }
+        benchmark::ClobberMemory();
+    }
+    SetProcessed(state, src.GetLen());
+}
+
+enum class CpuHdrOperation {
+    TONE_MAP,
+    DECOMPOSE,
+    COMPOSE,
+};
+
+void RunCpuHdr(benchmark::State &state, CpuHdrOperation operation)
+{
+    if (SkipIfTooLarge(state)) {
+        return;
+    }
+    uint32_t width = GetWidth(state);
+    uint32_t height = GetHeight(state);
+    HeapEffectBuffer hdr(width, height, IEffectFormat::RGBA_1010102);
+    HeapEffectBuffer sdr(width, height, IEffectFormat::RGBA8888);
+    HeapEffectBuffer gainmap(width / 2, height / 2, IEffectFormat::RGBA8888);
+    hdr.Get()->bufferInfo_->colorSpace_ = EffectColorSpace::BT2020_HLG;
+    sdr.Get()->bufferInfo_->colorSpace_ = EffectColorSpace::DISPLAY_P3;
+    gainmap.Get()->bufferInfo_->colorSpace_ = EffectColorSpace::DISPLAY_P3;
+    CpuGainmapMetadata metadata;
+    if (CpuHdrProcessor::Decompose(hdr.Get(), sdr.Get(), gainmap.Get(), metadata) != ErrorCode::SUCCESS) {
+        state.SkipWithError("decompose hdr image fail");
+        return;
+    }
+    for (auto _ : state) {
+        ErrorCode res = ErrorCode::SUCCESS;
+        switch (operation) {
+            case CpuHdrOperation::TONE_MAP:
+                res = CpuHdrProcessor::ToneMap(hdr.Get(), sdr.Get());
+                break;
+            case CpuHdrOperation::DECOMPOSE:
+                res = CpuHdrProcessor::Decompose(hdr.Get(), sdr.Get(), gainmap.Get(), metadata);
+                break;
+            case CpuHdrOperation::COMPOSE:
+                res = CpuHdrProcessor::Compose(sdr.Get(), gainmap.Get(), metadata, hdr.Get());
+                break;
+        }
+        if (res != ErrorCode::SUCCESS) {
+            state.SkipWithError("process hdr image fail");
+            return;
+        }
+        benchmark::ClobberMemory();
+    }
+    SetProcessed(state, hdr.GetLen());
+}
+} // namespace
+
+void BM_CpuBrightness_RGBA8888(benchmark::State &state)
+{
+    RunCpuAlgo(state, CpuBrightnessAlgo::OnApplyRGBA8888, IEffectFormat::RGBA8888);
+}
+BENCHMARK(BM_CpuBrightness_RGBA8888)->Apply(ApplyResolutions)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)->UseRealTime();
+
+void BM_CpuBrightness_NV12(benchmark::State &state)
+{
+    RunCpuAlgo(state, CpuBrightnessAlgo::OnApplyYUVNV12, IEffectFormat::YUVNV12);
+}
+BENCHMARK(BM_CpuBrightness_NV12)->Apply(ApplyResolutions)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)->UseRealTime();
+
+void BM_CpuBrightness_NV21(benchmark::State &state)
+{
+    RunCpuAlgo(state, CpuBrightnessAlgo::OnApplyYUVNV21, IEffectFormat::YUVNV21);
+}
+BENCHMARK(BM_CpuBrightness_NV21)->Apply(ApplyResolutions)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)->UseRealTime();
+
+void BM_CpuContrast_RGBA8888(benchmark::State &state)
+{
+    RunCpuAlgo(state, CpuContrastAlgo::OnApplyRGBA8888, IEffectFormat::RGBA8888);
+}
+BENCHMARK(BM_CpuContrast_RGBA8888)->Apply(ApplyResolutions)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)->UseRealTime();
+
+void BM_CpuContrast_NV12(benchmark::State &state)
+{
+    RunCpuAlgo(state, CpuContrastAlgo::OnApplyYUVNV12, IEffectFormat::YUVNV12);
+}
+BENCHMARK(BM_CpuContrast_NV12)->Apply(ApplyResolutions)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)->UseRealTime();
+
+void BM_CpuContrast_NV21(benchmark::State &state)
+{
+    RunCpuAlgo(state, CpuContrastAlgo::OnApplyYUVNV21, IEffectFormat::YUVNV21);
+}
+BENCHMARK(BM_CpuContrast_NV21)->Apply(ApplyResolutions)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)->UseRealTime();
+
+void BM_ConvertFormat_RGBAToNV12(benchmark::State &state)
+{
+    RunConvertFormat(state, IEffectFormat::RGBA8888, IEffectFormat::YUVNV12);
+}
+BENCHMARK(BM_ConvertFormat_RGBAToNV12)->Apply(ApplyResolutions)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)
+    ->UseRealTime();
+
+void BM_ConvertFormat_RGBAToNV21(benchmark::State &state)
+{
+    RunConvertFormat(state, IEffectFormat::RGBA8888, IEffectFormat::YUVNV21);
+}
+BENCHMARK(BM_ConvertFormat_RGBAToNV21)->Apply(ApplyResolutions)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)
+    ->UseRealTime();
+
+void BM_ConvertFormat_NV12ToRGBA(benchmark::State &state)
+{
+    RunConvertFormat(state, IEffectFormat::YUVNV12, IEffectFormat::RGBA8888);
+}
+BENCHMARK(BM_ConvertFormat_NV12ToRGBA)->Apply(ApplyResolutions)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)
+    ->UseRealTime();
+
+void BM_ConvertFormat_NV21ToRGBA(benchmark::State &state)
+{
+    RunConvertFormat(state, IEffectFormat::YUVNV21, IEffectFormat::RGBA8888);
+}
+BENCHMARK(BM_ConvertFormat_NV21ToRGBA)->Apply(ApplyResolutions)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)
+    ->UseRealTime();
+
+void BM_CpuColorSpace_AdobeRgbToDisplayP3(benchmark::State &state)
+{
+    RunCpuColorSpace(state, EffectColorSpace::ADOBE_RGB, EffectColorSpace::DISPLAY_P3);
+}
+BENCHMARK(BM_CpuColorSpace_AdobeRgbToDisplayP3)->Apply(ApplyResolutions)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)
+    ->UseRealTime();
+
+void BM_CpuColorSpace_SrgbToDisplayP3(benchmark::State &state)
+{
+    RunCpuColorSpace(state, EffectColorSpace::SRGB, EffectColorSpace::DISPLAY_P3);
+}
+BENCHMARK(BM_CpuColorSpace_SrgbToDisplayP3)->Apply(ApplyResolutions)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)
+    ->UseRealTime();
+
+void BM_CpuHdr_ToneMap(benchmark::State &state)
+{
+    RunCpuHdr(state, CpuHdrOperation::TONE_MAP);
+}
+BENCHMARK(BM_CpuHdr_ToneMap)->Apply(ApplyResolutions)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)->UseRealTime();
+
+void BM_CpuHdr_Decompose(benchmark::State &state)
+{
+    RunCpuHdr(state, CpuHdrOperation::DECOMPOSE);
+}
+BENCHMARK(BM_CpuHdr_Decompose)->Apply(ApplyResolutions)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)->UseRealTime();
+
+void BM_CpuHdr_Compose(benchmark::State &state)
+{
+    RunCpuHdr(state, CpuHdrOperation::COMPOSE);
+}
+BENCHMARK(BM_CpuHdr_Compose)->Apply(ApplyResolutions)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)->UseRealTime();
+
+void BM_MemcpyHelper_CopyData(benchmark::State &state)
+{
+    if (SkipIfTooLarge(state)) {
+        return;
+    }
+    uint32_t padding = static_cast<uint32_t>(state.range(2));
+    HeapEffectBuffer src(GetWidth(state), GetHeight(state), IEffectFormat::RGBA8888);
+    HeapEffectBuffer dst(GetWidth(state), GetHeight(state), IEffectFormat::RGBA8888, padding);
+    for (auto _ : state) {
+        MemcpyHelper::CopyData(src.Get(), dst.Get());
+        benchmark::ClobberMemory();
+    }
+    SetProcessed(state, src.GetLen());
+}
+BENCHMARK(BM_MemcpyHelper_CopyData)->Apply(ApplyResolutionsWithStrides)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)
+    ->UseRealTime();
+
+void BM_CropEFilter(benchmark::State &state)
+{
+    if (SkipIfTooLarge(state)) {
+        return;
+    }
+    uint32_t width = GetWidth(state);
+    uint32_t height = GetHeight(state);
+    HeapEffectBuffer src(width, height, IEffectFormat::RGBA8888);
+    HeapEffectBuffer dst(width / 2, height / 2, IEffectFormat::RGBA8888);
+
+    // Crop the center quarter of the image.
+    int32_t areaInfo[] = { static_cast<int32_t>(width / 4), static_cast<int32_t>(height / 4),
+        static_cast<int32_t>(width / 4 * 3), static_cast<int32_t>(height / 4 * 3) };
+    CropEFilter cropEFilter("Crop");
+    Any region = static_cast<void *>(areaInfo);
+    cropEFilter.SetValue(CropEFilter::Parameter::KEY_REGION, region);
+    std::shared_ptr<EffectContext> context = std::make_shared<EffectContext>();
+    for (auto _ : state) {
+        if (cropEFilter.Render(src.Get(), dst.Get(), context) != ErrorCode::SUCCESS) {
+            state.SkipWithError("crop fail");
+            return;
+        }
+        benchmark::ClobberMemory();
+    }
+    SetProcessed(state, dst.GetLen());
+}
+BENCHMARK(BM_CropEFilter)->Apply(ApplyResolutions)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)->UseRealTime();
+} // namespace Benchmark
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
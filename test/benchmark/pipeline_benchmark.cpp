@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+
+#include "benchmark_common.h"
+#include "effect_memory_manager.h"
+#include "efilter_factory.h"
+#include "image_effect_inner.h"
+#include "pixel_map.h"
+#include "render_executor.h"
+#include "render_task.h"
+#include "render_thread.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Benchmark {
+namespace {
+constexpr size_t QUEUE_SIZE = 64;
+constexpr float FILTER_INTENSITY = 50.f;
+constexpr const char *BRIGHTNESS_EFILTER = "Brightness";
+constexpr const char *KEY_FILTER_INTENSITY = "FilterIntensity";
+
+MemoryInfo CreateMemoryInfo(benchmark::State &state)
+{
+    MemoryInfo memoryInfo;
+    memoryInfo.bufferInfo.width_ = GetWidth(state);
+    memoryInfo.bufferInfo.height_ = GetHeight(state);
+    memoryInfo.bufferInfo.formatType_ = IEffectFormat::RGBA8888;
+    memoryInfo.bufferInfo.rowStride_ = FormatHelper::CalculateRowStride(GetWidth(state), IEffectFormat::RGBA8888);
+    memoryInfo.bufferInfo.len_ = FormatHelper::CalculateSize(GetWidth(state), GetHeight(state),
+        IEffectFormat::RGBA8888);
+    return memoryInfo;
+}
+
+// Render thread shared by all the benchmark threads, which measure the round trip of a task under contention.
+class SharedRenderThread {
+public:
+    SharedRenderThread() : renderThread_(QUEUE_SIZE)
+    {
+        renderThread_.Start();
+    }
+
+    ~SharedRenderThread()
+    {
+        renderThread_.Stop();
+    }
+
+    RenderThread<> &Get()
+    {
+        return renderThread_;
+    }
+
+private:
+    RenderThread<> renderThread_;
+};
+} // namespace
+
+void BM_EffectMemoryManager_Alloc(benchmark::State &state)
+{
+    if (SkipIfTooLarge(state)) {
+        return;
+    }
+    MemoryInfo memoryInfo = CreateMemoryInfo(state);
+    EffectMemoryManager memoryManager;
+    memoryManager.SetIPType(IPType::CPU);
+    for (auto _ : state) {
+        MemoryData *memoryData = memoryManager.AllocMemory(nullptr, memoryInfo);
+        if (memoryData == nullptr) {
+            state.SkipWithError("alloc memory fail");
+            return;
+        }
+        benchmark::DoNotOptimize(memoryData->data);
+        memoryManager.ClearMemory();
+    }
+    SetProcessed(state, memoryInfo.bufferInfo.len_);
+}
+BENCHMARK(BM_EffectMemoryManager_Alloc)->Apply(ApplyResolutions)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)
+    ->UseRealTime();
+
+void BM_EffectMemoryManager_Reuse(benchmark::State &state)
+{
+    if (SkipIfTooLarge(state)) {
+        return;
+    }
+    MemoryInfo memoryInfo = CreateMemoryInfo(state);
+    EffectMemoryManager memoryManager;
+    memoryManager.SetIPType(IPType::CPU);
+    if (memoryManager.AllocMemory(nullptr, memoryInfo) == nullptr) {
+        state.SkipWithError("alloc memory fail");
+        return;
+    }
+    for (auto _ : state) {
+        MemoryData *memoryData = memoryManager.AllocMemory(nullptr, memoryInfo);
+        benchmark::DoNotOptimize(memoryData);
+    }
+    memoryManager.ClearMemory();
+    SetProcessed(state, memoryInfo.bufferInfo.len_);
+}
+BENCHMARK(BM_EffectMemoryManager_Reuse)->Apply(ApplyResolutions)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)
+    ->UseRealTime();
+
+void BM_RenderThread_RoundTrip(benchmark::State &state)
+{
+    static SharedRenderThread sharedRenderThread;
+    uint64_t id = 0;
+    for (auto _ : state) {
+        auto task = std::make_shared<RenderTask<>>([]() {}, 0, id++);
+        sharedRenderThread.Get().AddTask(task);
+        task->Wait();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_RenderThread_RoundTrip)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)->UseRealTime();
+
+void BM_RenderStrand_RoundTrip(benchmark::State &state)
+{
+    // Every benchmark thread owns a strand, as every image effect does.
+    std::shared_ptr<RenderStrand> strand = RenderExecutor::Instance().CreateStrand(QUEUE_SIZE);
+    uint64_t id = 0;
+    for (auto _ : state) {
+        auto task = std::make_shared<RenderTask<>>([]() {}, 0, id++);
+        strand->AddTask(task);
+        task->Wait();
+    }
+    strand->Stop();
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_RenderStrand_RoundTrip)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)->UseRealTime();
+
+void BM_ImageEffect_Start(benchmark::State &state)
+{
+    if (SkipIfTooLarge(state)) {
+        return;
+    }
+    InitializationOptions options;
+    options.size.width = static_cast<int32_t>(GetWidth(state));
+    options.size.height = static_cast<int32_t>(GetHeight(state));
+    options.pixelFormat = PixelFormat::RGBA_8888;
+    options.allocatorType = AllocatorType::HEAP_ALLOC;
+    std::unique_ptr<PixelMap> pixelMap = PixelMap::Create(options);
+    if (pixelMap == nullptr) {
+        state.SkipWithError("create pixelmap fail");
+        return;
+    }
+
+    std::shared_ptr<ImageEffect> imageEffect = std::make_shared<ImageEffect>();
+    std::shared_ptr<EFilter> efilter = EFilterFactory::Instance()->Create(BRIGHTNESS_EFILTER);
+    Any value = FILTER_INTENSITY;
+    efilter->SetValue(KEY_FILTER_INTENSITY, value);
+    imageEffect->AddEFilter(efilter);
+    if (imageEffect->SetInputPixelMap(pixelMap.get()) != ErrorCode::SUCCESS) {
+        state.SkipWithError("set input pixelmap fail");
+        return;
+    }
+    for (auto _ : state) {
+        if (imageEffect->Start() != ErrorCode::SUCCESS) {
+            state.SkipWithError("start fail");
+            return;
+        }
+    }
+    SetProcessed(state, static_cast<uint64_t>(pixelMap->GetByteCount()));
+}
+BENCHMARK(BM_ImageEffect_Start)->Apply(ApplyResolutions)->ThreadRange(1, BENCHMARK_MAX_THREAD_NUM)->UseRealTime();
+} // namespace Benchmark
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+
+BENCHMARK_MAIN();
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "cpu_colorspace_converter.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr uint32_t WIDTH = 4;
+constexpr uint32_t HEIGHT = 3;
+constexpr uint32_t RGBA_BYTES_PER_PIXEL = 4;
+constexpr uint32_t ROW_PADDING = 8;
+constexpr uint32_t ROW_STRIDE = WIDTH * RGBA_BYTES_PER_PIXEL + ROW_PADDING;
+constexpr int32_t TOLERANCE = 1;
+
+std::shared_ptr<EffectBuffer> CreateBuffer(std::vector<uint8_t> &data, IEffectFormat format,
+    EffectColorSpace colorSpace)
+{
+    data.assign(ROW_STRIDE * HEIGHT, 0);
+    std::shared_ptr<BufferInfo> info = std::make_shared<BufferInfo>();
+    info->width_ = WIDTH;
+    info->height_ = HEIGHT;
+    info->rowStride_ = ROW_STRIDE;
+    info->len_ = static_cast<uint32_t>(data.size());
+    info->formatType_ = format;
+    info->colorSpace_ = colorSpace;
+    std::shared_ptr<ExtraInfo> extraInfo = std::make_shared<ExtraInfo>();
+    return std::make_shared<EffectBuffer>(info, data.data(), extraInfo);
+}
+
+void SetPixel(std::vector<uint8_t> &data, uint32_t x, uint32_t y, const std::vector<uint8_t> &rgba)
+{
+    std::memcpy(data.data() + y * ROW_STRIDE + x * RGBA_BYTES_PER_PIXEL, rgba.data(), RGBA_BYTES_PER_PIXEL);
+}
+
+void ExpectPixel(const std::vector<uint8_t> &data, uint32_t x, uint32_t y, const std::vector<uint8_t> &rgba)
+{
+    const uint8_t *pixel = data.data() + y * ROW_STRIDE + x * RGBA_BYTES_PER_PIXEL;
+    for (uint32_t i = 0; i < RGBA_BYTES_PER_PIXEL; ++i) {
+        EXPECT_LE(std::abs(static_cast<int32_t>(pixel[i]) - static_cast<int32_t>(rgba[i])), TOLERANCE)
+            << "x=" << x << ", y=" << y << ", channel=" << i;
+    }
+}
+} // namespace
+
+class TestCpuColorSpaceConverter : public testing::Test {
+public:
+    TestCpuColorSpaceConverter() = default;
+
+    ~TestCpuColorSpaceConverter() override = default;
+    static void SetUpTestCase() {}
+
+    static void TearDownTestCase() {}
+
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+HWTEST_F(TestCpuColorSpaceConverter, IsSupported001, TestSize.Level1)
+{
+    EXPECT_TRUE(CpuColorSpaceConverter::IsSupported(EffectColorSpace::ADOBE_RGB, EffectColorSpace::DISPLAY_P3,
+        IEffectFormat::RGBA8888));
+    EXPECT_TRUE(CpuColorSpaceConverter::IsSupported(EffectColorSpace::SRGB, EffectColorSpace::DISPLAY_P3,
+        IEffectFormat::RGBA_1010102));
+    EXPECT_FALSE(CpuColorSpaceConverter::IsSupported(EffectColorSpace::SRGB, EffectColorSpace::SRGB,
+        IEffectFormat::RGBA8888));
+    EXPECT_FALSE(CpuColorSpaceConverter::IsSupported(EffectColorSpace::SRGB, EffectColorSpace::BT2020_HLG,
+        IEffectFormat::RGBA_1010102));
+    EXPECT_FALSE(CpuColorSpaceConverter::IsSupported(EffectColorSpace::SRGB, EffectColorSpace::DISPLAY_P3,
+        IEffectFormat::YUVNV12));
+}
+
+HWTEST_F(TestCpuColorSpaceConverter, Convert001, TestSize.Level1)
+{
+    std::vector<uint8_t> srcData;
+    std::shared_ptr<EffectBuffer> src = CreateBuffer(srcData, IEffectFormat::RGBA8888, EffectColorSpace::SRGB);
+    SetPixel(srcData, 0, 0, { 255, 0, 0, 128 });
+    SetPixel(srcData, 1, 0, { 255, 255, 255, 255 });
+    SetPixel(srcData, WIDTH - 1, HEIGHT - 1, { 0, 255, 0, 7 });
+    std::vector<uint8_t> dstData;
+    std::shared_ptr<EffectBuffer> dst = CreateBuffer(dstData, IEffectFormat::RGBA8888, EffectColorSpace::DEFAULT);
+
+    // The srgb primaries are inside of the display p3 gamut, alpha and the row padding are left alone.
+    ASSERT_EQ(CpuColorSpaceConverter::Convert(src.get(), dst.get(), EffectColorSpace::DISPLAY_P3),
+        ErrorCode::SUCCESS);
+    EXPECT_EQ(dst->bufferInfo_->colorSpace_, EffectColorSpace::DISPLAY_P3);
+    ExpectPixel(dstData, 0, 0, { 234, 51, 35, 128 });
+    ExpectPixel(dstData, 1, 0, { 255, 255, 255, 255 });
+    ExpectPixel(dstData, 2, 1, { 0, 0, 0, 0 });
+    ExpectPixel(dstData, WIDTH - 1, HEIGHT - 1, { 117, 251, 76, 7 });
+    EXPECT_EQ(dstData[WIDTH * RGBA_BYTES_PER_PIXEL], 0);
+
+    // Back in place to srgb. The 8 bits display p3 values of other saturated colors are not precise enough to get
+    // the channels near black back within one code value.
+    ASSERT_EQ(CpuColorSpaceConverter::Convert(dst.get(), dst.get(), EffectColorSpace::SRGB), ErrorCode::SUCCESS);
+    ExpectPixel(dstData, 0, 0, { 255, 0, 0, 128 });
+    ExpectPixel(dstData, 1, 0, { 255, 255, 255, 255 });
+
+    dst->bufferInfo_->width_ = WIDTH - 1;
+    EXPECT_NE(CpuColorSpaceConverter::Convert(src.get(), dst.get(), EffectColorSpace::DISPLAY_P3),
+        ErrorCode::SUCCESS);
+    src->bufferInfo_->colorSpace_ = EffectColorSpace::BT2020_PQ;
+    EXPECT_NE(CpuColorSpaceConverter::Convert(src.get(), src.get(), EffectColorSpace::DISPLAY_P3),
+        ErrorCode::SUCCESS);
+}
+
+HWTEST_F(TestCpuColorSpaceConverter, Convert002, TestSize.Level1)
+{
+    std::vector<uint8_t> data;
+    std::shared_ptr<EffectBuffer> buffer = CreateBuffer(data, IEffectFormat::RGBA_1010102, EffectColorSpace::SRGB);
+    constexpr uint32_t alpha = 2;
+    uint32_t red = 0x3FF | (alpha << 30);
+    std::memcpy(data.data(), &red, sizeof(red));
+
+    ASSERT_EQ(CpuColorSpaceConverter::Convert(buffer.get(), buffer.get(), EffectColorSpace::DISPLAY_P3),
+        ErrorCode::SUCCESS);
+    uint32_t pixel = 0;
+    std::memcpy(&pixel, data.data(), sizeof(pixel));
+    EXPECT_NEAR(static_cast<int32_t>(pixel & 0x3FF), 939, TOLERANCE);
+    EXPECT_NEAR(static_cast<int32_t>((pixel >> 10) & 0x3FF), 205, TOLERANCE);
+    EXPECT_NEAR(static_cast<int32_t>((pixel >> 20) & 0x3FF), 142, TOLERANCE);
+    EXPECT_EQ(pixel >> 30, alpha);
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
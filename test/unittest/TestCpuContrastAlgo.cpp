@@ -29,6 +29,8 @@ namespace Effect {
 namespace Test {
 constexpr uint32_t BYTES_PER_INT = 4;
 constexpr uint8_t DEFAULT_PIXEL_VALUE = 128;
+// Pixel value changed visibly by the contrast, 128 is nearly a fixed point of it.
+constexpr uint8_t REGION_PIXEL_VALUE = 64;
 constexpr uint32_t MAX_BUFFER_SIZE = 100 * 1024 * 1024;
 
 class TestCpuContrastAlgo : public testing::Test {
@@ -376,6 +378,106 @@ HWTEST_F(TestCpuContrastAlgo, OnApplyRGBA8888013, TestSize.Level1)
     ReleaseEffectBuffer(dst);
 }
 
+HWTEST_F(TestCpuContrastAlgo, OnApplyRGBA8888014, TestSize.Level1)
+{
+    uint32_t width = 100;
+    uint32_t height = 100;
+    uint32_t len = width * height * BYTES_PER_INT;
+    
+    EffectBuffer* src = CreateEffectBuffer(width, height, len, width * BYTES_PER_INT);
+    ASSERT_NE(src, nullptr);
+    EffectBuffer* dst = CreateEffectBuffer(width, height, len, width * BYTES_PER_INT);
+    ASSERT_NE(dst, nullptr);
+    
+    std::map<std::string, Any> value;
+    value["FilterIntensity"] = 50.0f;
+    
+    std::shared_ptr<EffectContext> context = std::make_shared<EffectContext>();
+    context->cancelToken_ = std::make_shared<EffectCancelToken>();
+    context->cancelToken_->Cancel();
+    
+    ErrorCode result = CpuContrastAlgo::OnApplyRGBA8888(src, dst, value, context);
+    ASSERT_EQ(result, ErrorCode::ERR_RENDER_CANCELED);
+    ASSERT_EQ(static_cast<uint8_t *>(dst->buffer_)[0], DEFAULT_PIXEL_VALUE);
+    
+    ReleaseEffectBuffer(src);
+    ReleaseEffectBuffer(dst);
+}
+
+HWTEST_F(TestCpuContrastAlgo, OnApplyRGBA8888Region001, TestSize.Level1)
+{
+    uint32_t width = 100;
+    uint32_t height = 100;
+    uint32_t len = width * height * BYTES_PER_INT;
+
+    EffectBuffer* src = CreateEffectBuffer(width, height, len, width * BYTES_PER_INT);
+    ASSERT_NE(src, nullptr);
+    EffectBuffer* dst = CreateEffectBuffer(width, height, len, width * BYTES_PER_INT);
+    ASSERT_NE(dst, nullptr);
+    src->bufferInfo_->formatType_ = IEffectFormat::RGBA8888;
+    dst->bufferInfo_->formatType_ = IEffectFormat::RGBA8888;
+    ASSERT_EQ(memset_s(src->buffer_, len, REGION_PIXEL_VALUE, len), 0);
+
+    std::map<std::string, Any> value;
+    value["FilterIntensity"] = 50.0f;
+    RenderRegion region = { 10, 20, 50, 60 };
+    value["FilterRegion"] = region;
+    std::shared_ptr<EffectContext> context = std::make_shared<EffectContext>();
+
+    // The pixels outside the region are copied from the source.
+    ErrorCode result = CpuContrastAlgo::OnApplyRGBA8888(src, dst, value, context);
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+    auto *dstPixels = static_cast<uint8_t *>(dst->buffer_);
+    ASSERT_NE(dstPixels[(30 * width + 30) * BYTES_PER_INT], REGION_PIXEL_VALUE);
+    ASSERT_EQ(dstPixels[(30 * width + 30) * BYTES_PER_INT + 3], REGION_PIXEL_VALUE);
+    ASSERT_EQ(dstPixels[(30 * width + 9) * BYTES_PER_INT], REGION_PIXEL_VALUE);
+    ASSERT_EQ(dstPixels[(60 * width + 30) * BYTES_PER_INT], REGION_PIXEL_VALUE);
+
+    // In place, the region of the image effect narrows the region of the filter.
+    context->renderRegion_ = std::make_shared<RenderRegion>(RenderRegion{ 0, 0, 30, 100 });
+    result = CpuContrastAlgo::OnApplyRGBA8888(src, src, value, context);
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+    auto *srcPixels = static_cast<uint8_t *>(src->buffer_);
+    ASSERT_NE(srcPixels[(30 * width + 29) * BYTES_PER_INT], REGION_PIXEL_VALUE);
+    ASSERT_EQ(srcPixels[(30 * width + 30) * BYTES_PER_INT], REGION_PIXEL_VALUE);
+
+    ReleaseEffectBuffer(src);
+    ReleaseEffectBuffer(dst);
+}
+
+HWTEST_F(TestCpuContrastAlgo, OnApplyYUVNV12Region001, TestSize.Level1)
+{
+    uint32_t width = 100;
+    uint32_t height = 100;
+    uint32_t len = width * height * 3 / 2;
+
+    EffectBuffer* src = CreateEffectBuffer(width, height, len, width);
+    ASSERT_NE(src, nullptr);
+    EffectBuffer* dst = CreateEffectBuffer(width, height, len, width);
+    ASSERT_NE(dst, nullptr);
+    src->bufferInfo_->formatType_ = IEffectFormat::YUVNV12;
+    dst->bufferInfo_->formatType_ = IEffectFormat::YUVNV12;
+    ASSERT_EQ(memset_s(src->buffer_, width * height, REGION_PIXEL_VALUE, width * height), 0);
+
+    std::map<std::string, Any> value;
+    value["FilterIntensity"] = 50.0f;
+    RenderRegion region = { 11, 11, 51, 51 };
+    value["FilterRegion"] = region;
+    std::shared_ptr<EffectContext> context = std::make_shared<EffectContext>();
+
+    // The region is widened to the 2x2 blocks sharing a chroma sample.
+    ErrorCode result = CpuContrastAlgo::OnApplyYUVNV12(src, dst, value, context);
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+    auto *dstY = static_cast<uint8_t *>(dst->buffer_);
+    ASSERT_NE(dstY[10 * width + 10], REGION_PIXEL_VALUE);
+    ASSERT_NE(dstY[51 * width + 51], REGION_PIXEL_VALUE);
+    ASSERT_EQ(dstY[9 * width + 9], REGION_PIXEL_VALUE);
+    ASSERT_EQ(dstY[52 * width + 52], REGION_PIXEL_VALUE);
+
+    ReleaseEffectBuffer(src);
+    ReleaseEffectBuffer(dst);
+}
+
 }
 }
 }
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "cpu_hdr_processor.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr uint32_t WIDTH = 16;
+constexpr uint32_t HEIGHT = 11;
+constexpr uint32_t RGBA_BYTES_PER_PIXEL = 4;
+constexpr uint32_t ROW_PADDING = 8;
+constexpr uint32_t CODE_10_MAX = 1023;
+constexpr uint32_t GREEN_SHIFT = 10;
+constexpr uint32_t BLUE_SHIFT = 20;
+constexpr uint32_t ALPHA_SHIFT = 30;
+constexpr uint32_t ALPHA_MAX = 3;
+// HLG signal of the sdr reference white.
+constexpr uint32_t HLG_WHITE = 767;
+constexpr uint32_t HDR_BASE_LEVEL = 500;
+constexpr uint32_t HDR_LEVEL_STEP = 20;
+constexpr uint32_t HDR_TINT_STEP = 6;
+constexpr int32_t ROUND_TRIP_TOLERANCE = 6;
+// The last column and the odd last row lie past the center of the last gain map block, where the gain is held
+// instead of interpolated.
+constexpr int32_t EDGE_ROUND_TRIP_TOLERANCE = 12;
+
+std::shared_ptr<EffectBuffer> CreateBuffer(std::vector<uint8_t> &data, uint32_t width, uint32_t height,
+    IEffectFormat format, EffectColorSpace colorSpace)
+{
+    uint32_t rowStride = width * RGBA_BYTES_PER_PIXEL + ROW_PADDING;
+    data.assign(rowStride * height, 0);
+    std::shared_ptr<BufferInfo> info = std::make_shared<BufferInfo>();
+    info->width_ = width;
+    info->height_ = height;
+    info->rowStride_ = rowStride;
+    info->len_ = static_cast<uint32_t>(data.size());
+    info->formatType_ = format;
+    info->colorSpace_ = colorSpace;
+    std::shared_ptr<ExtraInfo> extraInfo = std::make_shared<ExtraInfo>();
+    return std::make_shared<EffectBuffer>(info, data.data(), extraInfo);
+}
+
+uint32_t *GetPixel(std::vector<uint8_t> &data, uint32_t x, uint32_t y)
+{
+    uint32_t rowStride = WIDTH * RGBA_BYTES_PER_PIXEL + ROW_PADDING;
+    return reinterpret_cast<uint32_t *>(data.data() + y * rowStride + x * RGBA_BYTES_PER_PIXEL);
+}
+
+uint32_t MakeHdrPixel(uint32_t red, uint32_t green, uint32_t blue)
+{
+    return red | (green << GREEN_SHIFT) | (blue << BLUE_SHIFT) | (ALPHA_MAX << ALPHA_SHIFT);
+}
+
+// A smooth image from below to well above the sdr white, with a tint that changes across the rows.
+void FillHdrImage(std::vector<uint8_t> &data)
+{
+    for (uint32_t y = 0; y < HEIGHT; ++y) {
+        for (uint32_t x = 0; x < WIDTH; ++x) {
+            uint32_t level = HDR_BASE_LEVEL + x * HDR_LEVEL_STEP;
+            uint32_t tint = y * HDR_TINT_STEP;
+            *GetPixel(data, x, y) = MakeHdrPixel(level, level - tint, level - tint / 2);
+        }
+    }
+}
+} // namespace
+
+class TestCpuHdrProcessor : public testing::Test {
+public:
+    TestCpuHdrProcessor() = default;
+
+    ~TestCpuHdrProcessor() override = default;
+    static void SetUpTestCase() {}
+
+    static void TearDownTestCase() {}
+
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+HWTEST_F(TestCpuHdrProcessor, ToneMap001, TestSize.Level1)
+{
+    std::vector<uint8_t> hdrData;
+    std::shared_ptr<EffectBuffer> hdr = CreateBuffer(hdrData, WIDTH, HEIGHT, IEffectFormat::RGBA_1010102,
+        EffectColorSpace::BT2020_HLG);
+    *GetPixel(hdrData, 0, 0) = MakeHdrPixel(CODE_10_MAX, CODE_10_MAX, CODE_10_MAX);
+    *GetPixel(hdrData, 1, 0) = MakeHdrPixel(HLG_WHITE, HLG_WHITE, HLG_WHITE);
+    *GetPixel(hdrData, 2, 0) = MakeHdrPixel(HLG_WHITE / 2, HLG_WHITE / 2, HLG_WHITE / 2);
+    std::vector<uint8_t> sdrData;
+    std::shared_ptr<EffectBuffer> sdr = CreateBuffer(sdrData, WIDTH, HEIGHT, IEffectFormat::RGBA8888,
+        EffectColorSpace::DISPLAY_P3);
+
+    ASSERT_EQ(CpuHdrProcessor::ToneMap(hdr.get(), sdr.get()), ErrorCode::SUCCESS);
+    const uint8_t *peak = reinterpret_cast<const uint8_t *>(GetPixel(sdrData, 0, 0));
+    const uint8_t *white = reinterpret_cast<const uint8_t *>(GetPixel(sdrData, 1, 0));
+    const uint8_t *gray = reinterpret_cast<const uint8_t *>(GetPixel(sdrData, 2, 0));
+    // The peak rolls off to the sdr white, neutral colors stay neutral.
+    EXPECT_EQ(peak[0], 255);
+    EXPECT_EQ(peak[3], 255);
+    EXPECT_GT(white[0], gray[0]);
+    EXPECT_LT(white[0], peak[0]);
+    EXPECT_NEAR(white[0], white[1], 1);
+    EXPECT_NEAR(white[0], white[2], 1);
+    EXPECT_EQ(*GetPixel(sdrData, 3, 0), 0u);
+
+    std::vector<uint8_t> otherData;
+    std::shared_ptr<EffectBuffer> other = CreateBuffer(otherData, WIDTH, HEIGHT, IEffectFormat::RGBA_1010102,
+        EffectColorSpace::DISPLAY_P3);
+    EXPECT_NE(CpuHdrProcessor::ToneMap(other.get(), sdr.get()), ErrorCode::SUCCESS);
+    EXPECT_FALSE(CpuHdrProcessor::IsHdrSupported(*other->bufferInfo_));
+    EXPECT_TRUE(CpuHdrProcessor::IsHdrSupported(*hdr->bufferInfo_));
+}
+
+HWTEST_F(TestCpuHdrProcessor, DecomposeCompose001, TestSize.Level1)
+{
+    std::vector<uint8_t> hdrData;
+    std::shared_ptr<EffectBuffer> hdr = CreateBuffer(hdrData, WIDTH, HEIGHT, IEffectFormat::RGBA_1010102,
+        EffectColorSpace::BT2020_PQ);
+    FillHdrImage(hdrData);
+    std::vector<uint8_t> sdrData;
+    std::shared_ptr<EffectBuffer> sdr = CreateBuffer(sdrData, WIDTH, HEIGHT, IEffectFormat::RGBA8888,
+        EffectColorSpace::DISPLAY_P3);
+    std::vector<uint8_t> gainmapData;
+    std::shared_ptr<EffectBuffer> gainmap = CreateBuffer(gainmapData, WIDTH / 2, HEIGHT / 2, IEffectFormat::RGBA8888,
+        EffectColorSpace::DISPLAY_P3);
+
+    CpuGainmapMetadata metadata;
+    ASSERT_EQ(CpuHdrProcessor::Decompose(hdr.get(), sdr.get(), gainmap.get(), metadata), ErrorCode::SUCCESS);
+    EXPECT_LE(metadata.minLog2[0], 0.f);
+    EXPECT_GT(metadata.maxLog2[0], 0.f);
+    EXPECT_GT(metadata.alternateHeadroom, 0.f);
+
+    std::vector<uint8_t> composedData;
+    std::shared_ptr<EffectBuffer> composed = CreateBuffer(composedData, WIDTH, HEIGHT, IEffectFormat::RGBA_1010102,
+        EffectColorSpace::BT2020_PQ);
+    ASSERT_EQ(CpuHdrProcessor::Compose(sdr.get(), gainmap.get(), metadata, composed.get()), ErrorCode::SUCCESS);
+    for (uint32_t y = 0; y < HEIGHT; ++y) {
+        for (uint32_t x = 0; x < WIDTH; ++x) {
+            int32_t tolerance = (x == WIDTH - 1 || y == HEIGHT - 1) ? EDGE_ROUND_TRIP_TOLERANCE : ROUND_TRIP_TOLERANCE;
+            uint32_t expected = *GetPixel(hdrData, x, y);
+            uint32_t actual = *GetPixel(composedData, x, y);
+            for (uint32_t shift : { 0u, GREEN_SHIFT, BLUE_SHIFT }) {
+                int32_t diff = static_cast<int32_t>((expected >> shift) & CODE_10_MAX) -
+                    static_cast<int32_t>((actual >> shift) & CODE_10_MAX);
+                EXPECT_LE(std::abs(diff), tolerance) << "x=" << x << ", y=" << y << ", shift=" << shift;
+            }
+            EXPECT_EQ(actual >> ALPHA_SHIFT, ALPHA_MAX);
+        }
+    }
+
+    gainmap->bufferInfo_->width_ = WIDTH;
+    EXPECT_NE(CpuHdrProcessor::Decompose(hdr.get(), sdr.get(), gainmap.get(), metadata), ErrorCode::SUCCESS);
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,261 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstring>
+#include <future>
+#include <thread>
+
+#include "efilter_factory.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr uint32_t READER_NUM = 4;
+constexpr uint32_t REGISTER_NUM = 100;
+constexpr char FIRST_EFILTER[] = "FactoryTestA";
+constexpr char SECOND_EFILTER[] = "FactoryTestB";
+
+std::shared_ptr<EFilter> CreateNothing(const std::string &name)
+{
+    return nullptr;
+}
+
+std::shared_ptr<EffectInfo> CreateEffectInfo(const std::string &name)
+{
+    return std::make_shared<EffectInfo>();
+}
+
+class NothingDelegate : public IFilterDelegate {
+public:
+    bool Render(void *efilter, EffectBuffer *src, EffectBuffer *dst, std::shared_ptr<EffectContext> &context) override
+    {
+        return true;
+    }
+
+    bool Render(void *efilter, EffectBuffer *src, std::shared_ptr<EffectContext> &context) override
+    {
+        return true;
+    }
+
+    bool SetValue(void *efilter, const std::string &key, const Any &value) override
+    {
+        return true;
+    }
+
+    bool Save(void *efilter, EffectJsonPtr &res) override
+    {
+        return true;
+    }
+
+    void *Restore(const EffectJsonPtr &values) override
+    {
+        return nullptr;
+    }
+
+    void *GetEffectInfo() override
+    {
+        return nullptr;
+    }
+};
+} // namespace
+
+class TestEFilterFactory : public testing::Test {
+public:
+    TestEFilterFactory() = default;
+
+    ~TestEFilterFactory() override = default;
+    static void SetUpTestCase() {}
+
+    static void TearDownTestCase() {}
+
+    void SetUp() override
+    {
+        EFilterFactory::Instance()->ClearFunctions();
+    }
+
+    void TearDown() override
+    {
+        EFilterFactory::Instance()->ClearFunctions();
+        EFilterFactory::Instance()->ClearDelegates();
+    }
+};
+
+HWTEST_F(TestEFilterFactory, Registry001, TestSize.Level1)
+{
+    EFilterFactory *factory = EFilterFactory::Instance();
+    EFilterFunction function;
+    function.generator_ = CreateNothing;
+    function.infoGetter_ = CreateEffectInfo;
+    factory->RegisterFunction(SECOND_EFILTER, function);
+    factory->RegisterFunction(FIRST_EFILTER, function);
+    uint32_t registerCount = factory->GetRegisterStats().count_;
+
+    // Lookups read the published snapshot while the registrations replace it.
+    std::atomic<bool> isStopped = false;
+    std::atomic<uint32_t> failureCount = 0;
+    std::vector<std::thread> readers;
+    for (uint32_t i = 0; i < READER_NUM; ++i) {
+        readers.emplace_back([&factory, &isStopped, &failureCount]() {
+            while (!isStopped) {
+                std::vector<const char *> names;
+                factory->GetAllEffectNames(names);
+                if (factory->GetEffectInfo(SECOND_EFILTER) == nullptr || names.size() < 2 ||
+                    strcmp(names[0], FIRST_EFILTER) != 0) {
+                    failureCount++;
+                }
+            }
+        });
+    }
+    for (uint32_t i = 0; i < REGISTER_NUM; ++i) {
+        factory->RegisterFunction(std::string(SECOND_EFILTER) + std::to_string(i), function);
+    }
+    isStopped = true;
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(failureCount, 0);
+
+    std::vector<const char *> names;
+    factory->GetAllEffectNames(names);
+    ASSERT_EQ(names.size(), REGISTER_NUM + 2);
+    EXPECT_STREQ(names[0], FIRST_EFILTER);
+    EXPECT_STREQ(names[1], SECOND_EFILTER);
+    EXPECT_EQ(factory->GetRegisterStats().count_, registerCount + REGISTER_NUM);
+    EXPECT_EQ(factory->Create(FIRST_EFILTER), nullptr);
+    EXPECT_EQ(factory->GetDelegate(FIRST_EFILTER), nullptr);
+
+    factory->ClearFunctions();
+    names.clear();
+    factory->GetAllEffectNames(names);
+    EXPECT_TRUE(names.empty());
+    EXPECT_EQ(factory->GetEffectInfo(FIRST_EFILTER), nullptr);
+}
+
+HWTEST_F(TestEFilterFactory, Registry002, TestSize.Level1)
+{
+    EFilterFactory *factory = EFilterFactory::Instance();
+    std::shared_ptr<IFilterDelegate> delegate = std::make_shared<NothingDelegate>();
+
+    // A custom filter is never seen without its delegate, the registration publishes them together.
+    std::atomic<bool> isStopped = false;
+    std::atomic<uint32_t> failureCount = 0;
+    std::vector<std::thread> readers;
+    for (uint32_t i = 0; i < READER_NUM; ++i) {
+        readers.emplace_back([&factory, &isStopped, &failureCount]() {
+            while (!isStopped) {
+                for (uint32_t j = 0; j < REGISTER_NUM; ++j) {
+                    std::string name = std::string(FIRST_EFILTER) + std::to_string(j);
+                    if (factory->Create(name) != nullptr && factory->GetDelegate(name) == nullptr) {
+                        failureCount++;
+                    }
+                }
+            }
+        });
+    }
+    for (uint32_t i = 0; i < REGISTER_NUM; ++i) {
+        std::shared_ptr<EffectInfo> effectInfo = std::make_shared<EffectInfo>();
+        factory->RegisterDelegate(std::string(FIRST_EFILTER) + std::to_string(i), delegate, effectInfo);
+    }
+    isStopped = true;
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(failureCount, 0);
+
+    std::string name = std::string(FIRST_EFILTER) + std::to_string(0);
+    EXPECT_EQ(factory->GetDelegate(name), delegate);
+    EXPECT_NE(factory->GetEffectInfo(name), nullptr);
+}
+
+HWTEST_F(TestEFilterFactory, Registry003, TestSize.Level1)
+{
+    EFilterFactory *factory = EFilterFactory::Instance();
+    std::shared_ptr<IFilterDelegate> delegate = std::make_shared<NothingDelegate>();
+    std::weak_ptr<IFilterDelegate> weakDelegate = delegate;
+    std::shared_ptr<EffectInfo> effectInfo = std::make_shared<EffectInfo>();
+    std::weak_ptr<EffectInfo> weakInfo = effectInfo;
+    factory->RegisterDelegate(FIRST_EFILTER, delegate, effectInfo);
+    delegate = nullptr;
+    effectInfo = nullptr;
+    EXPECT_FALSE(weakDelegate.expired());
+
+    // The replaced snapshots are freed, and the delegate and its info with them.
+    std::shared_ptr<IFilterDelegate> otherDelegate = std::make_shared<NothingDelegate>();
+    std::shared_ptr<EffectInfo> otherInfo = std::make_shared<EffectInfo>();
+    factory->RegisterDelegate(FIRST_EFILTER, otherDelegate, otherInfo);
+    EXPECT_TRUE(weakDelegate.expired());
+    EXPECT_TRUE(weakInfo.expired());
+    EXPECT_EQ(factory->GetDelegate(FIRST_EFILTER), otherDelegate);
+
+    // The names handed out stay valid once their snapshot is replaced.
+    std::vector<const char *> names;
+    factory->GetAllEffectNames(names);
+    factory->ClearFunctions();
+    factory->ClearDelegates();
+    EXPECT_EQ(factory->GetDelegate(FIRST_EFILTER), nullptr);
+    ASSERT_EQ(names.size(), 1);
+    EXPECT_STREQ(names[0], FIRST_EFILTER);
+}
+
+HWTEST_F(TestEFilterFactory, Registry004, TestSize.Level1)
+{
+    EFilterFactory *factory = EFilterFactory::Instance();
+    std::shared_ptr<IFilterDelegate> delegate = std::make_shared<NothingDelegate>();
+    std::weak_ptr<IFilterDelegate> weakDelegate = delegate;
+    std::shared_ptr<EffectInfo> effectInfo = std::make_shared<EffectInfo>();
+    factory->RegisterDelegate(FIRST_EFILTER, delegate, effectInfo);
+
+    // A looked up name is found through its precomputed hash as well.
+    std::string name = FIRST_EFILTER;
+    EFilterKey key(name);
+    EXPECT_EQ(key.hash_, std::hash<std::string>()(name));
+    EXPECT_EQ(factory->GetEffectInfo(key), effectInfo);
+
+    // Another thread keeps the snapshot it read until its next lookup, which moves on to the newer one.
+    std::shared_ptr<IFilterDelegate> otherDelegate = std::make_shared<NothingDelegate>();
+    std::promise<void> readPromise;
+    std::promise<void> registerPromise;
+    std::future<void> registerFuture = registerPromise.get_future();
+    std::shared_ptr<IFilterDelegate> firstRead;
+    std::shared_ptr<IFilterDelegate> secondRead;
+    std::thread reader([&factory, &readPromise, &registerFuture, &firstRead, &secondRead]() {
+        firstRead = factory->GetDelegate(FIRST_EFILTER);
+        readPromise.set_value();
+        registerFuture.wait();
+        secondRead = factory->GetDelegate(FIRST_EFILTER);
+    });
+    readPromise.get_future().wait();
+    std::shared_ptr<EffectInfo> otherInfo = std::make_shared<EffectInfo>();
+    factory->RegisterDelegate(FIRST_EFILTER, otherDelegate, otherInfo);
+    registerPromise.set_value();
+    reader.join();
+    EXPECT_EQ(firstRead, delegate);
+    EXPECT_EQ(secondRead, otherDelegate);
+
+    delegate = nullptr;
+    firstRead = nullptr;
+    EXPECT_TRUE(weakDelegate.expired());
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
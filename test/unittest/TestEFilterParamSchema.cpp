@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+
+#include "brightness_efilter.h"
+#include "efilter_factory.h"
+#include "efilter_param_schema.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr float INTENSITY = 42.5f;
+constexpr int32_t OFFSET = -7;
+constexpr int32_t REGION_SIZE = 16;
+const std::string KEY_FILTER_INTENSITY = "FilterIntensity";
+const std::string KEY_FILTER_REGION = "FilterRegion";
+
+struct TestParamBlock {
+    float intensity_ = 0.f;
+    int32_t offset_ = 0;
+    RenderRegion region_;
+};
+} // namespace
+
+class TestEFilterParamSchema : public testing::Test {
+public:
+    TestEFilterParamSchema() = default;
+
+    ~TestEFilterParamSchema() override = default;
+    static void SetUpTestCase() {}
+
+    static void TearDownTestCase() {}
+
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+HWTEST_F(TestEFilterParamSchema, Write001, TestSize.Level1)
+{
+    EFilterParamSchema schema;
+    ASSERT_EQ(schema.Add(KEY_FILTER_INTENSITY, EFilterParamType::FLOAT, offsetof(TestParamBlock, intensity_)),
+        ErrorCode::SUCCESS);
+    ASSERT_EQ(schema.Add("Offset", EFilterParamType::INT32, offsetof(TestParamBlock, offset_)), ErrorCode::SUCCESS);
+    ASSERT_EQ(schema.Add(KEY_FILTER_REGION, EFilterParamType::REGION, offsetof(TestParamBlock, region_)),
+        ErrorCode::SUCCESS);
+    EXPECT_NE(schema.Add("Offset", EFilterParamType::INT32, 0), ErrorCode::SUCCESS);
+    EXPECT_NE(schema.Add("", EFilterParamType::INT32, 0), ErrorCode::SUCCESS);
+    ASSERT_EQ(schema.GetParams().size(), 3);
+    EXPECT_EQ(schema.Find("Count"), nullptr);
+
+    TestParamBlock block;
+    const EFilterParamDesc *intensity = schema.Find(KEY_FILTER_INTENSITY);
+    ASSERT_NE(intensity, nullptr);
+    EXPECT_EQ(intensity->index_, 0);
+    EXPECT_EQ(EFilterParamSchema::Write(*intensity, Any(INTENSITY), &block), ErrorCode::SUCCESS);
+    EXPECT_FLOAT_EQ(block.intensity_, INTENSITY);
+
+    const EFilterParamDesc *offset = schema.Find("Offset");
+    ASSERT_NE(offset, nullptr);
+    EXPECT_EQ(EFilterParamSchema::Write(*offset, Any(OFFSET), &block), ErrorCode::SUCCESS);
+    EXPECT_EQ(block.offset_, OFFSET);
+    // The type has to match exactly, the field is left as it is otherwise.
+    EXPECT_NE(EFilterParamSchema::Write(*offset, Any(INTENSITY), &block), ErrorCode::SUCCESS);
+    EXPECT_EQ(block.offset_, OFFSET);
+
+    RenderRegion region = { 0, 0, REGION_SIZE, REGION_SIZE };
+    const EFilterParamDesc *regionDesc = schema.Find(KEY_FILTER_REGION);
+    ASSERT_NE(regionDesc, nullptr);
+    EXPECT_EQ(EFilterParamSchema::Write(*regionDesc, Any(region), &block), ErrorCode::SUCCESS);
+    EXPECT_EQ(block.region_.x1, REGION_SIZE);
+    EXPECT_EQ(block.region_.y1, REGION_SIZE);
+}
+
+HWTEST_F(TestEFilterParamSchema, DirtyParams001, TestSize.Level1)
+{
+    std::shared_ptr<EFilter> efilter = EFilterFactory::Instance()->Create("Brightness");
+    ASSERT_NE(efilter, nullptr);
+    EXPECT_EQ(efilter->TakeDirtyParams(), 0);
+    EXPECT_FALSE(efilter->IsParamSet(PointwiseParamBlock::INTENSITY));
+
+    Any intensity = INTENSITY;
+    ASSERT_EQ(efilter->SetValue(KEY_FILTER_INTENSITY, intensity), ErrorCode::SUCCESS);
+    const PointwiseParamBlock &block = std::static_pointer_cast<BrightnessEFilter>(efilter)->paramBlock_;
+    EXPECT_FLOAT_EQ(block.intensity_, INTENSITY);
+    EXPECT_TRUE(efilter->IsParamSet(PointwiseParamBlock::INTENSITY));
+    EXPECT_FALSE(efilter->IsParamSet(PointwiseParamBlock::REGION));
+    EXPECT_EQ(efilter->TakeDirtyParams(), EFilterParamSchema::ToMask(PointwiseParamBlock::INTENSITY));
+    EXPECT_EQ(efilter->TakeDirtyParams(), 0);
+
+    // The values stay readable by key.
+    Any value;
+    ASSERT_EQ(efilter->GetValue(KEY_FILTER_INTENSITY, value), ErrorCode::SUCCESS);
+    ASSERT_NE(AnyCast<float>(&value), nullptr);
+    EXPECT_FLOAT_EQ(*AnyCast<float>(&value), INTENSITY);
+
+    // The region of the developer is copied, the block does not point to it.
+    RenderRegion region = { 0, 0, REGION_SIZE, REGION_SIZE };
+    Any regionAny = static_cast<void *>(&region);
+    ASSERT_EQ(efilter->SetValue(KEY_FILTER_REGION, regionAny), ErrorCode::SUCCESS);
+    region.x1 = 0;
+    EXPECT_EQ(block.region_.x1, REGION_SIZE);
+    EXPECT_TRUE(efilter->IsParamSet(PointwiseParamBlock::REGION));
+    EXPECT_EQ(efilter->TakeDirtyParams(), EFilterParamSchema::ToMask(PointwiseParamBlock::REGION));
+
+    // A rejected value changes neither the block nor the dirty bits.
+    Any invalid = OFFSET;
+    EXPECT_NE(efilter->SetValue(KEY_FILTER_INTENSITY, invalid), ErrorCode::SUCCESS);
+    EXPECT_FLOAT_EQ(block.intensity_, INTENSITY);
+    EXPECT_EQ(efilter->TakeDirtyParams(), 0);
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include "effect_binary_helper.h"
+#include "effect_type.h"
+#include "securec.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr float BRIGHTNESS = 42.5f;
+constexpr int32_t OFFSET = -7;
+constexpr uint32_t COUNT = 3;
+constexpr size_t SIZE_OFFSET = 8;
+constexpr int32_t REGION_X0 = -4;
+constexpr int32_t REGION_Y0 = 8;
+constexpr int32_t REGION_X1 = 640;
+constexpr int32_t REGION_Y1 = 480;
+
+EffectChainPrototype CreateChain()
+{
+    EffectChainPrototype chain;
+    chain.name_ = "imageEdit";
+    EffectFilterPrototype brightness;
+    brightness.name_ = "Brightness";
+    brightness.values_.emplace_back("FilterIntensity", Any(BRIGHTNESS));
+    brightness.values_.emplace_back("Offset", Any(OFFSET));
+    brightness.values_.emplace_back("Count", Any(COUNT));
+    chain.filters_.emplace_back(brightness);
+    EffectFilterPrototype crop;
+    crop.name_ = "Crop";
+    chain.filters_.emplace_back(crop);
+    chain.filters_.emplace_back(brightness);
+    return chain;
+}
+} // namespace
+
+class TestEffectBinaryHelper : public testing::Test {
+public:
+    TestEffectBinaryHelper() = default;
+
+    ~TestEffectBinaryHelper() override = default;
+    static void SetUpTestCase() {}
+
+    static void TearDownTestCase() {}
+
+    void SetUp() override
+    {
+        EffectBinaryHelper::ClearCache();
+    }
+
+    void TearDown() override
+    {
+        EffectBinaryHelper::ClearCache();
+    }
+};
+
+HWTEST_F(TestEffectBinaryHelper, EncodeDecode001, TestSize.Level1)
+{
+    EffectChainPrototype chain = CreateChain();
+    // Values of other types are left out, like in the json form.
+    chain.filters_[0].values_.emplace_back("Name", Any(std::string("skipped")));
+    std::vector<uint8_t> data;
+    ASSERT_EQ(EffectBinaryHelper::Encode(chain, data), ErrorCode::SUCCESS);
+
+    std::shared_ptr<const EffectChainPrototype> decoded = nullptr;
+    ASSERT_EQ(EffectBinaryHelper::Decode(data.data(), data.size(), decoded), ErrorCode::SUCCESS);
+    ASSERT_NE(decoded, nullptr);
+    EXPECT_EQ(decoded->name_, "imageEdit");
+    ASSERT_EQ(decoded->filters_.size(), 3);
+    EXPECT_EQ(decoded->filters_[1].name_, "Crop");
+    EXPECT_TRUE(decoded->filters_[1].values_.empty());
+    const EffectFilterPrototype &brightness = decoded->filters_[2];
+    EXPECT_EQ(brightness.name_, "Brightness");
+    ASSERT_EQ(brightness.values_.size(), 3);
+    EXPECT_EQ(brightness.values_[0].first, "FilterIntensity");
+    ASSERT_NE(AnyCast<float>(&brightness.values_[0].second), nullptr);
+    EXPECT_FLOAT_EQ(*AnyCast<float>(&brightness.values_[0].second), BRIGHTNESS);
+    ASSERT_NE(AnyCast<int32_t>(&brightness.values_[1].second), nullptr);
+    EXPECT_EQ(*AnyCast<int32_t>(&brightness.values_[1].second), OFFSET);
+    ASSERT_NE(AnyCast<uint32_t>(&brightness.values_[2].second), nullptr);
+    EXPECT_EQ(*AnyCast<uint32_t>(&brightness.values_[2].second), COUNT);
+}
+
+HWTEST_F(TestEffectBinaryHelper, EncodeDecode002, TestSize.Level1)
+{
+    EffectChainPrototype chain = CreateChain();
+    RenderRegion region = { REGION_X0, REGION_Y0, REGION_X1, REGION_Y1 };
+    chain.filters_[0].values_.emplace_back("FilterRegion", Any(region));
+    std::vector<uint8_t> data;
+    ASSERT_EQ(EffectBinaryHelper::Encode(chain, data), ErrorCode::SUCCESS);
+
+    std::shared_ptr<const EffectChainPrototype> decoded = nullptr;
+    ASSERT_EQ(EffectBinaryHelper::Decode(data.data(), data.size(), decoded), ErrorCode::SUCCESS);
+    ASSERT_NE(decoded, nullptr);
+    const EffectFilterPrototype &brightness = decoded->filters_[0];
+    ASSERT_EQ(brightness.values_.size(), 4);
+    EXPECT_EQ(brightness.values_[3].first, "FilterRegion");
+    auto decodedRegion = AnyCast<RenderRegion>(&brightness.values_[3].second);
+    ASSERT_NE(decodedRegion, nullptr);
+    EXPECT_EQ(decodedRegion->x0, REGION_X0);
+    EXPECT_EQ(decodedRegion->y0, REGION_Y0);
+    EXPECT_EQ(decodedRegion->x1, REGION_X1);
+    EXPECT_EQ(decodedRegion->y1, REGION_Y1);
+    // The values after the region are still read in place.
+    EXPECT_EQ(decoded->filters_[2].values_.size(), 3);
+
+    // A region cut short is rejected, even when the size in the header is patched along.
+    EffectChainPrototype regionChain;
+    regionChain.name_ = "imageEdit";
+    EffectFilterPrototype regionFilter;
+    regionFilter.name_ = "Brightness";
+    regionFilter.values_.emplace_back("FilterRegion", Any(region));
+    regionChain.filters_.emplace_back(regionFilter);
+    ASSERT_EQ(EffectBinaryHelper::Encode(regionChain, data), ErrorCode::SUCCESS);
+    data.resize(data.size() - sizeof(uint32_t));
+    uint32_t size = static_cast<uint32_t>(data.size());
+    ASSERT_EQ(memcpy_s(data.data() + SIZE_OFFSET, sizeof(size), &size, sizeof(size)), 0);
+    EXPECT_EQ(EffectBinaryHelper::Decode(data.data(), data.size(), decoded), ErrorCode::ERR_INVALID_BINARY_DATA);
+}
+
+HWTEST_F(TestEffectBinaryHelper, Decode001, TestSize.Level1)
+{
+    std::vector<uint8_t> data;
+    ASSERT_EQ(EffectBinaryHelper::Encode(CreateChain(), data), ErrorCode::SUCCESS);
+    std::shared_ptr<const EffectChainPrototype> decoded = nullptr;
+
+    EXPECT_EQ(EffectBinaryHelper::Decode(nullptr, data.size(), decoded), ErrorCode::ERR_INVALID_BINARY_DATA);
+    EXPECT_EQ(EffectBinaryHelper::Decode(data.data(), data.size() - 1, decoded), ErrorCode::ERR_INVALID_BINARY_DATA);
+
+    std::vector<uint8_t> trailing = data;
+    trailing.push_back(0);
+    EXPECT_EQ(EffectBinaryHelper::Decode(trailing.data(), trailing.size(), decoded),
+        ErrorCode::ERR_INVALID_BINARY_DATA);
+
+    std::vector<uint8_t> badMagic = data;
+    badMagic[0] ^= 1;
+    EXPECT_EQ(EffectBinaryHelper::Decode(badMagic.data(), badMagic.size(), decoded),
+        ErrorCode::ERR_INVALID_BINARY_DATA);
+
+    std::vector<uint8_t> newerVersion = data;
+    newerVersion[sizeof(uint32_t)] = EffectBinaryHelper::BINARY_VERSION + 1;
+    EXPECT_EQ(EffectBinaryHelper::Decode(newerVersion.data(), newerVersion.size(), decoded),
+        ErrorCode::ERR_INVALID_BINARY_DATA);
+
+    std::vector<uint8_t> badType = data;
+    badType[badType.size() - sizeof(uint32_t) - 1] = 0;
+    EXPECT_EQ(EffectBinaryHelper::Decode(badType.data(), badType.size(), decoded),
+        ErrorCode::ERR_INVALID_BINARY_DATA);
+    EXPECT_EQ(EffectBinaryHelper::GetCacheSize(), 0);
+}
+
+HWTEST_F(TestEffectBinaryHelper, Cache001, TestSize.Level1)
+{
+    std::vector<uint8_t> data;
+    ASSERT_EQ(EffectBinaryHelper::Encode(CreateChain(), data), ErrorCode::SUCCESS);
+    std::shared_ptr<const EffectChainPrototype> first = nullptr;
+    std::shared_ptr<const EffectChainPrototype> second = nullptr;
+    ASSERT_EQ(EffectBinaryHelper::Decode(data.data(), data.size(), first), ErrorCode::SUCCESS);
+    ASSERT_EQ(EffectBinaryHelper::Decode(data.data(), data.size(), second), ErrorCode::SUCCESS);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(EffectBinaryHelper::GetCacheSize(), 1);
+
+    // The cache is bounded, the least recently used chains go first.
+    EffectChainPrototype chain = CreateChain();
+    for (size_t i = 0; i < EffectBinaryHelper::CHAIN_CACHE_CAPACITY; ++i) {
+        chain.name_ = "imageEdit" + std::to_string(i);
+        std::vector<uint8_t> other;
+        ASSERT_EQ(EffectBinaryHelper::Encode(chain, other), ErrorCode::SUCCESS);
+        std::shared_ptr<const EffectChainPrototype> decoded = nullptr;
+        ASSERT_EQ(EffectBinaryHelper::Decode(other.data(), other.size(), decoded), ErrorCode::SUCCESS);
+        EXPECT_EQ(decoded->name_, chain.name_);
+    }
+    EXPECT_EQ(EffectBinaryHelper::GetCacheSize(), EffectBinaryHelper::CHAIN_CACHE_CAPACITY);
+    ASSERT_EQ(EffectBinaryHelper::Decode(data.data(), data.size(), second), ErrorCode::SUCCESS);
+    EXPECT_NE(first, second);
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
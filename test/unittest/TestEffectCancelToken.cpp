@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <thread>
+
+#include "effect_cancel_token.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+// Far enough that a slow or loaded device never reaches it during the test.
+constexpr uint32_t LONG_TIMEOUT_MS = 60 * 1000;
+constexpr uint32_t SHORT_TIMEOUT_MS = 1;
+constexpr std::chrono::milliseconds WAIT_STEP(1);
+
+void WaitUntilPassed(std::chrono::steady_clock::time_point deadline)
+{
+    while (std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(WAIT_STEP);
+    }
+}
+} // namespace
+
+class TestEffectCancelToken : public testing::Test {
+public:
+    TestEffectCancelToken() = default;
+
+    ~TestEffectCancelToken() override = default;
+    static void SetUpTestCase() {}
+
+    static void TearDownTestCase() {}
+
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+HWTEST_F(TestEffectCancelToken, Check001, TestSize.Level1)
+{
+    EffectCancelToken token(LONG_TIMEOUT_MS);
+    EXPECT_EQ(token.Check(), ErrorCode::SUCCESS);
+    EXPECT_FALSE(token.IsCanceled());
+
+    token.Cancel();
+    EXPECT_EQ(token.Check(), ErrorCode::ERR_RENDER_CANCELED);
+    EXPECT_TRUE(token.IsCanceled());
+    EXPECT_TRUE(EffectCancelToken::IsCancelError(token.Check()));
+}
+
+HWTEST_F(TestEffectCancelToken, Check002, TestSize.Level1)
+{
+    EffectCancelToken token(SHORT_TIMEOUT_MS);
+    WaitUntilPassed(token.GetDeadline());
+    EXPECT_EQ(token.Check(), ErrorCode::ERR_TIMED_OUT);
+    EXPECT_TRUE(EffectCancelToken::IsCancelError(token.Check()));
+
+    // A cancel is reported over the timeout.
+    token.Cancel();
+    EXPECT_EQ(token.Check(), ErrorCode::ERR_RENDER_CANCELED);
+}
+
+HWTEST_F(TestEffectCancelToken, Check003, TestSize.Level1)
+{
+    EffectCancelToken token;
+    EXPECT_EQ(token.GetDeadline(), std::chrono::steady_clock::time_point::max());
+    EXPECT_EQ(token.Check(), ErrorCode::SUCCESS);
+    EXPECT_FALSE(EffectCancelToken::IsCancelError(ErrorCode::SUCCESS));
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -189,6 +189,33 @@ HWTEST_F(TestEffectColorSpaceManager, ColorSpaceHelper_ConvertColorSpace001, Tes
     EFFECT_LOGW("%{public}s ColorSpaceHelper_ConvertColorSpace001 end", TAG.c_str());
 }
 
+HWTEST_F(TestEffectColorSpaceManager, ColorSpaceHelper_ConvertColorSpace002, TestSize.Level1)
+{
+    EFFECT_LOGW("%{public}s ColorSpaceHelper_ConvertColorSpace002 enter", TAG.c_str());
+    std::shared_ptr<EffectBuffer> inputEffectBuffer = CreateEffectBufferByPicture(g_picture.get());
+    ASSERT_NE(inputEffectBuffer, nullptr);
+
+    inputEffectBuffer->bufferInfo_->colorSpace_ = EffectColorSpace::ADOBE_RGB;
+    effectContext_->colorSpaceManager_->strategy_ = std::make_shared<ColorSpaceStrategy>();
+    effectContext_->colorSpaceManager_->strategy_->src_ = inputEffectBuffer;
+
+    // No filter depends on the color space, the source is left as it is.
+    effectContext_->hasColorSpaceFilter_ = false;
+    ErrorCode result = ColorSpaceHelper::ConvertColorSpace(inputEffectBuffer, effectContext_);
+    EXPECT_EQ(result, ErrorCode::SUCCESS);
+    EXPECT_EQ(inputEffectBuffer->bufferInfo_->colorSpace_, EffectColorSpace::ADOBE_RGB);
+    EXPECT_EQ(effectContext_->pendingColorSpace_, EffectColorSpace::DEFAULT);
+
+    // Filters that only move pixels come first, the conversion waits for the first filter that needs it.
+    effectContext_->hasColorSpaceFilter_ = true;
+    effectContext_->isColorSpaceAgnosticHead_ = true;
+    result = ColorSpaceHelper::ConvertColorSpace(inputEffectBuffer, effectContext_);
+    EXPECT_EQ(result, ErrorCode::SUCCESS);
+    EXPECT_EQ(inputEffectBuffer->bufferInfo_->colorSpace_, EffectColorSpace::ADOBE_RGB);
+    EXPECT_EQ(effectContext_->pendingColorSpace_, EffectColorSpace::DISPLAY_P3);
+    EFFECT_LOGW("%{public}s ColorSpaceHelper_ConvertColorSpace002 end", TAG.c_str());
+}
+
 HWTEST_F(TestEffectColorSpaceManager, ColorSpaceHelper_UpdateMetadata001, TestSize.Level1)
 {
     EFFECT_LOGW("%{public}s ColorSpaceHelper_UpdateMetadata001 enter", TAG.c_str());
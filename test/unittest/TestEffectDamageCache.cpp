@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "effect_damage_cache.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr uint32_t WIDTH = 8;
+constexpr uint32_t HEIGHT = 6;
+constexpr uint32_t RGBA_BYTES_PER_PIXEL = 4;
+constexpr uint32_t ROW_PADDING = 16;
+constexpr uint8_t CACHED_VALUE = 10;
+constexpr uint8_t INPUT_VALUE = 20;
+constexpr uint8_t RENDERED_VALUE = 30;
+
+BufferInfo CreateFrame(std::vector<uint8_t> &data, IEffectFormat format, uint32_t rowStride, uint32_t rowNum,
+    uint8_t value)
+{
+    data.assign(rowStride * rowNum, value);
+    BufferInfo frame;
+    frame.width_ = WIDTH;
+    frame.height_ = HEIGHT;
+    frame.rowStride_ = rowStride;
+    frame.len_ = static_cast<uint32_t>(data.size());
+    frame.formatType_ = format;
+    frame.addr_ = data.data();
+    return frame;
+}
+
+void FillRegion(std::vector<uint8_t> &data, uint32_t rowStride, const RenderRegion &region, uint8_t value)
+{
+    for (int32_t y = region.y0; y < region.y1; ++y) {
+        for (uint32_t x = region.x0 * RGBA_BYTES_PER_PIXEL; x < region.x1 * RGBA_BYTES_PER_PIXEL; ++x) {
+            data[y * rowStride + x] = value;
+        }
+    }
+}
+
+uint8_t GetPixel(const std::vector<uint8_t> &data, uint32_t rowStride, uint32_t x, uint32_t y)
+{
+    return data[y * rowStride + x * RGBA_BYTES_PER_PIXEL];
+}
+} // namespace
+
+class TestEffectDamageCache : public testing::Test {
+public:
+    TestEffectDamageCache() = default;
+
+    ~TestEffectDamageCache() override = default;
+    static void SetUpTestCase() {}
+
+    static void TearDownTestCase() {}
+
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+HWTEST_F(TestEffectDamageCache, AlignDamage001, TestSize.Level1)
+{
+    std::vector<uint8_t> data;
+    BufferInfo nv12Frame = CreateFrame(data, IEffectFormat::YUVNV12, WIDTH, HEIGHT * 3 / 2, 0);
+
+    // Corners in any order, clamped to the frame and widened to whole chroma samples.
+    RenderRegion damage = { 5, 3, 1, -2 };
+    EXPECT_TRUE(EffectDamageCache::AlignDamage(nv12Frame, damage));
+    EXPECT_EQ(damage.x0, 0);
+    EXPECT_EQ(damage.y0, 0);
+    EXPECT_EQ(damage.x1, 6);
+    EXPECT_EQ(damage.y1, 4);
+
+    RenderRegion fullDamage = { 0, 0, static_cast<int32_t>(WIDTH), static_cast<int32_t>(HEIGHT) };
+    EXPECT_FALSE(EffectDamageCache::AlignDamage(nv12Frame, fullDamage));
+    RenderRegion emptyDamage = { 2, 2, 2, 4 };
+    EXPECT_FALSE(EffectDamageCache::AlignDamage(nv12Frame, emptyDamage));
+
+    BufferInfo p010Frame = nv12Frame;
+    p010Frame.formatType_ = IEffectFormat::YCBCR_P010;
+    RenderRegion p010Damage = { 0, 0, 2, 2 };
+    EXPECT_FALSE(EffectDamageCache::AlignDamage(p010Frame, p010Damage));
+}
+
+HWTEST_F(TestEffectDamageCache, Merge001, TestSize.Level1)
+{
+    uint32_t rowStride = WIDTH * RGBA_BYTES_PER_PIXEL + ROW_PADDING;
+    std::vector<uint64_t> settings = { 1, 2 };
+    EffectDamageCache cache;
+    std::vector<uint8_t> output;
+    BufferInfo outputFrame = CreateFrame(output, IEffectFormat::RGBA8888, rowStride, HEIGHT, CACHED_VALUE);
+    ASSERT_EQ(cache.Update(outputFrame, 1, settings), ErrorCode::SUCCESS);
+
+    // Only the next frame with the same layout and settings reuses the cache.
+    std::vector<uint8_t> data;
+    BufferInfo frame = CreateFrame(data, IEffectFormat::RGBA8888, rowStride, HEIGHT, INPUT_VALUE);
+    EXPECT_TRUE(cache.IsReusable(frame, 2, settings));
+    EXPECT_FALSE(cache.IsReusable(frame, 3, settings));
+    EXPECT_FALSE(cache.IsReusable(frame, 2, { 1, 3 }));
+    BufferInfo otherFrame = frame;
+    otherFrame.rowStride_ = WIDTH * RGBA_BYTES_PER_PIXEL;
+    EXPECT_FALSE(cache.IsReusable(otherFrame, 2, settings));
+
+    RenderRegion damage = { 2, 1, 5, 3 };
+    FillRegion(data, rowStride, damage, RENDERED_VALUE);
+    ASSERT_EQ(cache.Merge(frame, 2, damage), ErrorCode::SUCCESS);
+    EXPECT_EQ(GetPixel(data, rowStride, 0, 0), CACHED_VALUE);
+    EXPECT_EQ(GetPixel(data, rowStride, 1, 2), CACHED_VALUE);
+    EXPECT_EQ(GetPixel(data, rowStride, 2, 1), RENDERED_VALUE);
+    EXPECT_EQ(GetPixel(data, rowStride, 4, 2), RENDERED_VALUE);
+    EXPECT_EQ(GetPixel(data, rowStride, 5, 2), CACHED_VALUE);
+    EXPECT_EQ(GetPixel(data, rowStride, WIDTH - 1, HEIGHT - 1), CACHED_VALUE);
+
+    // The damage of the merged frame is cached for the frame after it.
+    std::vector<uint8_t> nextData;
+    BufferInfo nextFrame = CreateFrame(nextData, IEffectFormat::RGBA8888, rowStride, HEIGHT, INPUT_VALUE);
+    EXPECT_TRUE(cache.IsReusable(nextFrame, 3, settings));
+    RenderRegion nextDamage = { 0, 4, 2, 6 };
+    ASSERT_EQ(cache.Merge(nextFrame, 3, nextDamage), ErrorCode::SUCCESS);
+    EXPECT_EQ(GetPixel(nextData, rowStride, 3, 2), RENDERED_VALUE);
+    EXPECT_EQ(GetPixel(nextData, rowStride, 0, 0), CACHED_VALUE);
+    EXPECT_EQ(GetPixel(nextData, rowStride, 1, 5), INPUT_VALUE);
+
+    cache.Invalidate();
+    EXPECT_FALSE(cache.IsReusable(nextFrame, 4, settings));
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+#include "effect_frame_stats.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr int64_t NS_PER_MS = 1000000;
+constexpr int64_t FRAME_INTERVAL_NS = 10 * NS_PER_MS;
+constexpr uint32_t FRAME_NUM = 100;
+constexpr int WRITER_NUM = 4;
+
+EffectFrameTimestamps CreateTimestamps(int64_t acquiredNs, int64_t renderNs)
+{
+    EffectFrameTimestamps timestamps;
+    auto set = [&timestamps](FrameCheckpoint checkpoint, int64_t ns) {
+        timestamps.checkpointNs_[static_cast<size_t>(checkpoint)] = ns;
+    };
+    set(FrameCheckpoint::ACQUIRED, acquiredNs);
+    set(FrameCheckpoint::FENCE_SIGNALED, acquiredNs + NS_PER_MS);
+    set(FrameCheckpoint::CACHE_INVALIDATED, acquiredNs + NS_PER_MS);
+    set(FrameCheckpoint::BUFFER_REQUESTED, acquiredNs + NS_PER_MS);
+    set(FrameCheckpoint::QUEUED, acquiredNs + NS_PER_MS);
+    set(FrameCheckpoint::RENDER_BEGIN, acquiredNs + NS_PER_MS);
+    set(FrameCheckpoint::RENDER_END, acquiredNs + NS_PER_MS + renderNs);
+    set(FrameCheckpoint::FLUSHED, acquiredNs + NS_PER_MS + renderNs);
+    return timestamps;
+}
+} // namespace
+
+class TestEffectFrameStats : public testing::Test {
+public:
+    TestEffectFrameStats() = default;
+
+    ~TestEffectFrameStats() override = default;
+    static void SetUpTestCase() {}
+
+    static void TearDownTestCase() {}
+
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+HWTEST_F(TestEffectFrameStats, Statistics001, TestSize.Level1)
+{
+    EffectFrameStats frameStats;
+    EffectFrameStatistics statistics;
+    frameStats.GetStatistics(statistics);
+    EXPECT_EQ(statistics.renderedFrameNum_, 0);
+    EXPECT_EQ(statistics.fps_, 0.f);
+
+    // Render time of frame i is i ms, frames are flushed every 10 ms.
+    for (uint32_t i = 1; i <= FRAME_NUM; ++i) {
+        frameStats.Commit(CreateTimestamps(i * (FRAME_INTERVAL_NS - NS_PER_MS), i * NS_PER_MS));
+    }
+    frameStats.RecordDrop(2);
+    frameStats.RecordQueueDepth(3);
+    frameStats.RecordQueueDepth(1);
+
+    frameStats.GetStatistics(statistics);
+    EXPECT_EQ(statistics.renderedFrameNum_, FRAME_NUM);
+    EXPECT_EQ(statistics.droppedFrameNum_, 2);
+    EXPECT_EQ(statistics.queueDepth_, 1);
+    EXPECT_EQ(statistics.maxQueueDepth_, 3);
+    EXPECT_NEAR(statistics.fps_, 100.f, 1.f);
+
+    const EffectLatencyPercentile &render = statistics.latency_[static_cast<size_t>(FrameStage::RENDER)];
+    EXPECT_EQ(render.p50Us_, 50000);
+    EXPECT_EQ(render.p95Us_, 95000);
+    EXPECT_EQ(render.p99Us_, 99000);
+    const EffectLatencyPercentile &fenceWait = statistics.latency_[static_cast<size_t>(FrameStage::FENCE_WAIT)];
+    EXPECT_EQ(fenceWait.p99Us_, 1000);
+}
+
+HWTEST_F(TestEffectFrameStats, Statistics002, TestSize.Level1)
+{
+    EffectFrameStats frameStats;
+    std::vector<std::thread> writers;
+    for (int i = 0; i < WRITER_NUM; ++i) {
+        writers.emplace_back([&frameStats]() {
+            for (uint32_t j = 1; j <= EffectFrameStats::FRAME_WINDOW_SIZE; ++j) {
+                frameStats.Commit(CreateTimestamps(j * FRAME_INTERVAL_NS, NS_PER_MS));
+            }
+        });
+    }
+    EffectFrameStatistics statistics;
+    frameStats.GetStatistics(statistics);
+    for (auto &writer : writers) {
+        writer.join();
+    }
+
+    // Only the latest window is kept, every complete slot holds a consistent frame.
+    frameStats.GetStatistics(statistics);
+    EXPECT_EQ(statistics.renderedFrameNum_, WRITER_NUM * EffectFrameStats::FRAME_WINDOW_SIZE);
+    EXPECT_EQ(statistics.latency_[static_cast<size_t>(FrameStage::RENDER)].p50Us_, 1000);
+    EXPECT_EQ(statistics.latency_[static_cast<size_t>(FrameStage::TOTAL)].p99Us_, 2000);
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
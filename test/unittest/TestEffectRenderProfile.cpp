@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "effect_render_profile.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr uint64_t COPY_BYTES = 1024;
+constexpr int64_t SLEEP_MS = 2;
+constexpr int64_t NS_PER_MS = 1000000;
+} // namespace
+
+class TestEffectRenderProfile : public testing::Test {
+public:
+    TestEffectRenderProfile() = default;
+
+    ~TestEffectRenderProfile() override = default;
+    static void SetUpTestCase() {}
+
+    static void TearDownTestCase() {}
+
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+HWTEST_F(TestEffectRenderProfile, RenderProfile001, TestSize.Level1)
+{
+    EffectRenderProfile profile;
+    {
+        EffectProfileScope profileScope(&profile, ProfileStage::FILTER_RENDER, "Brightness");
+        profileScope.SetDetail("ipType=1,format=1");
+        std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_MS));
+    }
+    {
+        EffectProfileScope profileScope(nullptr, ProfileStage::SINK, "ImageSinkFilter");
+        EXPECT_FALSE(profileScope.IsEnabled());
+    }
+
+    std::vector<EffectProfileRecord> records = profile.GetRecords();
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0].stage_, ProfileStage::FILTER_RENDER);
+    EXPECT_EQ(records[0].name_, "Brightness");
+    EXPECT_GE(records[0].wallNs_, SLEEP_MS * NS_PER_MS);
+    EXPECT_GE(records[0].cpuNs_, 0);
+
+    EffectJsonPtr root = profile.ToJson();
+    std::vector<EffectJsonPtr> stages = root->GetArray("stages");
+    ASSERT_EQ(stages.size(), 1);
+    EXPECT_EQ(stages[0]->GetString("stage"), "FilterRender");
+    EXPECT_EQ(stages[0]->GetString("detail"), "ipType=1,format=1");
+    EXPECT_GE(stages[0]->GetDouble("wallUs"), static_cast<double>(SLEEP_MS * 1000));
+}
+
+HWTEST_F(TestEffectRenderProfile, RenderProfile002, TestSize.Level1)
+{
+    EffectRenderProfile profile;
+    EXPECT_EQ(EffectRenderProfile::GetCurrent(), nullptr);
+    {
+        EffectProfileBinder profileBinder(&profile);
+        EXPECT_EQ(EffectRenderProfile::GetCurrent(), &profile);
+
+        // Helpers without a context report into the profile bound to their thread only.
+        std::thread worker([]() {
+            EffectProfileScope profileScope(ProfileStage::MEMCPY, "MemcpyHelper::CopyData");
+            EXPECT_FALSE(profileScope.IsEnabled());
+        });
+        worker.join();
+
+        EffectProfileScope profileScope(ProfileStage::MEMORY_ALLOC, "EffectMemoryManager::AllocMemory");
+        profileScope.SetBytes(COPY_BYTES);
+        profileScope.SetStage(ProfileStage::MEMORY_REUSE);
+    }
+    EXPECT_EQ(EffectRenderProfile::GetCurrent(), nullptr);
+
+    std::vector<EffectProfileRecord> records = profile.GetRecords();
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0].stage_, ProfileStage::MEMORY_REUSE);
+    EXPECT_EQ(records[0].bytes_, COPY_BYTES);
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
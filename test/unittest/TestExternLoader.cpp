@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <thread>
+
+#include "external_loader.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr int32_t WAIT_READY_MS = 5000;
+constexpr int32_t POLL_INTERVAL_MS = 5;
+} // namespace
+
+class TestExternLoader : public testing::Test {
+public:
+    TestExternLoader() = default;
+
+    ~TestExternLoader() override = default;
+    static void SetUpTestCase() {}
+
+    static void TearDownTestCase() {}
+
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+HWTEST_F(TestExternLoader, Preload001, TestSize.Level1)
+{
+    ExternLoader *loader = ExternLoader::Instance();
+    loader->Preload();
+    loader->Preload();
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(WAIT_READY_MS);
+    while (!loader->IsReady() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(POLL_INTERVAL_MS));
+    }
+    ASSERT_TRUE(loader->IsReady());
+
+    // The library may be missing, the attempt is finished and timed either way.
+    ExternLoaderStats stats = loader->GetStartupStats();
+    EXPECT_TRUE(stats.isReady_);
+    EXPECT_EQ(stats.isExtLoad_, loader->IsExtLoad());
+    EXPECT_GE(stats.dlopenNs_, 0);
+    EXPECT_GE(stats.dlsymNs_, 0);
+    EXPECT_GE(stats.initNs_, 0);
+
+    // Already initialized, neither of them blocks nor starts anything.
+    loader->InitExt();
+    loader->Preload();
+    EXPECT_TRUE(loader->IsReady());
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
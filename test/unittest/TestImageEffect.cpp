@@ -105,7 +105,7 @@ public:
         mockPixelMap_ = new MockPixelMap();
         imageEffect_ = std::make_unique<ImageEffect>(IMAGE_EFFECT_NAME);
         ExternLoader::Instance()->InitExt();
-        EFilterFactory::Instance()->functions_.clear();
+        EFilterFactory::Instance()->ClearFunctions();
         EFilterFactory::Instance()->RegisterEFilter<BrightnessEFilter>(BRIGHTNESS_EFILTER);
         EFilterFactory::Instance()->RegisterEFilter<ContrastEFilter>(CONTRAST_EFILTER);
         EFilterFactory::Instance()->RegisterEFilter<CropEFilter>(CROP_EFILTER);
@@ -360,6 +360,149 @@ HWTEST_F(TestImageEffect, Restore003, TestSize.Level1)
     ASSERT_STREQ(efilters.at(0)->GetName().c_str(), CROP_EFILTER);
 }
 
+HWTEST_F(TestImageEffect, Restore004, TestSize.Level1)
+{
+    std::string info = "{\"imageEffect\":{\"filters\":[{\"name\":\"Brightness\",\"values\":{\"FilterIntensity\":"
+        "100.0}},{\"name\":\"Contrast\",\"values\":{\"FilterIntensity\":50.0}}],\"name\":\"imageEdit\"}}";
+    std::shared_ptr<ImageEffect> imageEffect = ImageEffect::Restore(info);
+    ASSERT_NE(imageEffect, nullptr);
+    ASSERT_EQ(imageEffect->GetEFilters().size(), 2);
+    RenderRegion regions[] = { { 10, 20, 300, 400 }, { 64, 32, 0, 16 } };
+    for (size_t i = 0; i < imageEffect->GetEFilters().size(); ++i) {
+        Any regionAny = static_cast<void *>(&regions[i]);
+        ASSERT_EQ(imageEffect->GetEFilters().at(i)->SetValue(KEY_FILTER_REGION, regionAny), ErrorCode::SUCCESS);
+    }
+    EffectJsonPtr root = EffectJsonHelper::CreateObject();
+    ASSERT_EQ(imageEffect->Save(root), ErrorCode::SUCCESS);
+
+    // The region goes through the json with the intensity, the restored filters do not apply to the whole frame.
+    std::string savedInfo = root->ToString();
+    std::shared_ptr<ImageEffect> restoredEffect = ImageEffect::Restore(savedInfo);
+    ASSERT_NE(restoredEffect, nullptr);
+    ASSERT_EQ(restoredEffect->GetEFilters().size(), 2);
+    for (size_t i = 0; i < restoredEffect->GetEFilters().size(); ++i) {
+        Any value;
+        ASSERT_EQ(restoredEffect->GetEFilters().at(i)->GetValue(KEY_FILTER_REGION, value), ErrorCode::SUCCESS);
+        auto restoredRegion = AnyCast<RenderRegion>(&value);
+        ASSERT_NE(restoredRegion, nullptr);
+        EXPECT_EQ(restoredRegion->x0, regions[i].x0);
+        EXPECT_EQ(restoredRegion->y0, regions[i].y0);
+        EXPECT_EQ(restoredRegion->x1, regions[i].x1);
+        EXPECT_EQ(restoredRegion->y1, regions[i].y1);
+        Any intensity;
+        ASSERT_EQ(restoredEffect->GetEFilters().at(i)->GetValue(KEY_FILTER_INTENSITY, intensity), ErrorCode::SUCCESS);
+        EXPECT_NE(AnyCast<float>(&intensity), nullptr);
+    }
+}
+
+HWTEST_F(TestImageEffect, RestoreBinary001, TestSize.Level1)
+{
+    std::string info = "{\"imageEffect\":{\"filters\":[{\"name\":\"Brightness\",\"values\":{\"FilterIntensity\":"
+        "100.0}},{\"name\":\"Contrast\",\"values\":{\"FilterIntensity\":50.0}}],\"name\":\"imageEdit\"}}";
+    std::shared_ptr<ImageEffect> imageEffect = ImageEffect::Restore(info);
+    ASSERT_NE(imageEffect, nullptr);
+    std::vector<uint8_t> data;
+    ASSERT_EQ(imageEffect->SaveBinary(data), ErrorCode::SUCCESS);
+
+    std::shared_ptr<ImageEffect> restoredEffect = ImageEffect::RestoreBinary(data.data(), data.size());
+    ASSERT_NE(restoredEffect, nullptr);
+    std::vector<std::shared_ptr<EFilter>> efilters = restoredEffect->GetEFilters();
+    ASSERT_EQ(efilters.size(), 2);
+    ASSERT_STREQ(efilters.at(0)->GetName().c_str(), BRIGHTNESS_EFILTER);
+    Any value;
+    ASSERT_EQ(efilters.at(0)->GetValue(KEY_FILTER_INTENSITY, value), ErrorCode::SUCCESS);
+    auto brightnessRatio = AnyCast<float>(&value);
+    ASSERT_NE(brightnessRatio, nullptr);
+    ASSERT_FLOAT_EQ(*brightnessRatio, 100.f);
+    ASSERT_STREQ(efilters.at(1)->GetName().c_str(), CONTRAST_EFILTER);
+
+    // The filters of a restored chain are not shared with the chains restored from the same data.
+    std::shared_ptr<ImageEffect> cachedEffect = ImageEffect::RestoreBinary(data.data(), data.size());
+    ASSERT_NE(cachedEffect, nullptr);
+    ASSERT_EQ(cachedEffect->GetEFilters().size(), 2);
+    ASSERT_NE(cachedEffect->GetEFilters().at(0), efilters.at(0));
+
+    ASSERT_EQ(ImageEffect::RestoreBinary(data.data(), data.size() - 1), nullptr);
+}
+
+HWTEST_F(TestImageEffect, RestoreBinary002, TestSize.Level1)
+{
+    std::shared_ptr<IFilterDelegate> customTestEFilter = std::make_unique<CustomTestEFilter>();
+    auto *effectInfo = static_cast<std::shared_ptr<EffectInfo> *>(customTestEFilter->GetEffectInfo());
+    ASSERT_NE(effectInfo, nullptr);
+    EFilterFactory::Instance()->RegisterDelegate(CUSTOM_TEST_EFILTER, customTestEFilter, *effectInfo);
+
+    std::string info = "{\"imageEffect\":{\"filters\":[{\"name\":\"CustomTestEFilter\",\"values\":{\"brightness\":"
+        "60.0}}],\"name\":\"imageEdit\"}}";
+    std::shared_ptr<ImageEffect> imageEffect = ImageEffect::Restore(info);
+    ASSERT_NE(imageEffect, nullptr);
+    std::vector<uint8_t> data;
+    ASSERT_NE(imageEffect->SaveBinary(data), ErrorCode::SUCCESS);
+}
+
+HWTEST_F(TestImageEffect, RestoreBinary003, TestSize.Level1)
+{
+    std::string info = "{\"imageEffect\":{\"filters\":[{\"name\":\"Brightness\",\"values\":{\"FilterIntensity\":"
+        "100.0}}],\"name\":\"imageEdit\"}}";
+    std::shared_ptr<ImageEffect> imageEffect = ImageEffect::Restore(info);
+    ASSERT_NE(imageEffect, nullptr);
+    ASSERT_EQ(imageEffect->GetEFilters().size(), 1);
+    RenderRegion region = { 10, 20, 300, 400 };
+    Any regionAny = static_cast<void *>(&region);
+    ASSERT_EQ(imageEffect->GetEFilters().at(0)->SetValue(KEY_FILTER_REGION, regionAny), ErrorCode::SUCCESS);
+    std::vector<uint8_t> data;
+    ASSERT_EQ(imageEffect->SaveBinary(data), ErrorCode::SUCCESS);
+
+    // The region is restored along, the filter does not apply to the whole frame.
+    std::shared_ptr<ImageEffect> restoredEffect = ImageEffect::RestoreBinary(data.data(), data.size());
+    ASSERT_NE(restoredEffect, nullptr);
+    ASSERT_EQ(restoredEffect->GetEFilters().size(), 1);
+    Any value;
+    ASSERT_EQ(restoredEffect->GetEFilters().at(0)->GetValue(KEY_FILTER_REGION, value), ErrorCode::SUCCESS);
+    auto restoredRegion = AnyCast<RenderRegion>(&value);
+    ASSERT_NE(restoredRegion, nullptr);
+    EXPECT_EQ(restoredRegion->x0, region.x0);
+    EXPECT_EQ(restoredRegion->y0, region.y0);
+    EXPECT_EQ(restoredRegion->x1, region.x1);
+    EXPECT_EQ(restoredRegion->y1, region.y1);
+}
+
+HWTEST_F(TestImageEffect, Clone001, TestSize.Level1)
+{
+    std::string info = "{\"imageEffect\":{\"filters\":[{\"name\":\"Brightness\",\"values\":{\"FilterIntensity\":"
+        "100.0}},{\"name\":\"Contrast\",\"values\":{\"FilterIntensity\":50.0}}],\"name\":\"imageEdit\"}}";
+    std::shared_ptr<ImageEffect> imageEffect = ImageEffect::Restore(info);
+    ASSERT_NE(imageEffect, nullptr);
+
+    std::shared_ptr<ImageEffect> clone = imageEffect->Clone();
+    ASSERT_NE(clone, nullptr);
+    std::vector<std::shared_ptr<EFilter>> efilters = imageEffect->GetEFilters();
+    std::vector<std::shared_ptr<EFilter>> clonedEFilters = clone->GetEFilters();
+    ASSERT_EQ(clonedEFilters.size(), efilters.size());
+    for (size_t i = 0; i < efilters.size(); ++i) {
+        ASSERT_NE(clonedEFilters.at(i), efilters.at(i));
+        ASSERT_STREQ(clonedEFilters.at(i)->GetName().c_str(), efilters.at(i)->GetName().c_str());
+    }
+    EffectJsonPtr root = EffectJsonHelper::CreateObject();
+    ASSERT_EQ(imageEffect->Save(root), ErrorCode::SUCCESS);
+    EffectJsonPtr clonedRoot = EffectJsonHelper::CreateObject();
+    ASSERT_EQ(clone->Save(clonedRoot), ErrorCode::SUCCESS);
+    ASSERT_EQ(clonedRoot->ToString(), root->ToString());
+
+    // The values are copied, changing them on the clone leaves the prototype as it was.
+    Any value = 20.f;
+    ASSERT_EQ(clonedEFilters.at(0)->SetValue(KEY_FILTER_INTENSITY, value), ErrorCode::SUCCESS);
+    Any prototypeValue;
+    ASSERT_EQ(efilters.at(0)->GetValue(KEY_FILTER_INTENSITY, prototypeValue), ErrorCode::SUCCESS);
+    auto brightnessRatio = AnyCast<float>(&prototypeValue);
+    ASSERT_NE(brightnessRatio, nullptr);
+    ASSERT_FLOAT_EQ(*brightnessRatio, 100.f);
+
+    std::shared_ptr<ImageEffect> emptyClone = imageEffect_->Clone();
+    ASSERT_NE(emptyClone, nullptr);
+    ASSERT_TRUE(emptyClone->GetEFilters().empty());
+}
+
 HWTEST_F(TestImageEffect, Surface001, TestSize.Level1)
 {
     sptr<Surface> consumerSurface = Surface::CreateSurfaceAsConsumer("UnitTest");
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+#include "render_perf_stats.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr int64_t NS_PER_US = 1000;
+constexpr uint32_t RENDER_NUM = 100;
+constexpr int THREAD_NUM = 4;
+constexpr uint64_t BUFFER_BYTES = 4096;
+constexpr uint32_t FORMAT_RGBA = 1;
+constexpr uint32_t FORMAT_NV12 = 4;
+constexpr uint32_t IP_TYPE_CPU = 1;
+} // namespace
+
+class TestRenderPerfStats : public testing::Test {
+public:
+    TestRenderPerfStats() = default;
+
+    ~TestRenderPerfStats() override = default;
+    static void SetUpTestCase() {}
+
+    static void TearDownTestCase() {}
+
+    void SetUp() override
+    {
+        RenderPerfStats::Instance().Collect();
+    }
+
+    void TearDown() override {}
+};
+
+HWTEST_F(TestRenderPerfStats, Collect001, TestSize.Level1)
+{
+    RenderPerfStats &stats = RenderPerfStats::Instance();
+    RenderPerfKey rgbaKey = { "Brightness", FORMAT_RGBA, IP_TYPE_CPU };
+    RenderPerfKey nv12Key = { "Brightness", FORMAT_NV12, IP_TYPE_CPU };
+    stats.Record(rgbaKey, 10 * NS_PER_US, BUFFER_BYTES, BUFFER_BYTES);
+    stats.Record(rgbaKey, 30 * NS_PER_US, BUFFER_BYTES, 0);
+    stats.Record(nv12Key, 20 * NS_PER_US, BUFFER_BYTES, 0);
+
+    RenderPerfCounterMap counters = stats.Collect();
+    ASSERT_EQ(counters.size(), 2);
+    const RenderPerfCounter &rgbaCounter = counters[rgbaKey];
+    EXPECT_EQ(rgbaCounter.renderNum_, 2);
+    EXPECT_EQ(rgbaCounter.totalDurationUs_, 40);
+    EXPECT_EQ(rgbaCounter.maxDurationUs_, 30);
+    EXPECT_EQ(rgbaCounter.processedBytes_, 2 * BUFFER_BYTES);
+    EXPECT_EQ(rgbaCounter.allocBytes_, BUFFER_BYTES);
+    EXPECT_EQ(counters[nv12Key].renderNum_, 1);
+
+    // Collected counters are reset.
+    EXPECT_TRUE(stats.Collect().empty());
+}
+
+HWTEST_F(TestRenderPerfStats, Collect002, TestSize.Level1)
+{
+    RenderPerfStats &stats = RenderPerfStats::Instance();
+    RenderPerfKey key = { "Contrast", FORMAT_RGBA, IP_TYPE_CPU };
+
+    // The counters of the exited threads are kept until the next collection.
+    std::vector<std::thread> threads;
+    for (int i = 0; i < THREAD_NUM; ++i) {
+        threads.emplace_back([&key]() {
+            for (uint32_t j = 0; j < RENDER_NUM; ++j) {
+                RenderPerfScope perfScope(key.filterName_, key.format_, key.ipType_, BUFFER_BYTES, 0);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    stats.Record(key, NS_PER_US, BUFFER_BYTES, 0);
+
+    RenderPerfCounterMap counters = stats.Collect();
+    ASSERT_EQ(counters.size(), 1);
+    EXPECT_EQ(counters[key].renderNum_, THREAD_NUM * RENDER_NUM + 1);
+    EXPECT_EQ(counters[key].processedBytes_, (THREAD_NUM * RENDER_NUM + 1) * BUFFER_BYTES);
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sys/stat.h>
+
+#include "core/render_resource_cache.h"
+#include "graphic/render_program_binary_cache.h"
+#include "render_environment.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr RenderProgramKey PROGRAM_KEY = { 0x1234, 0x4321, 10, 20 };
+constexpr uint64_t DRIVER_KEY = 0x5678;
+constexpr GLenum BINARY_FORMAT = 0x9abc;
+constexpr mode_t CACHE_DIR_MODE = 0700;
+constexpr size_t FILE_NAME_SIZE = 64;
+const std::string CACHE_DIR = "/data/test/image_effect_program_cache";
+const std::string VS_CONTENT = "attribute vec4 aPosition;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = aPosition;\n"
+    "}\n";
+const std::string FS_CONTENT = "precision highp float;\n"
+    "uniform float ratio;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_FragColor = vec4(ratio, ratio, ratio, 1.0);\n"
+    "}\n";
+
+RenderProgramBinary CreateBinary()
+{
+    RenderProgramBinary binary;
+    binary.driverKey_ = DRIVER_KEY;
+    binary.format_ = BINARY_FORMAT;
+    binary.data_ = { 1, 2, 3, 4, 5 };
+    return binary;
+}
+} // namespace
+
+class TestRenderProgramBinaryCache : public testing::Test {
+public:
+    TestRenderProgramBinaryCache() = default;
+
+    ~TestRenderProgramBinaryCache() override = default;
+    static void SetUpTestCase() {}
+
+    static void TearDownTestCase() {}
+
+    void SetUp() override
+    {
+        mkdir(CACHE_DIR.c_str(), CACHE_DIR_MODE);
+        RenderProgramBinaryCache::Instance().Clear();
+    }
+
+    void TearDown() override
+    {
+        RenderProgramBinaryCache &cache = RenderProgramBinaryCache::Instance();
+        cache.RemoveBinary(PROGRAM_KEY);
+        cache.RemoveBinary(RenderProgramBinaryCache::GetProgramKey(VS_CONTENT, FS_CONTENT));
+        cache.SetCacheDir("");
+        cache.Clear();
+        rmdir(CACHE_DIR.c_str());
+    }
+};
+
+HWTEST_F(TestRenderProgramBinaryCache, ProgramKey001, TestSize.Level1)
+{
+    RenderProgramKey key = RenderProgramBinaryCache::GetProgramKey(VS_CONTENT, FS_CONTENT);
+    EXPECT_TRUE(key == RenderProgramBinaryCache::GetProgramKey(VS_CONTENT, FS_CONTENT));
+    EXPECT_EQ(key.vsLength_, VS_CONTENT.size());
+    EXPECT_EQ(key.fsLength_, FS_CONTENT.size());
+    RenderProgramKey swapped = RenderProgramBinaryCache::GetProgramKey(FS_CONTENT, VS_CONTENT);
+    EXPECT_NE(key.sourceKey_, swapped.sourceKey_);
+    EXPECT_NE(key.checkKey_, swapped.checkKey_);
+    RenderProgramKey left = RenderProgramBinaryCache::GetProgramKey("ab", "c");
+    RenderProgramKey right = RenderProgramBinaryCache::GetProgramKey("a", "bc");
+    EXPECT_NE(left.sourceKey_, right.sourceKey_);
+    EXPECT_NE(left.checkKey_, right.checkKey_);
+}
+
+HWTEST_F(TestRenderProgramBinaryCache, DiskCache001, TestSize.Level1)
+{
+    RenderProgramBinaryCache &cache = RenderProgramBinaryCache::Instance();
+    EXPECT_FALSE(cache.SetCacheDir(CACHE_DIR + "/none"));
+    ASSERT_TRUE(cache.SetCacheDir(CACHE_DIR));
+    cache.StoreBinary(PROGRAM_KEY, CreateBinary());
+    EXPECT_EQ(cache.GetBinaryCount(), 1);
+
+    // The binary is read back from the file once the memory is cleared, as in the next run of the application.
+    cache.Clear();
+    RenderProgramBinary binary;
+    ASSERT_TRUE(cache.FindBinary(PROGRAM_KEY, DRIVER_KEY, binary));
+    EXPECT_EQ(binary.format_, BINARY_FORMAT);
+    EXPECT_EQ(binary.data_, CreateBinary().data_);
+    EXPECT_EQ(cache.GetBinaryCount(), 1);
+
+    // A binary of another driver is dropped.
+    cache.Clear();
+    EXPECT_FALSE(cache.FindBinary(PROGRAM_KEY, DRIVER_KEY + 1, binary));
+    EXPECT_EQ(cache.GetBinaryCount(), 0);
+
+    cache.RemoveBinary(PROGRAM_KEY);
+    EXPECT_FALSE(cache.FindBinary(PROGRAM_KEY, DRIVER_KEY, binary));
+
+    // Without a directory the binaries only live in memory.
+    ASSERT_TRUE(cache.SetCacheDir(""));
+    cache.StoreBinary(PROGRAM_KEY, CreateBinary());
+    EXPECT_TRUE(cache.FindBinary(PROGRAM_KEY, DRIVER_KEY, binary));
+    cache.Clear();
+    EXPECT_FALSE(cache.FindBinary(PROGRAM_KEY, DRIVER_KEY, binary));
+}
+
+HWTEST_F(TestRenderProgramBinaryCache, DiskCache002, TestSize.Level1)
+{
+    RenderProgramBinaryCache &cache = RenderProgramBinaryCache::Instance();
+    ASSERT_TRUE(cache.SetCacheDir(CACHE_DIR));
+    cache.StoreBinary(PROGRAM_KEY, CreateBinary());
+    char name[FILE_NAME_SIZE] = { 0 };
+    ASSERT_GT(snprintf(name, sizeof(name), "/ie_program_%016llx.bin",
+        static_cast<unsigned long long>(PROGRAM_KEY.sourceKey_)), 0);
+    std::string path = CACHE_DIR + name;
+
+    // A truncated file is not loaded.
+    std::ifstream input(path, std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    input.close();
+    ASSERT_GT(data.size(), 1);
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output.write(data.data(), data.size() - 1);
+    output.close();
+
+    cache.Clear();
+    RenderProgramBinary binary;
+    EXPECT_FALSE(cache.FindBinary(PROGRAM_KEY, DRIVER_KEY, binary));
+}
+
+HWTEST_F(TestRenderProgramBinaryCache, DiskCache003, TestSize.Level1)
+{
+    RenderProgramBinaryCache &cache = RenderProgramBinaryCache::Instance();
+    ASSERT_TRUE(cache.SetCacheDir(CACHE_DIR));
+    cache.StoreBinary(PROGRAM_KEY, CreateBinary());
+
+    // Other sources of the same 64-bit hash get neither the binary in memory nor the file.
+    RenderProgramKey collidedKey = PROGRAM_KEY;
+    collidedKey.checkKey_++;
+    RenderProgramBinary binary;
+    EXPECT_FALSE(cache.FindBinary(collidedKey, DRIVER_KEY, binary));
+    cache.Clear();
+    EXPECT_FALSE(cache.FindBinary(collidedKey, DRIVER_KEY, binary));
+    collidedKey = PROGRAM_KEY;
+    collidedKey.fsLength_++;
+    EXPECT_FALSE(cache.FindBinary(collidedKey, DRIVER_KEY, binary));
+    EXPECT_TRUE(cache.FindBinary(PROGRAM_KEY, DRIVER_KEY, binary));
+}
+
+HWTEST_F(TestRenderProgramBinaryCache, CreateProgram001, TestSize.Level1)
+{
+    std::shared_ptr<RenderEnvironment> renderEnvironment = std::make_shared<RenderEnvironment>();
+    renderEnvironment->Init();
+    renderEnvironment->Prepare();
+    RenderProgramBinaryCache &cache = RenderProgramBinaryCache::Instance();
+    ASSERT_TRUE(cache.SetCacheDir(CACHE_DIR));
+
+    GLuint program = cache.CreateProgram(VS_CONTENT, FS_CONTENT);
+    ASSERT_NE(program, 0);
+    glDeleteProgram(program);
+
+    uint64_t driverKey = RenderProgramBinaryCache::GetDriverKey();
+    if (driverKey != 0) {
+        RenderProgramKey key = RenderProgramBinaryCache::GetProgramKey(VS_CONTENT, FS_CONTENT);
+        RenderProgramBinary binary;
+        ASSERT_TRUE(cache.FindBinary(key, driverKey, binary));
+
+        // Linked from the file.
+        cache.Clear();
+        program = cache.CreateProgram(VS_CONTENT, FS_CONTENT);
+        EXPECT_NE(program, 0);
+        EXPECT_NE(glGetUniformLocation(program, "ratio"), -1);
+        glDeleteProgram(program);
+
+        // A binary the driver rejects falls back to the sources, and is replaced.
+        RenderProgramBinary invalid = CreateBinary();
+        invalid.driverKey_ = driverKey;
+        cache.StoreBinary(key, invalid);
+        program = cache.CreateProgram(VS_CONTENT, FS_CONTENT);
+        EXPECT_NE(program, 0);
+        EXPECT_NE(glGetUniformLocation(program, "ratio"), -1);
+        glDeleteProgram(program);
+        ASSERT_TRUE(cache.FindBinary(key, driverKey, binary));
+        EXPECT_NE(binary.data_, invalid.data_);
+    }
+
+    // The programs of the same sources are shared in a context.
+    ResourceCache *resCache = renderEnvironment->GetResourceCache();
+    ASSERT_NE(resCache, nullptr);
+    RenderGeneralProgram *shader = resCache->GetOrCreateShader(VS_CONTENT, FS_CONTENT);
+    ASSERT_NE(shader, nullptr);
+    EXPECT_EQ(resCache->GetOrCreateShader(VS_CONTENT, FS_CONTENT), shader);
+
+    renderEnvironment->ReleaseParam();
+    renderEnvironment->Release();
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
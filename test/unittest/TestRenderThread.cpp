@@ -0,0 +1,383 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "render_executor.h"
+#include "render_priority_queue.h"
+#include "render_ring_queue.h"
+#include "render_task.h"
+#include "render_thread.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+constexpr size_t QUEUE_SIZE = 8;
+constexpr int PRODUCER_NUM = 4;
+constexpr int TASK_NUM_PER_PRODUCER = 1000;
+constexpr size_t EXECUTOR_WORKER_NUM = 2;
+constexpr int STRAND_NUM = 4;
+constexpr uint32_t PARALLEL_TASK_NUM = 16;
+constexpr int BLOCK_TASK_TIME = 50;
+
+class TestRenderThread : public testing::Test {
+public:
+    TestRenderThread() = default;
+
+    ~TestRenderThread() override = default;
+    static void SetUpTestCase() {}
+
+    static void TearDownTestCase() {}
+
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+HWTEST_F(TestRenderThread, RenderRingQueue001, TestSize.Level1)
+{
+    RenderRingQueue<int> queue(3);
+    EXPECT_EQ(queue.GetCapacity(), 4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.Push(i));
+    }
+    EXPECT_FALSE(queue.Push(4));
+    EXPECT_EQ(queue.GetSize(), 4);
+
+    int data = -1;
+    EXPECT_TRUE(queue.Front(data));
+    EXPECT_EQ(data, 0);
+    EXPECT_TRUE(queue.Pop(data));
+    EXPECT_EQ(data, 0);
+    EXPECT_TRUE(queue.Push(4));
+}
+
+HWTEST_F(TestRenderThread, RenderRingQueue002, TestSize.Level1)
+{
+    RenderRingQueue<int> queue(QUEUE_SIZE);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(queue.Push(i));
+    }
+    queue.Remove([](int &data) { return data % 2 == 1; });
+    EXPECT_EQ(queue.GetSize(), 3);
+
+    std::vector<int> result;
+    int data = -1;
+    while (queue.Pop(data)) {
+        result.push_back(data);
+    }
+    EXPECT_EQ(result, std::vector<int>({ 0, 2, 4 }));
+
+    EXPECT_TRUE(queue.Push(1));
+    queue.RemoveAll();
+    EXPECT_EQ(queue.GetSize(), 0);
+    EXPECT_FALSE(queue.Pop(data));
+}
+
+HWTEST_F(TestRenderThread, RenderThread001, TestSize.Level1)
+{
+    RenderThread<> renderThread(QUEUE_SIZE);
+    renderThread.Start();
+
+    std::atomic<int> count = 0;
+    std::vector<std::thread> producers;
+    for (int i = 0; i < PRODUCER_NUM; ++i) {
+        producers.emplace_back([&renderThread, &count]() {
+            for (int j = 0; j < TASK_NUM_PER_PRODUCER; ++j) {
+                auto task = std::make_shared<RenderTask<>>([&count]() { count++; }, 0, j);
+                renderThread.AddTask(task);
+                task->Wait();
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    renderThread.WaitTaskFinished();
+    EXPECT_EQ(count.load(), PRODUCER_NUM * TASK_NUM_PER_PRODUCER);
+    renderThread.Stop();
+}
+
+HWTEST_F(TestRenderThread, RenderThread002, TestSize.Level1)
+{
+    RenderThread<> renderThread(QUEUE_SIZE);
+    renderThread.Start();
+
+    std::promise<void> blockPromise;
+    std::shared_future<void> blockFuture = blockPromise.get_future().share();
+    auto blockTask = std::make_shared<RenderTask<>>([blockFuture]() { blockFuture.wait(); }, 0, 0);
+    renderThread.AddTask(blockTask);
+
+    // The worker is busy and the queue fills up, AddTask must reject instead of waiting for space.
+    std::vector<std::shared_ptr<RenderTask<>>> tasks;
+    for (size_t i = 0; i < QUEUE_SIZE * 2; ++i) {
+        auto task = std::make_shared<RenderTask<>>([]() {}, 0, i + 1);
+        renderThread.AddTask(task);
+        tasks.push_back(task);
+    }
+    blockPromise.set_value();
+    for (auto &task : tasks) {
+        task->Wait();
+    }
+    renderThread.Stop();
+    renderThread.Start();
+    renderThread.Stop();
+}
+
+HWTEST_F(TestRenderThread, RenderThread003, TestSize.Level1)
+{
+    std::atomic<int> idleCount = 0;
+    RenderThread<> renderThread(QUEUE_SIZE, [&idleCount]() { idleCount++; });
+    renderThread.Start();
+
+    // The idle task runs once the thread has waited TIME_FOR_WAITING_TASK for work, not each time the queue drains.
+    for (int i = 0; i < TASK_NUM_PER_PRODUCER; ++i) {
+        auto task = std::make_shared<RenderTask<>>([]() {}, 0, i);
+        renderThread.AddTask(task);
+        task->Wait();
+    }
+    EXPECT_EQ(idleCount.load(), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(TIME_FOR_WAITING_TASK + BLOCK_TASK_TIME));
+    EXPECT_GE(idleCount.load(), 1);
+    renderThread.Stop();
+}
+
+HWTEST_F(TestRenderThread, RenderStrand001, TestSize.Level1)
+{
+    RenderExecutor executor(EXECUTOR_WORKER_NUM);
+    std::vector<std::shared_ptr<RenderStrand>> strands;
+    std::vector<std::vector<int>> results(STRAND_NUM);
+    for (int i = 0; i < STRAND_NUM; ++i) {
+        strands.push_back(executor.CreateStrand(QUEUE_SIZE));
+    }
+
+    // Tasks of one strand run in order while different strands share the workers.
+    std::vector<std::thread> producers;
+    for (int i = 0; i < STRAND_NUM; ++i) {
+        producers.emplace_back([&strands, &results, i]() {
+            for (int j = 0; j < TASK_NUM_PER_PRODUCER; ++j) {
+                auto task = std::make_shared<RenderTask<>>([&results, i, j]() { results[i].push_back(j); }, 0, j);
+                strands[i]->AddTask(task);
+                task->Wait();
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    for (int i = 0; i < STRAND_NUM; ++i) {
+        strands[i]->WaitTaskFinished();
+        ASSERT_EQ(results[i].size(), static_cast<size_t>(TASK_NUM_PER_PRODUCER));
+        for (int j = 0; j < TASK_NUM_PER_PRODUCER; ++j) {
+            EXPECT_EQ(results[i][j], j);
+        }
+        strands[i]->Stop();
+    }
+}
+
+HWTEST_F(TestRenderThread, RenderStrand002, TestSize.Level1)
+{
+    RenderExecutor executor(EXECUTOR_WORKER_NUM);
+    auto strand = executor.CreateStrand(QUEUE_SIZE);
+    EXPECT_FALSE(strand->IsPinned());
+
+    auto pinTask = std::make_shared<RenderTask<>>([]() { RenderExecutor::PinCurrentStrand(); }, 0, 0);
+    strand->AddTask(pinTask);
+    pinTask->Wait();
+    EXPECT_TRUE(strand->IsPinned());
+
+    // All later tasks of a pinned strand run on the thread which pinned it.
+    std::thread::id firstId;
+    std::thread::id secondId;
+    auto firstTask = std::make_shared<RenderTask<>>([&firstId]() { firstId = std::this_thread::get_id(); }, 0, 1);
+    strand->AddTask(firstTask);
+    auto secondTask = std::make_shared<RenderTask<>>([&secondId]() { secondId = std::this_thread::get_id(); }, 0, 2);
+    strand->AddTask(secondTask);
+    secondTask->Wait();
+    EXPECT_EQ(firstId, secondId);
+
+    strand->Stop();
+    std::atomic<bool> isRun = false;
+    auto rejectedTask = std::make_shared<RenderTask<>>([&isRun]() { isRun = true; }, 0, 3);
+    strand->AddTask(rejectedTask);
+    rejectedTask->Wait();
+    EXPECT_FALSE(isRun.load());
+}
+
+HWTEST_F(TestRenderThread, RenderPriorityQueue001, TestSize.Level1)
+{
+    RenderPriorityQueue<RenderCommonTaskPtr> queue;
+    auto now = std::chrono::steady_clock::now();
+    auto background = std::make_shared<RenderTask<>>([]() {}, 0, 0);
+    background->SetPriority(RenderTaskPriority::BACKGROUND);
+    auto preview = std::make_shared<RenderTask<>>([]() {}, 0, 1);
+    auto previewWithDeadline = std::make_shared<RenderTask<>>([]() {}, 0, 2);
+    previewWithDeadline->SetDeadline(now + std::chrono::seconds(1));
+    auto interactive = std::make_shared<RenderTask<>>([]() {}, 0, 3);
+    interactive->SetPriority(RenderTaskPriority::INTERACTIVE);
+    auto previewLater = std::make_shared<RenderTask<>>([]() {}, 0, 4);
+
+    EXPECT_TRUE(queue.Push(background));
+    EXPECT_TRUE(queue.Push(preview));
+    EXPECT_TRUE(queue.Push(previewWithDeadline));
+    EXPECT_TRUE(queue.Push(interactive));
+    EXPECT_TRUE(queue.Push(previewLater));
+    EXPECT_FALSE(queue.Push(nullptr));
+
+    queue.Remove([](RenderCommonTaskPtr &task) { return task->GetId() == 1; });
+    std::vector<uint64_t> result;
+    RenderCommonTaskPtr task = nullptr;
+    while (queue.Pop(task)) {
+        result.push_back(task->GetId());
+    }
+    EXPECT_EQ(result, std::vector<uint64_t>({ 3, 2, 4, 0 }));
+}
+
+HWTEST_F(TestRenderThread, RenderStrand003, TestSize.Level1)
+{
+    RenderExecutor executor(EXECUTOR_WORKER_NUM);
+    auto strand = executor.CreateStrand(QUEUE_SIZE);
+
+    std::promise<void> blockPromise;
+    std::shared_future<void> blockFuture = blockPromise.get_future().share();
+    auto blockTask = std::make_shared<RenderTask<>>([blockFuture]() { blockFuture.wait(); }, 0, 0);
+    strand->AddTask(blockTask);
+
+    // Queued behind the busy worker: the expired frame is dropped and only the latest coalescing frame is rendered.
+    std::atomic<int> runNum = 0;
+    auto expiredTask = std::make_shared<RenderTask<>>([&runNum]() { runNum++; }, 1, 1);
+    expiredTask->SetDeadline(std::chrono::steady_clock::now());
+    strand->AddTask(expiredTask);
+
+    std::vector<std::shared_ptr<RenderTask<>>> frames;
+    for (uint64_t i = 0; i < QUEUE_SIZE / 2; ++i) {
+        auto frame = std::make_shared<RenderTask<>>([&runNum]() { runNum++; }, 2, i + 2);
+        frame->SetCoalesce(true);
+        strand->AddTask(frame);
+        frames.push_back(frame);
+    }
+    blockPromise.set_value();
+    for (auto &frame : frames) {
+        frame->Wait();
+    }
+    expiredTask->Wait();
+    strand->WaitTaskFinished();
+    EXPECT_EQ(runNum.load(), 1);
+    strand->Stop();
+}
+
+HWTEST_F(TestRenderThread, RenderStrand004, TestSize.Level1)
+{
+    RenderExecutor executor(EXECUTOR_WORKER_NUM);
+    auto strand = executor.CreateStrand(QUEUE_SIZE);
+
+    // Waiting from a task of the same strand returns instead of waiting for itself.
+    auto selfWaitTask = std::make_shared<RenderTask<>>([&strand]() { strand->WaitTaskFinished(); }, 0, 0);
+    strand->AddTask(selfWaitTask);
+    selfWaitTask->Wait();
+
+    // Stop returns only after the running task is finished, however long it takes.
+    std::promise<void> startPromise;
+    std::future<void> startFuture = startPromise.get_future();
+    std::promise<void> blockPromise;
+    std::shared_future<void> blockFuture = blockPromise.get_future().share();
+    std::atomic<bool> isFinished = false;
+    auto blockTask = std::make_shared<RenderTask<>>([&startPromise, blockFuture, &isFinished]() {
+        startPromise.set_value();
+        blockFuture.wait();
+        std::this_thread::sleep_for(std::chrono::milliseconds(BLOCK_TASK_TIME));
+        isFinished = true;
+    }, 0, 1);
+    strand->AddTask(blockTask);
+    startFuture.wait();
+    std::thread releaser([&blockPromise]() { blockPromise.set_value(); });
+    strand->Stop();
+    EXPECT_TRUE(isFinished.load());
+    releaser.join();
+}
+
+HWTEST_F(TestRenderThread, RenderStrand005, TestSize.Level1)
+{
+    RenderExecutor executor(1);
+    auto busyStrand = executor.CreateStrand(QUEUE_SIZE);
+    auto backgroundStrand = executor.CreateStrand(QUEUE_SIZE);
+    auto interactiveStrand = executor.CreateStrand(QUEUE_SIZE);
+
+    std::promise<void> startPromise;
+    std::future<void> startFuture = startPromise.get_future();
+    std::promise<void> blockPromise;
+    std::shared_future<void> blockFuture = blockPromise.get_future().share();
+    auto blockTask = std::make_shared<RenderTask<>>([&startPromise, blockFuture]() {
+        startPromise.set_value();
+        blockFuture.wait();
+    }, 0, 0);
+    busyStrand->AddTask(blockTask);
+    startFuture.wait();
+
+    // Across effects the strand whose next task is the most urgent runs first, not the one scheduled first.
+    std::vector<int> order;
+    auto backgroundTask = std::make_shared<RenderTask<>>([&order]() { order.push_back(1); }, 1, 1);
+    backgroundTask->SetPriority(RenderTaskPriority::BACKGROUND);
+    backgroundStrand->AddTask(backgroundTask);
+    auto interactiveTask = std::make_shared<RenderTask<>>([&order]() { order.push_back(0); }, 2, 2);
+    interactiveTask->SetPriority(RenderTaskPriority::INTERACTIVE);
+    interactiveStrand->AddTask(interactiveTask);
+    blockPromise.set_value();
+    backgroundTask->Wait();
+    interactiveTask->Wait();
+    ASSERT_EQ(order.size(), 2);
+    EXPECT_EQ(order[0], 0);
+    EXPECT_EQ(order[1], 1);
+
+    busyStrand->Stop();
+    backgroundStrand->Stop();
+    interactiveStrand->Stop();
+}
+
+HWTEST_F(TestRenderThread, ParallelFor001, TestSize.Level1)
+{
+    RenderExecutor executor(EXECUTOR_WORKER_NUM);
+    std::vector<std::atomic<int>> runNums(PARALLEL_TASK_NUM);
+    executor.ParallelFor(PARALLEL_TASK_NUM, [&runNums](uint32_t task) { runNums[task]++; });
+    for (uint32_t i = 0; i < PARALLEL_TASK_NUM; ++i) {
+        EXPECT_EQ(runNums[i].load(), 1);
+    }
+
+    // Called from a task of a strand while the workers are busy, the calling thread runs the tasks left.
+    auto strand = executor.CreateStrand(QUEUE_SIZE);
+    std::atomic<uint32_t> total = 0;
+    auto task = std::make_shared<RenderTask<>>([&executor, &total]() {
+        executor.ParallelFor(PARALLEL_TASK_NUM, [&executor, &total](uint32_t) {
+            executor.ParallelFor(PARALLEL_TASK_NUM, [&total](uint32_t) { total++; });
+        });
+    }, 0, 0);
+    strand->AddTask(task);
+    task->Wait();
+    EXPECT_EQ(total.load(), PARALLEL_TASK_NUM * PARALLEL_TASK_NUM);
+    strand->Stop();
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
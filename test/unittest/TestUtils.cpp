@@ -15,6 +15,10 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include "native_common_utils.h"
 #include "effect_json_helper.h"
 #include "common_utils.h"
@@ -22,6 +26,7 @@
 #include "format_helper.h"
 #include "native_effect_base.h"
 #include "memcpy_helper.h"
+#include "region_helper.h"
 #include "event_report.h"
 #include "mock_producer_surface.h"
 #include "cJSON.h"
@@ -307,6 +312,47 @@ HWTEST_F(TestUtils, NativeCommonUtilsModifyPixelMapProperty001, TestSize.Level1)
     ErrorCode result = CommonUtils::ModifyPixelMapProperty(&pixelMap, buffer, context);
     EXPECT_EQ(result, ErrorCode::ERR_ALLOC_MEMORY_FAIL);
 }
+HWTEST_F(TestUtils, CommonUtilsIsBufferAdoptable001, TestSize.Level1)
+{
+    InitializationOptions options;
+    options.size.width = static_cast<int32_t>(WIDTH);
+    options.size.height = static_cast<int32_t>(HEIGHT);
+    options.pixelFormat = PixelFormat::RGBA_8888;
+    options.allocatorType = AllocatorType::HEAP_ALLOC;
+    std::unique_ptr<PixelMap> pixelMap = PixelMap::Create(options);
+    ASSERT_NE(pixelMap, nullptr);
+
+    std::shared_ptr<EffectContext> context = std::make_shared<EffectContext>();
+    context->memoryManager_ = std::make_shared<EffectMemoryManager>();
+    context->memoryManager_->SetIPType(IPType::CPU);
+    MemoryInfo memoryInfo;
+    memoryInfo.bufferInfo.width_ = WIDTH;
+    memoryInfo.bufferInfo.height_ = HEIGHT;
+    memoryInfo.bufferInfo.formatType_ = IEffectFormat::RGBA8888;
+    memoryInfo.bufferInfo.rowStride_ = WIDTH * RGBA_BYTES_PER_PIXEL;
+    memoryInfo.bufferInfo.len_ = WIDTH * HEIGHT * RGBA_BYTES_PER_PIXEL;
+    MemoryData *memoryData = context->memoryManager_->AllocMemory(nullptr, memoryInfo);
+    ASSERT_NE(memoryData, nullptr);
+
+    std::shared_ptr<BufferInfo> bufferInfo = std::make_shared<BufferInfo>(memoryInfo.bufferInfo);
+    std::shared_ptr<ExtraInfo> extraInfo = std::make_shared<ExtraInfo>();
+    extraInfo->dataType = DataType::PIXEL_MAP;
+    extraInfo->bufferType = BufferType::HEAP_MEMORY;
+    std::shared_ptr<EffectBuffer> buffer = std::make_shared<EffectBuffer>(bufferInfo, memoryData->data, extraInfo);
+    void *addr = memoryData->data;
+
+    // The memory of the user is not handed over.
+    std::shared_ptr<EffectBuffer> userBuffer = std::make_shared<EffectBuffer>(bufferInfo,
+        const_cast<uint8_t *>(pixelMap->GetPixels()), extraInfo);
+    EXPECT_FALSE(CommonUtils::IsBufferAdoptable(pixelMap.get(), userBuffer, context));
+
+    // The pixel map takes the intermediate memory over, which is no longer reused by the memory manager.
+    ASSERT_TRUE(CommonUtils::IsBufferAdoptable(pixelMap.get(), buffer, context));
+    EXPECT_EQ(CommonUtils::ModifyPixelMapProperty(pixelMap.get(), buffer, context), ErrorCode::SUCCESS);
+    EXPECT_EQ(pixelMap->GetPixels(), addr);
+    EXPECT_EQ(context->memoryManager_->GetAllocMemoryByAddr(addr), nullptr);
+}
+
 HWTEST_F(TestUtils, StringHelper001, TestSize.Level1) {
     std::string input = "abc";
     std::string suffix = "abcd";
@@ -467,6 +513,67 @@ HWTEST_F(TestUtils, MemcpyHelperCopyData002, TestSize.Level1)
     EXPECT_EQ(src.get(), dst.get());
 }
 
+static CopyInfo CreateCopyInfo(std::vector<uint8_t> &data, uint32_t height, IEffectFormat format, uint32_t padding)
+{
+    CopyInfo info;
+    info.bufferInfo.width_ = WIDTH;
+    info.bufferInfo.height_ = height;
+    info.bufferInfo.formatType_ = format;
+    info.bufferInfo.rowStride_ = FormatHelper::CalculateRowStride(WIDTH, format) + padding;
+    info.bufferInfo.len_ = info.bufferInfo.rowStride_ * FormatHelper::CalculateDataRowCount(height, format);
+    data.resize(info.bufferInfo.len_);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i % UINT8_MAX);
+    }
+    info.data = data.data();
+    return info;
+}
+
+HWTEST_F(TestUtils, MemcpyHelperCopyData003, TestSize.Level1)
+{
+    // Large enough to be split among the render workers and written with non-temporal stores.
+    constexpr uint32_t height = HEIGHT * 4;
+    constexpr uint32_t padding = 64;
+    std::vector<uint8_t> srcData;
+    std::vector<uint8_t> dstData;
+    CopyInfo src = CreateCopyInfo(srcData, height, IEffectFormat::RGBA8888, 0);
+    CopyInfo dst = CreateCopyInfo(dstData, height, IEffectFormat::RGBA8888, padding);
+    std::fill(dstData.begin(), dstData.end(), 0);
+
+    uint64_t copiedBytes = MemcpyHelper::GetCopiedBytes();
+    MemcpyHelper::CopyData(src, dst);
+    uint32_t rowBytes = WIDTH * RGBA_BYTES_PER_PIXEL;
+    EXPECT_EQ(MemcpyHelper::GetCopiedBytes() - copiedBytes, static_cast<uint64_t>(rowBytes) * height);
+    for (uint32_t row = 0; row < height; ++row) {
+        ASSERT_EQ(memcmp(srcData.data() + row * src.bufferInfo.rowStride_,
+            dstData.data() + row * dst.bufferInfo.rowStride_, rowBytes), 0);
+        // The padding of the destination is left untouched.
+        ASSERT_EQ(dstData[row * dst.bufferInfo.rowStride_ + rowBytes], 0);
+    }
+
+    CopyInfo same = CreateCopyInfo(dstData, height, IEffectFormat::RGBA8888, 0);
+    MemcpyHelper::CopyData(src, same);
+    EXPECT_EQ(srcData, dstData);
+}
+
+HWTEST_F(TestUtils, MemcpyHelperCopyData004, TestSize.Level1)
+{
+    // The chroma plane starts right after the luma plane, which differs when the heights differ.
+    constexpr uint32_t srcHeight = HEIGHT;
+    constexpr uint32_t dstHeight = HEIGHT / 2;
+    constexpr uint32_t padding = 32;
+    std::vector<uint8_t> srcData;
+    std::vector<uint8_t> dstData;
+    CopyInfo src = CreateCopyInfo(srcData, srcHeight, IEffectFormat::YUVNV12, padding);
+    CopyInfo dst = CreateCopyInfo(dstData, dstHeight, IEffectFormat::YUVNV12, 0);
+
+    MemcpyHelper::CopyData(src, dst);
+    uint32_t srcStride = src.bufferInfo.rowStride_;
+    EXPECT_EQ(memcmp(srcData.data() + (dstHeight - 1) * srcStride, dstData.data() + (dstHeight - 1) * WIDTH, WIDTH),
+        0);
+    EXPECT_EQ(memcmp(srcData.data() + srcHeight * srcStride, dstData.data() + dstHeight * WIDTH, WIDTH), 0);
+}
+
 HWTEST_F(TestUtils, NativeCommonUtilsSwitchToOHEffectInfo001, TestSize.Level1)
 {
     EffectInfo effectInfo;
@@ -696,6 +803,34 @@ HWTEST_F(TestUtils, CommonUtilsParsePicture002, TestSize.Level1)
     ErrorCode result = CommonUtils::ParsePicture(g_picture.get(), testEffectBuffer);
     EXPECT_EQ(result, ErrorCode::SUCCESS);
 }
+
+HWTEST_F(TestUtils, RegionHelperGetRenderROI001, TestSize.Level1)
+{
+    constexpr uint32_t size = 100;
+    std::map<std::string, Any> values;
+    std::shared_ptr<EffectContext> context = std::make_shared<EffectContext>();
+    ASSERT_TRUE(RegionHelper::GetRenderROI(values, context, size, size).IsFullFrame());
+
+    // The corners are sorted and clamped, then intersected with the region of the image effect.
+    values["FilterRegion"] = RenderRegion{ -10, 80, 50, 20 };
+    context->renderRegion_ = std::make_shared<RenderRegion>(RenderRegion{ 40, 0, 100, 100 });
+    RenderROI roi = RegionHelper::GetRenderROI(values, context, size, size);
+    EXPECT_EQ(roi.Left(), 40);
+    EXPECT_EQ(roi.Right(), 50);
+    EXPECT_EQ(roi.Bottom(), 20);
+    EXPECT_EQ(roi.Top(), 80);
+
+    values["FilterRegion"] = RenderRegion{ 11, 11, 51, 51 };
+    context->renderRegion_ = nullptr;
+    roi = RegionHelper::GetRenderROI(values, context, size, size, true);
+    EXPECT_EQ(roi.Left(), 10);
+    EXPECT_EQ(roi.Right(), 52);
+    EXPECT_EQ(roi.Bottom(), 10);
+    EXPECT_EQ(roi.Top(), 52);
+
+    context->renderRegion_ = std::make_shared<RenderRegion>(RenderRegion{ 60, 0, 100, 100 });
+    EXPECT_TRUE(RegionHelper::GetRenderROI(values, context, size, size).IsEmpty());
+}
 }
 }
 }
@@ -14,6 +14,11 @@
  */
 
 #include "image_effect_capi_unittest.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
 #include "image_effect.h"
 #include "image_effect_filter.h"
 #include "pixelmap_native_impl.h"
@@ -43,6 +48,158 @@ namespace {
 namespace OHOS {
 namespace Media {
 namespace Effect {
+namespace {
+constexpr int32_t RENDER_TEST_WIDTH = 64;
+constexpr int32_t RENDER_TEST_HEIGHT = 48;
+constexpr uint8_t SRC_PIXEL_VALUE = 0x5A;
+constexpr uint8_t DST_PIXEL_VALUE = 0xA5;
+// Large enough to be split into several regions.
+constexpr int32_t REGION_TEST_WIDTH = 1024;
+constexpr int32_t REGION_TEST_HEIGHT = 1030;
+constexpr int32_t REGION_TEST_ODD_HEIGHT = 1023;
+
+// The render callbacks are plain function pointers, so they write what they get here.
+struct RenderRecord {
+    std::mutex mutex;
+    uint32_t renderCount = 0;
+    uint32_t renderWithDstCount = 0;
+    void *renderAddr = nullptr;
+    void *srcAddr = nullptr;
+    void *dstAddr = nullptr;
+    bool isSrcIntact = true;
+    bool isDstPreCopied = false;
+    uint32_t regionCount = 0;
+    bool isRegionValid = true;
+    std::vector<uint32_t> rowCounts;
+
+    void Reset(int32_t rowNum = 0)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        renderCount = 0;
+        renderWithDstCount = 0;
+        renderAddr = nullptr;
+        srcAddr = nullptr;
+        dstAddr = nullptr;
+        isSrcIntact = true;
+        isDstPreCopied = false;
+        regionCount = 0;
+        isRegionValid = true;
+        rowCounts.assign(static_cast<size_t>(rowNum), 0);
+    }
+};
+RenderRecord g_renderRecord;
+
+bool IsFilledWith(const uint8_t *pixels, size_t len, uint8_t value)
+{
+    return std::all_of(pixels, pixels + len, [value](uint8_t pixel) { return pixel == value; });
+}
+
+uint8_t *GetPixels(OH_PixelmapNative *pixelmap)
+{
+    return const_cast<uint8_t *>(pixelmap->pixelmap_->GetPixels());
+}
+
+size_t GetPixelsLen(OH_PixelmapNative *pixelmap)
+{
+    return static_cast<size_t>(pixelmap->pixelmap_->GetRowStride()) *
+        static_cast<size_t>(pixelmap->pixelmap_->GetHeight());
+}
+
+std::shared_ptr<OH_PixelmapNative> CreateFilledPixelmap(int32_t width, int32_t height, PixelFormat format,
+    uint8_t value)
+{
+    InitializationOptions options;
+    options.size.width = width;
+    options.size.height = height;
+    options.pixelFormat = format;
+    options.allocatorType = AllocatorType::HEAP_ALLOC;
+    std::unique_ptr<PixelMap> pixelMap = PixelMap::Create(options);
+    if (pixelMap == nullptr) {
+        return nullptr;
+    }
+    std::fill_n(const_cast<uint8_t *>(pixelMap->GetPixels()), pixelMap->GetByteCount(), value);
+    std::shared_ptr<OH_PixelmapNative> pixelmapNative = std::make_shared<OH_PixelmapNative>(nullptr);
+    pixelmapNative->pixelmap_ = std::move(pixelMap);
+    return pixelmapNative;
+}
+
+bool RecordRender(OH_EffectFilter *filter, OH_EffectBufferInfo *src, OH_EffectFilterDelegate_PushData pushData)
+{
+    g_renderRecord.renderCount++;
+    (void)OH_EffectBufferInfo_GetAddr(src, &g_renderRecord.renderAddr);
+    pushData(filter, src);
+    return true;
+}
+
+bool RecordRenderWithDst(OH_EffectFilter *filter, OH_EffectBufferInfo *src, OH_EffectBufferInfo *dst)
+{
+    int32_t height = 0;
+    int32_t rowSize = 0;
+    (void)OH_EffectBufferInfo_GetHeight(dst, &height);
+    (void)OH_EffectBufferInfo_GetRowSize(dst, &rowSize);
+    (void)OH_EffectBufferInfo_GetAddr(src, &g_renderRecord.srcAddr);
+    (void)OH_EffectBufferInfo_GetAddr(dst, &g_renderRecord.dstAddr);
+    size_t len = static_cast<size_t>(rowSize) * static_cast<size_t>(height);
+    uint8_t *srcPixels = static_cast<uint8_t *>(g_renderRecord.srcAddr);
+    uint8_t *dstPixels = static_cast<uint8_t *>(g_renderRecord.dstAddr);
+
+    g_renderRecord.renderWithDstCount++;
+    g_renderRecord.isSrcIntact = IsFilledWith(srcPixels, len, SRC_PIXEL_VALUE);
+    g_renderRecord.isDstPreCopied = srcPixels != dstPixels && IsFilledWith(dstPixels, len, SRC_PIXEL_VALUE);
+    std::fill_n(dstPixels, len, DST_PIXEL_VALUE);
+    return true;
+}
+
+bool RecordRenderRegion(OH_EffectFilter *filter, const OH_EffectBufferInfo *src, OH_EffectBufferInfo *dst,
+    const ImageEffect_Region *region)
+{
+    int32_t width = 0;
+    int32_t height = 0;
+    int32_t rowSize = 0;
+    (void)OH_EffectBufferInfo_GetWidth(dst, &width);
+    (void)OH_EffectBufferInfo_GetHeight(dst, &height);
+    (void)OH_EffectBufferInfo_GetRowSize(dst, &rowSize);
+
+    std::lock_guard<std::mutex> lock(g_renderRecord.mutex);
+    (void)OH_EffectBufferInfo_GetAddr(const_cast<OH_EffectBufferInfo *>(src), &g_renderRecord.srcAddr);
+    (void)OH_EffectBufferInfo_GetAddr(dst, &g_renderRecord.dstAddr);
+    g_renderRecord.regionCount++;
+    // Whole rows with even boundaries, only the last region may end at an odd height.
+    bool isValid = region->x0 == 0 && region->x1 == width && region->y0 >= 0 && region->y0 < region->y1 &&
+        region->y1 <= height && region->y0 % 2 == 0 && (region->y1 % 2 == 0 || region->y1 == height) &&
+        static_cast<size_t>(height) == g_renderRecord.rowCounts.size();
+    g_renderRecord.isRegionValid = g_renderRecord.isRegionValid && isValid;
+    if (!isValid) {
+        return false;
+    }
+
+    uint8_t *srcPixels = static_cast<uint8_t *>(g_renderRecord.srcAddr);
+    uint8_t *dstPixels = static_cast<uint8_t *>(g_renderRecord.dstAddr);
+    for (int32_t row = region->y0; row < region->y1; ++row) {
+        size_t offset = static_cast<size_t>(row) * static_cast<size_t>(rowSize);
+        g_renderRecord.rowCounts[row]++;
+        g_renderRecord.isSrcIntact = g_renderRecord.isSrcIntact &&
+            IsFilledWith(srcPixels + offset, static_cast<size_t>(rowSize), SRC_PIXEL_VALUE);
+        std::fill_n(dstPixels + offset, rowSize, DST_PIXEL_VALUE);
+    }
+    return true;
+}
+
+bool IsEveryRowRenderedOnce()
+{
+    return std::all_of(g_renderRecord.rowCounts.begin(), g_renderRecord.rowCounts.end(),
+        [](uint32_t count) { return count == 1; });
+}
+
+// The filter keeps the pointer of the delegate, so it has to outlive the registered filters.
+ImageEffect_FilterDelegate g_recordDelegate = {
+    .setValue = [](OH_EffectFilter *filter, const char *key, const ImageEffect_Any *value) { return true; },
+    .render = RecordRender,
+    .save = [](OH_EffectFilter *filter, char **info) { return true; },
+    .restore = [](const char *info) -> OH_EffectFilter * { return nullptr; }
+};
+} // namespace
+
 void ImageEffectCApiUnittest::SetUpTestCase()
 {
     g_jpgHdrPath = std::string("/data/test/resource/image_effect_hdr_test1.jpg");
@@ -67,11 +224,11 @@ void ImageEffectCApiUnittest::SetUp()
     mockPixelMap_ = std::make_shared<MockPixelMap>();
     pixelmapNative_ = new OH_PixelmapNative(mockPixelMap_);
     ExternLoader::Instance()->InitExt();
-    EFilterFactory::Instance()->functions_.clear();
+    EFilterFactory::Instance()->ClearFunctions();
     EFilterFactory::Instance()->RegisterEFilter<BrightnessEFilter>(BRIGHTNESS_EFILTER);
     EFilterFactory::Instance()->RegisterEFilter<ContrastEFilter>(CONTRAST_EFILTER);
     EFilterFactory::Instance()->RegisterEFilter<CropEFilter>(CROP_EFILTER);
-    EFilterFactory::Instance()->delegates_.clear();
+    EFilterFactory::Instance()->ClearDelegates();
     filterInfo_ = OH_EffectFilterInfo_Create();
     OH_EffectFilterInfo_SetFilterName(filterInfo_, BRIGHTNESS_EFILTER);
     ImageEffect_BufferType bufferTypes[] = { ImageEffect_BufferType::EFFECT_BUFFER_TYPE_PIXEL };
@@ -1819,6 +1976,433 @@ HWTEST_F(ImageEffectCApiUnittest, OHEFilterRegister004, TestSize.Level1)
     GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterRegister004 END";
 }
 
+/**
+ * Feature: ImageEffect
+ * Function: Test OH_EffectFilterInfo_SetRenderMode and OH_EffectFilterInfo_GetRenderMode
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test OH_EffectFilterInfo_SetRenderMode and OH_EffectFilterInfo_GetRenderMode
+ */
+HWTEST_F(ImageEffectCApiUnittest, OHEFilterInfoRenderMode001, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterInfoRenderMode001 start";
+
+    ImageEffect_RenderMode renderMode = ImageEffect_RenderMode::EFFECT_RENDER_MODE_SRC_TO_DST;
+    ImageEffect_ErrorCode errorCode = OH_EffectFilterInfo_GetRenderMode(filterInfo_, &renderMode);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    ASSERT_EQ(renderMode, ImageEffect_RenderMode::EFFECT_RENDER_MODE_IN_PLACE);
+
+    errorCode = OH_EffectFilterInfo_SetRenderMode(filterInfo_,
+        ImageEffect_RenderMode::EFFECT_RENDER_MODE_SRC_TO_DST_OR_IN_PLACE);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    errorCode = OH_EffectFilterInfo_GetRenderMode(filterInfo_, &renderMode);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    ASSERT_EQ(renderMode, ImageEffect_RenderMode::EFFECT_RENDER_MODE_SRC_TO_DST_OR_IN_PLACE);
+
+    GTEST_LOG_(INFO) << "OHEFilterInfoRenderMode001 success! result: " << errorCode;
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterInfoRenderMode001 END";
+}
+
+/**
+ * Feature: ImageEffect
+ * Function: Test OH_EffectFilterInfo_SetRenderMode and OH_EffectFilterInfo_GetRenderMode with abnormal parameter
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test OH_EffectFilterInfo_SetRenderMode and OH_EffectFilterInfo_GetRenderMode with abnormal parameter
+ */
+HWTEST_F(ImageEffectCApiUnittest, OHEFilterInfoRenderMode002, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterInfoRenderMode002 start";
+
+    ImageEffect_ErrorCode errorCode = OH_EffectFilterInfo_SetRenderMode(nullptr,
+        ImageEffect_RenderMode::EFFECT_RENDER_MODE_SRC_TO_DST);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID);
+    errorCode = OH_EffectFilterInfo_SetRenderMode(filterInfo_, static_cast<ImageEffect_RenderMode>(-1));
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID);
+    errorCode = OH_EffectFilterInfo_GetRenderMode(filterInfo_, nullptr);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID);
+
+    GTEST_LOG_(INFO) << "OHEFilterInfoRenderMode002 success! result: " << errorCode;
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterInfoRenderMode002 END";
+}
+
+/**
+ * Feature: ImageEffect
+ * Function: Test OH_EffectFilter_RegisterWithDstRender
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test OH_EffectFilter_RegisterWithDstRender with null and normal render callback
+ */
+HWTEST_F(ImageEffectCApiUnittest, OHEFilterRegisterWithDstRender001, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterRegisterWithDstRender001 start";
+
+    ImageEffect_FilterDelegate delegate = {
+        .setValue = [](OH_EffectFilter *filter, const char *key, const ImageEffect_Any *value) { return true; },
+        .render = [](OH_EffectFilter *filter, OH_EffectBufferInfo *src, OH_EffectFilterDelegate_PushData pushData) {
+            pushData(filter, src);
+            return true;
+        },
+        .save = [](OH_EffectFilter *filter, char **info) { return true; },
+        .restore = [](const char *info) { return OH_EffectFilter_Create("CustomDstRenderEFilter"); }
+    };
+    OH_EffectFilterInfo_SetFilterName(filterInfo_, "CustomDstRenderEFilter");
+    OH_EffectFilterInfo_SetRenderMode(filterInfo_, ImageEffect_RenderMode::EFFECT_RENDER_MODE_SRC_TO_DST);
+
+    ImageEffect_ErrorCode errorCode = OH_EffectFilter_RegisterWithDstRender(filterInfo_, &delegate, nullptr);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID);
+
+    OH_EffectFilterDelegate_RenderWithDst renderWithDst = [](OH_EffectFilter *filter, OH_EffectBufferInfo *src,
+        OH_EffectBufferInfo *dst) { return true; };
+    errorCode = OH_EffectFilter_RegisterWithDstRender(filterInfo_, &delegate, renderWithDst);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS) <<
+        "OHEFilterRegisterWithDstRender001 OH_EffectFilter_RegisterWithDstRender failed";
+
+    GTEST_LOG_(INFO) << "OHEFilterRegisterWithDstRender001 success! result: " << errorCode;
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterRegisterWithDstRender001 END";
+}
+
+/**
+ * Feature: ImageEffect
+ * Function: Test OH_EffectFilterInfo_SetRenderHalo and OH_EffectFilterInfo_GetRenderHalo
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test OH_EffectFilterInfo_SetRenderHalo and OH_EffectFilterInfo_GetRenderHalo
+ */
+HWTEST_F(ImageEffectCApiUnittest, OHEFilterInfoRenderHalo001, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterInfoRenderHalo001 start";
+
+    uint32_t halo = 1;
+    ImageEffect_ErrorCode errorCode = OH_EffectFilterInfo_GetRenderHalo(filterInfo_, &halo);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    ASSERT_EQ(halo, 0u);
+
+    errorCode = OH_EffectFilterInfo_SetRenderHalo(filterInfo_, 2);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    errorCode = OH_EffectFilterInfo_GetRenderHalo(filterInfo_, &halo);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    ASSERT_EQ(halo, 2u);
+
+    errorCode = OH_EffectFilterInfo_SetRenderHalo(nullptr, 2);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID);
+    errorCode = OH_EffectFilterInfo_GetRenderHalo(filterInfo_, nullptr);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID);
+
+    GTEST_LOG_(INFO) << "OHEFilterInfoRenderHalo001 success! result: " << errorCode;
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterInfoRenderHalo001 END";
+}
+
+/**
+ * Feature: ImageEffect
+ * Function: Test OH_EffectFilter_RegisterWithRegionRender
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test OH_EffectFilter_RegisterWithRegionRender with null and normal render callback
+ */
+HWTEST_F(ImageEffectCApiUnittest, OHEFilterRegisterWithRegionRender001, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterRegisterWithRegionRender001 start";
+
+    ImageEffect_FilterDelegate delegate = {
+        .setValue = [](OH_EffectFilter *filter, const char *key, const ImageEffect_Any *value) { return true; },
+        .render = [](OH_EffectFilter *filter, OH_EffectBufferInfo *src, OH_EffectFilterDelegate_PushData pushData) {
+            pushData(filter, src);
+            return true;
+        },
+        .save = [](OH_EffectFilter *filter, char **info) { return true; },
+        .restore = [](const char *info) { return OH_EffectFilter_Create("CustomRegionRenderEFilter"); }
+    };
+    OH_EffectFilterInfo_SetFilterName(filterInfo_, "CustomRegionRenderEFilter");
+    OH_EffectFilterInfo_SetRenderHalo(filterInfo_, 1);
+
+    ImageEffect_ErrorCode errorCode = OH_EffectFilter_RegisterWithRegionRender(filterInfo_, &delegate, nullptr);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID);
+
+    OH_EffectFilterDelegate_RenderRegion renderRegion = [](OH_EffectFilter *filter, const OH_EffectBufferInfo *src,
+        OH_EffectBufferInfo *dst, const ImageEffect_Region *region) { return true; };
+    errorCode = OH_EffectFilter_RegisterWithRegionRender(filterInfo_, &delegate, renderRegion);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS) <<
+        "OHEFilterRegisterWithRegionRender001 OH_EffectFilter_RegisterWithRegionRender failed";
+
+    GTEST_LOG_(INFO) << "OHEFilterRegisterWithRegionRender001 success! result: " << errorCode;
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterRegisterWithRegionRender001 END";
+}
+
+/**
+ * Feature: ImageEffect
+ * Function: Test OH_EffectFilter_Render with the dst render callback in src to dst mode
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: The callback gets the input and the output pixels, the output is not copied from the input first
+ */
+HWTEST_F(ImageEffectCApiUnittest, OHEFilterRenderWithDst001, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterRenderWithDst001 start";
+
+    g_renderRecord.Reset();
+    OH_EffectFilterInfo_SetFilterName(filterInfo_, "CustomSrcToDstEFilter");
+    OH_EffectFilterInfo_SetRenderMode(filterInfo_, ImageEffect_RenderMode::EFFECT_RENDER_MODE_SRC_TO_DST);
+    ImageEffect_ErrorCode errorCode = OH_EffectFilter_RegisterWithDstRender(filterInfo_, &g_recordDelegate,
+        RecordRenderWithDst);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+
+    std::shared_ptr<OH_PixelmapNative> input = CreateFilledPixelmap(RENDER_TEST_WIDTH, RENDER_TEST_HEIGHT,
+        PixelFormat::RGBA_8888, SRC_PIXEL_VALUE);
+    std::shared_ptr<OH_PixelmapNative> output = CreateFilledPixelmap(RENDER_TEST_WIDTH, RENDER_TEST_HEIGHT,
+        PixelFormat::RGBA_8888, 0);
+    ASSERT_NE(input, nullptr);
+    ASSERT_NE(output, nullptr);
+    OH_EffectFilter *filter = OH_EffectFilter_Create("CustomSrcToDstEFilter");
+    ASSERT_NE(filter, nullptr);
+
+    errorCode = OH_EffectFilter_Render(filter, input.get(), output.get());
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    EXPECT_EQ(g_renderRecord.renderWithDstCount, 1u);
+    EXPECT_EQ(g_renderRecord.renderCount, 0u);
+    EXPECT_EQ(g_renderRecord.srcAddr, GetPixels(input.get()));
+    EXPECT_EQ(g_renderRecord.dstAddr, GetPixels(output.get()));
+    EXPECT_TRUE(g_renderRecord.isSrcIntact);
+    EXPECT_FALSE(g_renderRecord.isDstPreCopied);
+    EXPECT_TRUE(IsFilledWith(GetPixels(output.get()), GetPixelsLen(output.get()), DST_PIXEL_VALUE));
+    EXPECT_TRUE(IsFilledWith(GetPixels(input.get()), GetPixelsLen(input.get()), SRC_PIXEL_VALUE));
+
+    errorCode = OH_EffectFilter_Release(filter);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterRenderWithDst001 END";
+}
+
+/**
+ * Feature: ImageEffect
+ * Function: Test OH_EffectFilter_Render with the dst render callback in src to dst mode on one pixelmap
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: The filter can not run in place, so the callback reads a copy of the input and writes the pixelmap
+ */
+HWTEST_F(ImageEffectCApiUnittest, OHEFilterRenderWithDst002, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterRenderWithDst002 start";
+
+    g_renderRecord.Reset();
+    OH_EffectFilterInfo_SetFilterName(filterInfo_, "CustomSrcToDstEFilter");
+    OH_EffectFilterInfo_SetRenderMode(filterInfo_, ImageEffect_RenderMode::EFFECT_RENDER_MODE_SRC_TO_DST);
+    ImageEffect_ErrorCode errorCode = OH_EffectFilter_RegisterWithDstRender(filterInfo_, &g_recordDelegate,
+        RecordRenderWithDst);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+
+    std::shared_ptr<OH_PixelmapNative> pixelmap = CreateFilledPixelmap(RENDER_TEST_WIDTH, RENDER_TEST_HEIGHT,
+        PixelFormat::RGBA_8888, SRC_PIXEL_VALUE);
+    ASSERT_NE(pixelmap, nullptr);
+    OH_EffectFilter *filter = OH_EffectFilter_Create("CustomSrcToDstEFilter");
+    ASSERT_NE(filter, nullptr);
+
+    errorCode = OH_EffectFilter_Render(filter, pixelmap.get(), pixelmap.get());
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    EXPECT_EQ(g_renderRecord.renderWithDstCount, 1u);
+    EXPECT_EQ(g_renderRecord.renderCount, 0u);
+    EXPECT_NE(g_renderRecord.srcAddr, g_renderRecord.dstAddr);
+    EXPECT_EQ(g_renderRecord.dstAddr, GetPixels(pixelmap.get()));
+    EXPECT_TRUE(g_renderRecord.isSrcIntact);
+    EXPECT_TRUE(IsFilledWith(GetPixels(pixelmap.get()), GetPixelsLen(pixelmap.get()), DST_PIXEL_VALUE));
+
+    errorCode = OH_EffectFilter_Release(filter);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterRenderWithDst002 END";
+}
+
+/**
+ * Feature: ImageEffect
+ * Function: Test OH_EffectFilter_Render with the dst render callback in in place mode
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: The in place filter falls back to the render callback on the output pixels
+ */
+HWTEST_F(ImageEffectCApiUnittest, OHEFilterRenderWithDst003, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterRenderWithDst003 start";
+
+    g_renderRecord.Reset();
+    OH_EffectFilterInfo_SetFilterName(filterInfo_, "CustomInPlaceEFilter");
+    OH_EffectFilterInfo_SetRenderMode(filterInfo_, ImageEffect_RenderMode::EFFECT_RENDER_MODE_IN_PLACE);
+    ImageEffect_ErrorCode errorCode = OH_EffectFilter_RegisterWithDstRender(filterInfo_, &g_recordDelegate,
+        RecordRenderWithDst);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+
+    std::shared_ptr<OH_PixelmapNative> input = CreateFilledPixelmap(RENDER_TEST_WIDTH, RENDER_TEST_HEIGHT,
+        PixelFormat::RGBA_8888, SRC_PIXEL_VALUE);
+    std::shared_ptr<OH_PixelmapNative> output = CreateFilledPixelmap(RENDER_TEST_WIDTH, RENDER_TEST_HEIGHT,
+        PixelFormat::RGBA_8888, 0);
+    ASSERT_NE(input, nullptr);
+    ASSERT_NE(output, nullptr);
+    OH_EffectFilter *filter = OH_EffectFilter_Create("CustomInPlaceEFilter");
+    ASSERT_NE(filter, nullptr);
+
+    errorCode = OH_EffectFilter_Render(filter, input.get(), output.get());
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    EXPECT_EQ(g_renderRecord.renderWithDstCount, 0u);
+    EXPECT_EQ(g_renderRecord.renderCount, 1u);
+    EXPECT_EQ(g_renderRecord.renderAddr, GetPixels(output.get()));
+    EXPECT_TRUE(IsFilledWith(GetPixels(output.get()), GetPixelsLen(output.get()), SRC_PIXEL_VALUE));
+
+    errorCode = OH_EffectFilter_Render(filter, input.get(), input.get());
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    EXPECT_EQ(g_renderRecord.renderWithDstCount, 0u);
+    EXPECT_EQ(g_renderRecord.renderCount, 2u);
+    EXPECT_EQ(g_renderRecord.renderAddr, GetPixels(input.get()));
+
+    errorCode = OH_EffectFilter_Release(filter);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterRenderWithDst003 END";
+}
+
+/**
+ * Feature: ImageEffect
+ * Function: Test OH_EffectFilter_Render with the dst render callback in src to dst or in place mode
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: The callback gets one buffer as src and dst on one pixelmap and two buffers on two pixelmaps
+ */
+HWTEST_F(ImageEffectCApiUnittest, OHEFilterRenderWithDst004, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterRenderWithDst004 start";
+
+    g_renderRecord.Reset();
+    OH_EffectFilterInfo_SetFilterName(filterInfo_, "CustomAnyModeEFilter");
+    OH_EffectFilterInfo_SetRenderMode(filterInfo_, ImageEffect_RenderMode::EFFECT_RENDER_MODE_SRC_TO_DST_OR_IN_PLACE);
+    ImageEffect_ErrorCode errorCode = OH_EffectFilter_RegisterWithDstRender(filterInfo_, &g_recordDelegate,
+        RecordRenderWithDst);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+
+    std::shared_ptr<OH_PixelmapNative> input = CreateFilledPixelmap(RENDER_TEST_WIDTH, RENDER_TEST_HEIGHT,
+        PixelFormat::RGBA_8888, SRC_PIXEL_VALUE);
+    std::shared_ptr<OH_PixelmapNative> output = CreateFilledPixelmap(RENDER_TEST_WIDTH, RENDER_TEST_HEIGHT,
+        PixelFormat::RGBA_8888, 0);
+    ASSERT_NE(input, nullptr);
+    ASSERT_NE(output, nullptr);
+    OH_EffectFilter *filter = OH_EffectFilter_Create("CustomAnyModeEFilter");
+    ASSERT_NE(filter, nullptr);
+
+    errorCode = OH_EffectFilter_Render(filter, input.get(), output.get());
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    EXPECT_EQ(g_renderRecord.renderWithDstCount, 1u);
+    EXPECT_EQ(g_renderRecord.srcAddr, GetPixels(input.get()));
+    EXPECT_EQ(g_renderRecord.dstAddr, GetPixels(output.get()));
+    EXPECT_FALSE(g_renderRecord.isDstPreCopied);
+
+    errorCode = OH_EffectFilter_Render(filter, input.get(), input.get());
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    EXPECT_EQ(g_renderRecord.renderWithDstCount, 2u);
+    EXPECT_EQ(g_renderRecord.renderCount, 0u);
+    EXPECT_EQ(g_renderRecord.srcAddr, GetPixels(input.get()));
+    EXPECT_EQ(g_renderRecord.dstAddr, GetPixels(input.get()));
+    EXPECT_TRUE(IsFilledWith(GetPixels(input.get()), GetPixelsLen(input.get()), DST_PIXEL_VALUE));
+
+    errorCode = OH_EffectFilter_Release(filter);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterRenderWithDst004 END";
+}
+
+/**
+ * Feature: ImageEffect
+ * Function: Test OH_EffectFilter_Render with the region render callback on a yuv pixelmap
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: The regions of a filter without halo cover every row once with even boundaries and run in place
+ */
+HWTEST_F(ImageEffectCApiUnittest, OHEFilterRenderRegion001, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterRenderRegion001 start";
+
+    g_renderRecord.Reset(REGION_TEST_HEIGHT);
+    OH_EffectFilterInfo_SetFilterName(filterInfo_, "CustomRegionEFilter");
+    ImageEffect_ErrorCode errorCode = OH_EffectFilter_RegisterWithRegionRender(filterInfo_, &g_recordDelegate,
+        RecordRenderRegion);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+
+    std::shared_ptr<OH_PixelmapNative> pixelmap = CreateFilledPixelmap(REGION_TEST_WIDTH, REGION_TEST_HEIGHT,
+        PixelFormat::NV21, SRC_PIXEL_VALUE);
+    ASSERT_NE(pixelmap, nullptr);
+    OH_EffectFilter *filter = OH_EffectFilter_Create("CustomRegionEFilter");
+    ASSERT_NE(filter, nullptr);
+
+    errorCode = OH_EffectFilter_Render(filter, pixelmap.get(), pixelmap.get());
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    EXPECT_GE(g_renderRecord.regionCount, 1u);
+    EXPECT_EQ(g_renderRecord.renderCount, 0u);
+    EXPECT_TRUE(g_renderRecord.isRegionValid);
+    EXPECT_TRUE(IsEveryRowRenderedOnce());
+    EXPECT_EQ(g_renderRecord.srcAddr, GetPixels(pixelmap.get()));
+    EXPECT_EQ(g_renderRecord.dstAddr, GetPixels(pixelmap.get()));
+    EXPECT_TRUE(g_renderRecord.isSrcIntact);
+    size_t lumaLen = static_cast<size_t>(REGION_TEST_WIDTH) * static_cast<size_t>(REGION_TEST_HEIGHT);
+    EXPECT_TRUE(IsFilledWith(GetPixels(pixelmap.get()), lumaLen, DST_PIXEL_VALUE));
+
+    errorCode = OH_EffectFilter_Release(filter);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterRenderRegion001 END";
+}
+
+/**
+ * Feature: ImageEffect
+ * Function: Test OH_EffectFilter_Render with the region render callback and halo
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: A filter with halo reads the regions from a separate buffer and still covers every row once
+ */
+HWTEST_F(ImageEffectCApiUnittest, OHEFilterRenderRegion002, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterRenderRegion002 start";
+
+    g_renderRecord.Reset(REGION_TEST_ODD_HEIGHT);
+    OH_EffectFilterInfo_SetFilterName(filterInfo_, "CustomHaloRegionEFilter");
+    OH_EffectFilterInfo_SetRenderHalo(filterInfo_, 2);
+    ImageEffect_ErrorCode errorCode = OH_EffectFilter_RegisterWithRegionRender(filterInfo_, &g_recordDelegate,
+        RecordRenderRegion);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+
+    std::shared_ptr<OH_PixelmapNative> input = CreateFilledPixelmap(REGION_TEST_WIDTH, REGION_TEST_ODD_HEIGHT,
+        PixelFormat::RGBA_8888, SRC_PIXEL_VALUE);
+    std::shared_ptr<OH_PixelmapNative> output = CreateFilledPixelmap(REGION_TEST_WIDTH, REGION_TEST_ODD_HEIGHT,
+        PixelFormat::RGBA_8888, 0);
+    ASSERT_NE(input, nullptr);
+    ASSERT_NE(output, nullptr);
+    OH_EffectFilter *filter = OH_EffectFilter_Create("CustomHaloRegionEFilter");
+    ASSERT_NE(filter, nullptr);
+
+    errorCode = OH_EffectFilter_Render(filter, input.get(), output.get());
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    EXPECT_TRUE(g_renderRecord.isRegionValid);
+    EXPECT_TRUE(IsEveryRowRenderedOnce());
+    EXPECT_EQ(g_renderRecord.srcAddr, GetPixels(input.get()));
+    EXPECT_EQ(g_renderRecord.dstAddr, GetPixels(output.get()));
+    EXPECT_TRUE(IsFilledWith(GetPixels(output.get()), GetPixelsLen(output.get()), DST_PIXEL_VALUE));
+
+    g_renderRecord.Reset(REGION_TEST_ODD_HEIGHT);
+    errorCode = OH_EffectFilter_Render(filter, input.get(), input.get());
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    EXPECT_TRUE(g_renderRecord.isRegionValid);
+    EXPECT_TRUE(IsEveryRowRenderedOnce());
+    EXPECT_NE(g_renderRecord.srcAddr, g_renderRecord.dstAddr);
+    EXPECT_EQ(g_renderRecord.dstAddr, GetPixels(input.get()));
+    EXPECT_TRUE(g_renderRecord.isSrcIntact);
+    EXPECT_TRUE(IsFilledWith(GetPixels(input.get()), GetPixelsLen(input.get()), DST_PIXEL_VALUE));
+
+    errorCode = OH_EffectFilter_Release(filter);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHEFilterRenderRegion002 END";
+}
+
 /**
  * Feature: ImageEffect
  * Function: Test OH_EffectFilter_LookupFilterInfo with normal parameter
@@ -2659,6 +3243,36 @@ HWTEST_F(ImageEffectCApiUnittest, OHImageEffectSetOutputTextureId002, TestSize.L
     GTEST_LOG_(INFO) << "OHImageEffectSetOutputTextureId002 success! result: " << errorCode;
     GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHImageEffectSetOutputTextureId002 END";
 }
+/**
+ * Feature: ImageEffect
+ * Function: Test OH_ImageEffect_GetFrameStatistics
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test OH_ImageEffect_GetFrameStatistics before any surface frame is rendered
+ */
+HWTEST_F(ImageEffectCApiUnittest, OHImageEffectGetFrameStatistics001, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHImageEffectGetFrameStatistics001 start";
+    OH_ImageEffect *imageEffect = OH_ImageEffect_Create(IMAGE_EFFECT_NAME);
+    ASSERT_NE(imageEffect, nullptr) << "OHImageEffectGetFrameStatistics001 OH_ImageEffect_Create failed";
+
+    ImageEffect_FrameStatistics statistics;
+    ImageEffect_ErrorCode errorCode = OH_ImageEffect_GetFrameStatistics(nullptr, &statistics);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID);
+    errorCode = OH_ImageEffect_GetFrameStatistics(imageEffect, nullptr);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID);
+
+    errorCode = OH_ImageEffect_GetFrameStatistics(imageEffect, &statistics);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS) << "OH_ImageEffect_GetFrameStatistics failed";
+    EXPECT_EQ(statistics.renderedFrames, 0);
+    EXPECT_EQ(statistics.droppedFrames, 0);
+    EXPECT_EQ(statistics.latency[EFFECT_FRAME_STAGE_TOTAL].p99, 0);
+
+    errorCode = OH_ImageEffect_Release(imageEffect);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    GTEST_LOG_(INFO) << "ImageEffectCApiUnittest: OHImageEffectGetFrameStatistics001 END";
+}
 } // namespace Effect
 } // namespace Media
 } // namespace OHOS
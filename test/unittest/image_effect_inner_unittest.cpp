@@ -15,6 +15,8 @@
 
 #include "image_effect_inner_unittest.h"
 
+#include <algorithm>
+
 #include "efilter_factory.h"
 #include "brightness_efilter.h"
 #include "contrast_efilter.h"
@@ -75,11 +77,11 @@ void ImageEffectInnerUnittest::TearDownTestCase() {}
 void ImageEffectInnerUnittest::SetUp()
 {
     ExternLoader::Instance()->InitExt();
-    EFilterFactory::Instance()->functions_.clear();
+    EFilterFactory::Instance()->ClearFunctions();
     EFilterFactory::Instance()->RegisterEFilter<BrightnessEFilter>(BRIGHTNESS_EFILTER);
     EFilterFactory::Instance()->RegisterEFilter<ContrastEFilter>(CONTRAST_EFILTER);
     EFilterFactory::Instance()->RegisterEFilter<CropEFilter>(CROP_EFILTER);
-    EFilterFactory::Instance()->delegates_.clear();
+    EFilterFactory::Instance()->ClearDelegates();
     mockPixelMap_ = new MockPixelMap();
     imageEffect_ = new FakeImageEffect();
     efilter_ = new FakeEFilter(BRIGHTNESS_EFILTER);
@@ -720,6 +722,63 @@ HWTEST_F(ImageEffectInnerUnittest, Quality_HEIC_Fallback_001, TestSize.Level1)
     ErrorCode res = imageEffect_->Start();
     EXPECT_EQ(res, ErrorCode::SUCCESS);
 }
+HWTEST_F(ImageEffectInnerUnittest, Configure_InFlightDepth_001, TestSize.Level1)
+{
+    Any invalidDepth = 0;
+    EXPECT_EQ(imageEffect_->Configure("inFlightDepth", invalidDepth), ErrorCode::ERR_INVALID_PARAMETER_VALUE);
+    invalidDepth = 4;
+    EXPECT_EQ(imageEffect_->Configure("inFlightDepth", invalidDepth), ErrorCode::ERR_INVALID_PARAMETER_VALUE);
+
+    imageEffect_->maxBufferPoolSize_.store(3);
+    imageEffect_->bufferPool_ = std::make_shared<ThreadSafeBufferQueue<BufferEntry>>(DEFAULT_IN_FLIGHT_DEPTH);
+    Any depth = 1;
+    EXPECT_EQ(imageEffect_->Configure("inFlightDepth", depth), ErrorCode::SUCCESS);
+    EXPECT_EQ(imageEffect_->inFlightDepth_.load(), 1);
+    EXPECT_EQ(imageEffect_->bufferPool_->Capacity(), 1);
+
+    // The stalest frame is evicted instead of blocking the producer.
+    std::vector<BufferEntry> droppedEntries;
+    imageEffect_->bufferPool_->PushLatest({ 1, nullptr, nullptr, 0 }, droppedEntries);
+    EXPECT_TRUE(droppedEntries.empty());
+    imageEffect_->bufferPool_->PushLatest({ 2, nullptr, nullptr, 0 }, droppedEntries);
+    ASSERT_EQ(droppedEntries.size(), 1);
+    EXPECT_EQ(droppedEntries[0].seqNum_, 1);
+    auto entry = imageEffect_->bufferPool_->TryPop(false);
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(entry->seqNum_, 2);
+    imageEffect_->bufferPool_ = nullptr;
+}
+
+HWTEST_F(ImageEffectInnerUnittest, Configure_RenderProfile_001, TestSize.Level1)
+{
+    std::shared_ptr<EFilter> efilter = EFilterFactory::Instance()->Create(BRIGHTNESS_EFILTER);
+    imageEffect_->AddEFilter(efilter);
+    Any value = 100.f;
+    efilter->SetValue(KEY_FILTER_INTENSITY, value);
+    ASSERT_EQ(imageEffect_->SetInputPixelMap(mockPixelMap_), ErrorCode::SUCCESS);
+    ASSERT_EQ(imageEffect_->Start(), ErrorCode::SUCCESS);
+    EXPECT_EQ(imageEffect_->GetRenderProfile(), nullptr);
+
+    Any invalidValue = 1;
+    EXPECT_EQ(imageEffect_->Configure("renderProfile", invalidValue), ErrorCode::ERR_ANY_CAST_TYPE_NOT_MATCH);
+    Any isEnabled = true;
+    EXPECT_EQ(imageEffect_->Configure("renderProfile", isEnabled), ErrorCode::SUCCESS);
+    ASSERT_EQ(imageEffect_->Start(), ErrorCode::SUCCESS);
+
+    std::shared_ptr<EffectRenderProfile> profile = imageEffect_->GetRenderProfile();
+    ASSERT_NE(profile, nullptr);
+    std::vector<EffectProfileRecord> records = profile->GetRecords();
+    auto hasStage = [&records](ProfileStage stage) {
+        return std::any_of(records.begin(), records.end(),
+            [stage](const EffectProfileRecord &record) { return record.stage_ == stage; });
+    };
+    EXPECT_TRUE(hasStage(ProfileStage::GET_IMAGE_INFO));
+    EXPECT_TRUE(hasStage(ProfileStage::PREPARE));
+    EXPECT_TRUE(hasStage(ProfileStage::LOCK_ALL));
+    EXPECT_TRUE(hasStage(ProfileStage::FILTER_RENDER));
+    EXPECT_TRUE(hasStage(ProfileStage::SINK));
+    EXPECT_FALSE(profile->ToJson()->GetArray("stages").empty());
+}
 } // namespace Effect
 } // namespace Media
 } // namespace OHOS
\ No newline at end of file
@@ -168,13 +168,13 @@ public:
         mockPixelMap_ = std::make_shared<MockPixelMap>();
         pixelmapNative_ = new OH_PixelmapNative(mockPixelMap_);
         ExternLoader::Instance()->InitExt();
-        EFilterFactory::Instance()->functions_.clear();
+        EFilterFactory::Instance()->ClearFunctions();
         EFilterFactory::Instance()->RegisterEFilter<BrightnessEFilter>(BRIGHTNESS_EFILTER);
         EFilterFactory::Instance()->RegisterEFilter<ContrastEFilter>(CONTRAST_EFILTER);
         EFilterFactory::Instance()->RegisterEFilter<CustomTestEFilter>(CUSTOM_TEST_EFILTER);
         EFilterFactory::Instance()->RegisterEFilter<CustomTestEFilter2>(CUSTOM_TEST_EFILTER2);
         EFilterFactory::Instance()->RegisterEFilter<CropEFilter>(CROP_EFILTER);
-        EFilterFactory::Instance()->delegates_.clear();
+        EFilterFactory::Instance()->ClearDelegates();
         filterInfo_ = OH_EffectFilterInfo_Create();
         OH_EffectFilterInfo_SetFilterName(filterInfo_, BRIGHTNESS_EFILTER);
         ImageEffect_BufferType bufferTypes[] = { ImageEffect_BufferType::EFFECT_BUFFER_TYPE_PIXEL };